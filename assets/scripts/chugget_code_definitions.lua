@@ -3803,7 +3803,7 @@ InheritedProperties = {
     ---@type InheritedPropertiesType
     role_type = nil,  -- The role of this entity in the hierarchy.
     ---@type Entity
-    master = nil,  -- The master entity this entity inherits from.
+    master = nil,  -- The master entity this entity inherits from. Read-only; use transform.AssignRole to change it.
     ---@type Vector2
     offset = nil,  -- The current offset from the master.
     ---@type Vector2
@@ -12241,15 +12241,6 @@ function transform.CreateOrEmplace(...) end
 ---@return Entity
 function transform.CreateGameWorldContainerEntity(...) end
 
----
---- Updates spring smoothing factors for a transform.
----
----@param registry registry
----@param e Entity
----@param dt number
----@return nil
-function transform.UpdateTransformSmoothingFactors(...) end
-
 ---
 --- Injects dynamic motion into a transform's springs.
 ---
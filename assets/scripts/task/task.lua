@@ -14,6 +14,10 @@ end
 
 -- Wait for a duration (deltaTime-aware)
 function M.wait(seconds)
+    -- Scheduler tasks sleep until due instead of being resumed every frame.
+    if tasks and tasks.in_task() then
+        return tasks.wait(seconds)
+    end
     local elapsed = 0
     while elapsed < seconds do
         local dt = coroutine.yield()
@@ -22,6 +26,15 @@ function M.wait(seconds)
     end
 end
 
+-- Wait for n updates / until tasks.notify(event, ...); returns notify's arguments
+function M.wait_frames(n)
+    return tasks.wait_frames(n)
+end
+
+function M.wait_event(event)
+    return tasks.wait_event(event)
+end
+
 -- Fire-and-forget coroutine task
 function M.run_task(self, fn)
     local co = fn
@@ -30,6 +30,10 @@ enum class PlaybackDirection {
 
 struct SpriteComponentASCII
 {
+    // Removing a sprite leaves a hole instead of moving the last one into its
+    // place, so ecs_ffi sprite views of other entities stay put.
+    static constexpr auto in_place_delete = true;
+
     std::shared_ptr<globals::SpriteFrameData> spriteFrame{}; // coordinates of the sprite on the sprite image
 
     FrameData spriteData{}; // the sprite data for the sprite TODO: phase out spriteframe and use this instead
@@ -17,6 +17,7 @@
 #include "sol/sol.hpp"
 
 #include "core/event_bus.hpp"
+#include "core/event_channel.hpp"
 #include "core/globals.hpp"
 #include "components/graphics.hpp"
 #include "systems/shaders/shader_system.hpp"
@@ -55,6 +56,7 @@ struct EngineContext {
 
     std::shared_ptr<PhysicsManager> physicsManager{};
     event_bus::EventBus eventBus;
+    event_bus::EventChannels eventChannels; // pull-based, for high-volume events
 
     // Resource caches (owned)
     std::map<std::string, Texture2D> textureAtlas;
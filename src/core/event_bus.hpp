@@ -1,21 +1,25 @@
 #pragma once
 
-#include <any>
+#include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <functional>
+#include <memory>
 #include <utility>
-#include <typeindex>
-#include <unordered_map>
 #include <vector>
 
 #include "spdlog/spdlog.h"
 
 namespace event_bus {
 
-// Base event with a timestamp to help future ordering/latency tracking.
-struct Event {
-    Event() : timestamp(std::chrono::system_clock::now()) {}
-    virtual ~Event() = default;
+// Base event. Empty, so high-volume events (collisions) stay plain data and
+// are cheap to copy into the deferred queues.
+struct Event {};
+
+// For events whose listeners care when they were raised. Stamping costs a
+// clock read per event, so only the events that need it opt in.
+struct TimestampedEvent : Event {
+    TimestampedEvent() : timestamp(std::chrono::system_clock::now()) {}
 
     std::chrono::system_clock::time_point timestamp;
 };
@@ -23,6 +27,22 @@ struct Event {
 template <typename EventT>
 using EventListener = std::function<void(const EventT &)>;
 
+using EventTypeId = uint32_t;
+
+namespace detail {
+inline EventTypeId nextEventTypeId() {
+    static std::atomic<EventTypeId> next{0};
+    return next.fetch_add(1, std::memory_order_relaxed);
+}
+} // namespace detail
+
+// Dense id per event type, assigned on first use and shared by every bus.
+template <typename EventT>
+EventTypeId eventTypeId() {
+    static const EventTypeId id = detail::nextEventTypeId();
+    return id;
+}
+
 class EventBus {
 public:
     EventBus() = default;
@@ -30,67 +50,103 @@ public:
     // Subscribe to an event type.
     template <typename EventT>
     void subscribe(EventListener<EventT> listener) {
-        auto &list = getListeners<EventT>();
-        list.push_back(std::move(listener));
+        channel<EventT>().listeners.push_back(std::move(listener));
     }
 
     // Publish an event. If we're mid-dispatch, defer until the current dispatch completes.
     template <typename EventT>
     void publish(const EventT &event) {
+        auto &ch = channel<EventT>();
         if (dispatching_) {
-            deferred_.emplace_back([this, event]() { publish(event); });
+            ch.deferred.push_back(event);
+            if (!ch.queued) {
+                ch.queued = true;
+                pendingTypes_.push_back(eventTypeId<EventT>());
+            }
             return;
         }
 
         dispatching_ = true;
-        auto &list = getListeners<EventT>();
-        for (auto &listener : list) {
-            try {
-                listener(event);
-            } catch (const std::exception &e) {
-                SPDLOG_ERROR("Event listener threw: {}", e.what());
-            } catch (...) {
-                SPDLOG_ERROR("Event listener threw an unknown exception");
-            }
-        }
+        ch.dispatch(event);
         dispatching_ = false;
         processDeferred();
     }
 
-    // Flush any deferred events accumulated during nested dispatch.
+    // Flush any deferred events accumulated during nested dispatch. Each type's
+    // events are drained together; types go in the order they were first deferred.
     void processDeferred() {
-        // Drain in FIFO order while allowing newly deferred events to chain.
-        while (!deferred_.empty()) {
-            auto pending = std::move(deferred_);
-            deferred_.clear();
-            for (auto &fn : pending) {
-                if (fn) fn();
-            }
+        if (dispatching_) return;
+        dispatching_ = true;
+        // Drain while allowing newly deferred events to chain.
+        while (!pendingTypes_.empty()) {
+            std::vector<EventTypeId> types;
+            types.swap(pendingTypes_);
+            for (EventTypeId id : types) channels_[id]->drain();
         }
+        dispatching_ = false;
     }
 
     void clear() {
-        listeners_.clear();
-        deferred_.clear();
+        for (auto &ch : channels_) {
+            if (ch) ch->clear();
+        }
+        pendingTypes_.clear();
         dispatching_ = false;
     }
 
 private:
-    template <typename EventT>
-    using ListenerList = std::vector<EventListener<EventT>>;
+    struct ChannelBase {
+        virtual ~ChannelBase() = default;
+        virtual void drain() = 0;
+        virtual void clear() = 0;
+
+        bool queued = false; // listed in pendingTypes_
+    };
 
     template <typename EventT>
-    ListenerList<EventT> &getListeners() {
-        const std::type_index key{typeid(EventT)};
-        auto it = listeners_.find(key);
-        if (it == listeners_.end()) {
-            it = listeners_.emplace(key, ListenerList<EventT>{}).first;
+    struct Channel final : ChannelBase {
+        std::vector<EventListener<EventT>> listeners;
+        std::vector<EventT> deferred;
+        std::vector<EventT> draining; // keeps its capacity between drains
+
+        void dispatch(const EventT &event) {
+            // by index: a listener may subscribe more listeners, or clear the bus
+            for (size_t i = 0, n = listeners.size(); i < n && i < listeners.size(); ++i) {
+                try {
+                    listeners[i](event);
+                } catch (const std::exception &e) {
+                    SPDLOG_ERROR("Event listener threw: {}", e.what());
+                } catch (...) {
+                    SPDLOG_ERROR("Event listener threw an unknown exception");
+                }
+            }
+        }
+
+        void drain() override {
+            queued = false;
+            draining.swap(deferred);
+            for (const EventT &event : draining) dispatch(event);
+            draining.clear();
+        }
+
+        void clear() override {
+            listeners.clear();
+            deferred.clear();
+            queued = false;
         }
-        return *std::any_cast<ListenerList<EventT>>(&it->second);
+    };
+
+    template <typename EventT>
+    Channel<EventT> &channel() {
+        const EventTypeId id = eventTypeId<EventT>();
+        if (id >= channels_.size()) channels_.resize(id + 1);
+        auto &slot = channels_[id];
+        if (!slot) slot = std::make_unique<Channel<EventT>>();
+        return static_cast<Channel<EventT> &>(*slot);
     }
 
-    std::unordered_map<std::type_index, std::any> listeners_;
-    std::vector<std::function<void()>> deferred_;
+    std::vector<std::unique_ptr<ChannelBase>> channels_; // indexed by EventTypeId
+    std::vector<EventTypeId> pendingTypes_;
     bool dispatching_{false};
 };
 
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "core/event_bus.hpp"
+
+namespace event_bus {
+
+// Pull-based counterpart to EventBus for high-volume events (collisions,
+// damage ticks, particle deaths). Producers append plain-data events; each
+// consumer reads everything it has not seen yet as one or two contiguous
+// spans, once per frame, instead of being called once per event.
+//
+// Events are double-buffered: swapBuffers() (once per frame) retires the
+// older buffer and starts a new one, so an event stays readable for the
+// frame it was pushed in and the next. A consumer that reads at least once
+// per frame sees every event exactly once, whether it runs before or after
+// the producers.
+template <typename EventT>
+class EventChannel {
+    static_assert(std::is_trivially_copyable_v<EventT>, "channel events must be plain data");
+
+public:
+    // A consumer's position in the channel; one per consumer.
+    struct Reader {
+        uint64_t next = 0; // sequence number of the first event not yet read
+    };
+
+    // Unread events, oldest first.
+    struct Batch {
+        std::span<const EventT> older;
+        std::span<const EventT> newer;
+
+        size_t size() const { return older.size() + newer.size(); }
+        bool empty() const { return older.empty() && newer.empty(); }
+
+        template <typename Fn>
+        void forEach(Fn &&fn) const {
+            for (const EventT &e : older) fn(e);
+            for (const EventT &e : newer) fn(e);
+        }
+    };
+
+    void push(const EventT &event) {
+        buffers_[1].events.push_back(event);
+        ++count_;
+    }
+
+    template <typename... Args>
+    void emplace(Args &&...args) {
+        buffers_[1].events.emplace_back(std::forward<Args>(args)...);
+        ++count_;
+    }
+
+    // Starts at the current end: only events pushed from now on.
+    Reader reader() const { return Reader{count_}; }
+
+    Batch read(Reader &reader) const {
+        Batch batch{unread(buffers_[0], reader.next), unread(buffers_[1], reader.next)};
+        reader.next = count_;
+        return batch;
+    }
+
+    // Once per frame. Events older than the previous frame are dropped.
+    void swapBuffers() {
+        std::swap(buffers_[0], buffers_[1]);
+        buffers_[1].events.clear(); // keeps its capacity
+        buffers_[1].first = count_;
+    }
+
+    void clear() {
+        for (Buffer &b : buffers_) {
+            b.events.clear();
+            b.first = count_;
+        }
+    }
+
+    // Events still readable by a new-enough reader.
+    size_t size() const { return buffers_[0].events.size() + buffers_[1].events.size(); }
+
+private:
+    struct Buffer {
+        std::vector<EventT> events;
+        uint64_t first = 0; // sequence number of events[0]
+    };
+
+    static std::span<const EventT> unread(const Buffer &b, uint64_t next) {
+        const uint64_t end = b.first + b.events.size();
+        if (next >= end) return {};
+        const size_t skip = next > b.first ? static_cast<size_t>(next - b.first) : 0;
+        return std::span<const EventT>(b.events).subspan(skip);
+    }
+
+    Buffer buffers_[2]; // [0] previous frame, [1] this frame
+    uint64_t count_ = 0; // events ever pushed
+};
+
+// One EventChannel per event type, indexed by the same dense ids as EventBus.
+class EventChannels {
+public:
+    template <typename EventT>
+    EventChannel<EventT> &channel() {
+        const EventTypeId id = eventTypeId<EventT>();
+        if (id >= channels_.size()) channels_.resize(id + 1);
+        auto &slot = channels_[id];
+        if (!slot) slot = std::make_unique<Holder<EventT>>();
+        return static_cast<Holder<EventT> &>(*slot).channel;
+    }
+
+    template <typename EventT>
+    void push(const EventT &event) {
+        channel<EventT>().push(event);
+    }
+
+    // Once per frame, before the producers run.
+    void swapBuffers() {
+        for (auto &ch : channels_) {
+            if (ch) ch->swapBuffers();
+        }
+    }
+
+    void clear() {
+        for (auto &ch : channels_) {
+            if (ch) ch->clear();
+        }
+    }
+
+private:
+    struct HolderBase {
+        virtual ~HolderBase() = default;
+        virtual void swapBuffers() = 0;
+        virtual void clear() = 0;
+    };
+
+    template <typename EventT>
+    struct Holder final : HolderBase {
+        EventChannel<EventT> channel;
+
+        void swapBuffers() override { channel.swapBuffers(); }
+        void clear() override { channel.clear(); }
+    };
+
+    std::vector<std::unique_ptr<HolderBase>> channels_; // indexed by EventTypeId
+};
+
+} // namespace event_bus
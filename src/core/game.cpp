@@ -83,6 +83,7 @@
 #include "systems/composable_mechanics/ability.hpp"
 
 #include "systems/scripting/lua_hot_reload.hpp"
+#include "systems/scripting/lua_sampler.hpp"
 #include "sol/types.hpp"
 
 using std::pair;
@@ -521,6 +522,8 @@ namespace game
         
         timer::TimerSystem::clear_all_timers();
         event_system::ClearAllListeners(); // drop Lua callbacks before nuking the Lua state
+        scripting::task_scheduler().clear(); // same for script coroutines
+        lua_profiler::sampler().stop(); // the sampler hooks the old state
         localization::clearLanguageChangedCallbacks(); // drop localized UI callbacks (Lua-backed)
         
         globals::getRegistry().view<transform::Transform>().each([](auto entity, auto &t){
@@ -1025,6 +1028,40 @@ Texture2D GenerateDensityTexture(BlockSampler* sampler, const Camera2D& camera)
 
     std::shared_ptr<BasicTileCache> _tileCache = nullptr;
 
+    // Collision events are pulled once per frame as a batch rather than pushed
+    // to a listener per event; there can be thousands of them.
+    static event_bus::EventChannel<events::CollisionStarted>::Reader collisionStartedReader{};
+    static event_bus::EventChannel<events::CollisionEnded>::Reader collisionEndedReader{};
+
+    static void consumeCollisionEvents()
+    {
+        auto& channels = globals::getEventChannels();
+        const auto started = channels.channel<events::CollisionStarted>().read(collisionStartedReader);
+        const auto ended = channels.channel<events::CollisionEnded>().read(collisionEndedReader);
+        const float now = main_loop::mainLoop.totaltimeTimer;
+
+        started.forEach([&](const events::CollisionStarted& ev) {
+            globals::pushCollisionLog(globals::CollisionNote{ev.entityA, ev.entityB, true, ev.point, now});
+        });
+        ended.forEach([&](const events::CollisionEnded& ev) {
+            globals::pushCollisionLog(globals::CollisionNote{ev.entityA, ev.entityB, false, Vector2{0.0f, 0.0f}, now});
+        });
+
+        if (!started.empty()) {
+            const auto& last = started.newer.empty() ? started.older.back() : started.newer.back();
+            // Update a debug uniform so shaders can react to collisions (e.g., flash).
+            globals::getGlobalShaderUniforms().set("collision_flash", "last_hit",
+                Vector2{(float)entt::to_integral(last.entityA), (float)entt::to_integral(last.entityB)});
+            globals::setLastCollision(last.entityA, last.entityB);
+            // Provide immediate haptic feedback for collisions.
+            globals::getVibration() = std::min(1.0f, globals::getVibration() + 0.5f);
+        }
+        if (!ended.empty()) {
+            const auto& last = ended.newer.empty() ? ended.older.back() : ended.newer.back();
+            globals::setLastCollision(last.entityA, last.entityB);
+        }
+    }
+
     // perform game-specific initialization here. This makes it easier to find all the initialization code
     // specific to a game project
     auto init() -> void
@@ -1149,31 +1186,7 @@ Texture2D GenerateDensityTexture(BlockSampler* sampler, const Camera2D& camera)
                                         {"platform", telemetry::PlatformTag()},
                                         {"build_id", telemetry::BuildId()}});
             });
-            bus.subscribe<events::CollisionStarted>([](const events::CollisionStarted& ev) {
-                // Update a debug uniform so shaders can react to collisions (e.g., flash).
-                globals::getGlobalShaderUniforms().set("collision_flash", "last_hit",
-                    Vector2{(float)entt::to_integral(ev.entityA), (float)entt::to_integral(ev.entityB)});
-                globals::setLastCollision(ev.entityA, ev.entityB);
-                // Provide immediate haptic feedback for collisions.
-                globals::getVibration() = std::min(1.0f, globals::getVibration() + 0.5f);
-                globals::pushCollisionLog(globals::CollisionNote{
-                    ev.entityA,
-                    ev.entityB,
-                    true,
-                    ev.point,
-                    main_loop::mainLoop.totaltimeTimer
-                });
-            });
-            bus.subscribe<events::CollisionEnded>([](const events::CollisionEnded& ev) {
-                globals::setLastCollision(ev.entityA, ev.entityB);
-                globals::pushCollisionLog(globals::CollisionNote{
-                    ev.entityA,
-                    ev.entityB,
-                    false,
-                    Vector2{0.0f, 0.0f},
-                    main_loop::mainLoop.totaltimeTimer
-                });
-            });
+            // Collisions come through globals::getEventChannels(); see consumeCollisionEvents().
         }
         
         // // testing
@@ -1386,6 +1399,8 @@ world.SetGlobalDamping(0.2f);         // world‑wide damping
         // Process pending save callbacks on main thread
         save_io::process_pending_callbacks();
 
+        consumeCollisionEvents();
+
         // physicsWorld->Update(delta);
         // _tileCache->ensureRect(cpBBNew(0, 0, globals::VIRTUAL_WIDTH, globals::VIRTUAL_HEIGHT));
 
@@ -1485,7 +1500,6 @@ world.SetGlobalDamping(0.2f);         // world‑wide damping
         //     physicsWorld->EndMouseDrag();
 
         globals::getMasterCacheEntityToParentCompMap.clear();
-        globals::g_springCache.clear();
         
         // tag all objects attached to UI so we don't have to check later
         // globals::getRegistry().clear<ui::ObjectAttachedToUITag>();
@@ -41,6 +41,7 @@ namespace globals {
     EngineContext* g_ctx = nullptr;
     static AudioContext g_audioContext{};
     static event_bus::EventBus g_fallbackEventBus{};
+    static event_bus::EventChannels g_fallbackEventChannels{};
 
     // Mouse/cursor tracking mirrored into EngineContext when present.
     Vector2 worldMousePosition = {0,0};
@@ -214,8 +215,6 @@ void setEngineContext(EngineContext* ctx) {
         return getPhysicsManagerPtr().get();
     }
     
-    std::unordered_map<entt::entity, transform::SpringCacheBundle> g_springCache;
-
     std::unordered_map<entt::entity, transform::MasterCacheEntry> getMasterCacheEntityToParentCompMap{};
 
     float globalUIScaleFactor =1.f; // scale factor for UI elements
@@ -312,26 +311,11 @@ void setEngineContext(EngineContext* ctx) {
             return kEmpty;
         }
 
-        auto fetchSpring = [&](entt::entity springEid) -> const spring::Spring * {
-            if (!registry.valid(springEid)) return nullptr;
-            return registry.try_get<spring::Spring>(springEid);
-        };
-
-        const auto *springX = fetchSpring(transform->x);
-        const auto *springY = fetchSpring(transform->y);
-        const auto *springW = fetchSpring(transform->w);
-        const auto *springH = fetchSpring(transform->h);
-        const auto *springR = fetchSpring(transform->r);
-
-        if (!springX || !springY || !springW || !springH || !springR) {
-            return kEmpty;
-        }
-
-        const float x = springX->targetValue;
-        const float y = springY->targetValue;
-        const float w = springW->targetValue;
-        const float h = springH->targetValue;
-        const float r = std::abs(springR->targetValue);
+        const float x = transform->getXSpring().targetValue;
+        const float y = transform->getYSpring().targetValue;
+        const float w = transform->getWSpring().targetValue;
+        const float h = transform->getHSpring().targetValue;
+        const float r = std::abs(transform->getRSpring().targetValue);
     
         // Use inflation factor only when rotation is non-negligible
         constexpr float inflation = 1.4142f; // sqrt(2)
@@ -709,6 +693,13 @@ void setEngineContext(EngineContext* ctx) {
         return g_fallbackEventBus;
     }
 
+    event_bus::EventChannels& getEventChannels() {
+        if (g_ctx) {
+            return g_ctx->eventChannels;
+        }
+        return g_fallbackEventChannels;
+    }
+
     input::InputState& getInputState() {
         if (g_ctx && g_ctx->inputState) {
             return *g_ctx->inputState;
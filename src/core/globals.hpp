@@ -34,6 +34,7 @@
 #include "../systems/collision/Quadtree.h"
 #include "../systems/localization/localization.hpp"
 #include "event_bus.hpp"
+#include "event_channel.hpp"
 
 #include "third_party/rlImGui/imgui.h" // raylib imGUI binding
 
@@ -91,7 +92,6 @@ struct InputState;
 
 namespace transform {
 struct MasterCacheEntry;
-struct SpringCacheBundle;
 } // namespace transform
 
 namespace shaders {
@@ -154,9 +154,6 @@ ENGINECTX_DEPRECATED("Access EngineContext::physicsManager instead of "
                      "globals::getPhysicsManager()")
 [[nodiscard]] PhysicsManager *getPhysicsManager();
 
-extern std::unordered_map<entt::entity, transform::SpringCacheBundle>
-    g_springCache;
-
 extern std::unordered_map<entt::entity, transform::MasterCacheEntry>
     getMasterCacheEntityToParentCompMap;
 
@@ -576,6 +573,9 @@ extern entt::registry registry;
 ENGINECTX_DEPRECATED(
     "Access EngineContext::eventBus instead of globals::getEventBus()")
 [[nodiscard]] event_bus::EventBus &getEventBus();
+ENGINECTX_DEPRECATED(
+    "Access EngineContext::eventChannels instead of globals::getEventChannels()")
+[[nodiscard]] event_bus::EventChannels &getEventChannels();
 
 // Helpers to bridge cursor entity while migrating to EngineContext.
 ENGINECTX_DEPRECATED(
@@ -53,9 +53,15 @@
 #include "systems/localization/localization.hpp"
 #include "systems/loading_screen/loading_screen.hpp"
 #include "systems/loading_screen/loading_progress.hpp"
+#include "systems/job_system/job_system.hpp"
+#include "systems/particles/particle_governor.hpp"
 
 #include "util/utilities.hpp" // global utilty methods
 #include "util/perf_overlay.hpp"
+#include "systems/scripting/lua_gc_pacer.hpp"
+#include "systems/scripting/lua_sampler.hpp"
+#include "systems/scripting/lua_hot_reload.hpp"
+#include "systems/file_watch/file_watch.hpp"
 #if ENABLE_GOAP
 #include "systems/ai/goap_debug_window.hpp"
 #endif
@@ -103,6 +109,7 @@ using json = nlohmann::json;
 #include "systems/shaders/shader_system.hpp"
 #include "systems/sound/sound_system.hpp"
 #include "systems/timer/timer.hpp"
+#include "systems/timer/tween_system.hpp"
 #include "testing/test_mode.hpp"
 #include "testing/test_mode_config.hpp"
 
@@ -298,6 +305,11 @@ void RunGameLoop() {
   while (!WindowShouldClose() && !g_test_mode_exit_requested) {
     ZONE_SCOPED("RunGameLoop"); // custom label
 #endif
+    scripting::lua_gc_pacer().beginFrame();
+#ifndef __EMSCRIPTEN__
+    file_watch::watcher().update(GetTime());
+#endif
+
     if (render_enabled) {
       ZONE_SCOPED("BeginDrawing/rlImGuiBegin call");
       BeginDrawing();
@@ -411,6 +423,10 @@ void RunGameLoop() {
     mainLoop.lag = std::min(mainLoop.lag + lagDelta,
                             mainLoop.rate * mainLoop.maxFrameSkip);
 
+    // Start this frame's buffers for the pull-based event channels (collisions
+    // etc.); last frame's events stay readable until the next swap.
+    globals::getEventChannels().swapBuffers();
+
     // ---------- Step 3: Fixed updates ----------
     int updatesPerformed = 0;
     while (mainLoop.lag >= mainLoop.rate &&
@@ -497,6 +513,16 @@ void RunGameLoop() {
       fpsLastTime = now;
     }
 
+    // ---------- Step 7: Lua GC in the frame's slack ----------
+    // Budget is the fixed step, or the frame time when frames are shorter.
+    {
+      float frameBudget = mainLoop.rate;
+      if (mainLoop.framerate > 0.0f)
+        frameBudget = std::min(frameBudget, 1.0f / mainLoop.framerate);
+      scripting::lua_gc_pacer().endFrame(ai_system::masterStateLua.lua_state(),
+                                         frameBudget * 1000.0);
+    }
+
     if (render_enabled) {
       ZONE_SCOPED("EndDrawing/rlImGuiEnd call");
 
@@ -508,6 +534,10 @@ void RunGameLoop() {
     }
 
     if (testing::is_test_mode_enabled()) {
+      if (auto *runtime = g_test_mode.runtime()) {
+        const auto &gc = scripting::lua_gc_pacer().lastFrame();
+        runtime->perf_tracker().record_lua_gc(gc.heapKB, gc.stepMs);
+      }
       g_test_mode.on_frame_end(main_loop::mainLoop.renderFrame + 1);
       if (g_test_mode.is_complete()) {
         g_test_mode_exit_requested = true;
@@ -625,6 +655,38 @@ void RunGameLoop() {
     init::startInit();
 #endif
 
+    int jobThreads = 0;
+    if (globals::configJSON.contains("performance") &&
+        globals::configJSON["performance"].contains("job_threads")) {
+        jobThreads = globals::configJSON["performance"]["job_threads"].get<int>();
+    }
+    job_system::init(jobThreads);
+
+    if (globals::configJSON.contains("performance") &&
+        globals::configJSON["performance"].contains("particle_budget")) {
+        const int budget = globals::configJSON["performance"]["particle_budget"].get<int>();
+        auto &particleConfig = particle::GetParticleGovernor().config;
+        particleConfig.enabled = budget > 0;
+        if (budget > 0) particleConfig.budget = static_cast<uint32_t>(budget);
+    }
+
+    if (globals::configJSON.contains("performance") &&
+        globals::configJSON["performance"].contains("transform_dirty_updates")) {
+        transform::SetDirtyOnlyTransformUpdates(
+            globals::configJSON["performance"]["transform_dirty_updates"].get<bool>());
+    }
+
+    if (globals::configJSON.contains("performance") &&
+        globals::configJSON["performance"].contains("script_update_dispatch")) {
+        const auto mode = globals::configJSON["performance"]["script_update_dispatch"].get<std::string>();
+        scripting::ScriptUpdateDispatch dispatch;
+        if (scripting::parse_script_update_dispatch(mode, dispatch)) {
+            scripting::set_script_update_dispatch(dispatch);
+        } else {
+            SPDLOG_WARN("Unknown performance.script_update_dispatch '{}'", mode);
+        }
+    }
+
     input::Init(globals::getInputState(), globals::getRegistry(),
                 globals::g_ctx);
 
@@ -632,6 +694,24 @@ void RunGameLoop() {
 
     perf_overlay::init();
 
+#ifndef __EMSCRIPTEN__
+    // Hot reload of scripts, shaders and other assets while the debug UI is on.
+    if (globals::getUseImGUI() && !g_test_mode_configured) {
+      const std::filesystem::path assetsRoot = util::getRawAssetPathNoUUID("");
+      // the bytecode cache rewrites its .luac/.tmp entries as scripts load; not asset edits
+      file_watch::watcher().ignoreTree(util::getRawAssetPathNoUUID("cache/"));
+      if (file_watch::watcher().watchTree(assetsRoot)) {
+        lua_hot_reload::watch(ai_system::masterStateLua, assetsRoot);
+        shaders::watchShaderFiles();
+        localization::watchLanguageFiles(util::getRawAssetPathNoUUID("localization/"));
+      }
+    }
+#endif
+
+    if (g_test_mode_configured && g_test_mode_config.lua_profile_path) {
+      lua_profiler::sampler().start(ai_system::masterStateLua.lua_state());
+    }
+
 #ifdef __EMSCRIPTEN__
     telemetry::SetVisibilityChangeCallback([](const std::string &reason, bool visible) {
         if (!pauseGameWhenOutofFocus)
@@ -698,6 +778,8 @@ void RunGameLoop() {
                             {"session_id", telemetry::SessionId()}});
     telemetry::Flush();
 
+    job_system::shutdown();
+
     // TODO: unload all textures & sprite atlas & sounds
     // TODO: unload all layer commands as welll.
     palette_quantizer::unloadPaletteTexture(); // unload palette texture if any
@@ -710,7 +792,22 @@ void RunGameLoop() {
     }
     game::physicsWorld.reset();
 
+    if (g_test_mode_configured && g_test_mode_config.lua_profile_path) {
+      auto &luaSampler = lua_profiler::sampler();
+      luaSampler.stop();
+      auto tracePath = *g_test_mode_config.lua_profile_path;
+      tracePath.replace_extension(".trace.json");
+      luaSampler.write_folded(*g_test_mode_config.lua_profile_path);
+      luaSampler.write_chrome_trace(tracePath);
+      SPDLOG_INFO("Lua profile: {} samples -> {}", luaSampler.sample_count(),
+                  g_test_mode_config.lua_profile_path->string());
+    }
+
     // Drop Lua-owned callbacks/handles before tearing down the Lua state.
+    lua_hot_reload::unwatch();
+    shaders::unwatchShaderFiles();
+    localization::unwatchLanguageFiles();
+    file_watch::watcher().reset();
     timer::TimerSystem::clear_all_timers();
     event_system::ClearAllListeners();
     scripting::monobehavior_system::shutdown(globals::getRegistry());
@@ -799,6 +896,7 @@ void RunGameLoop() {
 
     shaders::update(dt);
     timer::TimerSystem::update_timers(dt);
+    timer::TweenSystem::update_tweens(dt);
     spring::updateAllSprings(globals::getRegistry(), dt);
     animation_system::update(dt);
     transform::ExecuteCallsForTransformMethod<void>(
@@ -10,6 +10,7 @@
 #include "../scripting/scripting_functions.hpp"
 #include "../scripting/scripting_system.hpp"
 #include "../scripting/binding_recorder.hpp"
+#include "../scripting/lua_sampler.hpp"
 
 #include "../event/event_system.hpp"
 
@@ -696,6 +697,8 @@ namespace ai_system
 
         // now reset lua master state and initialize it again
         SPDLOG_DEBUG("Resetting Lua master state and re-loading scripts from disk.");
+        scripting::task_scheduler().clear();
+        lua_profiler::sampler().stop(); // the hook belongs to the old state
         masterStateLua = sol::state{};
         init();
         // re-init all the goap components
@@ -757,6 +760,8 @@ namespace ai_system
         // Drop all event listeners before the Lua state is torn down to avoid
         // dangling sol::function handles pointing at a dead lua_State.
         event_system::ClearAllListeners();
+        scripting::task_scheduler().clear();
+        lua_profiler::sampler().stop();
 
         // Properly close the Lua state to avoid crashes on exit
         // The sol::state destructor will handle lua_close internally,
@@ -2,6 +2,11 @@
 #include "../../util/common_headers.hpp"
 
 #include "systems/scripting/binding_recorder.hpp"
+#include "core/events.hpp"
+#include "core/globals.hpp"
+
+#include <array>
+#include <optional>
 
 namespace event_system {
 
@@ -140,8 +145,131 @@ namespace event_system {
 
     // Function to expose event system to Lua
     // Note that additional event types from C++ side must be added here manually as well
+    namespace {
+        using LuaChannelRead = std::function<sol::table(sol::state_view)>;
+
+        // Hands a whole channel batch to Lua as {count = n, <column> = {...}, ...}:
+        // one array per field, filled with raw sets, instead of a table or a
+        // call per event.
+        template <typename EventT, size_t N>
+        sol::table batchToLua(sol::state_view lua,
+                              const typename event_bus::EventChannel<EventT>::Batch& batch,
+                              const std::array<const char*, N>& names,
+                              std::array<lua_Number, N> (*row)(const EventT&))
+        {
+            const int count = static_cast<int>(batch.size());
+            std::array<sol::table, N> columns;
+            for (auto& column : columns) column = lua.create_table(count, 0);
+
+            int i = 1;
+            batch.forEach([&](const EventT& ev) {
+                const auto values = row(ev);
+                for (size_t c = 0; c < N; ++c) columns[c].raw_set(i, values[c]);
+                ++i;
+            });
+
+            sol::table out = lua.create_table(0, static_cast<int>(N) + 1);
+            out.raw_set("count", count);
+            for (size_t c = 0; c < N; ++c) out.raw_set(names[c], columns[c]);
+            return out;
+        }
+
+        // Makes a new reader of EventT's channel, starting at its current end.
+        template <typename EventT, size_t N>
+        std::function<LuaChannelRead()> luaChannel(std::array<const char*, N> names,
+                                                   std::array<lua_Number, N> (*row)(const EventT&))
+        {
+            return [names, row]() -> LuaChannelRead {
+                auto reader = globals::getEventChannels().channel<EventT>().reader();
+                return [reader, names, row](sol::state_view lua) mutable {
+                    const auto batch = globals::getEventChannels().channel<EventT>().read(reader);
+                    return batchToLua<EventT, N>(lua, batch, names, row);
+                };
+            };
+        }
+
+        lua_Number entityNumber(entt::entity e) { return static_cast<lua_Number>(entt::to_integral(e)); }
+
+        // Channels Lua can read, by name.
+        const std::unordered_map<std::string, std::function<LuaChannelRead()>>& luaChannels() {
+            static const std::unordered_map<std::string, std::function<LuaChannelRead()>> channels{
+                {"collision_started", luaChannel<events::CollisionStarted, 4>(
+                    {"entity_a", "entity_b", "x", "y"},
+                    [](const events::CollisionStarted& e) {
+                        return std::array<lua_Number, 4>{entityNumber(e.entityA), entityNumber(e.entityB), e.point.x, e.point.y};
+                    })},
+                {"collision_ended", luaChannel<events::CollisionEnded, 2>(
+                    {"entity_a", "entity_b"},
+                    [](const events::CollisionEnded& e) {
+                        return std::array<lua_Number, 2>{entityNumber(e.entityA), entityNumber(e.entityB)};
+                    })},
+            };
+            return channels;
+        }
+
+        // Indexed by reader id; released slots are empty and listed in freeLuaChannelReaders.
+        std::vector<LuaChannelRead> luaChannelReaders;
+        std::vector<size_t> freeLuaChannelReaders;
+    }
+
+    void ClearLuaChannelReaders() {
+        luaChannelReaders.clear();
+        freeLuaChannelReaders.clear();
+    }
+
     void exposeEventSystemToLua(sol::state& lua) {
         auto& rec = BindingRecorder::instance();
+
+        // event_channels.reader / event_channels.read / event_channels.release
+        rec.bind_function(
+            lua,
+            {"event_channels"},
+            "reader",
+            [](const std::string& channel) -> std::optional<size_t> {
+                const auto& channels = luaChannels();
+                auto it = channels.find(channel);
+                if (it == channels.end()) {
+                    SPDLOG_WARN("event_channels.reader: unknown channel '{}'", channel);
+                    return std::nullopt;
+                }
+                if (!freeLuaChannelReaders.empty()) {
+                    const size_t id = freeLuaChannelReaders.back();
+                    freeLuaChannelReaders.pop_back();
+                    luaChannelReaders[id] = it->second();
+                    return id;
+                }
+                luaChannelReaders.push_back(it->second());
+                return luaChannelReaders.size() - 1;
+            },
+            "---@param channel 'collision_started'|'collision_ended' # The channel name.\n"
+            "---@return integer|nil # A reader id, or nil for an unknown channel.",
+            "Creates a reader of a batched event channel. It sees events pushed after it was created."
+        );
+        rec.bind_function(
+            lua,
+            {"event_channels"},
+            "read",
+            [](size_t reader, sol::this_state ts) -> sol::object {
+                if (reader >= luaChannelReaders.size() || !luaChannelReaders[reader]) return sol::lua_nil;
+                return luaChannelReaders[reader](sol::state_view(ts));
+            },
+            "---@param reader integer # From event_channels.reader().\n"
+            "---@return table|nil # {count = n, <field> = {...}} with one array per event field (entity_a, entity_b, x, y).",
+            "Returns every event the reader has not seen yet, as column arrays. Read at least once per frame; events older than the previous frame are dropped."
+        );
+        rec.bind_function(
+            lua,
+            {"event_channels"},
+            "release",
+            [](size_t reader) {
+                if (reader >= luaChannelReaders.size() || !luaChannelReaders[reader]) return;
+                luaChannelReaders[reader] = nullptr;
+                freeLuaChannelReaders.push_back(reader);
+            },
+            "---@param reader integer # From event_channels.reader().\n"
+            "---@return nil",
+            "Frees a reader that is no longer read, e.g. when its owner is destroyed. The id may be handed out again by a later event_channels.reader()."
+        );
         // subscribeToCppEvent
         rec.bind_function(
             lua,
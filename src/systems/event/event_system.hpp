@@ -76,12 +76,16 @@ namespace event_system {
     }
 
     // Clear all listeners
+    // Drops every event_channels reader; ids handed out before are void.
+    extern void ClearLuaChannelReaders();
+
     inline void ClearAllListeners() {
         emitter.clear();
         luaEventListeners.clear();  // Also clear Lua-defined event listeners
         cppEventListenersToLuaEvents.clear();  // Clear C++ listeners for Lua-defined events
         eventOccurredMap.clear();
         eventOccurredPayloadMap.clear();
+        ClearLuaChannelReaders();
     }
     
     extern void initializeEventMap(sol::state& lua);
@@ -0,0 +1,295 @@
+#include "file_watch.hpp"
+
+#include <algorithm>
+
+#include "util/common_headers.hpp"
+
+#if defined(__linux__) && !defined(__EMSCRIPTEN__)
+#define FILE_WATCH_INOTIFY 1
+#include <cerrno>
+#include <cstring>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace file_watch {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+#if FILE_WATCH_INOTIFY
+// Files are reported when a writer closes them or they are moved in (editors
+// that save to a temp file and rename); directory creation extends the watch.
+constexpr uint32_t kWatchMask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_ONLYDIR;
+#endif
+
+fs::path normalize(const fs::path &p) {
+    std::error_code ec;
+    fs::path out = fs::absolute(p, ec).lexically_normal();
+    if (ec) out = p.lexically_normal();
+    if (!out.has_filename() && out.has_parent_path()) out = out.parent_path(); // drop a trailing '/'
+    return out;
+}
+
+// Ends with a separator, so "cache/" does not claim "cache2".
+std::string dirPrefix(const fs::path &dir) {
+    std::string prefix = normalize(dir).string();
+    const char separator = static_cast<char>(fs::path::preferred_separator);
+    if (prefix.empty() || prefix.back() != separator) prefix += separator;
+    return prefix;
+}
+
+bool matches(const std::string &path, const std::string &prefix, const std::vector<std::string> &extensions) {
+    if (path.compare(0, prefix.size(), prefix) != 0) return false;
+    if (extensions.empty()) return true;
+    const std::string ext = fs::path(path).extension().string();
+    return std::find(extensions.begin(), extensions.end(), ext) != extensions.end();
+}
+
+} // namespace
+
+Watcher::Watcher(WatchConfig config) : config_(config) {
+#if FILE_WATCH_INOTIFY
+    if (!config_.forcePolling) {
+        inotifyFd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (inotifyFd_ < 0) {
+            SPDLOG_WARN("[FileWatch] inotify unavailable ({}), polling every {}s", std::strerror(errno), config_.pollSeconds);
+        }
+    }
+#endif
+}
+
+Watcher::~Watcher() {
+#if FILE_WATCH_INOTIFY
+    if (inotifyFd_ >= 0) close(inotifyFd_);
+#endif
+}
+
+bool Watcher::watchTree(const fs::path &root) {
+    std::error_code ec;
+    const fs::path dir = normalize(root);
+    if (!fs::is_directory(dir, ec)) {
+        SPDLOG_WARN("[FileWatch] Not a directory: {}", dir.string());
+        return false;
+    }
+    if (std::find(roots_.begin(), roots_.end(), dir) != roots_.end()) return true;
+    roots_.push_back(dir);
+
+    if (usingInotify()) {
+        addDirectory(dir, false, 0.0);
+        SPDLOG_INFO("[FileWatch] Watching {} ({} directories, inotify)", dir.string(), watchDirs_.size());
+        return true;
+    }
+
+    // Polling: remember the current write times so only later edits count.
+    for (auto it = fs::recursive_directory_iterator(dir, fs::directory_options::skip_permission_denied, ec);
+         !ec && it != fs::recursive_directory_iterator(); it.increment(ec)) {
+        if (it->is_directory(ec) && ignored(it->path().string())) {
+            it.disable_recursion_pending();
+        } else if (it->is_regular_file(ec)) {
+            snapshot_[it->path().string()] = it->last_write_time(ec);
+        }
+    }
+    SPDLOG_INFO("[FileWatch] Watching {} ({} files, polling)", dir.string(), snapshot_.size());
+    return true;
+}
+
+void Watcher::ignoreTree(const fs::path &dir) {
+    std::string prefix = dirPrefix(dir);
+    if (std::find(ignored_.begin(), ignored_.end(), prefix) != ignored_.end()) return;
+    ignored_.push_back(std::move(prefix));
+
+    // Drop whatever an earlier watchTree() already picked up below it.
+    for (auto it = watchDirs_.begin(); it != watchDirs_.end();) {
+        if (ignored(it->second.string())) {
+#if FILE_WATCH_INOTIFY
+            inotify_rm_watch(inotifyFd_, it->first);
+#endif
+            it = watchDirs_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    std::erase_if(snapshot_, [this](const auto &entry) { return ignored(entry.first); });
+    std::erase_if(pending_, [this](const auto &entry) { return ignored(entry.first); });
+}
+
+bool Watcher::ignored(const std::string &path) const {
+    const char separator = static_cast<char>(fs::path::preferred_separator);
+    for (const std::string &prefix : ignored_) {
+        // the directory itself, or anything below it
+        const size_t dirLength = prefix.size() - 1;
+        if (path.compare(0, dirLength, prefix, 0, dirLength) != 0) continue;
+        if (path.size() == dirLength || path[dirLength] == separator) return true;
+    }
+    return false;
+}
+
+SubscriptionId Watcher::subscribe(const fs::path &under, std::vector<std::string> extensions, Callback fn) {
+    const SubscriptionId id = nextId_++;
+    subscriptions_.push_back({id, dirPrefix(under), std::move(extensions), std::move(fn)});
+    return id;
+}
+
+void Watcher::unsubscribe(SubscriptionId id) {
+    std::erase_if(subscriptions_, [id](const Subscription &s) { return s.id == id; });
+}
+
+void Watcher::update(double now) {
+    if (roots_.empty()) return;
+    ZONE_SCOPED("file_watch::update");
+    if (usingInotify()) {
+        readEvents(now);
+    } else {
+        poll(now);
+    }
+    if (!pending_.empty()) deliver(now);
+}
+
+void Watcher::reset() {
+#if FILE_WATCH_INOTIFY
+    for (const auto &[wd, dir] : watchDirs_) inotify_rm_watch(inotifyFd_, wd);
+#endif
+    watchDirs_.clear();
+    roots_.clear();
+    subscriptions_.clear();
+    pending_.clear();
+    snapshot_.clear();
+    nextPoll_ = 0.0;
+}
+
+size_t Watcher::watchedDirectoryCount() const {
+    return watchDirs_.size();
+}
+
+void Watcher::addDirectory(const fs::path &dir, bool reportFiles, double now) {
+#if FILE_WATCH_INOTIFY
+    auto watch = [&](const fs::path &d) {
+        const int wd = inotify_add_watch(inotifyFd_, d.c_str(), kWatchMask);
+        if (wd < 0) {
+            SPDLOG_WARN("[FileWatch] Cannot watch {}: {}", d.string(), std::strerror(errno));
+            return;
+        }
+        watchDirs_[wd] = d;
+    };
+
+    if (ignored(dir.string())) return;
+    watch(dir);
+    std::error_code ec;
+    for (auto it = fs::recursive_directory_iterator(dir, fs::directory_options::skip_permission_denied, ec);
+         !ec && it != fs::recursive_directory_iterator(); it.increment(ec)) {
+        if (it->is_directory(ec)) {
+            if (ignored(it->path().string())) {
+                it.disable_recursion_pending();
+                continue;
+            }
+            watch(it->path());
+        } else if (reportFiles && it->is_regular_file(ec)) {
+            // Written before the new directory's watch existed.
+            pending_[it->path().string()] = now;
+        }
+    }
+#else
+    (void)dir;
+    (void)reportFiles;
+    (void)now;
+#endif
+}
+
+void Watcher::readEvents(double now) {
+#if FILE_WATCH_INOTIFY
+    alignas(inotify_event) char buffer[16 * 1024];
+    for (;;) {
+        const ssize_t len = read(inotifyFd_, buffer, sizeof(buffer));
+        if (len <= 0) break; // EAGAIN: nothing more queued
+
+        for (const char *p = buffer; p < buffer + len;) {
+            const auto *event = reinterpret_cast<const inotify_event *>(p);
+            p += sizeof(inotify_event) + event->len;
+
+            if (event->mask & IN_Q_OVERFLOW) {
+                SPDLOG_WARN("[FileWatch] inotify queue overflowed; some changes were missed");
+                continue;
+            }
+            if (event->mask & IN_IGNORED) { // directory removed or unmounted
+                watchDirs_.erase(event->wd);
+                continue;
+            }
+            auto dir = watchDirs_.find(event->wd);
+            if (dir == watchDirs_.end() || event->len == 0) continue;
+
+            fs::path path = dir->second / event->name;
+            if (event->mask & IN_ISDIR) {
+                if (event->mask & (IN_CREATE | IN_MOVED_TO)) addDirectory(path, true, now);
+            } else if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) {
+                pending_[path.string()] = now;
+            }
+        }
+    }
+#else
+    (void)now;
+#endif
+}
+
+void Watcher::poll(double now) {
+    if (now < nextPoll_) return;
+    nextPoll_ = now + config_.pollSeconds;
+
+    std::unordered_map<std::string, fs::file_time_type> current;
+    current.reserve(snapshot_.size());
+    std::error_code ec;
+    for (const fs::path &root : roots_) {
+        for (auto it = fs::recursive_directory_iterator(root, fs::directory_options::skip_permission_denied, ec);
+             !ec && it != fs::recursive_directory_iterator(); it.increment(ec)) {
+            if (it->is_directory(ec) && ignored(it->path().string())) {
+                it.disable_recursion_pending();
+                continue;
+            }
+            if (!it->is_regular_file(ec)) continue;
+            const auto time = it->last_write_time(ec);
+            std::string path = it->path().string();
+            auto old = snapshot_.find(path);
+            if (old == snapshot_.end() || old->second != time) pending_[path] = now;
+            current.emplace(std::move(path), time);
+        }
+        ec.clear();
+    }
+    snapshot_ = std::move(current);
+}
+
+void Watcher::deliver(double now) {
+    std::vector<std::string> settled;
+    for (auto it = pending_.begin(); it != pending_.end();) {
+        if (now - it->second >= config_.settleSeconds) {
+            settled.push_back(it->first);
+            it = pending_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    if (settled.empty()) return;
+    std::sort(settled.begin(), settled.end());
+
+    // Callbacks may subscribe or unsubscribe.
+    const std::vector<Subscription> subscriptions = subscriptions_;
+    for (const Subscription &sub : subscriptions) {
+        Paths batch;
+        for (const std::string &path : settled) {
+            if (matches(path, sub.prefix, sub.extensions)) batch.emplace_back(path);
+        }
+        if (batch.empty()) continue;
+        try {
+            sub.fn(batch);
+        } catch (const std::exception &e) {
+            SPDLOG_ERROR("[FileWatch] Subscriber failed: {}", e.what());
+        }
+    }
+}
+
+Watcher &watcher() {
+    static Watcher instance;
+    return instance;
+}
+
+} // namespace file_watch
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * File watch service
+ *
+ * Watches asset directory trees and hands batches of changed files to
+ * subscribers (Lua hot reload, shaders, localization, Lua-side asset
+ * listeners).
+ *
+ * On Linux it is driven by inotify: every directory in the tree gets a watch
+ * (directories created later are picked up), so an idle tree costs one
+ * non-blocking read() per update and no stat calls. Elsewhere, or when
+ * inotify is unavailable, it falls back to scanning the trees' write times
+ * every `pollSeconds`.
+ *
+ * A file is reported once it has been quiet for `settleSeconds`, so editors
+ * that save in several steps produce one entry, and every path settled by an
+ * update is delivered in one batch. Paths are absolute and lexically normal.
+ *
+ * Directories the game writes to itself (caches) can be left out with
+ * ignoreTree(), so their churn is neither watched nor delivered.
+ *
+ * Usage:
+ *   auto &w = file_watch::watcher();
+ *   w.ignoreTree("assets/cache");
+ *   w.watchTree("assets");
+ *   w.subscribe("assets/shaders", {".fs", ".vs"}, [](const file_watch::Paths &changed) { ... });
+ *   w.update(GetTime()); // once per frame, main thread; callbacks run here
+ */
+namespace file_watch {
+
+using Paths = std::vector<std::filesystem::path>;
+using Callback = std::function<void(const Paths &changed)>;
+using SubscriptionId = uint32_t;
+
+struct WatchConfig {
+    double settleSeconds = 0.02; // quiet time before a changed file is delivered
+    double pollSeconds = 1.0;    // scan interval of the polling fallback
+    bool forcePolling = false;   // skip inotify (network filesystems, tests)
+};
+
+class Watcher {
+public:
+    explicit Watcher(WatchConfig config = {});
+    ~Watcher();
+    Watcher(const Watcher &) = delete;
+    Watcher &operator=(const Watcher &) = delete;
+
+    // Watches root and everything below it. False if root is not a directory.
+    bool watchTree(const std::filesystem::path &root);
+    // Leaves dir and everything below it out of every watched tree, before or
+    // after the tree is watched. dir need not exist yet.
+    void ignoreTree(const std::filesystem::path &dir);
+
+    // fn receives the changed files under `under` whose extension is listed
+    // (any extension if empty), or is not called if there are none.
+    SubscriptionId subscribe(const std::filesystem::path &under, std::vector<std::string> extensions, Callback fn);
+    void unsubscribe(SubscriptionId id);
+
+    // Collects new changes and delivers the ones that have settled.
+    void update(double now);
+
+    // Stops watching and drops subscriptions and pending changes.
+    void reset();
+
+    bool usingInotify() const { return inotifyFd_ >= 0; }
+    size_t watchedDirectoryCount() const;
+    size_t pendingCount() const { return pending_.size(); }
+
+private:
+    struct Subscription {
+        SubscriptionId id = 0;
+        std::string prefix; // generic form, ends with '/'
+        std::vector<std::string> extensions;
+        Callback fn;
+    };
+
+    bool ignored(const std::string &path) const;
+    void addDirectory(const std::filesystem::path &dir, bool reportFiles, double now);
+    void readEvents(double now);
+    void poll(double now);
+    void deliver(double now);
+
+    WatchConfig config_;
+    std::vector<std::filesystem::path> roots_;
+    std::vector<std::string> ignored_; // generic form, ends with '/'
+    std::vector<Subscription> subscriptions_;
+    SubscriptionId nextId_ = 1;
+
+    std::unordered_map<std::string, double> pending_; // path -> time of its last event
+
+    int inotifyFd_ = -1;
+    std::unordered_map<int, std::filesystem::path> watchDirs_; // inotify watch descriptor -> directory
+
+    std::unordered_map<std::string, std::filesystem::file_time_type> snapshot_; // polling fallback
+    double nextPoll_ = 0.0;
+};
+
+// The watcher for the asset trees.
+Watcher &watcher();
+
+} // namespace file_watch
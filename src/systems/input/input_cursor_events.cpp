@@ -302,6 +302,7 @@ void handle_hover_event(InputState &inputState, entt::registry &registry) {
     if (registry.valid(newHover)) {
         auto &node = registry.get<transform::GameObject>(newHover);
         node.state.isBeingHovered = true;
+        transform::MarkTransformDirty(newHover); // hover scale
         if (node.methods.onHover) node.methods.onHover(registry, newHover);
     }
 
@@ -418,6 +419,7 @@ void handle_down_event(entt::registry &registry, input::InputState &inputState)
         {
             SPDLOG_DEBUG("Start dragging");
             cursorDownTargetNode.state.isBeingDragged = true;
+            transform::MarkTransformDirty(inputState.cursor_down_target); // drag scale
             transform::SetClickOffset(&registry, inputState.cursor_down_target, inputState.cursor_down_position.value(), true);
             inputState.cursor_dragging_target = inputState.cursor_down_target;
 
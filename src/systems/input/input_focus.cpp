@@ -472,6 +472,7 @@ bool CaptureFocusedInput(entt::registry &registry, InputState &state, const std:
         // eg. realignCards();
         input::UpdateCursor(state, registry); // Update cursor
         focusedNode.state.isBeingDragged = true;
+        transform::MarkTransformDirty(focused); // drag scale
         ret = true;
     }
 
@@ -764,6 +764,7 @@ namespace input
             // eg. realignCards();
             UpdateCursor(state, registry); // Update cursor
             focusedNode.state.isBeingDragged = true;
+            transform::MarkTransformDirty(focused); // drag scale
             ret = true;
         }
 
@@ -0,0 +1,99 @@
+#include "job_system.hpp"
+
+#include "util/common_headers.hpp"
+
+#ifndef __EMSCRIPTEN__
+#include <taskflow.hpp>
+#include <thread>
+#endif
+
+namespace job_system {
+
+#ifndef __EMSCRIPTEN__
+static std::unique_ptr<tf::Executor> s_executor;
+#endif
+
+void init(int configuredThreads) {
+#ifndef __EMSCRIPTEN__
+    if (s_executor) return;
+
+    if (configuredThreads < 0) {
+        SPDLOG_INFO("[JobSystem] Running frame jobs serially");
+        return;
+    }
+
+    unsigned int hwConcurrency = std::thread::hardware_concurrency();
+    if (hwConcurrency == 0) hwConcurrency = 4;
+
+    int numThreads = configuredThreads;
+    if (numThreads == 0) {
+        numThreads = static_cast<int>(hwConcurrency) - 1;
+    } else {
+        numThreads = std::min(numThreads, static_cast<int>(hwConcurrency) - 1);
+    }
+    if (numThreads < 1) {
+        SPDLOG_INFO("[JobSystem] Single core detected, running frame jobs serially");
+        return;
+    }
+
+    try {
+        s_executor = std::make_unique<tf::Executor>(static_cast<size_t>(numThreads));
+        SPDLOG_INFO("[JobSystem] Initialized executor with {} threads", numThreads);
+    } catch (const std::exception &e) {
+        SPDLOG_ERROR("[JobSystem] Failed to create executor: {}. Running serially.", e.what());
+        s_executor.reset();
+    }
+#else
+    (void)configuredThreads;
+#endif
+}
+
+void shutdown() {
+#ifndef __EMSCRIPTEN__
+    if (s_executor) {
+        s_executor->wait_for_all();
+    }
+    s_executor.reset();
+#endif
+}
+
+bool isParallel() {
+#ifndef __EMSCRIPTEN__
+    return s_executor != nullptr;
+#else
+    return false;
+#endif
+}
+
+size_t workerCount() {
+#ifndef __EMSCRIPTEN__
+    return s_executor ? s_executor->num_workers() : 0;
+#else
+    return 0;
+#endif
+}
+
+void parallelFor(size_t count, size_t grain,
+                 const std::function<void(size_t begin, size_t end)> &fn) {
+    if (count == 0) return;
+    if (grain == 0) grain = count;
+
+#ifndef __EMSCRIPTEN__
+    if (s_executor && count > grain) {
+        ZONE_SCOPED("JobSystem::parallelFor");
+        tf::Taskflow taskflow;
+        for (size_t begin = 0; begin < count; begin += grain) {
+            const size_t end = std::min(begin + grain, count);
+            taskflow.emplace([&fn, begin, end]() { fn(begin, end); });
+        }
+        s_executor->run(taskflow).wait();
+        return;
+    }
+#endif
+
+    for (size_t begin = 0; begin < count; begin += grain) {
+        fn(begin, std::min(begin + grain, count));
+    }
+}
+
+} // namespace job_system
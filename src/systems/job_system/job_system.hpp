@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+/**
+ * Frame job system
+ *
+ * A small Taskflow executor shared by per-frame systems (particles, transforms)
+ * for data-parallel loops. Work is split into fixed-size chunks, so the
+ * partition never depends on the thread count or on scheduling; callers that
+ * write only to their own chunk get identical results serially or in parallel.
+ *
+ * Jobs must not touch Lua, the registry's component pools (adding/removing),
+ * or the layer command queues. Do that on the main thread after parallelFor.
+ *
+ * Usage:
+ *   job_system::init(threads);   // 0 = hardware_concurrency - 1, <0 = serial
+ *   job_system::parallelFor(count, 1024, [&](size_t begin, size_t end) { ... });
+ *   job_system::shutdown();
+ */
+namespace job_system {
+
+void init(int configuredThreads);
+void shutdown();
+
+// True when an executor with at least one worker is running.
+bool isParallel();
+size_t workerCount();
+
+// Calls fn(begin, end) for each chunk of [0, count), `grain` items per chunk
+// (the last chunk may be shorter), and blocks until all chunks are done.
+// Runs inline on the calling thread when there is a single chunk or no
+// executor (Emscripten, serial mode, not initialised).
+void parallelFor(size_t count, size_t grain,
+                 const std::function<void(size_t begin, size_t end)> &fn);
+
+} // namespace job_system
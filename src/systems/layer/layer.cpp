@@ -2871,7 +2871,7 @@ auto pushEntityTransformsToMatrixImmediate(entt::registry &registry,
   auto &t = registry.get<transform::Transform>(e);
 
   PushMatrix();
-  rlMultMatrixf(MatrixToFloat(t.cachedMatrix));
+  rlMultMatrixf(MatrixToFloat(transform::ToMatrix(t.cachedMatrix)));
 }
 
 void Circle(float x, float y, float radius, const Color &color) {
@@ -135,6 +135,7 @@ namespace layer
                     DELETE_COMMAND(layer, DrawGradientRectCentered, CmdDrawGradientRectCentered)
                     DELETE_COMMAND(layer, DrawGradientRectRoundedCentered, CmdDrawGradientRectRoundedCentered)
                     DELETE_COMMAND(layer, DrawBatchedEntities, CmdDrawBatchedEntities)
+                    DELETE_COMMAND(layer, DrawParticleBatch, CmdDrawParticleBatch)
                     default:
                         SPDLOG_ERROR("Unknown command type: {}", magic_enum::enum_name(cmd.type));
                         break;
@@ -328,6 +328,10 @@ template <>
 inline DrawCommandType GetDrawCommandType<CmdDrawRenderGroup>() {
   return DrawCommandType::DrawRenderGroup;
 }
+template <>
+inline DrawCommandType GetDrawCommandType<CmdDrawParticleBatch>() {
+  return DrawCommandType::DrawParticleBatch;
+}
 
 template <typename T> struct PoolBlockSize {
   static constexpr ::detail::index_t value = 128;
@@ -691,7 +695,7 @@ inline void LogAllPoolStats(const std::shared_ptr<Layer> &layer) {
       CmdDrawTriangleEquilateral, CmdDrawCenteredFilledRoundedRect,
       CmdDrawSteppedRoundedRect, CmdDrawSpriteCentered, CmdDrawSpriteTopLeft, 
       CmdDrawDashedCircle, CmdDrawDashedRoundedRect, CmdDrawDashedLine, 
-      CmdDrawBatchedEntities
+      CmdDrawBatchedEntities, CmdDrawParticleBatch
 
       >;
 
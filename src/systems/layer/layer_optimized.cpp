@@ -17,6 +17,7 @@
 #include "layer.hpp"
 #include "core/globals.hpp"
 #include "raylib.h"
+#include <algorithm>
 #include "systems/ui/element.hpp"
 
 #include "systems/ui/ui_data.hpp"
@@ -525,6 +526,40 @@ namespace layer
         batch.execute();
     }
 
+    // Sends the vertices as RL_TRIANGLES runs that each fit in the current
+    // rlgl batch, so a big emitter never splits a triangle across a flush.
+    static void EmitParticleBatchVertices(const std::vector<ParticleBatchVertex>& vertices) {
+        constexpr size_t kRun = 3 * 1024;
+        rlSetTexture(0);
+        for (size_t start = 0; start < vertices.size(); start += kRun) {
+            const size_t end = std::min(vertices.size(), start + kRun);
+            rlCheckRenderBatchLimit(static_cast<int>(end - start));
+            rlBegin(RL_TRIANGLES);
+            for (size_t i = start; i < end; ++i) {
+                const ParticleBatchVertex& v = vertices[i];
+                rlColor4ub(v.color.r, v.color.g, v.color.b, v.color.a);
+                rlVertex2f(v.x, v.y);
+            }
+            rlEnd();
+        }
+    }
+
+    void ExecuteDrawParticleBatch(Layer* layer, CmdDrawParticleBatch* c) {
+        if (c->instances.empty()) return;
+
+        static std::vector<ParticleBatchVertex> vertices; // render thread only, reused
+        vertices.clear();
+        if (c->drawShadow) {
+            AppendParticleBatchVertices(c->instances, c->shadowOffset.x, c->shadowOffset.y, &c->shadowColor, vertices);
+        }
+        AppendParticleBatchVertices(c->instances, 0.0f, 0.0f, nullptr, vertices);
+
+        const bool customBlend = c->blendMode != BLEND_ALPHA;
+        if (customBlend) SetBlendMode(c->blendMode);
+        EmitParticleBatchVertices(vertices);
+        if (customBlend) UnsetBlendMode();
+    }
+
     void ExecuteDrawRenderGroup(Layer* layer, CmdDrawRenderGroup* c) {
         auto* group = render_groups::getGroup(c->groupName);
         if (!group) {
@@ -691,6 +726,7 @@ namespace layer
         RegisterRenderer<CmdDrawDashedLine>(DrawCommandType::DrawDashedLine, ExecuteDrawDashedLine);
         RegisterRenderer<CmdDrawBatchedEntities>(DrawCommandType::DrawBatchedEntities, ExecuteDrawBatchedEntities);
         RegisterRenderer<CmdDrawRenderGroup>(DrawCommandType::DrawRenderGroup, ExecuteDrawRenderGroup);
+        RegisterRenderer<CmdDrawParticleBatch>(DrawCommandType::DrawParticleBatch, ExecuteDrawParticleBatch);
 
     }
 }
@@ -13,6 +13,7 @@
 
 #include "third_party/objectpool-master/src/object_pool.hpp"
 #include "systems/layer/layer_command_buffer_data.hpp"
+#include "systems/layer/particle_batch_geometry.hpp"
 #include "third_party/spine_impl/spine_raylib.hpp"
 
 namespace layer
@@ -154,6 +155,7 @@ namespace layer
         DrawGradientRectRoundedCentered,
         DrawBatchedEntities,
         DrawRenderGroup,
+        DrawParticleBatch,
 
         Count // <--- always last
     };
@@ -645,6 +647,16 @@ namespace layer
         bool autoOptimize = true;
     };
 
+    // Draws many particles as a single sorted command (one per emitter), so
+    // they end up in one rlgl batch instead of N commands with matrix pushes.
+    struct CmdDrawParticleBatch {
+        std::vector<ParticleBatchInstance> instances;
+        int blendMode = BLEND_ALPHA;
+        bool drawShadow = false;        // shadow pass before the colour pass
+        Vector2 shadowOffset = {0, 0};
+        Color shadowColor = {0, 0, 0, 128};
+    };
+
 
 
 
@@ -748,6 +760,7 @@ namespace layer
     extern void ExecuteDrawGradientRectRoundedCentered(Layer* layer, CmdDrawGradientRectRoundedCentered* c);
     extern void ExecuteDrawBatchedEntities(Layer* layer, CmdDrawBatchedEntities* c);
     extern void ExecuteDrawRenderGroup(Layer* layer, CmdDrawRenderGroup* c);
+    extern void ExecuteDrawParticleBatch(Layer* layer, CmdDrawParticleBatch* c);
 
 
     // ===========================
@@ -802,6 +815,7 @@ namespace layer
             case DrawCommandType::DrawDashedRoundedRect:
             case DrawCommandType::DrawGradientRectCentered:
             case DrawCommandType::DrawGradientRectRoundedCentered:
+            case DrawCommandType::DrawParticleBatch:
             case DrawCommandType::RenderNPatchRect:
             case DrawCommandType::RenderRectVerticesFilledLayer:
             case DrawCommandType::RenderRectVerticlesOutlineLayer:
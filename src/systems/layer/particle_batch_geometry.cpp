@@ -0,0 +1,107 @@
+#include "particle_batch_geometry.hpp"
+
+#include <cmath>
+#include <utility>
+
+namespace layer
+{
+    namespace
+    {
+        struct Emitter {
+            std::vector<ParticleBatchVertex>& out;
+            Color color;
+
+            // y points down, so DrawRectanglePro's top-left, bottom-left,
+            // top-right has a negative cross product; flip anything else.
+            void triangle(Vector2 a, Vector2 b, Vector2 c) {
+                const float cross = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+                if (cross > 0.0f) std::swap(b, c);
+                out.push_back({a.x, a.y, color});
+                out.push_back({b.x, b.y, color});
+                out.push_back({c.x, c.y, color});
+            }
+
+            // Corners in order around the quad.
+            void quad(Vector2 a, Vector2 b, Vector2 c, Vector2 d) {
+                triangle(a, b, c);
+                triangle(a, c, d);
+            }
+
+            void rect(float x, float y, float w, float h) {
+                quad({x, y}, {x, y + h}, {x + w, y + h}, {x + w, y});
+            }
+        };
+
+        Vector2 rotated(float cx, float cy, float lx, float ly, float c, float s) {
+            return {cx + lx * c - ly * s, cy + lx * s + ly * c};
+        }
+    } // namespace
+
+    void AppendParticleBatchVertices(const std::vector<ParticleBatchInstance>& instances,
+                                     float dx, float dy, const Color* overrideColor,
+                                     std::vector<ParticleBatchVertex>& out)
+    {
+        for (const auto& p : instances) {
+            Emitter e{out, overrideColor ? *overrideColor : p.color};
+            const float x = p.x + dx;
+            const float y = p.y + dy;
+            const float c = cosf(p.rotation * DEG2RAD);
+            const float s = sinf(p.rotation * DEG2RAD);
+
+            switch (p.shape) {
+                case ParticleBatchShape::Rectangle: {
+                    const float hw = p.w * 0.5f, hh = p.h * 0.5f;
+                    e.quad(rotated(x, y, -hw, -hh, c, s), rotated(x, y, -hw, hh, c, s),
+                           rotated(x, y, hw, hh, c, s), rotated(x, y, hw, -hh, c, s));
+                    break;
+                }
+                case ParticleBatchShape::RectangleLines: {
+                    // DrawRectangleLinesEx with a 1px line: four strips inside the bounds
+                    constexpr float t = 1.0f;
+                    const float left = x - p.w * 0.5f, top = y - p.h * 0.5f;
+                    e.rect(left, top, p.w, t);
+                    e.rect(left, top + p.h - t, p.w, t);
+                    e.rect(left, top + t, t, p.h - 2.0f * t);
+                    e.rect(left + p.w - t, top + t, t, p.h - 2.0f * t);
+                    break;
+                }
+                case ParticleBatchShape::Circle: {
+                    constexpr float kStep = 2.0f * PI / kParticleCircleSegments;
+                    for (int i = 0; i < kParticleCircleSegments; ++i) {
+                        e.triangle({x, y},
+                                   {x + cosf(i * kStep) * p.w, y + sinf(i * kStep) * p.w},
+                                   {x + cosf((i + 1) * kStep) * p.w, y + sinf((i + 1) * kStep) * p.w});
+                    }
+                    break;
+                }
+                case ParticleBatchShape::CircleLines: {
+                    constexpr float kStep = 2.0f * PI / kParticleRingSegments;
+                    const float inner = p.w - 3.0f;
+                    for (int i = 0; i < kParticleRingSegments; ++i) {
+                        const float c0 = cosf(i * kStep), s0 = sinf(i * kStep);
+                        const float c1 = cosf((i + 1) * kStep), s1 = sinf((i + 1) * kStep);
+                        e.quad({x + c0 * inner, y + s0 * inner}, {x + c0 * p.w, y + s0 * p.w},
+                               {x + c1 * p.w, y + s1 * p.w}, {x + c1 * inner, y + s1 * inner});
+                    }
+                    break;
+                }
+                case ParticleBatchShape::Line: {
+                    const float hl = p.w * 0.5f, ht = p.h * 0.5f;
+                    e.quad(rotated(x, y, -hl, -ht, c, s), rotated(x, y, -hl, ht, c, s),
+                           rotated(x, y, hl, ht, c, s), rotated(x, y, hl, -ht, c, s));
+                    break;
+                }
+                case ParticleBatchShape::Ellipse: {
+                    constexpr float kStep = 2.0f * PI / kParticleEllipseSegments;
+                    const float rx = p.w * 0.5f, ry = p.h * 0.5f;
+                    for (int i = 0; i < kParticleEllipseSegments; ++i) {
+                        e.triangle({x, y},
+                                   rotated(x, y, cosf(i * kStep) * rx, sinf(i * kStep) * ry, c, s),
+                                   rotated(x, y, cosf((i + 1) * kStep) * rx, sinf((i + 1) * kStep) * ry, c, s));
+                    }
+                    break;
+                }
+            }
+        }
+    }
+}
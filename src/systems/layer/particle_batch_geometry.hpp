@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "raylib.h"
+
+namespace layer
+{
+    enum class ParticleBatchShape : uint8_t {
+        Rectangle,      // rotated, filled
+        RectangleLines, // axis-aligned outline
+        Circle,         // radius = w
+        CircleLines,    // radius = w, 3px ring
+        Line,           // length = w, thickness = h, direction = rotation
+        Ellipse,        // radii = w/2, h/2, rotated
+    };
+
+    // One packed particle. (x, y) is the centre in layer coordinates and the
+    // size is final (already scaled); rotation is in degrees.
+    struct ParticleBatchInstance {
+        float x, y;
+        float w, h;
+        float rotation;
+        Color color;
+        ParticleBatchShape shape;
+    };
+
+    struct ParticleBatchVertex {
+        float x, y;
+        Color color;
+    };
+
+    // Segment counts of the raylib calls the shapes replace.
+    inline constexpr int kParticleCircleSegments = 36;
+    inline constexpr int kParticleRingSegments = 32;
+    inline constexpr int kParticleEllipseSegments = 24;
+
+    // Appends the triangles (three vertices each) of every instance, offset
+    // by (dx, dy) and drawn in overrideColor if given. Geometry matches the
+    // raylib shape calls the per-particle commands used, and every triangle
+    // has the winding of DrawRectanglePro, so the whole batch can go to rlgl
+    // as one RL_TRIANGLES run.
+    void AppendParticleBatchVertices(const std::vector<ParticleBatchInstance>& instances,
+                                     float dx, float dy, const Color* overrideColor,
+                                     std::vector<ParticleBatchVertex>& out);
+}
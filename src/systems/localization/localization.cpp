@@ -3,6 +3,7 @@
 #include "core/globals.hpp"
 #include "util/utilities.hpp"
 
+#include "systems/file_watch/file_watch.hpp"
 #include "systems/scripting/binding_recorder.hpp"
 
 #include <fmt/args.h>
@@ -347,6 +348,38 @@ void setFallbackLanguage(const std::string &langCode) {
   fallbackLang = langCode;
 }
 
+namespace {
+file_watch::SubscriptionId languageWatch = 0;
+}
+
+void watchLanguageFiles(const std::string &path) {
+  if (languageWatch != 0)
+    return;
+  languageWatch = file_watch::watcher().subscribe(
+      path, {".json"}, [path](const file_watch::Paths &changed) {
+        const std::string active = currentLang;
+        bool reloaded = false;
+        for (const auto &file : changed) {
+          const std::string langCode = file.stem().string();
+          if (!languageData.count(langCode))
+            continue; // font data and other JSON next to the languages
+          loadLanguage(langCode, path);
+          SPDLOG_INFO("Reloaded language '{}' from {}", langCode, file.string());
+          reloaded = true;
+        }
+        // loadLanguage switches to the language it loaded
+        if (reloaded)
+          setCurrentLanguage(active);
+      });
+}
+
+void unwatchLanguageFiles() {
+  if (languageWatch == 0)
+    return;
+  file_watch::watcher().unsubscribe(languageWatch);
+  languageWatch = 0;
+}
+
 std::string get(const std::string &key) {
   auto it = languageData.find(currentLang);
   if (it != languageData.end()) {
@@ -90,6 +90,11 @@ namespace localization
   extern void loadLanguage(const std::string &langCode, const std::string &path);
   extern void setFallbackLanguage(const std::string &langCode);
 
+  // Reloads a loaded language when its <code>.json under `path` changes on
+  // disk, then re-announces the current language so listeners re-text.
+  extern void watchLanguageFiles(const std::string &path);
+  extern void unwatchLanguageFiles();
+
   extern std::string get(const std::string &key);
 
   // 1) A thin non-templated “raw” lookup that uses your flattened maps:
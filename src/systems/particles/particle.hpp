@@ -7,6 +7,7 @@
 #include "util/utilities.hpp"
 
 #include "systems/ai/ai_system.hpp"
+#include "systems/camera/camera_manager.hpp"
 #include "systems/collision/broad_phase.hpp"
 #include "systems/entity_gamestate_management/entity_gamestate_management.hpp"
 #include "systems/factory/factory.hpp"
@@ -14,6 +15,10 @@
 #include "systems/main_loop_enhancement/main_loop.hpp"
 #include "systems/transform/transform.hpp"
 #include "systems/transform/transform_functions.hpp"
+#include "systems/particles/particle_governor.hpp"
+#include "systems/particles/particle_pool.hpp"
+#include "systems/job_system/job_system.hpp"
+#include "systems/lockstep/lockstep_config.hpp"
 
 #include "systems/scripting/binding_recorder.hpp"
 
@@ -21,6 +26,7 @@
 #include "core/init.hpp"
 #include "systems/shaders/shader_system.hpp"
 
+#include <cstring>
 #include <limits>
 #include <optional>
 
@@ -111,6 +117,9 @@ struct ParticleEmitter {
   // New: defaults for particles spawned by this emitter
   std::optional<int> defaultZ;             // if set, each particle gets this z
   std::optional<RenderSpace> defaultSpace; // if set, overrides useGlobalCoords
+
+  // how long this emitter keeps emitting as the particle budget fills
+  EmitterPriority priority = EmitterPriority::Normal;
 };
 
 struct ParticleAnimationConfig {
@@ -121,6 +130,100 @@ struct ParticleAnimationConfig {
   std::optional<Color> bg;
 };
 
+// Lives on every emitter entity. Particles spawned through the emitter are
+// stored here instead of being created as entities; they die with the emitter.
+struct ParticleEmitterPool {
+  ParticlePool particles;
+  // onUpdateCallbacks indexed by ParticlePool::callbackSlot
+  std::vector<std::function<void(Particle &, float)>> callbacks;
+  std::vector<uint32_t> freeCallbackSlots;
+  // fractional particles owed by the governor between EmitParticles() calls
+  float emissionCarry = 0.0f;
+};
+
+// ============================================================================
+// STENCIL-MASKED PARTICLES
+// Allows particles to be rendered only within the bounds of a source entity's
+// sprite, using stencil buffer masking. Works with shader pipeline.
+// ============================================================================
+
+/// Marker component: indicates this entity provides a stencil mask for particles
+struct StencilMaskSource {
+  float paddingPx = 0.0f;  // Optional: expand/contract mask rect
+};
+
+/// Marker component: indicates this particle (or, on an emitter, all of its
+/// pooled particles) should be masked by a source entity
+struct StencilMaskedParticle {
+  entt::entity sourceEntity = entt::null;  // Entity whose bounds define stencil mask
+  float zBias = 0.0f;  // Relative z ordering within local commands
+};
+
+inline uint32_t PackColor(Color c) {
+  uint32_t packed;
+  std::memcpy(&packed, &c, sizeof(packed));
+  return packed;
+}
+
+inline Color UnpackColor(uint32_t packed) {
+  Color c;
+  std::memcpy(&c, &packed, sizeof(c));
+  return c;
+}
+
+// Snapshot of pooled particle i as a Particle, for callbacks and Lua.
+inline Particle ReadPooledParticle(const ParticlePool &pool, size_t i) {
+  Particle p{};
+  p.renderType = static_cast<ParticleRenderType>(pool.renderType[i]);
+  p.velocity = Vector2{pool.velX[i], pool.velY[i]};
+  p.rotation = pool.rotation[i];
+  p.rotationSpeed = pool.rotationSpeed[i];
+  p.scale = pool.scale[i];
+  if (pool.lifespan[i] != kParticleLivesForever)
+    p.lifespan = pool.lifespan[i];
+  p.age = pool.age[i];
+  p.color = UnpackColor(pool.color[i]);
+  p.gravity = pool.gravity[i];
+  p.acceleration = pool.acceleration[i];
+  if (pool.flags[i] & kParticleFlagColorLerp) {
+    p.startColor = UnpackColor(pool.startColor[i]);
+    p.endColor = UnpackColor(pool.endColor[i]);
+  }
+  p.autoAspect = (pool.flags[i] & kParticleFlagAutoAspect) != 0;
+  p.faceVelocity = (pool.flags[i] & kParticleFlagFaceVelocity) != 0;
+  p.z = pool.z[i];
+  p.space = (pool.flags[i] & kParticleFlagScreenSpace) ? RenderSpace::Screen
+                                                        : RenderSpace::World;
+  return p;
+}
+
+// Copies back whatever a callback changed on the snapshot.
+inline void WritePooledParticle(ParticlePool &pool, size_t i,
+                                const Particle &p) {
+  if (p.velocity) {
+    pool.velX[i] = p.velocity->x;
+    pool.velY[i] = p.velocity->y;
+  }
+  pool.rotation[i] = p.rotation.value_or(pool.rotation[i]);
+  pool.rotationSpeed[i] = p.rotationSpeed.value_or(pool.rotationSpeed[i]);
+  pool.scale[i] = p.scale.value_or(pool.scale[i]);
+  pool.lifespan[i] = p.lifespan.value_or(kParticleLivesForever);
+  pool.age[i] = p.age.value_or(pool.age[i]);
+  pool.gravity[i] = p.gravity.value_or(0.0f);
+  pool.acceleration[i] = p.acceleration.value_or(0.0f);
+  if (p.color)
+    pool.color[i] = PackColor(*p.color);
+  if (p.startColor && p.endColor) {
+    pool.startColor[i] = PackColor(*p.startColor);
+    pool.endColor[i] = PackColor(*p.endColor);
+    pool.flags[i] |= kParticleFlagColorLerp;
+  } else {
+    pool.flags[i] &= ~kParticleFlagColorLerp;
+  }
+  pool.renderType[i] = static_cast<uint8_t>(p.renderType);
+  pool.z[i] = p.z.value_or(pool.z[i]);
+}
+
 inline entt::entity CreateParticle(
     entt::registry &registry, Vector2 location, Vector2 size,
     Particle particleData,
@@ -204,6 +307,64 @@ inline entt::entity CreateParticle(
   return particle;
 }
 
+// Spawns a particle into the emitter's SoA pool instead of creating an
+// entity. Defaults are resolved exactly like CreateParticle().
+inline void SpawnPooledParticle(entt::registry &registry,
+                                entt::entity emitterEntity, Vector2 location,
+                                Vector2 size, const Particle &particleData) {
+  if (!GetParticleGovernor().trySpawn())
+    return;
+  auto &emitterPool = registry.get_or_emplace<ParticleEmitterPool>(emitterEntity);
+
+  ParticleSpawn s{};
+  s.x = location.x;
+  s.y = location.y;
+  s.w = size.x;
+  s.h = size.y;
+  const Vector2 velocity = particleData.velocity.value_or(
+      Vector2(Random::get<float>(-defaultSpeed, defaultSpeed),
+              Random::get<float>(-defaultSpeed, defaultSpeed)));
+  s.vx = velocity.x;
+  s.vy = velocity.y;
+  s.rotation = particleData.rotation.value_or(defaultRotation);
+  s.rotationSpeed = particleData.rotationSpeed.value_or(defaultRotationSpeed);
+  s.scale = particleData.scale.value_or(defaultScale);
+  s.lifespan = particleData.lifespan.value_or(defaultLifespan);
+  if (s.lifespan <= 0.0f) {
+    s.lifespan = kParticleLivesForever;
+  }
+  s.age = particleData.age.value_or(0.0f);
+  s.gravity = particleData.gravity.value_or(0.0f);
+  s.acceleration = particleData.acceleration.value_or(0.0f);
+  s.color = PackColor(particleData.color.value_or(WHITE));
+  if (particleData.startColor && particleData.endColor) {
+    s.startColor = PackColor(*particleData.startColor);
+    s.endColor = PackColor(*particleData.endColor);
+    s.flags |= kParticleFlagColorLerp;
+  }
+  if (particleData.autoAspect.value_or(false))
+    s.flags |= kParticleFlagAutoAspect;
+  if (particleData.faceVelocity.value_or(true))
+    s.flags |= kParticleFlagFaceVelocity;
+  if (particleData.space.value_or(RenderSpace::World) == RenderSpace::Screen)
+    s.flags |= kParticleFlagScreenSpace;
+  s.z = particleData.z.value_or(0);
+  s.renderType = static_cast<uint8_t>(particleData.renderType);
+
+  if (particleData.onUpdateCallback) {
+    if (!emitterPool.freeCallbackSlots.empty()) {
+      s.callbackSlot = emitterPool.freeCallbackSlots.back();
+      emitterPool.freeCallbackSlots.pop_back();
+      emitterPool.callbacks[s.callbackSlot] = particleData.onUpdateCallback;
+    } else {
+      s.callbackSlot = static_cast<uint32_t>(emitterPool.callbacks.size());
+      emitterPool.callbacks.push_back(particleData.onUpdateCallback);
+    }
+  }
+
+  emitterPool.particles.push(s);
+}
+
 inline void EmitParticleHelper(entt::entity emitterEntity,
                                entt::registry &registry);
 
@@ -215,23 +376,41 @@ inline void EmitParticles(entt::registry &registry, entt::entity emitterEntity,
       1.0f + (emitter.randomness * ((GetRandomValue(-100, 100) / 100.0f)));
   emitter.lastEmitTime += deltaTime * emitter.speedScale * randomFactor;
 
+  int requested = 0;
   if (emitter.oneShot) {
-    if (emitter.lastEmitTime <= 0.0f) {
-      for (int i = 0; i < emitter.oneShotParticleCount; i++) {
-        EmitParticleHelper(emitterEntity, registry);
-      }
-      emitter.lastEmitTime = std::numeric_limits<float>::max();
+    if (emitter.lastEmitTime > 0.0f)
+      return;
+    requested = static_cast<int>(ceil(emitter.oneShotParticleCount));
+    emitter.lastEmitTime = std::numeric_limits<float>::max();
+  } else {
+    requested = 1;
+    if (emitter.explosiveness > 0.0f) {
+      requested = static_cast<int>(
+          ceil(emitter.explosiveness * emitter.emissionRate * 10));
     }
-    return;
   }
+  if (requested <= 0)
+    return;
 
-  int particlesToEmit = 1;
-  if (emitter.explosiveness > 0.0f) {
-    particlesToEmit = static_cast<int>(
-        ceil(emitter.explosiveness * emitter.emissionRate * 10));
+  // Screen-space emitters are always on screen; world-space ones are
+  // measured against the camera view from the last update.
+  auto &governor = GetParticleGovernor();
+  float distance = 0.0f;
+  const bool screenSpace =
+      emitter.defaultSpace.value_or(emitter.useGlobalCoords
+                                        ? RenderSpace::World
+                                        : RenderSpace::Screen) ==
+      RenderSpace::Screen;
+  if (!screenSpace) {
+    auto &t = registry.get<transform::Transform>(emitterEntity);
+    distance = governor.distanceToView(t.getActualX(), t.getActualY());
   }
+  auto &emitterPool = registry.get_or_emplace<ParticleEmitterPool>(emitterEntity);
+  const uint32_t particlesToEmit =
+      governor.admit(static_cast<uint32_t>(requested), emitter.priority,
+                     distance, emitterPool.emissionCarry);
 
-  for (int i = 0; i < particlesToEmit; i++) {
+  for (uint32_t i = 0; i < particlesToEmit; i++) {
     EmitParticleHelper(emitterEntity, registry);
   }
 }
@@ -280,7 +459,8 @@ void EmitParticleHelper(entt::entity emitterEntity, entt::registry &registry) {
     p.z = emitter.defaultZ.value();
   }
 
-  CreateParticle(registry, spawnPosition, Vector2{10, 10}, p);
+  SpawnPooledParticle(registry, emitterEntity, spawnPosition, Vector2{10, 10},
+                      p);
 }
 
 inline entt::entity CreateParticleEmitter(entt::registry &registry,
@@ -291,6 +471,7 @@ inline entt::entity CreateParticleEmitter(entt::registry &registry,
                                  location.x, location.y, 0, 0);
 
   auto &emitter = registry.emplace<ParticleEmitter>(emitterEntity);
+  registry.emplace<ParticleEmitterPool>(emitterEntity);
 
   emitter = emitterData;
 
@@ -307,6 +488,137 @@ inline entt::entity CreateParticleEmitter(entt::registry &registry,
   return emitterEntity;
 }
 
+// Large emitters are split into slices of this many particles so one big
+// effect can use several workers. Fixed, so slicing never depends on cores.
+constexpr size_t kPooledParticleChunkSize = 2048;
+
+struct PooledParticleJob {
+  entt::entity emitter = entt::null;
+  ParticleEmitterPool *emitterPool = nullptr; // valid during phase 1 only
+  ParticleChunk chunk;
+};
+
+// Simulates every emitter's pooled particles in two phases:
+//  1. workers integrate each slice and record deaths / callback indices;
+//  2. the main thread runs Lua callbacks and removes dead particles, emitter
+//     by emitter and slice by slice in a fixed order.
+// Phase 1 writes only to its own slice, so results do not depend on the
+// thread count. Under lockstep the scalar kernel is forced so every machine
+// produces bit-identical floats.
+inline void UpdatePooledParticles(entt::registry &registry, float deltaTime) {
+  ZONE_SCOPED("particle::UpdatePooledParticles");
+  static std::vector<PooledParticleJob> jobs; // reused, main thread only
+  size_t jobCount = 0;
+
+  auto view = registry.view<ParticleEmitterPool,
+                            entity_gamestate_management::StateTag>();
+  for (auto [entity, emitterPool, stateTag] : view.each()) {
+    if (!entity_gamestate_management::isActiveState(stateTag))
+      continue;
+
+    const size_t count = emitterPool.particles.size();
+    for (size_t begin = 0; begin < count; begin += kPooledParticleChunkSize) {
+      if (jobCount == jobs.size())
+        jobs.emplace_back();
+      auto &job = jobs[jobCount++];
+      job.emitter = entity;
+      job.emitterPool = &emitterPool;
+      job.chunk.begin = begin;
+      job.chunk.end = std::min(begin + kPooledParticleChunkSize, count);
+    }
+  }
+  if (jobCount == 0)
+    return;
+
+  const ParticleKernel kernel = lockstep::isLockstepEnabled()
+                                    ? ParticleKernel::Scalar
+                                    : ActiveParticleKernel();
+
+  job_system::parallelFor(jobCount, 1, [&](size_t first, size_t last) {
+    for (size_t j = first; j < last; ++j) {
+      auto &job = jobs[j];
+      SimulateParticleChunk(job.emitterPool->particles, deltaTime, kernel,
+                            job.chunk);
+    }
+  });
+
+  // Callbacks first (indices are still valid), in job order. Lua may spawn,
+  // wipe or destroy emitters from here, so the pool is looked up again and
+  // indices are bounds-checked.
+  for (size_t j = 0; j < jobCount; ++j) {
+    auto &job = jobs[j];
+    for (uint32_t i : job.chunk.withCallback) {
+      auto *emitterPool = registry.try_get<ParticleEmitterPool>(job.emitter);
+      if (!emitterPool || i >= emitterPool->particles.size())
+        break;
+      auto &pool = emitterPool->particles;
+      const uint32_t slot = pool.callbackSlot[i];
+      if (slot == kNoParticleCallback || slot >= emitterPool->callbacks.size())
+        continue;
+      auto &callback = emitterPool->callbacks[slot];
+      if (!callback)
+        continue;
+      Particle snapshot = ReadPooledParticle(pool, i);
+      callback(snapshot, deltaTime);
+      WritePooledParticle(pool, i, snapshot);
+    }
+  }
+
+  // Deaths from the highest index down: a pool's slices are contiguous and
+  // ascending, so walking the jobs backwards keeps swap-removes valid.
+  for (size_t j = jobCount; j-- > 0;) {
+    auto &job = jobs[j];
+    auto *emitterPool = registry.try_get<ParticleEmitterPool>(job.emitter);
+    if (!emitterPool)
+      continue;
+    const auto &expired = job.chunk.expired;
+    for (size_t k = expired.size(); k-- > 0;) {
+      if (expired[k] >= emitterPool->particles.size())
+        continue;
+      const uint32_t slot = emitterPool->particles.callbackSlot[expired[k]];
+      RemoveParticleAt(emitterPool->particles, expired[k]);
+      if (slot != kNoParticleCallback && slot < emitterPool->callbacks.size()) {
+        // drop the Lua reference now rather than when the slot is reused
+        emitterPool->callbacks[slot] = nullptr;
+        emitterPool->freeCallbackSlots.push_back(slot);
+      }
+    }
+  }
+
+  for (size_t j = 0; j < jobCount; ++j)
+    jobs[j].emitterPool = nullptr;
+}
+
+// Closes the governor's frame: publishes spawn/throttle/cull counts, resyncs
+// the live count with the pools and refreshes the camera view used for
+// distance-based emission.
+inline void UpdateParticleGovernor(entt::registry &registry) {
+  auto &governor = GetParticleGovernor();
+
+  size_t live = 0;
+  for (auto [entity, emitterPool] : registry.view<ParticleEmitterPool>().each())
+    live += emitterPool.particles.size();
+  governor.endFrame(static_cast<uint32_t>(live));
+
+  if (camera_manager::Exists("world_camera")) {
+    // bounds of all four corners, so a rotated camera is still covered
+    const Camera2D &cam = camera_manager::Get("world_camera")->cam;
+    const float w = static_cast<float>(GetScreenWidth());
+    const float h = static_cast<float>(GetScreenHeight());
+    float minX = std::numeric_limits<float>::max(), minY = minX;
+    float maxX = std::numeric_limits<float>::lowest(), maxY = maxX;
+    for (Vector2 corner : {Vector2{0, 0}, Vector2{w, 0}, Vector2{0, h},
+                           Vector2{w, h}}) {
+      const Vector2 world = GetScreenToWorld2D(corner, cam);
+      minX = std::min(minX, world.x);
+      minY = std::min(minY, world.y);
+      maxX = std::max(maxX, world.x);
+      maxY = std::max(maxY, world.y);
+    }
+    governor.setView(minX, minY, maxX, maxY);
+  }
+}
+
 inline void UpdateParticles(entt::registry &registry, float deltaTime) {
   auto view = registry.view<Particle, entity_gamestate_management::StateTag>();
   for (auto entity : view) {
@@ -371,10 +683,149 @@ inline void UpdateParticles(entt::registry &registry, float deltaTime) {
       particle.onUpdateCallback(particle, deltaTime);
     }
   }
+
+  UpdatePooledParticles(registry, deltaTime);
+  UpdateParticleGovernor(registry);
+}
+
+// Converts pooled particle i into a packed batch instance (centre, final
+// size, rotation in degrees). Trig is only needed for the line shapes and
+// velocity-aligned ellipses.
+inline layer::ParticleBatchInstance
+MakePooledParticleInstance(const ParticlePool &pool, size_t i) {
+  const float s = pool.scale[i];
+  layer::ParticleBatchInstance inst{};
+  inst.x = pool.posX[i] + pool.width[i] * 0.5f;
+  inst.y = pool.posY[i] + pool.height[i] * 0.5f;
+  inst.w = pool.width[i] * s;
+  inst.h = pool.height[i] * s;
+  inst.rotation = pool.rotation[i];
+  inst.color = UnpackColor(pool.color[i]);
+  inst.color.a = 255; // matches entity particles (alpha fade disabled)
+
+  const float vx = pool.velX[i], vy = pool.velY[i];
+  switch (static_cast<ParticleRenderType>(pool.renderType[i])) {
+  case ParticleRenderType::RECTANGLE_LINE:
+    inst.shape = layer::ParticleBatchShape::RectangleLines;
+    break;
+  case ParticleRenderType::CIRCLE_FILLED:
+    inst.shape = layer::ParticleBatchShape::Circle;
+    inst.w = std::max(inst.w, inst.h);
+    break;
+  case ParticleRenderType::CIRCLE_LINE:
+    inst.shape = layer::ParticleBatchShape::CircleLines;
+    inst.w = std::max(inst.w, inst.h);
+    break;
+  case ParticleRenderType::LINE:
+    // (0,0)-(w,h) in the particle's local frame, rotated about its centre
+    inst.shape = layer::ParticleBatchShape::Line;
+    inst.rotation += atan2f(inst.h, inst.w) * RAD2DEG;
+    inst.w = sqrtf(inst.w * inst.w + inst.h * inst.h);
+    inst.h = 1.0f;
+    break;
+  case ParticleRenderType::LINE_FACING:
+    inst.shape = layer::ParticleBatchShape::Line;
+    if ((pool.flags[i] & kParticleFlagFaceVelocity) && (vx != 0.0f || vy != 0.0f))
+      inst.rotation = atan2f(vy, vx) * RAD2DEG;
+    inst.h = std::max(1.5f, pool.height[i]);
+    break;
+  case ParticleRenderType::ELLIPSE:
+    inst.shape = layer::ParticleBatchShape::Ellipse;
+    break;
+  case ParticleRenderType::ELLIPSE_STRETCH: {
+    inst.shape = layer::ParticleBatchShape::Ellipse;
+    if (vx != 0.0f || vy != 0.0f)
+      inst.rotation = atan2f(vy, vx) * RAD2DEG;
+    float aspect = 3.0f;
+    if (pool.flags[i] & kParticleFlagAutoAspect)
+      aspect = std::clamp(sqrtf(vx * vx + vy * vy) / 200.0f, 1.5f, 6.0f);
+    inst.h /= aspect;
+    break;
+  }
+  case ParticleRenderType::TEXTURE: // pooled particles carry no animation
+  case ParticleRenderType::RECTANGLE_FILLED:
+  default:
+    inst.shape = layer::ParticleBatchShape::Rectangle;
+    break;
+  }
+  return inst;
+}
+
+// Shadow settings of an emitter, taken from its GameObject like entity
+// particles take them from their own.
+inline void ApplyEmitterShadow(entt::registry &registry, entt::entity emitter,
+                               layer::CmdDrawParticleBatch *cmd) {
+  auto *gameObject = registry.try_get<transform::GameObject>(emitter);
+  if (!gameObject || !gameObject->shadowDisplacement)
+    return;
+  const float heightFactor = 1.0f + gameObject->shadowHeight.value_or(0.f);
+  const float exaggeration = globals::getBaseShadowExaggeration();
+  cmd->drawShadow = true;
+  cmd->shadowOffset = {
+      -gameObject->shadowDisplacement->x * exaggeration * heightFactor,
+      gameObject->shadowDisplacement->y * exaggeration * heightFactor};
+}
+
+// Queues one CmdDrawParticleBatch per emitter (per distinct z/space, which
+// is normally just one) instead of one command per particle. Emitters whose
+// particles are stencil-masked are drawn by DrawStencilMaskedParticlesForEntity.
+inline void DrawPooledParticles(entt::registry &registry,
+                                const std::shared_ptr<layer::Layer> &layerPtr) {
+  ZONE_SCOPED("particle::DrawPooledParticles");
+  struct PendingBatch {
+    int z;
+    layer::DrawCommandSpace space;
+    std::vector<layer::ParticleBatchInstance> instances;
+  };
+  std::vector<PendingBatch> batches;
+
+  auto view = registry.view<ParticleEmitterPool>(entt::exclude<StencilMaskedParticle>);
+  for (auto [entity, emitterPool] : view.each()) {
+    const auto &pool = emitterPool.particles;
+    if (pool.empty())
+      continue;
+
+    batches.clear();
+    for (size_t i = 0; i < pool.size(); ++i) {
+      const auto space = (pool.flags[i] & kParticleFlagScreenSpace)
+                             ? layer::DrawCommandSpace::Screen
+                             : layer::DrawCommandSpace::World;
+      const int z = pool.z[i];
+      PendingBatch *batch = nullptr;
+      for (auto &b : batches) {
+        if (b.z == z && b.space == space) {
+          batch = &b;
+          break;
+        }
+      }
+      if (!batch) {
+        batches.push_back({z, space, {}});
+        batch = &batches.back();
+        batch->instances.reserve(pool.size());
+      }
+      batch->instances.push_back(MakePooledParticleInstance(pool, i));
+    }
+
+    const entt::entity emitterEntity = entity;
+    const auto *emitter = registry.try_get<ParticleEmitter>(emitterEntity);
+    const int blendMode = emitter ? emitter->blendMode : BLEND_ALPHA;
+    for (auto &batch : batches) {
+      layer::QueueCommand<layer::CmdDrawParticleBatch>(
+          layerPtr,
+          [&](layer::CmdDrawParticleBatch *cmd) {
+            cmd->instances = std::move(batch.instances);
+            cmd->blendMode = blendMode;
+            ApplyEmitterShadow(registry, emitterEntity, cmd);
+          },
+          batch.z, batch.space);
+    }
+  }
 }
 
 inline void DrawParticles(entt::registry &registry,
                           std::shared_ptr<layer::Layer> layerPtr) {
+  DrawPooledParticles(registry, layerPtr);
+
   auto view = registry.view<Particle>();
 
   for (auto entity : view) {
@@ -996,15 +1447,26 @@ inline void DrawParticles(entt::registry &registry,
   }
 }
 
+inline void ClearEmitterPool(ParticleEmitterPool &emitterPool) {
+  emitterPool.particles.clear();
+  emitterPool.callbacks.clear();
+  emitterPool.freeCallbackSlots.clear();
+}
+
 // destroys every live particle
 inline void WipeAll() {
   auto view = globals::getRegistry().view<Particle>();
   for (auto e : view) {
     globals::getRegistry().destroy(e);
   }
+  for (auto [e, emitterPool] :
+       globals::getRegistry().view<ParticleEmitterPool>().each()) {
+    ClearEmitterPool(emitterPool);
+  }
 }
 
-// destroys only those particles whose ParticleTag.name == tag
+// destroys only those particles whose ParticleTag.name == tag; a tagged
+// emitter has its pooled particles cleared
 inline void WipeTagged(const std::string &tag) {
   auto view = globals::getRegistry().view<Particle, ParticleTag>();
   for (auto [e, p, t] : view.each()) {
@@ -1012,25 +1474,19 @@ inline void WipeTagged(const std::string &tag) {
       globals::getRegistry().destroy(e);
     }
   }
+  auto poolView =
+      globals::getRegistry().view<ParticleEmitterPool, ParticleTag>();
+  for (auto [e, emitterPool, t] : poolView.each()) {
+    if (t.name == tag) {
+      ClearEmitterPool(emitterPool);
+    }
+  }
 }
 
 // ============================================================================
-// STENCIL-MASKED PARTICLES
-// Allows particles to be rendered only within the bounds of a source entity's
-// sprite, using stencil buffer masking. Works with shader pipeline.
+// STENCIL-MASKED PARTICLES (drawing; marker components are declared above)
 // ============================================================================
 
-/// Marker component: indicates this entity provides a stencil mask for particles
-struct StencilMaskSource {
-  float paddingPx = 0.0f;  // Optional: expand/contract mask rect
-};
-
-/// Marker component: indicates this particle should be masked by a source entity
-struct StencilMaskedParticle {
-  entt::entity sourceEntity = entt::null;  // Entity whose bounds define stencil mask
-  float zBias = 0.0f;  // Relative z ordering within local commands
-};
-
 /// Draw stencil-masked particles for a specific source entity.
 /// This function queues stencil commands as LOCAL commands on the source entity,
 /// so particles are captured in the shader pipeline input and processed with shaders.
@@ -1063,7 +1519,8 @@ inline void DrawStencilMaskedParticlesForEntity(
   
   auto& maskSource = registry.get<StencilMaskSource>(sourceEntity);
   
-  // Collect all particles masked by this source
+  // Collect all particles masked by this source: entity particles, and
+  // emitters whose pooled particles are all masked by it.
   std::vector<entt::entity> maskedParticles;
   auto view = registry.view<Particle, StencilMaskedParticle, transform::Transform>();
   for (auto [particleEntity, particle, maskedComp, transform] : view.each()) {
@@ -1071,21 +1528,33 @@ inline void DrawStencilMaskedParticlesForEntity(
       maskedParticles.push_back(particleEntity);
     }
   }
+  std::vector<entt::entity> maskedEmitters;
+  auto emitterView = registry.view<ParticleEmitterPool, StencilMaskedParticle>();
+  for (auto [emitterEntity, emitterPool, maskedComp] : emitterView.each()) {
+    if (maskedComp.sourceEntity == sourceEntity && !emitterPool.particles.empty()) {
+      maskedEmitters.push_back(emitterEntity);
+    }
+  }
   
   // No particles to draw
-  if (maskedParticles.empty()) {
+  if (maskedParticles.empty() && maskedEmitters.empty()) {
     return;
   }
   
   // Determine rendering space from first particle (assume all same space)
   layer::DrawCommandSpace drawCommandSpace = layer::DrawCommandSpace::World;
-  {
+  if (!maskedParticles.empty()) {
     auto& firstParticle = registry.get<Particle>(maskedParticles[0]);
     if (firstParticle.space.has_value()) {
       drawCommandSpace = (firstParticle.space.value() == RenderSpace::Screen)
                              ? layer::DrawCommandSpace::Screen
                              : layer::DrawCommandSpace::World;
     }
+  } else {
+    const auto& firstPool = registry.get<ParticleEmitterPool>(maskedEmitters[0]).particles;
+    if (firstPool.flags[0] & kParticleFlagScreenSpace) {
+      drawCommandSpace = layer::DrawCommandSpace::Screen;
+    }
   }
   
   // Get mask bounds from source transform
@@ -1214,111 +1683,69 @@ inline void DrawStencilMaskedParticlesForEntity(
         cmd->dummy = 0;
       }, baseZ + 11, drawCommandSpace);
   
-  // 5. Draw all masked particles (only visible where stencil == 1)
-  int particleZ = baseZ + 12;
+  // 5. Draw all masked particles (only visible where stencil == 1) as a
+  //    single batch instead of a push/transform/draw/pop run per particle.
+  const int particleZ = baseZ + 12;
+  std::vector<layer::ParticleBatchInstance> instances;
+  instances.reserve(maskedParticles.size());
   for (auto particleEntity : maskedParticles) {
     auto& particle = registry.get<Particle>(particleEntity);
     auto& particleTransform = registry.get<transform::Transform>(particleEntity);
-    auto& gameObject = registry.get<transform::GameObject>(particleEntity);
-    
-    float visualX = particleTransform.getVisualX();
-    float visualY = particleTransform.getVisualY();
-    float visualW = particleTransform.getVisualW();
-    float visualH = particleTransform.getVisualH();
-    float visualR = particleTransform.getVisualRWithDynamicMotionAndXLeaning();
-    float visualScale = particleTransform.getVisualScaleWithHoverAndDynamicMotionReflected();
-    
-    Color drawColor = particle.color.value_or(WHITE);
-    
-    // Push matrix for this particle
-    layer::QueueCommand<layer::CmdPushMatrix>(
-        layerPtr, [](layer::CmdPushMatrix* cmd) {}, particleZ, drawCommandSpace);
-    
-    layer::QueueCommand<layer::CmdTranslate>(
-        layerPtr, [visualX, visualY, visualW, visualH](layer::CmdTranslate* cmd) {
-          cmd->x = visualX + visualW * 0.5f;
-          cmd->y = visualY + visualH * 0.5f;
-        }, particleZ + 1, drawCommandSpace);
     
-    layer::QueueCommand<layer::CmdScale>(
-        layerPtr, [visualScale](layer::CmdScale* cmd) {
-          cmd->scaleX = visualScale;
-          cmd->scaleY = visualScale;
-        }, particleZ + 2, drawCommandSpace);
-    
-    layer::QueueCommand<layer::CmdRotate>(
-        layerPtr, [visualR](layer::CmdRotate* cmd) {
-          cmd->angle = visualR;
-        }, particleZ + 3, drawCommandSpace);
+    const float visualW = particleTransform.getVisualW();
+    const float visualH = particleTransform.getVisualH();
+    const float visualScale = particleTransform.getVisualScaleWithHoverAndDynamicMotionReflected();
     
-    layer::QueueCommand<layer::CmdTranslate>(
-        layerPtr, [visualW, visualH](layer::CmdTranslate* cmd) {
-          cmd->x = -visualW * 0.5f;
-          cmd->y = -visualH * 0.5f;
-        }, particleZ + 4, drawCommandSpace);
+    layer::ParticleBatchInstance inst{};
+    inst.x = particleTransform.getVisualX() + visualW * 0.5f;
+    inst.y = particleTransform.getVisualY() + visualH * 0.5f;
+    inst.w = visualW * visualScale;
+    inst.h = visualH * visualScale;
+    inst.rotation = particleTransform.getVisualRWithDynamicMotionAndXLeaning();
+    inst.color = particle.color.value_or(WHITE);
     
-    // Draw particle based on render type
     switch (particle.renderType) {
-      case ParticleRenderType::CIRCLE_FILLED:
-        layer::QueueCommand<layer::CmdDrawCircleFilled>(
-            layerPtr,
-            [radius = std::max(visualW, visualH), drawColor](layer::CmdDrawCircleFilled* cmd) {
-              cmd->x = radius / 2;
-              cmd->y = radius / 2;
-              cmd->radius = radius;
-              cmd->color = drawColor;
-            }, particleZ + 5, drawCommandSpace);
-        break;
-        
       case ParticleRenderType::RECTANGLE_FILLED:
-        layer::QueueCommand<layer::CmdDrawRectanglePro>(
-            layerPtr,
-            [visualW, visualH, drawColor](layer::CmdDrawRectanglePro* cmd) {
-              cmd->offsetX = 0;
-              cmd->offsetY = 0;
-              cmd->size.x = visualW;
-              cmd->size.y = visualH;
-              cmd->color = drawColor;
-            }, particleZ + 5, drawCommandSpace);
+        inst.shape = layer::ParticleBatchShape::Rectangle;
         break;
-        
       case ParticleRenderType::ELLIPSE:
-        layer::QueueCommand<layer::CmdDrawCenteredEllipse>(
-            layerPtr,
-            [radiusX = visualW * 0.5f, radiusY = visualH * 0.5f, drawColor](layer::CmdDrawCenteredEllipse* cmd) {
-              cmd->x = radiusX;
-              cmd->y = radiusY;
-              cmd->rx = radiusX;
-              cmd->ry = radiusY;
-              cmd->color = drawColor;
-              cmd->lineWidth.reset();
-            }, particleZ + 5, drawCommandSpace);
+        inst.shape = layer::ParticleBatchShape::Ellipse;
         break;
-        
-      default:
-        // For other types, draw as circle
-        layer::QueueCommand<layer::CmdDrawCircleFilled>(
-            layerPtr,
-            [radius = std::max(visualW, visualH), drawColor](layer::CmdDrawCircleFilled* cmd) {
-              cmd->x = radius / 2;
-              cmd->y = radius / 2;
-              cmd->radius = radius;
-              cmd->color = drawColor;
-            }, particleZ + 5, drawCommandSpace);
+      case ParticleRenderType::CIRCLE_FILLED:
+      default: {
+        // For other types, draw as circle. The per-particle path drew it at
+        // (radius/2, radius/2) from the particle's top-left corner, which is
+        // off-centre for non-square particles; keep that placement.
+        inst.shape = layer::ParticleBatchShape::Circle;
+        const float radius = std::max(visualW, visualH);
+        const float ox = (radius - visualW) * 0.5f * visualScale;
+        const float oy = (radius - visualH) * 0.5f * visualScale;
+        const float rad = inst.rotation * DEG2RAD;
+        inst.x += ox * cosf(rad) - oy * sinf(rad);
+        inst.y += ox * sinf(rad) + oy * cosf(rad);
+        inst.w = radius * visualScale;
         break;
+      }
+    }
+    instances.push_back(inst);
+  }
+  for (auto emitterEntity : maskedEmitters) {
+    const auto& pool = registry.get<ParticleEmitterPool>(emitterEntity).particles;
+    for (size_t i = 0; i < pool.size(); ++i) {
+      instances.push_back(MakePooledParticleInstance(pool, i));
     }
-    
-    layer::QueueCommand<layer::CmdPopMatrix>(
-        layerPtr, [](layer::CmdPopMatrix* cmd) {}, particleZ + 6, drawCommandSpace);
-    
-    particleZ += 10;  // Space for next particle
   }
   
+  layer::QueueCommand<layer::CmdDrawParticleBatch>(
+      layerPtr, [&instances](layer::CmdDrawParticleBatch* cmd) {
+        cmd->instances = std::move(instances);
+      }, particleZ, drawCommandSpace);
+  
   // 6. End stencil mode
   layer::QueueCommand<layer::CmdEndStencilMode>(
       layerPtr, [](layer::CmdEndStencilMode* cmd) {
         cmd->dummy = 0;
-      }, particleZ, drawCommandSpace);
+      }, particleZ + 1, drawCommandSpace);
 }
 
 /// Draw all stencil-masked particles across all source entities
@@ -1421,6 +1848,24 @@ inline void exposeToLua(sol::state &lua) {
   rec.record_property("particle.RenderSpace",
                       {"SCREEN", "1", "Render in screen/UI space"});
 
+  p["EmitterPriority"] = lua.create_table_with(
+      "LOW", particle::EmitterPriority::Low, "NORMAL",
+      particle::EmitterPriority::Normal, "HIGH",
+      particle::EmitterPriority::High, "CRITICAL",
+      particle::EmitterPriority::Critical);
+
+  auto &priorityDef = rec.add_type("particle.EmitterPriority");
+  priorityDef.doc = "How long an emitter keeps emitting as the particle "
+                    "budget fills";
+  rec.record_property("particle.EmitterPriority",
+                      {"LOW", "0", "Ambient effects; throttled first"});
+  rec.record_property("particle.EmitterPriority", {"NORMAL", "1", "Default"});
+  rec.record_property("particle.EmitterPriority",
+                      {"HIGH", "2", "Gameplay feedback; throttled last"});
+  rec.record_property(
+      "particle.EmitterPriority",
+      {"CRITICAL", "3", "Never throttled or culled, only hard-capped"});
+
   lua.new_usertype<particle::Particle>(
       "Particle", sol::constructors<particle::Particle()>(),
 
@@ -1696,7 +2141,8 @@ inline void exposeToLua(sol::state &lua) {
       &particle::ParticleEmitter::blendMode, "colors",
       &particle::ParticleEmitter::colors, "defaultZ",
       &particle::ParticleEmitter::defaultZ, "defaultSpace",
-      &particle::ParticleEmitter::defaultSpace, "type_id",
+      &particle::ParticleEmitter::defaultSpace, "priority",
+      &particle::ParticleEmitter::priority, "type_id",
       []() { return entt::type_hash<particle::ParticleEmitter>::value(); });
   rec.bind_usertype<particle::ParticleEmitter>(
       lua, "particle.ParticleEmitter", "0.1",
@@ -1759,6 +2205,11 @@ inline void exposeToLua(sol::state &lua) {
   rec.record_property(
       "particle.ParticleEmitter",
       {"colors", "nil", "Color[]: A table of possible colors for particles."});
+  rec.record_property(
+      "particle.ParticleEmitter",
+      {"priority", "particle.EmitterPriority.NORMAL",
+       "particle.EmitterPriority: How long this emitter keeps emitting as "
+       "the particle budget fills."});
 
   p.new_usertype<particle::ParticleAnimationConfig>(
       "ParticleAnimationConfig", sol::constructors<>(), "loop",
@@ -1813,6 +2264,7 @@ inline void exposeToLua(sol::state &lua) {
     e.acceleration = opts.get_or("acceleration", e.acceleration);
     e.blendMode = opts.get_or("blendMode", e.blendMode);
     e.colors = opts.get_or("colors", e.colors);
+    e.priority = opts.get_or("priority", e.priority);
     // NEW: defaults
     if (auto zopt = opts["defaultZ"];
         zopt.valid() && !zopt.is<sol::lua_nil_t>()) {
@@ -2064,6 +2516,69 @@ inline void exposeToLua(sol::state &lua) {
       "Creates a Particle from Lua, applies optional animation, sprite, color "
       "tinting, and tag.");
 
+  // Pooled (non-entity) spawn: cheap, but no components can be attached.
+  static auto luaSpawnPooledParticle = [](entt::entity emitter,
+                                          Vector2 location, Vector2 size,
+                                          sol::optional<sol::table> opts) {
+    auto &registry = globals::getRegistry();
+    if (!registry.valid(emitter) || !registry.all_of<ParticleEmitter>(emitter)) {
+      SPDLOG_WARN("SpawnPooledParticle: entity is not a particle emitter");
+      return;
+    }
+    particle::Particle p =
+        opts ? tableDrivenParticleMaker(*opts) : particle::Particle{};
+    SpawnPooledParticle(registry, emitter, location, size, p);
+  };
+
+  rec.bind_function(
+      lua, particlePath, "SpawnPooledParticle", luaSpawnPooledParticle,
+      "---@param emitter  entt.entity                    # emitter that owns "
+      "the particle\n"
+      "---@param location Vector2                        # top-left spawn "
+      "position\n"
+      "---@param size     Vector2                        # width/height\n"
+      "---@param opts     table?                         # same keys as "
+      "CreateParticle opts\n"
+      "---@return nil",
+      "Spawns a lightweight particle into the emitter's pool. Pooled "
+      "particles are not entities and die with their emitter.");
+
+  rec.bind_function(
+      lua, particlePath, "GetGovernorStats",
+      [](sol::this_state s) {
+        sol::state_view L(s);
+        const auto &governor = GetParticleGovernor();
+        const auto &stats = governor.lastFrame();
+        sol::table t = L.create_table();
+        t["live"] = stats.live;
+        t["spawned"] = stats.spawned;
+        t["throttled"] = stats.throttled;
+        t["culled"] = stats.culled;
+        t["pressure"] = stats.pressure;
+        t["budget"] = governor.config.budget;
+        return t;
+      },
+      "---@return table # { live, spawned, throttled, culled, pressure, "
+      "budget }",
+      "Pooled particle counts for the last frame: particles alive, spawned, "
+      "dropped for budget pressure (throttled) and dropped because the "
+      "emitter was off-screen (culled).");
+
+  rec.bind_function(
+      lua, particlePath, "SetGovernorConfig",
+      [](sol::table opts) {
+        auto &config = GetParticleGovernor().config;
+        config.enabled = opts.get_or("enabled", config.enabled);
+        config.budget = opts.get_or("budget", config.budget);
+        config.offscreenScale =
+            opts.get_or("offscreenScale", config.offscreenScale);
+        config.cullDistance = opts.get_or("cullDistance", config.cullDistance);
+      },
+      "---@param opts table # { enabled?, budget?, offscreenScale?, "
+      "cullDistance? }\n"
+      "---@return nil",
+      "Adjusts the pooled particle budget and off-screen emission falloff.");
+
   // 1) Create a new usertype for Vector2
   lua.new_usertype<Vector2>(
       "Vector2",
@@ -2194,5 +2709,18 @@ inline void exposeToLua(sol::state &lua) {
       "---@param padding number?\n"
       "---@return nil",
       "Marks an entity as a stencil mask source for particles");
+
+  auto luaMaskEmitter = [](entt::entity emitter, entt::entity sourceEntity) {
+    particle::StencilMaskedParticle maskedComp;
+    maskedComp.sourceEntity = sourceEntity;
+    globals::getRegistry().emplace_or_replace<particle::StencilMaskedParticle>(emitter, maskedComp);
+  };
+
+  rec.bind_function(
+      lua, particlePath, "MaskEmitter", luaMaskEmitter,
+      "---@param emitter Entity # Emitter whose pooled particles get masked\n"
+      "---@param sourceEntity Entity # Entity providing stencil mask\n"
+      "---@return nil",
+      "Masks every particle spawned by the emitter with the source entity's bounds");
 }
 } // namespace particle
@@ -0,0 +1,95 @@
+#include "particle_governor.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace particle {
+
+float ParticleGovernor::budgetScale(EmitterPriority priority) const {
+    if (!config.enabled || priority == EmitterPriority::Critical || config.budget == 0)
+        return 1.0f;
+
+    const size_t p = static_cast<size_t>(priority);
+    const float pressure = static_cast<float>(live_) / static_cast<float>(config.budget);
+    const float start = config.throttleStart[p];
+    const float end = config.throttleEnd[p];
+    if (pressure <= start) return 1.0f;
+    if (pressure >= end) return 0.0f;
+    return 1.0f - (pressure - start) / (end - start);
+}
+
+float ParticleGovernor::distanceScale(float distance) const {
+    if (!config.enabled || distance <= 0.0f) return 1.0f;
+    if (distance >= config.cullDistance) return 0.0f;
+    return config.offscreenScale * (1.0f - distance / config.cullDistance);
+}
+
+void ParticleGovernor::setView(float minX, float minY, float maxX, float maxY) {
+    hasView_ = true;
+    viewMinX_ = std::min(minX, maxX);
+    viewMaxX_ = std::max(minX, maxX);
+    viewMinY_ = std::min(minY, maxY);
+    viewMaxY_ = std::max(minY, maxY);
+}
+
+float ParticleGovernor::distanceToView(float x, float y) const {
+    if (!hasView_) return 0.0f;
+    const float dx = std::max({viewMinX_ - x, 0.0f, x - viewMaxX_});
+    const float dy = std::max({viewMinY_ - y, 0.0f, y - viewMaxY_});
+    return std::sqrt(dx * dx + dy * dy);
+}
+
+uint32_t ParticleGovernor::admit(uint32_t requested, EmitterPriority priority,
+                                 float distance, float &carry) {
+    if (requested == 0) return 0;
+
+    const bool critical = priority == EmitterPriority::Critical;
+    const float viewScale = critical ? 1.0f : distanceScale(distance);
+    const float scale = budgetScale(priority) * viewScale;
+
+    uint32_t admitted = requested;
+    if (scale < 1.0f) {
+        const double exact = static_cast<double>(requested) * scale + carry;
+        admitted = static_cast<uint32_t>(std::floor(exact));
+        carry = static_cast<float>(exact - admitted);
+    }
+
+    if (config.enabled) {
+        const uint32_t room = config.budget > live_ ? config.budget - live_ : 0;
+        admitted = std::min(admitted, room);
+    }
+
+    // attribute drops to the view first, the rest to budget pressure
+    const uint32_t dropped = requested - admitted;
+    const uint32_t culled = std::min(
+        dropped, static_cast<uint32_t>(std::lround(requested * (1.0f - viewScale))));
+    current_.culled += culled;
+    current_.throttled += dropped - culled;
+    return admitted;
+}
+
+bool ParticleGovernor::trySpawn() {
+    if (config.enabled && live_ >= config.budget) {
+        ++current_.throttled;
+        return false;
+    }
+    ++live_;
+    ++current_.spawned;
+    return true;
+}
+
+void ParticleGovernor::endFrame(uint32_t live) {
+    live_ = live;
+    current_.live = live;
+    current_.pressure =
+        config.budget > 0 ? static_cast<float>(live) / static_cast<float>(config.budget) : 0.0f;
+    lastFrame_ = current_;
+    current_ = ParticleGovernorStats{};
+}
+
+ParticleGovernor &GetParticleGovernor() {
+    static ParticleGovernor governor;
+    return governor;
+}
+
+} // namespace particle
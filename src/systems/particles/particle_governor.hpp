@@ -0,0 +1,92 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace particle {
+
+//------------------------------------------------------------
+// Global budget for pooled particles.
+//
+// Emitters ask the governor how many particles they may spawn. As the live
+// count approaches the budget, emission is scaled down — low-priority
+// emitters first — and emitters outside the camera view emit less the
+// further away they are. The budget itself is a hard cap, so the per-frame
+// simulation and draw cost stays bounded whatever scripts request.
+//------------------------------------------------------------
+
+enum class EmitterPriority : uint8_t {
+    Low,      // ambient dressing; first to be throttled
+    Normal,
+    High,     // gameplay feedback
+    Critical, // never throttled or culled, only hard-capped
+};
+
+constexpr size_t kEmitterPriorityCount = 4;
+
+struct ParticleGovernorConfig {
+    bool enabled = true;
+    uint32_t budget = 20000; // max live pooled particles across all emitters
+
+    // Per priority, emission scales linearly from 1 at throttleStart to 0 at
+    // throttleEnd, both expressed as a fraction of the budget in use.
+    std::array<float, kEmitterPriorityCount> throttleStart{0.50f, 0.65f, 0.80f, 1.00f};
+    std::array<float, kEmitterPriorityCount> throttleEnd{0.75f, 0.90f, 1.00f, 1.00f};
+
+    float offscreenScale = 0.25f; // emission just outside the view
+    float cullDistance = 1024.0f; // world units outside the view where emission stops
+};
+
+struct ParticleGovernorStats {
+    uint32_t live = 0;      // pooled particles alive after the last update
+    uint32_t spawned = 0;
+    uint32_t throttled = 0; // dropped because of budget pressure
+    uint32_t culled = 0;    // dropped because the emitter was off-screen
+    float pressure = 0.0f;  // live / budget
+};
+
+struct ParticleGovernor {
+    ParticleGovernorConfig config;
+
+    // Emission multiplier in [0, 1] for the current fill level.
+    float budgetScale(EmitterPriority priority) const;
+
+    // Emission multiplier in [0, 1] for an emitter `distance` units outside
+    // the view; 0 means inside.
+    float distanceScale(float distance) const;
+
+    // World-space rectangle currently on screen. Until one is set every
+    // emitter counts as visible.
+    void setView(float minX, float minY, float maxX, float maxY);
+    float distanceToView(float x, float y) const;
+
+    // How many of `requested` particles may be spawned now. `carry` is the
+    // emitter's fractional remainder, so an emitter scaled to 0.3 still emits
+    // on average 0.3 of what it asks for. Dropped particles are counted as
+    // throttled or culled.
+    uint32_t admit(uint32_t requested, EmitterPriority priority, float distance,
+                   float &carry);
+
+    // Hard-cap check for one spawn; counts it as spawned or throttled.
+    bool trySpawn();
+
+    // Publishes this frame's counters and starts the next frame from the
+    // actual live count.
+    void endFrame(uint32_t live);
+
+    uint32_t live() const { return live_; }
+    const ParticleGovernorStats &lastFrame() const { return lastFrame_; }
+
+private:
+    ParticleGovernorStats current_{};
+    ParticleGovernorStats lastFrame_{};
+    uint32_t live_ = 0;
+    bool hasView_ = false;
+    float viewMinX_ = 0.f, viewMinY_ = 0.f, viewMaxX_ = 0.f, viewMaxY_ = 0.f;
+};
+
+// The governor shared by every emitter (main thread only).
+ParticleGovernor &GetParticleGovernor();
+
+} // namespace particle
@@ -0,0 +1,247 @@
+#include "particle_pool.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+// AVX2 is compiled in on x86-64 builds (per-function target attribute, so no
+// global -mavx2 is needed) and only used if the CPU reports it at runtime.
+#if !defined(__EMSCRIPTEN__) && (defined(__x86_64__) || defined(_M_X64))
+    #include <immintrin.h>
+    #define PARTICLEPOOL_USE_AVX2 1
+    #if defined(_MSC_VER) && !defined(__clang__)
+        #include <intrin.h>
+        #define PARTICLEPOOL_AVX2_TARGET
+    #else
+        #define PARTICLEPOOL_AVX2_TARGET __attribute__((target("avx2")))
+    #endif
+#else
+    #define PARTICLEPOOL_USE_AVX2 0
+#endif
+
+namespace particle {
+
+namespace {
+
+// Packed RGBA lerp, one channel at a time. Truncates like the old
+// static_cast<uint8_t>(float) so results match the entity path.
+inline uint32_t lerpPackedColor(uint32_t s, uint32_t e, float t) {
+    uint32_t out = 0;
+    for (int shift = 0; shift < 32; shift += 8) {
+        const float a = static_cast<float>((s >> shift) & 0xFFu);
+        const float b = static_cast<float>((e >> shift) & 0xFFu);
+        out |= (static_cast<uint32_t>(a + (b - a) * t) & 0xFFu) << shift;
+    }
+    return out;
+}
+
+void integrateScalar(ParticlePool &pool, float dt, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+        pool.age[i] += dt;
+
+        // acceleration along the normalized velocity; a particle at rest is
+        // pushed along +x, which is what atan2(0, 0) == 0 used to give
+        float vx = pool.velX[i];
+        float vy = pool.velY[i];
+        const float lenSq = vx * vx + vy * vy;
+        float dirX = 1.0f, dirY = 0.0f;
+        if (lenSq > 0.0f) {
+            const float invLen = 1.0f / std::sqrt(lenSq);
+            dirX = vx * invLen;
+            dirY = vy * invLen;
+        }
+        const float speedIncrease = pool.acceleration[i] * dt;
+        vx += dirX * speedIncrease;
+        vy += dirY * speedIncrease;
+
+        vy += pool.gravity[i] * dt;
+
+        pool.velX[i] = vx;
+        pool.velY[i] = vy;
+        pool.posX[i] += vx * dt;
+        pool.posY[i] += vy * dt;
+        pool.rotation[i] += pool.rotationSpeed[i] * dt;
+
+        if (pool.flags[i] & kParticleFlagColorLerp) {
+            // 0 for immortal particles; clamped so the last frame can't overshoot
+            const float t = std::clamp(pool.age[i] / pool.lifespan[i], 0.0f, 1.0f);
+            pool.color[i] = lerpPackedColor(pool.startColor[i], pool.endColor[i], t);
+        }
+    }
+}
+
+#if PARTICLEPOOL_USE_AVX2
+
+PARTICLEPOOL_AVX2_TARGET
+inline __m256i lerpChannel8(__m256i s, __m256i e, __m256 t, int shift) {
+    const __m256i mask = _mm256_set1_epi32(0xFF);
+    const __m128i count = _mm_cvtsi32_si128(shift);
+    const __m256 a = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srl_epi32(s, count), mask));
+    const __m256 b = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srl_epi32(e, count), mask));
+    const __m256 v = _mm256_add_ps(a, _mm256_mul_ps(_mm256_sub_ps(b, a), t));
+    return _mm256_sll_epi32(_mm256_and_si256(_mm256_cvttps_epi32(v), mask), count);
+}
+
+// Eight packed RGBA lerps at once; same truncation as lerpPackedColor().
+PARTICLEPOOL_AVX2_TARGET
+inline __m256i lerpPackedColor8(__m256i s, __m256i e, __m256 t) {
+    __m256i out = lerpChannel8(s, e, t, 0);
+    out = _mm256_or_si256(out, lerpChannel8(s, e, t, 8));
+    out = _mm256_or_si256(out, lerpChannel8(s, e, t, 16));
+    return _mm256_or_si256(out, lerpChannel8(s, e, t, 24));
+}
+
+PARTICLEPOOL_AVX2_TARGET
+void integrateAVX2(ParticlePool &pool, float dt, size_t begin, size_t end) {
+    const size_t step = 8;
+    const size_t aligned = begin + (end - begin) - ((end - begin) % step);
+
+    const __m256 vdt   = _mm256_set1_ps(dt);
+    const __m256 vzero = _mm256_setzero_ps();
+    const __m256 vone  = _mm256_set1_ps(1.0f);
+    const __m256i vlerpFlag = _mm256_set1_epi32(kParticleFlagColorLerp);
+
+    size_t i = begin;
+    for (; i < aligned; i += step) {
+        __m256 vAge = _mm256_add_ps(_mm256_loadu_ps(&pool.age[i]), vdt);
+        __m256 vx = _mm256_loadu_ps(&pool.velX[i]);
+        __m256 vy = _mm256_loadu_ps(&pool.velY[i]);
+
+        const __m256 lenSq = _mm256_add_ps(_mm256_mul_ps(vx, vx), _mm256_mul_ps(vy, vy));
+        const __m256 moving = _mm256_cmp_ps(lenSq, vzero, _CMP_GT_OQ);
+        const __m256 invLen = _mm256_div_ps(vone, _mm256_sqrt_ps(lenSq));
+        const __m256 dirX = _mm256_blendv_ps(vone, _mm256_mul_ps(vx, invLen), moving);
+        const __m256 dirY = _mm256_and_ps(_mm256_mul_ps(vy, invLen), moving);
+
+        const __m256 speedIncrease = _mm256_mul_ps(_mm256_loadu_ps(&pool.acceleration[i]), vdt);
+        vx = _mm256_add_ps(vx, _mm256_mul_ps(dirX, speedIncrease));
+        vy = _mm256_add_ps(vy, _mm256_mul_ps(dirY, speedIncrease));
+        vy = _mm256_add_ps(vy, _mm256_mul_ps(_mm256_loadu_ps(&pool.gravity[i]), vdt));
+
+        _mm256_storeu_ps(&pool.velX[i], vx);
+        _mm256_storeu_ps(&pool.velY[i], vy);
+        _mm256_storeu_ps(&pool.posX[i], _mm256_add_ps(_mm256_loadu_ps(&pool.posX[i]), _mm256_mul_ps(vx, vdt)));
+        _mm256_storeu_ps(&pool.posY[i], _mm256_add_ps(_mm256_loadu_ps(&pool.posY[i]), _mm256_mul_ps(vy, vdt)));
+        _mm256_storeu_ps(&pool.rotation[i],
+                         _mm256_add_ps(_mm256_loadu_ps(&pool.rotation[i]),
+                                       _mm256_mul_ps(_mm256_loadu_ps(&pool.rotationSpeed[i]), vdt)));
+        _mm256_storeu_ps(&pool.age[i], vAge);
+
+        // colour: lerp all eight, keep the old value where the flag is clear
+        const __m256i flags = _mm256_cvtepu8_epi32(
+            _mm_loadl_epi64(reinterpret_cast<const __m128i *>(&pool.flags[i])));
+        const __m256i lerpMask = _mm256_cmpeq_epi32(_mm256_and_si256(flags, vlerpFlag), vlerpFlag);
+        if (_mm256_testz_si256(lerpMask, lerpMask)) continue;
+
+        const __m256 t = _mm256_min_ps(
+            _mm256_max_ps(_mm256_div_ps(vAge, _mm256_loadu_ps(&pool.lifespan[i])), vzero), vone);
+        const __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&pool.startColor[i]));
+        const __m256i e = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&pool.endColor[i]));
+        const __m256i old = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&pool.color[i]));
+        const __m256i lerped = lerpPackedColor8(s, e, t);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(&pool.color[i]),
+                            _mm256_blendv_epi8(old, lerped, lerpMask));
+    }
+
+    integrateScalar(pool, dt, i, end); // tail
+}
+
+bool cpuHasAVX2() {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx     = (info[2] & (1 << 28)) != 0;
+    if (!(osxsave && avx)) return false;
+    if ((_xgetbv(0) & 0x6) != 0x6) return false; // OS saves YMM state
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif // PARTICLEPOOL_USE_AVX2
+
+} // namespace
+
+bool ParticleKernelAvailable(ParticleKernel kernel) {
+    switch (kernel) {
+    case ParticleKernel::Scalar:
+        return true;
+    case ParticleKernel::AVX2:
+#if PARTICLEPOOL_USE_AVX2
+    {
+        static const bool hasAVX2 = cpuHasAVX2();
+        return hasAVX2;
+    }
+#else
+        return false;
+#endif
+    }
+    return false;
+}
+
+ParticleKernel ActiveParticleKernel() {
+    static const ParticleKernel active = ParticleKernelAvailable(ParticleKernel::AVX2)
+                                             ? ParticleKernel::AVX2
+                                             : ParticleKernel::Scalar;
+    return active;
+}
+
+void IntegrateParticleRange(ParticlePool &pool, float dt, size_t begin, size_t end,
+                            ParticleKernel kernel) {
+    end = std::min(end, pool.size());
+    if (begin >= end) return;
+#if PARTICLEPOOL_USE_AVX2
+    if (kernel == ParticleKernel::AVX2 && ParticleKernelAvailable(ParticleKernel::AVX2)) {
+        integrateAVX2(pool, dt, begin, end);
+        return;
+    }
+#endif
+    (void)kernel;
+    integrateScalar(pool, dt, begin, end);
+}
+
+void IntegrateParticlePool(ParticlePool &pool, float dt, ParticleKernel kernel) {
+    IntegrateParticleRange(pool, dt, 0, pool.size(), kernel);
+}
+
+void IntegrateParticlePool(ParticlePool &pool, float dt) {
+    IntegrateParticlePool(pool, dt, ActiveParticleKernel());
+}
+
+void SimulateParticleChunk(ParticlePool &pool, float dt, ParticleKernel kernel,
+                           ParticleChunk &chunk) {
+    chunk.expired.clear();
+    chunk.withCallback.clear();
+    IntegrateParticleRange(pool, dt, chunk.begin, chunk.end, kernel);
+
+    for (size_t i = chunk.begin; i < chunk.end; ++i) {
+        if (pool.age[i] >= pool.lifespan[i]) {
+            chunk.expired.push_back(static_cast<uint32_t>(i));
+        } else if (pool.callbackSlot[i] != kNoParticleCallback) {
+            chunk.withCallback.push_back(static_cast<uint32_t>(i));
+        }
+    }
+}
+
+void RemoveParticleAt(ParticlePool &pool, size_t i, std::vector<uint32_t> *releasedCallbackSlots) {
+    if (releasedCallbackSlots && pool.callbackSlot[i] != kNoParticleCallback) {
+        releasedCallbackSlots->push_back(pool.callbackSlot[i]);
+    }
+    pool.swapRemove(i);
+}
+
+size_t RemoveExpiredParticles(ParticlePool &pool, std::vector<uint32_t> *releasedCallbackSlots) {
+    size_t removed = 0;
+    // walk backwards so the element swapped into slot i has already been checked
+    for (size_t i = pool.size(); i-- > 0;) {
+        if (pool.age[i] < pool.lifespan[i]) continue;
+        RemoveParticleAt(pool, i, releasedCallbackSlots);
+        ++removed;
+    }
+    return removed;
+}
+
+} // namespace particle
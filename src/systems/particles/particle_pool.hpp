@@ -0,0 +1,182 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace particle {
+
+//------------------------------------------------------------
+// Structure-of-arrays particle storage, one pool per emitter.
+//
+// Pooled particles are NOT entities: they have no Transform, springs,
+// GameObject or StateTag. Death is a swap-remove, so iteration order is
+// not stable across frames and indices must never be held onto.
+// Colours are packed RGBA in raylib's Color byte order (r first).
+//------------------------------------------------------------
+
+constexpr uint32_t kNoParticleCallback = std::numeric_limits<uint32_t>::max();
+constexpr float kParticleLivesForever = std::numeric_limits<float>::infinity();
+
+enum ParticlePoolFlags : uint8_t {
+    kParticleFlagColorLerp    = 1 << 0, // colour follows startColor -> endColor
+    kParticleFlagAutoAspect   = 1 << 1, // ELLIPSE_STRETCH elongates with speed
+    kParticleFlagFaceVelocity = 1 << 2, // LINE_FACING aligns with velocity
+    kParticleFlagScreenSpace  = 1 << 3, // draw in screen space instead of world
+};
+
+// Everything needed to spawn one pooled particle. Mirrors the resolved
+// (non-optional) state of particle::Particle after CreateParticle() defaults.
+struct ParticleSpawn {
+    float x = 0.f, y = 0.f;          // top-left, same convention as Transform
+    float w = 10.f, h = 10.f;
+    float vx = 0.f, vy = 0.f;
+    float rotation = 0.f;
+    float rotationSpeed = 0.f;
+    float scale = 1.f;
+    float age = 0.f;
+    float lifespan = kParticleLivesForever;
+    float gravity = 0.f;
+    float acceleration = 0.f;
+    uint32_t color = 0xFFFFFFFFu;
+    uint32_t startColor = 0xFFFFFFFFu;
+    uint32_t endColor = 0xFFFFFFFFu;
+    uint8_t renderType = 0;
+    uint8_t flags = 0;
+    int32_t z = 0;
+    uint32_t callbackSlot = kNoParticleCallback;
+};
+
+struct ParticlePool {
+    std::vector<float> posX, posY;
+    std::vector<float> velX, velY;
+    std::vector<float> width, height;
+    std::vector<float> rotation, rotationSpeed;
+    std::vector<float> scale;
+    std::vector<float> age, lifespan;
+    std::vector<float> gravity, acceleration;
+    std::vector<uint32_t> color, startColor, endColor;
+    std::vector<uint8_t> renderType;
+    std::vector<uint8_t> flags;
+    std::vector<int32_t> z;
+    std::vector<uint32_t> callbackSlot;
+
+    inline size_t size() const { return posX.size(); }
+    inline bool empty() const { return posX.empty(); }
+
+    inline void reserve(size_t n) {
+        posX.reserve(n); posY.reserve(n);
+        velX.reserve(n); velY.reserve(n);
+        width.reserve(n); height.reserve(n);
+        rotation.reserve(n); rotationSpeed.reserve(n);
+        scale.reserve(n);
+        age.reserve(n); lifespan.reserve(n);
+        gravity.reserve(n); acceleration.reserve(n);
+        color.reserve(n); startColor.reserve(n); endColor.reserve(n);
+        renderType.reserve(n); flags.reserve(n); z.reserve(n);
+        callbackSlot.reserve(n);
+    }
+
+    inline size_t push(const ParticleSpawn &s) {
+        const size_t idx = posX.size();
+        posX.push_back(s.x); posY.push_back(s.y);
+        velX.push_back(s.vx); velY.push_back(s.vy);
+        width.push_back(s.w); height.push_back(s.h);
+        rotation.push_back(s.rotation); rotationSpeed.push_back(s.rotationSpeed);
+        scale.push_back(s.scale);
+        age.push_back(s.age); lifespan.push_back(s.lifespan);
+        gravity.push_back(s.gravity); acceleration.push_back(s.acceleration);
+        color.push_back(s.color); startColor.push_back(s.startColor); endColor.push_back(s.endColor);
+        renderType.push_back(s.renderType); flags.push_back(s.flags); z.push_back(s.z);
+        callbackSlot.push_back(s.callbackSlot);
+        return idx;
+    }
+
+    // O(1) removal: the last particle is moved into slot i.
+    inline void swapRemove(size_t i) {
+        const size_t last = posX.size() - 1;
+        if (i != last) {
+            posX[i] = posX[last]; posY[i] = posY[last];
+            velX[i] = velX[last]; velY[i] = velY[last];
+            width[i] = width[last]; height[i] = height[last];
+            rotation[i] = rotation[last]; rotationSpeed[i] = rotationSpeed[last];
+            scale[i] = scale[last];
+            age[i] = age[last]; lifespan[i] = lifespan[last];
+            gravity[i] = gravity[last]; acceleration[i] = acceleration[last];
+            color[i] = color[last]; startColor[i] = startColor[last]; endColor[i] = endColor[last];
+            renderType[i] = renderType[last]; flags[i] = flags[last]; z[i] = z[last];
+            callbackSlot[i] = callbackSlot[last];
+        }
+        posX.pop_back(); posY.pop_back();
+        velX.pop_back(); velY.pop_back();
+        width.pop_back(); height.pop_back();
+        rotation.pop_back(); rotationSpeed.pop_back();
+        scale.pop_back();
+        age.pop_back(); lifespan.pop_back();
+        gravity.pop_back(); acceleration.pop_back();
+        color.pop_back(); startColor.pop_back(); endColor.pop_back();
+        renderType.pop_back(); flags.pop_back(); z.pop_back();
+        callbackSlot.pop_back();
+    }
+
+    inline void clear() {
+        posX.clear(); posY.clear();
+        velX.clear(); velY.clear();
+        width.clear(); height.clear();
+        rotation.clear(); rotationSpeed.clear();
+        scale.clear();
+        age.clear(); lifespan.clear();
+        gravity.clear(); acceleration.clear();
+        color.clear(); startColor.clear(); endColor.clear();
+        renderType.clear(); flags.clear(); z.clear();
+        callbackSlot.clear();
+    }
+};
+
+// Integration kernels. AVX2 is picked at runtime when the CPU supports it;
+// Scalar is the reference implementation and the fallback everywhere else.
+enum class ParticleKernel : uint8_t {
+    Scalar,
+    AVX2,
+};
+
+bool ParticleKernelAvailable(ParticleKernel kernel);
+ParticleKernel ActiveParticleKernel();
+
+// Advances age, velocity, position, rotation and colour for every particle.
+// Does not remove anything; call RemoveExpiredParticles() afterwards.
+void IntegrateParticlePool(ParticlePool &pool, float dt);
+
+// Same, forcing a kernel (falls back to Scalar if it is unavailable).
+void IntegrateParticlePool(ParticlePool &pool, float dt, ParticleKernel kernel);
+
+// Integrates particles [begin, end) only. Disjoint ranges of the same pool
+// may be integrated concurrently.
+void IntegrateParticleRange(ParticlePool &pool, float dt, size_t begin, size_t end,
+                            ParticleKernel kernel);
+
+// One slice of a pool for parallel simulation. A worker integrates the slice
+// and records, in ascending order, what the main thread has to do next:
+// particles that died and live particles that have an update callback.
+struct ParticleChunk {
+    size_t begin = 0, end = 0;
+    std::vector<uint32_t> expired;
+    std::vector<uint32_t> withCallback;
+};
+
+void SimulateParticleChunk(ParticlePool &pool, float dt, ParticleKernel kernel,
+                           ParticleChunk &chunk);
+
+// Swap-removes particle i, recording its callback slot (if any). Removing
+// several particles is only safe from the highest index down.
+void RemoveParticleAt(ParticlePool &pool, size_t i,
+                      std::vector<uint32_t> *releasedCallbackSlots = nullptr);
+
+// Swap-removes every particle whose age reached its lifespan. Callback slots
+// of removed particles are appended to `releasedCallbackSlots` (if non-null)
+// so the owner can recycle them. Returns the number removed.
+size_t RemoveExpiredParticles(ParticlePool &pool,
+                              std::vector<uint32_t> *releasedCallbackSlots = nullptr);
+
+} // namespace particle
@@ -232,16 +232,20 @@ void PhysicsWorld::Update(float deltaTime) {
 
 void PhysicsWorld::PostUpdate() {
   ZONE_SCOPED("PhysicsWorld::PostUpdate");
-  // Process deferred collision events
+  // Process deferred collision events. They can number in the thousands per
+  // step, so they go to the pull-based channels rather than EventBus listeners.
+  auto &channels = globals::getEventChannels();
+  auto &started = channels.channel<events::CollisionStarted>();
+  auto &ended = channels.channel<events::CollisionEnded>();
   for (const auto &[key, eventList] : collisionEnter) {
     for (const auto &event : eventList) {
       entt::entity entityA =
           static_cast<entt::entity>(reinterpret_cast<uintptr_t>(event.objectA));
       entt::entity entityB =
           static_cast<entt::entity>(reinterpret_cast<uintptr_t>(event.objectB));
-      globals::getEventBus().publish(events::CollisionStarted{
+      started.emplace(
           entityA, entityB,
-          Vector2{static_cast<float>(event.x1), static_cast<float>(event.y1)}});
+          Vector2{static_cast<float>(event.x1), static_cast<float>(event.y1)});
     }
   }
 
@@ -251,7 +255,7 @@ void PhysicsWorld::PostUpdate() {
           static_cast<entt::entity>(reinterpret_cast<uintptr_t>(event.objectA));
       entt::entity entityB =
           static_cast<entt::entity>(reinterpret_cast<uintptr_t>(event.objectB));
-      globals::getEventBus().publish(events::CollisionEnded{entityA, entityB});
+      ended.emplace(entityA, entityB);
     }
   }
 
@@ -262,7 +266,8 @@ void PhysicsWorld::PostUpdate() {
 
   // NOTE: Per-entity collision vectors were removed from ColliderComponent.
   // All collision data is handled via world-level maps (collisionEnter, collisionExit, etc.)
-  // and the C++ event bus (events::CollisionStarted, events::CollisionEnded).
+  // and the event channels for events::CollisionStarted / events::CollisionEnded
+  // (globals::getEventChannels(); Lua reads them through event_channels.reader).
 }
 
 void PhysicsWorld::SetGravity(float gravityX, float gravityY) {
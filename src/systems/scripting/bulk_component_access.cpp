@@ -0,0 +1,241 @@
+#include "bulk_component_access.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "binding_recorder.hpp"
+#include "meta_helper.hpp"
+
+namespace scripting::bulk
+{
+    namespace
+    {
+        // Fields are held by pointer so compiled queries stay valid when more are registered.
+        std::unordered_map<std::string, std::unique_ptr<BulkField>> &fields()
+        {
+            static std::unordered_map<std::string, std::unique_ptr<BulkField>> registered;
+            return registered;
+        }
+
+        size_t slot_of(BulkQuery &query, entt::id_type component)
+        {
+            auto it = std::find(query.required.begin(), query.required.end(), component);
+            if (it != query.required.end()) return static_cast<size_t>(it - query.required.begin());
+            query.required.push_back(component);
+            return query.required.size() - 1;
+        }
+
+        // Returns t[key], creating an empty table there if it holds anything else.
+        // Leaves it on the stack.
+        void push_column(lua_State *L, int t, const char *key)
+        {
+            lua_getfield(L, t, key);
+            if (lua_istable(L, -1)) return;
+            lua_pop(L, 1);
+            lua_newtable(L);
+            lua_pushvalue(L, -1);
+            lua_setfield(L, t, key);
+        }
+    }
+
+    void register_field(BulkField field)
+    {
+        auto &registered = fields();
+        auto it = registered.find(field.name);
+        if (it != registered.end())
+        {
+            *it->second = std::move(field); // keep the address compiled queries hold
+            return;
+        }
+        std::string name = field.name;
+        registered.emplace(std::move(name), std::make_unique<BulkField>(std::move(field)));
+    }
+
+    const BulkField *find_field(std::string_view name)
+    {
+        const auto &registered = fields();
+        auto it = registered.find(std::string(name));
+        return it == registered.end() ? nullptr : it->second.get();
+    }
+
+    BulkQuery make_query(const std::vector<std::string> &names, const std::vector<entt::id_type> &with)
+    {
+        BulkQuery query;
+        for (const std::string &name : names)
+        {
+            const BulkField *field = find_field(name);
+            if (!field) throw std::invalid_argument("bulk: unknown field '" + name + "'");
+            query.fields.push_back(field);
+            query.slot.push_back(slot_of(query, field->component));
+        }
+        for (entt::id_type id : with) slot_of(query, id);
+        return query;
+    }
+
+    size_t read(entt::registry &registry, const BulkQuery &query, std::vector<entt::entity> &entities,
+                std::vector<std::vector<double>> &columns)
+    {
+        entities.clear();
+        columns.resize(query.fields.size());
+        for (auto &column : columns) column.clear();
+
+        for_each_match(registry, query, [&](entt::entity entity, const std::vector<void *> &components) {
+            entities.push_back(entity);
+            for (size_t f = 0; f < query.fields.size(); ++f)
+                columns[f].push_back(query.fields[f]->get(components[query.slot[f]]));
+        });
+        return entities.size();
+    }
+
+    size_t write(entt::registry &registry, const BulkQuery &query, const std::vector<entt::entity> &entities,
+                 const std::vector<std::vector<double>> &columns)
+    {
+        std::vector<entt::sparse_set *> storages;
+        for (entt::id_type id : query.required)
+        {
+            entt::sparse_set *storage = registry.storage(id);
+            if (!storage) return 0;
+            storages.push_back(storage);
+        }
+
+        size_t written = 0;
+        for (size_t i = 0; i < entities.size(); ++i)
+        {
+            const entt::entity entity = entities[i];
+            const bool matches = std::all_of(storages.begin(), storages.end(),
+                                             [&](const entt::sparse_set *s) { return s->contains(entity); });
+            if (!matches) continue;
+
+            for (size_t f = 0; f < query.fields.size(); ++f)
+            {
+                const BulkField &field = *query.fields[f];
+                if (field.set && i < columns[f].size())
+                    field.set(storages[query.slot[f]]->value(entity), columns[f][i]);
+            }
+            ++written;
+        }
+        return written;
+    }
+
+    void exposeToLua(sol::state &lua)
+    {
+        auto &rec = BindingRecorder::instance();
+
+        lua.new_usertype<BulkQuery>("BulkQuery", sol::no_constructor,
+            "field_count", [](const BulkQuery &q) { return q.fields.size(); });
+        rec.add_type("BulkQuery").doc = "A compiled bulk.query(): the fields to move and the components entities must have.";
+        rec.record_property("BulkQuery", {"field_count", "---@param self BulkQuery\n---@return integer", "Number of fields the query moves."});
+
+        rec.bind_function(lua, {"bulk"}, "query",
+            [](sol::table fieldNames, sol::optional<sol::table> with) {
+                std::vector<std::string> names;
+                for (size_t i = 1; i <= fieldNames.size(); ++i) names.push_back(fieldNames.get<std::string>(i));
+                std::vector<entt::id_type> ids;
+                if (with)
+                {
+                    for (const auto &[key, value] : *with) ids.push_back(scripting::deduce_type(value));
+                }
+                return make_query(names, ids);
+            },
+            "---@param fields string[] # Field names, see bulk.fields().\n"
+            "---@param with? (table|integer)[] # Extra components matching entities must have.\n"
+            "---@return BulkQuery",
+            "Compiles a bulk query once, for use with bulk.read and bulk.write every frame. Errors on an unknown field.");
+
+        // Fills the columns through the C API: one boundary crossing for the whole batch.
+        rec.bind_function(lua, {"bulk"}, "read",
+            [](entt::registry &registry, const BulkQuery &query, sol::table out) {
+                lua_State *L = out.lua_state();
+                luaL_checkstack(L, static_cast<int>(query.fields.size()) + 4, "bulk.read: too many fields");
+                out.push();
+                const int t = lua_gettop(L);
+
+                push_column(L, t, "entities");
+                const int entitiesIndex = lua_gettop(L);
+                for (const BulkField *field : query.fields) push_column(L, t, field->name.c_str());
+
+                int n = 0;
+                for_each_match(registry, query, [&](entt::entity entity, const std::vector<void *> &components) {
+                    ++n;
+                    lua_pushinteger(L, static_cast<lua_Integer>(entt::to_integral(entity)));
+                    lua_rawseti(L, entitiesIndex, n);
+                    for (size_t f = 0; f < query.fields.size(); ++f)
+                    {
+                        lua_pushnumber(L, query.fields[f]->get(components[query.slot[f]]));
+                        lua_rawseti(L, entitiesIndex + 1 + static_cast<int>(f), n);
+                    }
+                });
+
+                lua_settop(L, t - 1);
+                return n;
+            },
+            "---@param registry registry\n"
+            "---@param query BulkQuery\n"
+            "---@param out table # Reused between calls; gets out.entities and one array per field.\n"
+            "---@return integer # Number of matching entities (rows 1..n).",
+            "Reads the query's fields of every matching entity into column arrays of `out`.");
+
+        rec.bind_function(lua, {"bulk"}, "write",
+            [](entt::registry &registry, const BulkQuery &query, sol::table out, sol::optional<int> count) {
+                lua_State *L = out.lua_state();
+                luaL_checkstack(L, static_cast<int>(query.fields.size()) + 4, "bulk.write: too many fields");
+                out.push();
+                const int t = lua_gettop(L);
+
+                push_column(L, t, "entities");
+                const int entitiesIndex = lua_gettop(L);
+                const int n = count ? *count : static_cast<int>(lua_rawlen(L, entitiesIndex));
+                for (const BulkField *field : query.fields) push_column(L, t, field->name.c_str());
+
+                std::vector<entt::entity> entities;
+                std::vector<std::vector<double>> columns(query.fields.size());
+                entities.reserve(static_cast<size_t>(std::max(n, 0)));
+                for (int i = 1; i <= n; ++i)
+                {
+                    lua_rawgeti(L, entitiesIndex, i);
+                    entities.push_back(static_cast<entt::entity>(lua_tointeger(L, -1)));
+                    lua_pop(L, 1);
+                }
+                for (size_t f = 0; f < query.fields.size(); ++f)
+                {
+                    if (!query.fields[f]->set) continue;
+                    const int column = entitiesIndex + 1 + static_cast<int>(f);
+                    columns[f].resize(entities.size());
+                    for (int i = 1; i <= n; ++i)
+                    {
+                        lua_rawgeti(L, column, i);
+                        columns[f][static_cast<size_t>(i - 1)] = lua_tonumber(L, -1);
+                        lua_pop(L, 1);
+                    }
+                }
+                lua_settop(L, t - 1);
+
+                return write(registry, query, entities, columns);
+            },
+            "---@param registry registry\n"
+            "---@param query BulkQuery\n"
+            "---@param out table # As filled by bulk.read.\n"
+            "---@param count? integer # Rows to write; defaults to #out.entities.\n"
+            "---@return integer # Number of entities written.",
+            "Writes the query's writable fields back from the column arrays of `out`. Read-only fields are ignored.");
+
+        rec.bind_function(lua, {"bulk"}, "fields",
+            [](sol::this_state s) {
+                sol::state_view view(s);
+                sol::table names = view.create_table();
+                int i = 0;
+                for (const auto &[name, field] : fields())
+                {
+                    sol::table entry = view.create_table();
+                    entry["name"] = name;
+                    entry["writable"] = static_cast<bool>(field->set);
+                    names[++i] = entry;
+                }
+                return names;
+            },
+            "---@return {name: string, writable: boolean}[]",
+            "Lists the registered bulk fields.");
+    }
+}
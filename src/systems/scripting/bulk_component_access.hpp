@@ -0,0 +1,119 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "entt/entity/registry.hpp"
+#include "sol/sol.hpp"
+
+// Bulk component access for Lua.
+//
+// Reading transforms one entity at a time costs a registry lookup and a C
+// boundary crossing per field. Instead, scripts compile a query once (which
+// numeric fields, plus any extra components entities must have), then move
+// the fields of every matching entity in one call:
+//
+//   local q = bulk.query({ "actual_x", "actual_y" }, { SomeTag })
+//   local out = {}                      -- reused every frame, no garbage
+//   local n = bulk.read(registry, q, out)
+//   for i = 1, n do out.actual_x[i] = out.actual_x[i] + 1 end
+//   bulk.write(registry, q, out, n)
+//
+// out.entities[i] is the i-th entity, out.<field>[i] its value. Entries past
+// n are left over from earlier reads; use n, not #out.entities.
+namespace scripting::bulk
+{
+    // A numeric field of one component type. get/set receive the component
+    // already fetched from its storage; set is empty for read-only fields.
+    struct BulkField
+    {
+        std::string name;
+        entt::id_type component = 0; // storage id, entt::type_hash of the component
+        std::function<double(void *)> get;
+        std::function<void(void *, double)> set;
+    };
+
+    // Registers a field. A later registration under the same name replaces it.
+    void register_field(BulkField field);
+
+    template <typename Component, typename Get>
+    void register_field(std::string name, Get get)
+    {
+        register_field(BulkField{std::move(name), entt::type_hash<Component>::value(),
+                                 [get](void *c) { return static_cast<double>(get(*static_cast<Component *>(c))); },
+                                 {}});
+    }
+
+    template <typename Component, typename Get, typename Set>
+    void register_field(std::string name, Get get, Set set)
+    {
+        register_field(BulkField{std::move(name), entt::type_hash<Component>::value(),
+                                 [get](void *c) { return static_cast<double>(get(*static_cast<Component *>(c))); },
+                                 [set](void *c, double v) { set(*static_cast<Component *>(c), v); }});
+    }
+
+    [[nodiscard]] const BulkField *find_field(std::string_view name);
+
+    // A compiled query: the fields to move, and every storage an entity must be in.
+    struct BulkQuery
+    {
+        std::vector<const BulkField *> fields;
+        std::vector<entt::id_type> required; // each field's component, then the extra ones; no duplicates
+        std::vector<size_t> slot;            // fields[f] lives in required[slot[f]]
+    };
+
+    // Throws std::invalid_argument for an unknown field name.
+    [[nodiscard]] BulkQuery make_query(const std::vector<std::string> &fields, const std::vector<entt::id_type> &with = {});
+
+    // Calls fn(entity, components) for every entity matching the query, where
+    // components[k] is the entity's instance of query.required[k].
+    template <typename Fn>
+    void for_each_match(entt::registry &registry, const BulkQuery &query, Fn &&fn);
+
+    // Entities in no particular order (that of the smallest storage). Fills
+    // `entities` and one column per field, row i belonging to entities[i].
+    size_t read(entt::registry &registry, const BulkQuery &query, std::vector<entt::entity> &entities,
+                std::vector<std::vector<double>> &columns);
+
+    // Writes columns[f][i] to entities[i]'s field f, for the writable fields.
+    // Entities that are gone or no longer match are skipped. Returns how many were written.
+    size_t write(entt::registry &registry, const BulkQuery &query, const std::vector<entt::entity> &entities,
+                 const std::vector<std::vector<double>> &columns);
+
+    // Lua table `bulk`: query, read, write, fields.
+    void exposeToLua(sol::state &lua);
+
+    // ------------------------------------------------------------
+
+    template <typename Fn>
+    void for_each_match(entt::registry &registry, const BulkQuery &query, Fn &&fn)
+    {
+        std::vector<entt::sparse_set *> storages;
+        storages.reserve(query.required.size());
+        for (entt::id_type id : query.required)
+        {
+            entt::sparse_set *storage = registry.storage(id);
+            if (!storage || storage->empty()) return;
+            storages.push_back(storage);
+        }
+        if (storages.empty()) return;
+
+        const entt::sparse_set *smallest = storages.front();
+        for (const entt::sparse_set *storage : storages)
+            if (storage->size() < smallest->size()) smallest = storage;
+
+        std::vector<void *> components(storages.size());
+        for (const entt::entity entity : *smallest)
+        {
+            bool matches = true;
+            for (size_t k = 0; k < storages.size() && matches; ++k)
+            {
+                matches = storages[k]->contains(entity);
+                if (matches) components[k] = storages[k]->value(entity);
+            }
+            if (matches) fn(entity, components);
+        }
+    }
+}
@@ -0,0 +1,368 @@
+#include "bytecode_cache.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <system_error>
+
+#include "spdlog/spdlog.h"
+
+namespace fs = std::filesystem;
+
+namespace scripting::bytecode_cache
+{
+    namespace
+    {
+        constexpr char kMagic[4] = {'C', 'H', 'B', 'C'};
+        constexpr uint32_t kFormatVersion = 2;
+
+        struct Config
+        {
+            fs::path root; // absolute, normalized, no trailing separator
+            fs::path dir;
+        };
+
+        Config &config()
+        {
+            static Config c;
+            return c;
+        }
+
+        Stats &mutable_stats()
+        {
+            static Stats s;
+            return s;
+        }
+
+        fs::path normalized(const fs::path &path)
+        {
+            std::error_code ec;
+            fs::path abs = fs::absolute(path, ec);
+            if (ec) abs = path;
+            abs = abs.lexically_normal();
+            if (abs.has_relative_path() && abs.filename().empty()) abs = abs.parent_path();
+            return abs;
+        }
+
+        // Relative to the scripts root when inside it, so baked entries survive relocation.
+        std::string cache_key(const fs::path &root, const std::string &path)
+        {
+            const fs::path abs = normalized(path);
+            if (!root.empty())
+            {
+                const fs::path rel = abs.lexically_relative(root);
+                if (!rel.empty() && *rel.begin() != "..") return rel.generic_string();
+            }
+            return abs.generic_string();
+        }
+
+        fs::path entry_path(const Config &cfg, const std::string &path)
+        {
+            char name[24];
+            std::snprintf(name, sizeof(name), "%016llx.luac",
+                          static_cast<unsigned long long>(hash_bytes(cache_key(cfg.root, path))));
+            return cfg.dir / name;
+        }
+
+        bool read_file(const fs::path &path, std::string &out)
+        {
+            std::ifstream in(path, std::ios::binary);
+            if (!in) return false;
+            out.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+            return !in.bad();
+        }
+
+        // luaL_loadfile skips a UTF-8 BOM and a leading '#' line; so must we. The
+        // newline is kept so line numbers in errors stay right.
+        std::string_view chunk_text(const std::string &source)
+        {
+            std::string_view text = source;
+            if (text.substr(0, 3) == "\xEF\xBB\xBF") text.remove_prefix(3);
+            if (!text.empty() && text.front() == '#')
+            {
+                const size_t eol = text.find('\n');
+                text.remove_prefix(eol == std::string_view::npos ? text.size() : eol);
+            }
+            return text;
+        }
+
+        template <typename T>
+        void append_pod(std::string &out, const T &value)
+        {
+            out.append(reinterpret_cast<const char *>(&value), sizeof(T));
+        }
+
+        template <typename T>
+        bool take_pod(std::string_view &in, T &value)
+        {
+            if (in.size() < sizeof(T)) return false;
+            std::memcpy(&value, in.data(), sizeof(T));
+            in.remove_prefix(sizeof(T));
+            return true;
+        }
+
+        // Returns the bytecode of a valid entry for this source, or an empty view.
+        // The chunk name is part of the check: a loaded binary chunk keeps the
+        // name it was compiled under, whatever name it is loaded with, so an
+        // entry baked under another path would report that path in errors
+        // and debug.getinfo.
+        std::string_view parse_entry(std::string_view entry, uint64_t sourceHash, const std::string &flavour,
+                                     const std::string &chunkname)
+        {
+            if (entry.size() < sizeof(kMagic) || std::memcmp(entry.data(), kMagic, sizeof(kMagic)) != 0) return {};
+            entry.remove_prefix(sizeof(kMagic));
+
+            uint32_t version = 0, flavourSize = 0;
+            uint64_t hash = 0;
+            if (!take_pod(entry, version) || version != kFormatVersion) return {};
+            if (!take_pod(entry, hash) || hash != sourceHash) return {};
+            if (!take_pod(entry, flavourSize) || entry.size() < flavourSize) return {};
+            if (entry.substr(0, flavourSize) != flavour) return {};
+            entry.remove_prefix(flavourSize);
+
+            uint32_t nameSize = 0;
+            if (!take_pod(entry, nameSize) || entry.size() < nameSize) return {};
+            if (entry.substr(0, nameSize) != chunkname) return {};
+            entry.remove_prefix(nameSize);
+            return entry;
+        }
+
+        int dump_writer(lua_State *, const void *p, size_t size, void *ud)
+        {
+            static_cast<std::string *>(ud)->append(static_cast<const char *>(p), size);
+            return 0;
+        }
+
+        // The compiled chunk on top of the stack -> cache entry. Written to a
+        // temporary and renamed, so a crash never leaves a half-written entry.
+        bool store_entry(lua_State *L, const fs::path &entry, uint64_t sourceHash, const std::string &flavour,
+                         const std::string &chunkname)
+        {
+            std::string data(kMagic, sizeof(kMagic));
+            append_pod(data, kFormatVersion);
+            append_pod(data, sourceHash);
+            append_pod(data, static_cast<uint32_t>(flavour.size()));
+            data += flavour;
+            append_pod(data, static_cast<uint32_t>(chunkname.size()));
+            data += chunkname;
+            if (lua_dump(L, dump_writer, &data, 0) != 0) return false; // sol's compat layer covers LuaJIT's 3-arg form
+
+            std::error_code ec;
+            fs::create_directories(entry.parent_path(), ec);
+            fs::path tmp = entry;
+            tmp += ".tmp";
+            {
+                std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+                if (!out || !out.write(data.data(), static_cast<std::streamsize>(data.size()))) return false;
+            }
+            fs::rename(tmp, entry, ec);
+            if (ec) fs::remove(tmp, ec);
+            return !ec;
+        }
+
+        // `chunkname` is what errors and debug.getinfo report for the chunk.
+        int load_with(lua_State *L, const std::string &path, const std::string &chunkname, const Config &cfg,
+                      Stats &stats)
+        {
+            std::string source;
+            if (!read_file(path, source))
+            {
+                lua_pushfstring(L, "cannot open %s", path.c_str());
+                return LUA_ERRFILE;
+            }
+            const std::string_view text = chunk_text(source);
+            if (cfg.dir.empty()) return luaL_loadbuffer(L, text.data(), text.size(), chunkname.c_str());
+
+            const uint64_t sourceHash = hash_bytes(text);
+            const std::string flavour = vm_flavour();
+            const fs::path entry = entry_path(cfg, path);
+
+            std::string cached;
+            const bool hadEntry = read_file(entry, cached);
+            if (hadEntry)
+            {
+                const std::string_view bytecode = parse_entry(cached, sourceHash, flavour, chunkname);
+                if (!bytecode.empty() &&
+                    luaL_loadbuffer(L, bytecode.data(), bytecode.size(), chunkname.c_str()) == 0)
+                {
+                    ++stats.hits;
+                    return 0;
+                }
+                if (!bytecode.empty()) lua_pop(L, 1); // the VM rejected it; recompile
+                ++stats.stale;
+            }
+
+            const int status = luaL_loadbuffer(L, text.data(), text.size(), chunkname.c_str());
+            if (status != 0) return status;
+            ++stats.compiled;
+            if (!store_entry(L, entry, sourceHash, flavour, chunkname))
+                SPDLOG_WARN("bytecode_cache: could not write {} for {}", entry.string(), path);
+            return 0;
+        }
+
+        // package.path lookup, as package.searchpath does (LuaJIT and 5.4 alike).
+        std::string search_path(const std::string &name, const std::string &templates)
+        {
+            std::string file = name;
+            for (char &c : file)
+                if (c == '.') c = '/';
+
+            size_t start = 0;
+            while (start <= templates.size())
+            {
+                size_t end = templates.find(';', start);
+                if (end == std::string::npos) end = templates.size();
+                std::string candidate = templates.substr(start, end - start);
+                start = end + 1;
+                if (candidate.empty()) continue;
+
+                for (size_t q = candidate.find('?'); q != std::string::npos; q = candidate.find('?', q + file.size()))
+                    candidate.replace(q, 1, file);
+                if (FILE *f = std::fopen(candidate.c_str(), "r"))
+                {
+                    std::fclose(f);
+                    return candidate;
+                }
+            }
+            return {};
+        }
+
+        int cached_searcher(lua_State *L)
+        {
+            const char *name = luaL_checkstring(L, 1);
+            {
+                lua_getglobal(L, "package");
+                lua_getfield(L, -1, "path");
+                const char *templates = lua_tostring(L, -1);
+                const std::string path = templates ? search_path(name, templates) : std::string{};
+                lua_pop(L, 2);
+                if (path.empty()) return 0; // let the next searcher report where it looked
+
+                if (load_with(L, path, "@" + path, config(), mutable_stats()) == 0)
+                {
+                    lua_pushstring(L, path.c_str());
+                    return 2;
+                }
+                lua_pushfstring(L, "error loading module '%s' from file '%s':\n\t%s", name, path.c_str(),
+                                lua_tostring(L, -1));
+            }
+            return lua_error(L); // outside the scope above: plain Lua unwinds with longjmp
+        }
+    }
+
+    void configure(const fs::path &scriptsRoot, const fs::path &cacheDir)
+    {
+        Config &cfg = config();
+        cfg.root = scriptsRoot.empty() ? fs::path{} : normalized(scriptsRoot);
+        cfg.dir = cacheDir;
+        if (cfg.dir.empty()) return;
+
+        std::error_code ec;
+        fs::create_directories(cfg.dir, ec);
+        if (ec) SPDLOG_WARN("bytecode_cache: cannot create {} ({}); entries will not be stored", cfg.dir.string(), ec.message());
+    }
+
+    const fs::path &cache_directory() { return config().dir; }
+
+    std::string vm_flavour()
+    {
+#if defined(LUAJIT_VERSION)
+        std::string flavour = LUAJIT_VERSION;
+#else
+        std::string flavour = LUA_RELEASE;
+#endif
+        return flavour + "/p" + std::to_string(sizeof(void *) * 8);
+    }
+
+    uint64_t hash_bytes(std::string_view bytes)
+    {
+        uint64_t hash = 14695981039346656037ull;
+        for (unsigned char c : bytes)
+        {
+            hash ^= c;
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    int load_file(lua_State *L, const std::string &path)
+    {
+        return load_with(L, path, "@" + path, config(), mutable_stats());
+    }
+
+    sol::protected_function_result script_file(sol::state_view lua, const std::string &path)
+    {
+        lua_State *L = lua.lua_state();
+        if (load_file(L, path) != 0)
+        {
+            std::string message = lua_tostring(L, -1) ? lua_tostring(L, -1) : "unknown error";
+            lua_pop(L, 1);
+            throw sol::error(std::move(message));
+        }
+        sol::protected_function chunk(L, -1);
+        lua_pop(L, 1);
+
+        sol::protected_function_result result = chunk();
+        if (!result.valid())
+        {
+            sol::error err = result;
+            throw err;
+        }
+        return result;
+    }
+
+    void install_searcher(sol::state_view lua)
+    {
+        sol::table package = lua["package"];
+        // 5.2+ calls it searchers; LuaJIT keeps 5.1's loaders.
+        sol::optional<sol::table> searchers = package["searchers"];
+        if (!searchers) searchers = package.get<sol::optional<sol::table>>("loaders");
+        if (!searchers)
+        {
+            SPDLOG_WARN("bytecode_cache: package.searchers not found; scripts load from source");
+            return;
+        }
+
+        // Right after package.preload, ahead of the source searcher.
+        sol::table list = *searchers;
+        const size_t n = list.size();
+        for (size_t i = n; i >= 2; --i) list[i + 1] = list.get<sol::object>(i);
+        list[2] = &cached_searcher;
+    }
+
+    size_t prebake(const fs::path &scriptsRoot, const fs::path &cacheDir, const std::string &gameScriptsRoot,
+                   std::vector<std::string> *errors)
+    {
+        const Config cfg{normalized(scriptsRoot), cacheDir};
+        std::string namePrefix = gameScriptsRoot.empty() ? scriptsRoot.generic_string() : gameScriptsRoot;
+        if (!namePrefix.empty() && namePrefix.back() != '/') namePrefix += '/';
+        Stats stats;
+        sol::state lua; // compiling needs no libraries
+        lua_State *L = lua.lua_state();
+
+        std::error_code ec;
+        size_t baked = 0;
+        for (fs::recursive_directory_iterator it(scriptsRoot, ec), end; !ec && it != end; it.increment(ec))
+        {
+            if (!it->is_regular_file() || it->path().extension() != ".lua") continue;
+            const std::string path = it->path().generic_string();
+            const std::string chunkname = "@" + namePrefix + it->path().lexically_relative(scriptsRoot).generic_string();
+            if (load_with(L, path, chunkname, cfg, stats) != 0)
+            {
+                if (errors) errors->push_back(lua_tostring(L, -1) ? lua_tostring(L, -1) : path);
+            }
+            else
+            {
+                ++baked;
+            }
+            lua_settop(L, 0);
+        }
+        if (ec && errors) errors->push_back(scriptsRoot.string() + ": " + ec.message());
+        return baked;
+    }
+
+    const Stats &stats() { return mutable_stats(); }
+
+    void reset_stats() { mutable_stats() = {}; }
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "sol/sol.hpp"
+
+// Precompiled bytecode for the script tree.
+//
+// Parsing ~500 script files from source dominates Lua startup and every
+// hot reload. load_file() keeps the compiled chunk of each script in a cache
+// directory and reuses it while the source is unchanged:
+//
+//   <cache dir>/<hash of path relative to scripts root>.luac
+//     header: magic, format version, source hash, VM flavour, chunk name
+//     body:   lua_dump() of the compiled chunk, debug info kept
+//
+// Entries are never trusted blindly: a different source hash, VM flavour
+// (Lua 5.4 vs LuaJIT, 32 vs 64 bit) or chunk name, a truncated file, or
+// bytecode the VM rejects all fall back to compiling the source and
+// rewriting the entry. The chunk name is checked because the dumped chunk
+// carries the name it was compiled under and keeps it when loaded.
+// Shipping builds pre-bake the directory with the bake_lua_bytecode tool,
+// naming each chunk the way the game will load it.
+namespace scripting::bytecode_cache
+{
+    struct Stats
+    {
+        size_t hits = 0;     // loaded from a valid entry
+        size_t compiled = 0; // no usable entry; compiled from source (and stored)
+        size_t stale = 0;    // of the compiled ones, had an entry that was out of date
+    };
+
+    // Scripts under scriptsRoot are keyed by their path relative to it, so a
+    // baked cache stays valid wherever the game is installed. An empty cacheDir
+    // disables caching: load_file() then just compiles from source.
+    void configure(const std::filesystem::path &scriptsRoot, const std::filesystem::path &cacheDir);
+    [[nodiscard]] const std::filesystem::path &cache_directory();
+
+    // Identifies the bytecode format; entries from another flavour are ignored.
+    [[nodiscard]] std::string vm_flavour();
+
+    // 64-bit FNV-1a.
+    [[nodiscard]] uint64_t hash_bytes(std::string_view bytes);
+
+    // Like luaL_loadfile: pushes the compiled chunk (status 0) or an error
+    // message (non-zero status). Chunk names are "@path", as with luaL_loadfile.
+    int load_file(lua_State *L, const std::string &path);
+
+    // load_file + call, throwing sol::error like sol::state::script_file.
+    sol::protected_function_result script_file(sol::state_view lua, const std::string &path);
+
+    // Adds a searcher that resolves modules on package.path and loads them
+    // through load_file, ahead of Lua's own source searcher.
+    void install_searcher(sol::state_view lua);
+
+    // Compiles every .lua file under scriptsRoot into cacheDir. Chunks are
+    // named "@" + gameScriptsRoot + path relative to scriptsRoot, which has to
+    // match the path the game loads them by (its ASSETS_PATH "scripts/") for
+    // the entries to be used; empty means scriptsRoot itself. Returns the
+    // number of files baked; files that fail to compile are listed in errors.
+    size_t prebake(const std::filesystem::path &scriptsRoot, const std::filesystem::path &cacheDir,
+                   const std::string &gameScriptsRoot, std::vector<std::string> *errors = nullptr);
+
+    [[nodiscard]] const Stats &stats();
+    void reset_stats();
+}
@@ -0,0 +1,256 @@
+#include "ffi_component_views.hpp"
+
+#include <type_traits>
+#include <vector>
+
+#include "binding_recorder.hpp"
+#include "components/graphics.hpp"
+#include "systems/physics/physics_world.hpp"
+#include "systems/spring/spring_pool.hpp"
+#include "systems/transform/transform.hpp"
+#include "util/common_headers.hpp"
+
+namespace scripting::ffi_views
+{
+    static_assert(sizeof(entt::entity) == sizeof(uint32_t), "views pass entities as uint32_t");
+    static_assert(sizeof(Color) == 4 && std::is_standard_layout_v<Color>, "ecs_ffi_color mirrors raylib's Color");
+    static_assert(std::is_same_v<cpFloat, double>, "ecs_ffi_body assumes double-precision chipmunk");
+    static_assert(std::is_standard_layout_v<TransformView> && std::is_standard_layout_v<SpriteView> &&
+                  std::is_standard_layout_v<BodyState> && std::is_standard_layout_v<Api>);
+
+    namespace
+    {
+        constexpr const char *kCdef = R"(
+typedef struct { uint8_t r, g, b, a; } ecs_ffi_color;
+typedef struct { float *value; float *target; float *velocity; } ecs_ffi_spring;
+typedef struct { uint32_t entity; uint32_t epoch; ecs_ffi_spring x, y, w, h, r, s; } ecs_ffi_transform;
+typedef struct { uint32_t entity; uint32_t epoch; ecs_ffi_color *fg; ecs_ffi_color *bg; } ecs_ffi_sprite;
+typedef struct { double x, y, vx, vy, angle, angular_velocity; } ecs_ffi_body;
+typedef struct {
+  uint32_t (*epoch)(void);
+  bool (*bind_transform)(ecs_ffi_transform *out, uint32_t entity);
+  bool (*bind_sprite)(ecs_ffi_sprite *out, uint32_t entity);
+  bool (*read_body)(ecs_ffi_body *out, uint32_t entity);
+  bool (*write_body)(const ecs_ffi_body *in, uint32_t entity);
+} ecs_ffi_api;
+)";
+
+        entt::registry *g_registry = nullptr;
+        uint32_t g_removals = 1;           // starts at 1 so epoch() is never 0
+        std::vector<entt::entity> g_bound; // transforms bound since the last flush()
+
+        void on_removal(entt::registry &, entt::entity) { ++g_removals; }
+
+        template <typename Component>
+        Component *find(uint32_t id)
+        {
+            const auto entity = static_cast<entt::entity>(id);
+            if (!g_registry || !g_registry->valid(entity)) return nullptr; // checks the version too
+            return g_registry->try_get<Component>(entity);
+        }
+
+        SpringLane lane(spring::SpringRef ref) { return SpringLane{&ref.value, &ref.targetValue, &ref.velocity}; }
+
+        uint32_t api_epoch() { return epoch(); }
+
+        bool bind_transform(TransformView *out, uint32_t id)
+        {
+            using transform::TransformSpring;
+            auto *t = find<transform::Transform>(id);
+            if (!t)
+            {
+                *out = TransformView{};
+                return false;
+            }
+            out->entity = id;
+            out->epoch = epoch();
+            out->x = lane(t->getSpring(TransformSpring::X));
+            out->y = lane(t->getSpring(TransformSpring::Y));
+            out->w = lane(t->getSpring(TransformSpring::W));
+            out->h = lane(t->getSpring(TransformSpring::H));
+            out->r = lane(t->getSpring(TransformSpring::R));
+            out->s = lane(t->getSpring(TransformSpring::S));
+            t->lastCacheFrame = -1;
+            g_bound.push_back(static_cast<entt::entity>(id));
+            return true;
+        }
+
+        bool bind_sprite(SpriteView *out, uint32_t id)
+        {
+            auto *sprite = find<SpriteComponentASCII>(id);
+            if (!sprite)
+            {
+                *out = SpriteView{};
+                return false;
+            }
+            out->entity = id;
+            out->epoch = epoch();
+            out->fg = &sprite->fgColor;
+            out->bg = &sprite->bgColor;
+            return true;
+        }
+
+        cpBody *body_of(uint32_t id)
+        {
+            auto *collider = find<physics::ColliderComponent>(id);
+            return collider ? collider->body.get() : nullptr;
+        }
+
+        bool read_body(BodyState *out, uint32_t id)
+        {
+            cpBody *body = body_of(id);
+            if (!body)
+            {
+                *out = BodyState{};
+                return false;
+            }
+            const cpVect p = cpBodyGetPosition(body);
+            const cpVect v = cpBodyGetVelocity(body);
+            *out = BodyState{p.x, p.y, v.x, v.y, cpBodyGetAngle(body), cpBodyGetAngularVelocity(body)};
+            return true;
+        }
+
+        bool write_body(const BodyState *in, uint32_t id)
+        {
+            cpBody *body = body_of(id);
+            if (!body) return false;
+            cpBodySetPosition(body, cpv(in->x, in->y));
+            cpBodySetVelocity(body, cpv(in->vx, in->vy));
+            cpBodySetAngle(body, in->angle);
+            cpBodySetAngularVelocity(body, in->angular_velocity);
+            return true;
+        }
+
+        const Api g_api{&api_epoch, &bind_transform, &bind_sprite, &read_body, &write_body};
+
+#if defined(SOL_LUAJIT) && SOL_LUAJIT
+        // Runs once per state with (cdef, api) and returns the ecs_ffi table.
+        constexpr const char *kModule = R"(
+local ffi = require("ffi")
+local cdef, api_ptr = ...
+if not pcall(ffi.typeof, "ecs_ffi_api") then ffi.cdef(cdef) end
+local api = ffi.cast("const ecs_ffi_api *", api_ptr)
+local transform_t = ffi.typeof("ecs_ffi_transform")
+local sprite_t = ffi.typeof("ecs_ffi_sprite")
+local body_t = ffi.typeof("ecs_ffi_body")
+
+local M = {}
+function M.transform(entity, view)
+  view = view or transform_t()
+  if api.bind_transform(view, entity) then return view end
+  return nil
+end
+function M.sprite(entity, view)
+  view = view or sprite_t()
+  if api.bind_sprite(view, entity) then return view end
+  return nil
+end
+function M.body(entity, out)
+  out = out or body_t()
+  if api.read_body(out, entity) then return out end
+  return nil
+end
+function M.set_body(entity, body)
+  return api.write_body(body, entity)
+end
+function M.valid(view)
+  return view ~= nil and view.epoch == api.epoch()
+end
+function M.epoch()
+  return api.epoch()
+end
+return M
+)";
+#endif
+    } // namespace
+
+    const char *cdef() { return kCdef; }
+
+    const Api &api() { return g_api; }
+
+    void install(entt::registry &registry)
+    {
+        if (g_registry && g_registry != &registry) uninstall();
+        g_registry = &registry;
+        // connect() replaces an earlier connection of the same function
+        registry.on_destroy<transform::Transform>().connect<&on_removal>();
+        registry.on_destroy<SpriteComponentASCII>().connect<&on_removal>();
+    }
+
+    void uninstall()
+    {
+        if (g_registry)
+        {
+            g_registry->on_destroy<transform::Transform>().disconnect<&on_removal>();
+            g_registry->on_destroy<SpriteComponentASCII>().disconnect<&on_removal>();
+        }
+        g_registry = nullptr;
+        g_bound.clear();
+        ++g_removals;
+    }
+
+    uint32_t epoch()
+    {
+        return g_removals + spring::GetSpringPool().releases();
+    }
+
+    void flush()
+    {
+        if (g_registry)
+        {
+            for (entt::entity entity : g_bound)
+            {
+                if (!g_registry->valid(entity)) continue;
+                if (auto *t = g_registry->try_get<transform::Transform>(entity)) t->lastCacheFrame = -1;
+            }
+        }
+        g_bound.clear();
+    }
+
+    void exposeToLua(sol::state &lua)
+    {
+#if defined(SOL_LUAJIT) && SOL_LUAJIT
+        auto &rec = BindingRecorder::instance();
+
+        sol::load_result chunk = lua.load(kModule, "=ecs_ffi");
+        if (!chunk.valid())
+        {
+            const sol::error err = chunk;
+            SPDLOG_WARN("[ecs_ffi] Not available: {}", err.what());
+            return;
+        }
+        sol::protected_function init = chunk;
+        sol::protected_function_result module = init(kCdef, sol::lightuserdata_value(const_cast<Api *>(&g_api)));
+        if (!module.valid())
+        {
+            const sol::error err = module;
+            SPDLOG_WARN("[ecs_ffi] Not available: {}", err.what());
+            return;
+        }
+        lua["ecs_ffi"] = module.get<sol::table>();
+
+        rec.add_type("ecs_ffi").doc =
+            "LuaJIT FFI views: pointers into component storage that compiled code reads and writes directly.";
+        rec.record_free_function({"ecs_ffi"}, MethodDef{"transform",
+            "---@param entity Entity\n---@param view? ffi.cdata* # Reused if given.\n---@return ffi.cdata*|nil",
+            "Fills a view of the transform's springs: view.x.target[0] is actual x, view.x.value[0] visual x. "
+            "nil if the entity is stale or has no Transform. Fill again every update rather than keeping a view.", true, false});
+        rec.record_free_function({"ecs_ffi"}, MethodDef{"sprite",
+            "---@param entity Entity\n---@param view? ffi.cdata*\n---@return ffi.cdata*|nil",
+            "Fills a view of the SpriteComponentASCII colors (view.fg, view.bg with r, g, b, a). Fill again every update rather than keeping a view.", true, false});
+        rec.record_free_function({"ecs_ffi"}, MethodDef{"body",
+            "---@param entity Entity\n---@param out? ffi.cdata*\n---@return ffi.cdata*|nil",
+            "Copies the collider body state (x, y, vx, vy, angle, angular_velocity).", true, false});
+        rec.record_free_function({"ecs_ffi"}, MethodDef{"set_body",
+            "---@param entity Entity\n---@param body ffi.cdata*\n---@return boolean",
+            "Writes a body state back through chipmunk's setters.", true, false});
+        rec.record_free_function({"ecs_ffi"}, MethodDef{"valid",
+            "---@param view ffi.cdata*|nil\n---@return boolean",
+            "False once a removal may have moved what the view points at; fill it again. Only checked when called.", true, false});
+        rec.record_free_function({"ecs_ffi"}, MethodDef{"epoch", "---@return integer",
+            "Changes whenever views may have gone stale.", true, false});
+#else
+        (void)lua;
+#endif
+    }
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstdint>
+
+#include "entt/entity/registry.hpp"
+#include "sol/sol.hpp"
+
+struct Color; // raylib
+
+// LuaJIT FFI views over component storage.
+//
+// Usertype getters cost a sol2 call, a registry lookup and a boxed number
+// per field, and they stop the JIT from compiling the loop around them.
+// With LuaJIT, scripts can instead ask for a view: a small C struct of
+// pointers straight into the storage, filled by one FFI call that the JIT
+// compiles like any other. Reads and writes through it are plain loads and
+// stores.
+//
+//   local t = ecs_ffi.transform(e)        -- nil if e is stale or has no Transform
+//   t.x.target[0] = t.x.target[0] + 1     -- actual x, what setActualX writes
+//   t.x.value[0], t.x.velocity[0]         -- visual x and its spring velocity
+//   local s = ecs_ffi.sprite(e, s)        -- reuses the view `s` if given
+//   s.fg.a = 128
+//   local b = ecs_ffi.body(e)             -- a copy, see below
+//   b.vx = b.vx * 0.9
+//   ecs_ffi.set_body(e, b)
+//
+// Fill views in the update that uses them. A view kept across updates is not
+// checked by anything unless the script calls ecs_ffi.valid(view), and its
+// transform writes are not picked up by flush(); refill it instead, which
+// reuses the cdata:
+//
+//   function S:update(dt)
+//     self.t = ecs_ffi.transform(self.id, self.t)  -- not just on first use
+//     if not self.t then return end
+//
+// Where the pointers lead:
+//  - transform: the six springs' lanes in spring::GetSpringPool(). Filling
+//    the view marks them as possibly awake, so writes made in the same
+//    update wake the springs and report the transform as changed (one more
+//    reason not to keep views across updates); Transform's per-frame getter
+//    cache is refreshed by flush().
+//  - sprite: fgColor/bgColor of the SpriteComponentASCII in its EnTT pool.
+//  - body: chipmunk owns body state and must be written through its setters
+//    (they wake sleeping bodies), so bodies are copied in and out instead.
+//
+// Views are checked when filled: the entity's version must be current, so a
+// recycled id is refused. Nothing the pointers lead to is moved by removals
+// of other entities' components: SpriteComponentASCII uses in-place delete
+// (a removal leaves a hole) and the spring pool reuses a destroyed spring's
+// slot only after its next update. So a view filled in this update writes
+// to its own entity, or to a dead slot nobody reads, for the rest of the
+// update, whatever else is destroyed meanwhile. The one exception: a sprite
+// emplaced after a removal may take over the hole, and with it whatever the
+// removed sprite's views write.
+// Removals change epoch(); views remember the epoch they were filled at and
+// ecs_ffi.valid(view) compares, for views kept longer than that.
+// Creating entities and components moves nothing, so views taken at the
+// start of an update survive spawning.
+//
+// Main thread only, like the registry.
+namespace scripting::ffi_views
+{
+    // C layouts, declared to LuaJIT by cdef(); keep the two in sync.
+
+    // One spring's lanes; index with [0].
+    struct SpringLane
+    {
+        float *value;
+        float *target;
+        float *velocity;
+    };
+
+    struct TransformView
+    {
+        uint32_t entity;
+        uint32_t epoch; // 0 when the last fill failed
+        SpringLane x, y, w, h, r, s;
+    };
+
+    struct SpriteView
+    {
+        uint32_t entity;
+        uint32_t epoch;
+        Color *fg;
+        Color *bg;
+    };
+
+    struct BodyState
+    {
+        double x, y;
+        double vx, vy;
+        double angle;
+        double angular_velocity;
+    };
+
+    // Function table the Lua side casts from a light userdata. Fills return
+    // false (and clear the view) for a stale entity or a missing component.
+    struct Api
+    {
+        uint32_t (*epoch)();
+        bool (*bind_transform)(TransformView *out, uint32_t entity);
+        bool (*bind_sprite)(SpriteView *out, uint32_t entity);
+        bool (*read_body)(BodyState *out, uint32_t entity);
+        bool (*write_body)(const BodyState *in, uint32_t entity);
+    };
+
+    // The cdef matching the structs above.
+    [[nodiscard]] const char *cdef();
+    [[nodiscard]] const Api &api();
+
+    // Points the views at `registry` and subscribes to the removals that
+    // invalidate them. Call again after switching registries.
+    void install(entt::registry &registry);
+    void uninstall();
+
+    // Current epoch; never 0.
+    [[nodiscard]] uint32_t epoch();
+
+    // Makes the transforms bound since the last flush re-read their springs,
+    // so C++ getters see what scripts wrote. Called after script updates.
+    void flush();
+
+    // Defines the `ecs_ffi` table. Does nothing without LuaJIT.
+    void exposeToLua(sol::state &lua);
+}
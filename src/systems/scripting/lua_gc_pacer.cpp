@@ -0,0 +1,129 @@
+#include "lua_gc_pacer.hpp"
+
+#include <algorithm>
+
+#include "util/common_headers.hpp"
+
+namespace scripting
+{
+    namespace
+    {
+        float heap_kb(lua_State *L)
+        {
+            return static_cast<float>(lua_gc(L, LUA_GCCOUNT, 0)) +
+                   static_cast<float>(lua_gc(L, LUA_GCCOUNTB, 0)) / 1024.0f;
+        }
+
+        // One increment of collector work; 1 when it finished the cycle.
+        int gc_step(lua_State *L, int stepKB)
+        {
+#if LUA_VERSION_NUM >= 504
+            (void)stepKB; // a sized step can be swallowed by the debt the last one left; take a basic step
+            return lua_gc(L, LUA_GCSTEP, 0);
+#else
+            return lua_gc(L, LUA_GCSTEP, stepKB);
+#endif
+        }
+
+        double ms_since(std::chrono::steady_clock::time_point start)
+        {
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+    }
+
+    void LuaGcPacer::adopt(lua_State *L)
+    {
+        L_ = L;
+        stopped_ = false;
+#ifdef LUA_GCINC
+        lua_gc(L, LUA_GCINC, 0, 0, 0); // 5.4: steps below assume the incremental collector
+#endif
+        baseKB_ = std::max(heap_kb(L), config.minBaseKB);
+        // Much of a freshly loaded heap is load-time garbage; the first cycle finds the real live size.
+        cycleRunning_ = true;
+    }
+
+    void LuaGcPacer::beginFrame()
+    {
+        frameStart_ = std::chrono::steady_clock::now();
+    }
+
+    void LuaGcPacer::endFrame(lua_State *L, double budgetMs)
+    {
+        if (!L)
+            return;
+        if (L != L_)
+            adopt(L);
+
+        if (!config.enabled)
+        {
+            if (stopped_)
+            {
+                lua_gc(L, LUA_GCRESTART, 0);
+                stopped_ = false;
+            }
+            lastFrame_ = LuaGcPacerStats{};
+            lastFrame_.heapKB = heap_kb(L);
+            lastFrame_.baseKB = baseKB_;
+            return;
+        }
+
+        const double usedMs = frameStart_ == std::chrono::steady_clock::time_point{} ? 0.0 : ms_since(frameStart_);
+        step(L, budgetMs - usedMs);
+    }
+
+    void LuaGcPacer::step(lua_State *L, double slackMs)
+    {
+        ZONE_SCOPED("LuaGcPacer::step");
+        if (L != L_)
+            adopt(L);
+
+        LuaGcPacerStats stats;
+        stats.slackMs = static_cast<float>(std::max(slackMs, 0.0));
+
+        const float ratio = heap_kb(L) / baseKB_;
+        if (!cycleRunning_ && ratio >= config.pauseRatio)
+            cycleRunning_ = true;
+
+        if (cycleRunning_)
+        {
+            const float span = config.hardRatio - config.softRatio;
+            stats.pressure = span > 0.0f ? std::clamp((ratio - config.softRatio) / span, 0.0f, 1.0f)
+                                         : (ratio >= config.hardRatio ? 1.0f : 0.0f);
+            const bool finish = ratio >= config.hardRatio;
+            const double floorMs = config.minStepMs + stats.pressure * (config.maxStepMs - config.minStepMs);
+            const double budgetMs = std::min(std::max(stats.slackMs * static_cast<double>(config.slackShare), floorMs),
+                                             static_cast<double>(config.maxStepMs));
+
+            const auto start = std::chrono::steady_clock::now();
+            do
+            {
+                ++stats.steps;
+                if (gc_step(L, config.stepKB) == 1)
+                {
+                    cycleRunning_ = false;
+                    ++cycles_;
+                    baseKB_ = std::max(heap_kb(L), config.minBaseKB);
+                    break;
+                }
+            } while (finish || ms_since(start) < budgetMs);
+            stats.stepMs = static_cast<float>(ms_since(start));
+        }
+
+        // Explicit steps re-arm LuaJIT's threshold; keep allocation from triggering collection.
+        lua_gc(L, LUA_GCSTOP, 0);
+        stopped_ = true;
+
+        stats.heapKB = heap_kb(L);
+        stats.baseKB = baseKB_;
+        stats.cycleRunning = cycleRunning_;
+        worstPauseMs_ = std::max(worstPauseMs_, stats.stepMs);
+        lastFrame_ = stats;
+    }
+
+    LuaGcPacer &lua_gc_pacer()
+    {
+        static LuaGcPacer pacer;
+        return pacer;
+    }
+}
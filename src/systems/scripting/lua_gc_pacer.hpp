@@ -0,0 +1,87 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#include "sol/sol.hpp"
+
+// Paces the Lua garbage collector against the frame budget.
+//
+// Left alone, the collector runs whenever allocation debt says so, which can
+// land a multi-millisecond step in the middle of a heavy frame. The pacer
+// takes the VM out of automatic mode and runs bounded LUA_GCSTEP increments
+// at the end of each frame, in whatever time the frame left over. When the
+// heap grows well past its size after the last cycle, it steps harder
+// regardless of slack, and at the hard limit it finishes the cycle outright,
+// so a frame that never has slack cannot grow the heap without bound.
+//
+// Works the same on PUC Lua and LuaJIT: both honour LUA_GCSTOP between
+// explicit steps (LuaJIT re-arms its threshold on every step, so the pacer
+// stops it again after each batch).
+namespace scripting
+{
+    struct LuaGcPacerConfig
+    {
+        bool enabled = true;
+        float slackShare = 0.5f;  // share of the frame's slack the collector may use
+        float minStepMs = 0.05f;  // spent every frame while a cycle runs, slack or not
+        float maxStepMs = 4.0f;   // per-frame cap below the hard limit
+        int stepKB = 8;           // size of one LUA_GCSTEP increment (LuaJIT; 5.4 takes basic steps)
+
+        // Heap size relative to the live size left by the last cycle:
+        float pauseRatio = 1.3f;  // start a new cycle
+        float softRatio = 2.0f;   // from here the minimum ramps up to maxStepMs
+        float hardRatio = 3.0f;   // finish the running cycle this frame
+        float minBaseKB = 1024.0f; // small heaps are not chased
+    };
+
+    struct LuaGcPacerStats
+    {
+        float heapKB = 0.0f;    // after this frame's steps
+        float baseKB = 0.0f;    // live size after the last completed cycle
+        float slackMs = 0.0f;   // frame budget left when the pacer ran
+        float stepMs = 0.0f;    // time spent collecting this frame
+        uint32_t steps = 0;
+        float pressure = 0.0f;  // 0 up to softRatio, 1 at hardRatio
+        bool cycleRunning = false;
+    };
+
+    class LuaGcPacer
+    {
+    public:
+        LuaGcPacerConfig config;
+
+        // Marks the start of the frame's work.
+        void beginFrame();
+
+        // Runs collection for L in the time left of budgetMs since beginFrame.
+        // A state the pacer has not seen yet (e.g. after a reset) is taken
+        // over here; disabling the pacer hands the collector back to Lua.
+        void endFrame(lua_State *L, double budgetMs);
+
+        // The stepping policy for a given amount of slack, without the clock.
+        void step(lua_State *L, double slackMs);
+
+        const LuaGcPacerStats &lastFrame() const { return lastFrame_; }
+        uint64_t cycles() const { return cycles_; }
+
+        // Longest single frame of collection since the last reset.
+        float worstPauseMs() const { return worstPauseMs_; }
+        void resetWorstPause() { worstPauseMs_ = 0.0f; }
+
+    private:
+        void adopt(lua_State *L);
+
+        lua_State *L_ = nullptr; // compared, never dereferenced once replaced
+        bool stopped_ = false;
+        bool cycleRunning_ = false;
+        float baseKB_ = 0.0f;
+        uint64_t cycles_ = 0;
+        float worstPauseMs_ = 0.0f;
+        std::chrono::steady_clock::time_point frameStart_{};
+        LuaGcPacerStats lastFrame_{};
+    };
+
+    // The pacer for the master Lua state (main thread only).
+    LuaGcPacer &lua_gc_pacer();
+}
@@ -10,6 +10,8 @@
 #include "third_party/rlImGui/imgui.h"
 #include "sol/types.hpp"
 #include "core/game.hpp"
+#include "systems/event/event_system.hpp"
+#include "systems/file_watch/file_watch.hpp"
 
 namespace lua_hot_reload {
 
@@ -17,11 +19,13 @@ namespace lua_hot_reload {
         std::string path;
         std::string moduleName; // derived from path
         std::filesystem::file_time_type lastWriteTime;
+        std::filesystem::path absolutePath; // as reported by file_watch
     };
 
     extern std::unordered_map<std::string, LuaFile> trackedFiles;
     extern std::vector<std::string> changedFiles;
     inline bool autoReload = false;
+    inline file_watch::SubscriptionId watchSubscription = 0; // 0: poll in draw_imgui
     
     // ------------------------------------------------------------
     // Helper: derive module name (e.g. "scripts/ai/init.lua" → "ai.init")
@@ -54,11 +58,18 @@ namespace lua_hot_reload {
             trackedFiles[path] = {
                 path,
                 to_module_name(path),
-                std::filesystem::last_write_time(path)
+                std::filesystem::last_write_time(path),
+                std::filesystem::absolute(path).lexically_normal()
             };
         }
     }
 
+    inline void mark_changed(const std::string& path) {
+        if (std::find(changedFiles.begin(), changedFiles.end(), path) == changedFiles.end()) {
+            changedFiles.push_back(path);
+        }
+    }
+
     inline void scan_for_changes() {
         // Don't clear changedFiles here — we want it to persist.
         for (auto& [path, info] : trackedFiles) {
@@ -67,10 +78,7 @@ namespace lua_hot_reload {
 
                 // Use > instead of != to avoid precision loss issues
                 if (newTime > info.lastWriteTime) {
-                    // If not already marked changed, add it
-                    if (std::find(changedFiles.begin(), changedFiles.end(), path) == changedFiles.end()) {
-                        changedFiles.push_back(path);
-                    }
+                    mark_changed(path);
                     info.lastWriteTime = newTime;
                 }
             }
@@ -112,18 +120,54 @@ namespace lua_hot_reload {
     }
 
 
+    // ------------------------------------------------------------
+    // Subscribes to file_watch for everything under assetsRoot: tracked Lua
+    // modules are marked changed (and reloaded when autoReload is on), and
+    // other files are published to Lua as an "asset_files_changed" event
+    // with { paths = { ... } } so scripts can reload their JSON, textures...
+    // ------------------------------------------------------------
+    inline void watch(sol::state& lua, const std::filesystem::path& assetsRoot) {
+        if (watchSubscription != 0) return;
+        watchSubscription = file_watch::watcher().subscribe(assetsRoot, {}, [&lua](const file_watch::Paths& changed) {
+            sol::table paths;
+            for (const auto& file : changed) {
+                if (file.extension() != ".lua") {
+                    if (!paths.valid()) paths = lua.create_table();
+                    paths.add(file.generic_string());
+                    continue;
+                }
+                for (const auto& [path, info] : trackedFiles) {
+                    if (info.absolutePath != file) continue;
+                    mark_changed(path);
+                    if (autoReload) reload(lua, path);
+                    break;
+                }
+            }
+            if (paths.valid()) {
+                event_system::publishLuaEvent("asset_files_changed", lua.create_table_with("paths", paths));
+            }
+        });
+    }
+
+    // Back to polling in draw_imgui.
+    inline void unwatch() {
+        if (watchSubscription == 0) return;
+        file_watch::watcher().unsubscribe(watchSubscription);
+        watchSubscription = 0;
+    }
+
     inline void draw_imgui(sol::state& lua) {
         static double lastScan = 0.0;
-        if (GetTime() - lastScan > 1.0) { // every second
+        if (watchSubscription == 0 && GetTime() - lastScan > 1.0) { // every second
             scan_for_changes();
             lastScan = GetTime();
         }
 
         if (ImGui::Begin("Lua Hot Reload")) {
-            static bool autoReload = false;
             ImGui::Checkbox("Auto Reload Changed Files", &autoReload);
             if (autoReload) {
-                for (auto& file : changedFiles)
+                const auto pending = changedFiles; // reload() erases from changedFiles
+                for (auto& file : pending)
                     reload(lua, file);
             }
             if (changedFiles.empty()) {
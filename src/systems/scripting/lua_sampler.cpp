@@ -0,0 +1,474 @@
+#include "lua_sampler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+
+#if defined(SOL_LUAJIT) && SOL_LUAJIT
+#include "luajit.h"
+#endif
+
+#include "binding_recorder.hpp"
+#include "nlohmann/json.hpp"
+#include "spdlog/spdlog.h"
+
+namespace lua_profiler {
+
+namespace {
+
+constexpr uint32_t kNoFrame = UINT32_MAX;
+
+Sampler* g_hooked = nullptr; // the sampler the count hook reports to
+int g_hook_interval = 1;     // instructions between count events
+
+// A hook that was set on a thread before ours replaced it (debug.sethook, say).
+// It keeps getting its events through count_hook, and gets the thread back
+// once sampling stops.
+struct ChainedHook {
+    lua_Hook hook;
+    int mask;
+    int count;
+    int elapsed = 0; // instructions since its last count event
+};
+std::unordered_map<lua_State*, ChainedHook> g_chained;
+
+uint64_t now_us() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch())
+                                     .count());
+}
+
+void count_hook(lua_State* L, lua_Debug* ar) {
+    auto chained = g_chained.find(L);
+    if (!g_hooked) {
+        // sampling stopped: hand the thread back to whoever had it
+        if (chained == g_chained.end()) {
+            lua_sethook(L, nullptr, 0, 0);
+        } else {
+            const ChainedHook previous = chained->second;
+            g_chained.erase(chained);
+            lua_sethook(L, previous.hook, previous.mask, previous.count);
+        }
+        return;
+    }
+
+    if (ar->event == LUA_HOOKCOUNT) {
+        g_hooked->record(L, 1, 0);
+    }
+    if (chained == g_chained.end()) {
+        return;
+    }
+    ChainedHook& previous = chained->second;
+    if (ar->event == LUA_HOOKCOUNT) {
+        if (!(previous.mask & LUA_MASKCOUNT)) {
+            return;
+        }
+        previous.elapsed += g_hook_interval;
+        if (previous.elapsed < previous.count) {
+            return;
+        }
+        previous.elapsed = 0;
+    }
+    previous.hook(L, ar); // may not return (a timeout hook raising an error)
+}
+
+#if defined(SOL_LUAJIT) && SOL_LUAJIT
+void profile_callback(void* data, lua_State* L, int samples, int vmstate) {
+    static_cast<Sampler*>(data)->record(L, static_cast<uint32_t>(std::max(samples, 1)), vmstate);
+}
+#endif
+
+// "scripts/ai/init.lua" for files under the scripts tree, the full path for
+// other files, and Lua's short form for chunks loaded from strings.
+std::string chunk_name(const lua_Debug& ar) {
+    std::string name;
+    if (ar.source && ar.source[0] == '@') {
+        name = ar.source + 1;
+        std::replace(name.begin(), name.end(), '\\', '/');
+        const auto pos = name.rfind("scripts/");
+        if (pos != std::string::npos) {
+            name.erase(0, pos);
+        }
+    } else {
+        name = ar.short_src;
+    }
+    // ';' separates frames in folded stacks, and a label must stay on one line.
+    std::replace(name.begin(), name.end(), ';', ':');
+    std::replace(name.begin(), name.end(), '\n', ' ');
+    return name;
+}
+
+std::string function_name(const lua_Debug& ar) {
+    if (ar.name) {
+        return ar.name;
+    }
+    if (ar.what && std::strcmp(ar.what, "main") == 0) {
+        return "main chunk";
+    }
+    return "anonymous"; // called from C, or through a tail call
+}
+
+bool write_file(const std::filesystem::path& path, const std::string& content) {
+    std::error_code ec;
+    if (path.has_parent_path()) {
+        std::filesystem::create_directories(path.parent_path(), ec);
+    }
+    std::ofstream out(path, std::ios::binary);
+    if (!out) {
+        SPDLOG_WARN("[lua_profiler] Unable to write {}", path.string());
+        return false;
+    }
+    out << content;
+    return static_cast<bool>(out);
+}
+
+} // namespace
+
+bool Sampler::start(lua_State* L, const SamplerConfig& config) {
+    if (L_ || !L) {
+        return false;
+    }
+
+    SampleMode mode = config.mode;
+    if (mode == SampleMode::Auto) {
+#if defined(SOL_LUAJIT) && SOL_LUAJIT
+        mode = SampleMode::Timer;
+#else
+        mode = SampleMode::Instructions;
+#endif
+    }
+
+    config_ = config;
+    config_.max_depth = std::clamp(config.max_depth, 1, kMaxDepth - 2); // room for [GC] and [truncated]
+    if (ring_.size() != std::max<size_t>(config.ring_capacity, 1)) {
+        drain();
+        ring_.assign(std::max<size_t>(config.ring_capacity, 1), RawSample{});
+        ring_head_ = ring_tail_ = 0;
+    }
+    if (total_ == 0) {
+        start_us_ = now_us();
+    }
+
+    if (mode == SampleMode::Timer) {
+#if defined(SOL_LUAJIT) && SOL_LUAJIT
+        const std::string vm_mode = "i" + std::to_string(std::max(config.interval_ms, 1));
+        luaJIT_profile_start(L, vm_mode.c_str(), &profile_callback, this);
+#else
+        SPDLOG_WARN("[lua_profiler] Timer sampling needs LuaJIT; use Instructions mode");
+        return false;
+#endif
+    } else {
+        g_hooked = this;
+        g_hook_interval = std::max(config.instruction_interval, 1);
+    }
+
+    active_mode_ = mode;
+    L_ = L;
+    attach(L);
+    return true;
+}
+
+void Sampler::attach(lua_State* thread) {
+    if (!L_ || !thread || active_mode_ != SampleMode::Instructions) {
+        return;
+    }
+    const lua_Hook current = lua_gethook(thread);
+    if (current == &count_hook) {
+        return;
+    }
+    int mask = LUA_MASKCOUNT;
+    if (current) {
+        g_chained[thread] = ChainedHook{current, lua_gethookmask(thread), lua_gethookcount(thread)};
+        mask |= lua_gethookmask(thread);
+    } else {
+        g_chained.erase(thread);
+    }
+    lua_sethook(thread, &count_hook, mask, g_hook_interval);
+}
+
+void Sampler::rearm() {
+    attach(L_);
+}
+
+void Sampler::stop() {
+    if (!L_) {
+        return;
+    }
+    if (active_mode_ == SampleMode::Timer) {
+#if defined(SOL_LUAJIT) && SOL_LUAJIT
+        luaJIT_profile_stop(L_);
+#endif
+    } else {
+        // other attached threads unhook themselves on their next count event
+        g_hooked = nullptr;
+        auto chained = g_chained.find(L_);
+        if (lua_gethook(L_) != &count_hook) {
+            // someone else's hook by now; leave it alone
+        } else if (chained == g_chained.end()) {
+            lua_sethook(L_, nullptr, 0, 0);
+        } else {
+            lua_sethook(L_, chained->second.hook, chained->second.mask, chained->second.count);
+        }
+        if (chained != g_chained.end()) {
+            g_chained.erase(chained);
+        }
+    }
+    L_ = nullptr;
+    drain();
+}
+
+uint32_t Sampler::label_id(const std::string& label) {
+    auto [it, inserted] = label_ids_.try_emplace(label, static_cast<uint32_t>(frame_labels_.size()));
+    if (inserted) {
+        frame_labels_.push_back(label);
+    }
+    return it->second;
+}
+
+uint32_t Sampler::frame_id(const lua_Debug& ar, bool line_only) {
+    const bool c_function = ar.what && std::strcmp(ar.what, "C") == 0;
+    // Lua frames are keyed by their chunk's source string, C frames by name.
+    const char* identity = c_function ? (ar.name ? ar.name : "") : (ar.source ? ar.source : "");
+    const int line = line_only || config_.lines ? ar.currentline : ar.linedefined;
+    const FrameKey key{identity, c_function ? -1 : line};
+
+    auto& ids = line_only ? line_ids_ : frame_ids_;
+    auto it = ids.find(key);
+    if (it != ids.end() && it->second.identity == identity) {
+        return it->second.id;
+    }
+
+    std::string label;
+    if (c_function) {
+        label = "[C] " + function_name(ar);
+    } else if (line_only) {
+        label = chunk_name(ar) + ":" + std::to_string(line);
+    } else {
+        label = function_name(ar) + " (" + chunk_name(ar) + ":" + std::to_string(line) + ")";
+    }
+    const uint32_t id = label_id(label);
+    ids.insert_or_assign(key, FrameEntry{id, identity});
+    return id;
+}
+
+void Sampler::record(lua_State* L, uint32_t weight, int vmstate) {
+    if (ring_.empty()) {
+        return;
+    }
+    if (ring_head_ - ring_tail_ == ring_.size()) {
+        drain();
+    }
+
+    RawSample& sample = ring_[ring_head_ % ring_.size()];
+    sample.ts_us = now_us() - start_us_;
+    sample.weight = weight;
+    sample.leaf_line = kNoFrame;
+    sample.depth = 0;
+
+    // LuaJIT reports where the VM was; GC and trace compilation get a leaf of their own.
+    if (vmstate == 'G') {
+        sample.frames[sample.depth++] = label_id("[GC]");
+    } else if (vmstate == 'J') {
+        sample.frames[sample.depth++] = label_id("[JIT compiler]");
+    }
+
+    lua_Debug ar;
+    int level = 0;
+    while (level < config_.max_depth && lua_getstack(L, level, &ar)) {
+        lua_getinfo(L, "Sln", &ar);
+        if (sample.leaf_line == kNoFrame && ar.currentline > 0) {
+            sample.leaf_line = frame_id(ar, true); // C leaves count toward the Lua line calling them
+        }
+        sample.frames[sample.depth++] = frame_id(ar, false);
+        ++level;
+    }
+    if (level == 0) {
+        return; // nothing on the Lua stack
+    }
+    if (lua_getstack(L, level, &ar)) {
+        sample.frames[sample.depth++] = label_id("[truncated]");
+    }
+    ++ring_head_;
+}
+
+void Sampler::drain() {
+    while (ring_tail_ < ring_head_) {
+        const RawSample& sample = ring_[ring_tail_ % ring_.size()];
+        std::vector<uint32_t> stack(sample.frames, sample.frames + sample.depth);
+        std::reverse(stack.begin(), stack.end());
+
+        if (sample.leaf_line != kNoFrame) {
+            line_self_[sample.leaf_line] += sample.weight;
+        }
+        total_ += sample.weight;
+        if (timeline_.size() < config_.timeline_capacity) {
+            stacks_[stack] += sample.weight;
+            timeline_.emplace_back(sample.ts_us, std::move(stack));
+        } else {
+            stacks_[std::move(stack)] += sample.weight;
+        }
+        ++ring_tail_;
+    }
+}
+
+void Sampler::reset() {
+    stop();
+    ring_head_ = ring_tail_ = 0;
+    frame_ids_.clear();
+    line_ids_.clear();
+    frame_labels_.clear();
+    label_ids_.clear();
+    stacks_.clear();
+    line_self_.clear();
+    timeline_.clear();
+    total_ = 0;
+}
+
+uint64_t Sampler::sample_count() {
+    drain();
+    return total_;
+}
+
+std::string Sampler::folded() {
+    drain();
+    std::string out;
+    for (const auto& [stack, count] : stacks_) {
+        for (size_t i = 0; i < stack.size(); ++i) {
+            if (i > 0) {
+                out += ';';
+            }
+            out += frame_labels_[stack[i]];
+        }
+        out += ' ';
+        out += std::to_string(count);
+        out += '\n';
+    }
+    return out;
+}
+
+std::string Sampler::chrome_trace() {
+    drain();
+    nlohmann::json events = nlohmann::json::array();
+
+    // Consecutive samples sharing a frame at the same depth become one slice.
+    std::vector<std::pair<uint32_t, uint64_t>> open; // frame, start
+    auto close_to = [&](size_t depth, uint64_t ts) {
+        while (open.size() > depth) {
+            const auto [frame, start] = open.back();
+            open.pop_back();
+            events.push_back({{"name", frame_labels_[frame]},
+                              {"cat", "lua"},
+                              {"ph", "X"},
+                              {"ts", start},
+                              {"dur", ts - start},
+                              {"pid", 1},
+                              {"tid", 1}});
+        }
+    };
+
+    for (const auto& [ts, stack] : timeline_) {
+        size_t common = 0;
+        while (common < open.size() && common < stack.size() && open[common].first == stack[common]) {
+            ++common;
+        }
+        close_to(common, ts);
+        for (size_t i = common; i < stack.size(); ++i) {
+            open.emplace_back(stack[i], ts);
+        }
+    }
+    if (!timeline_.empty()) {
+        // The last sample stands for one more interval.
+        const uint64_t span = timeline_.back().first - timeline_.front().first;
+        const uint64_t interval = timeline_.size() > 1 ? span / (timeline_.size() - 1) : 1000;
+        close_to(0, timeline_.back().first + std::max<uint64_t>(interval, 1));
+    }
+
+    nlohmann::json trace;
+    trace["traceEvents"] = std::move(events);
+    trace["displayTimeUnit"] = "ms";
+    return trace.dump();
+}
+
+bool Sampler::write_folded(const std::filesystem::path& path) {
+    return write_file(path, folded());
+}
+
+bool Sampler::write_chrome_trace(const std::filesystem::path& path) {
+    return write_file(path, chrome_trace());
+}
+
+std::vector<HotLine> Sampler::hot_lines(size_t n) {
+    drain();
+    std::vector<HotLine> lines;
+    lines.reserve(line_self_.size());
+    for (const auto& [id, count] : line_self_) {
+        lines.push_back({frame_labels_[id], count});
+    }
+    n = std::min(n, lines.size());
+    std::partial_sort(lines.begin(), lines.begin() + static_cast<std::ptrdiff_t>(n), lines.end(),
+                      [](const HotLine& a, const HotLine& b) {
+                          return a.samples != b.samples ? a.samples > b.samples : a.location < b.location;
+                      });
+    lines.resize(n);
+    return lines;
+}
+
+Sampler& sampler() {
+    static Sampler instance;
+    return instance;
+}
+
+void exposeToLua(sol::state& lua) {
+    auto& rec = BindingRecorder::instance();
+
+    rec.add_type("lua_profiler").doc =
+        "Sampling profiler for Lua call stacks. Exports folded stacks (flame graphs) and Chrome traces.";
+
+    rec.bind_function(lua, {"lua_profiler"}, "start",
+        [&lua](sol::optional<sol::table> opts) {
+            SamplerConfig config;
+            if (opts) {
+                const std::string mode = opts->get_or<std::string>("mode", "auto");
+                config.mode = mode == "timer"          ? SampleMode::Timer
+                              : mode == "instructions" ? SampleMode::Instructions
+                                                       : SampleMode::Auto;
+                config.interval_ms = opts->get_or("interval_ms", config.interval_ms);
+                config.instruction_interval = opts->get_or("instructions", config.instruction_interval);
+                config.max_depth = opts->get_or("depth", config.max_depth);
+                config.lines = opts->get_or("lines", config.lines);
+            }
+            return sampler().start(lua.lua_state(), config);
+        },
+        "---@param opts? {mode?: 'auto'|'timer'|'instructions', interval_ms?: integer, instructions?: integer, depth?: integer, lines?: boolean}\n"
+        "---@return boolean",
+        "Starts sampling the Lua state. Timer mode needs LuaJIT; instructions mode samples every N VM instructions.");
+    rec.bind_function(lua, {"lua_profiler"}, "stop", [] { sampler().stop(); },
+        "---@return nil", "Stops sampling; collected samples are kept until reset().");
+    rec.bind_function(lua, {"lua_profiler"}, "running", [] { return sampler().running(); },
+        "---@return boolean", "True while sampling.");
+    rec.bind_function(lua, {"lua_profiler"}, "reset", [] { sampler().reset(); },
+        "---@return nil", "Stops sampling and drops all samples.");
+    rec.bind_function(lua, {"lua_profiler"}, "sample_count", [] { return sampler().sample_count(); },
+        "---@return integer", "Samples collected so far.");
+    rec.bind_function(lua, {"lua_profiler"}, "write_folded",
+        [](const std::string& path) { return sampler().write_folded(path); },
+        "---@param path string\n---@return boolean", "Writes folded stacks ('a;b;c count' per line) for flame graph tools.");
+    rec.bind_function(lua, {"lua_profiler"}, "write_trace",
+        [](const std::string& path) { return sampler().write_chrome_trace(path); },
+        "---@param path string\n---@return boolean", "Writes a Chrome trace (chrome://tracing, Perfetto) flame chart.");
+    rec.bind_function(lua, {"lua_profiler"}, "hot_lines",
+        [](sol::this_state ts, sol::optional<int> n) {
+            sol::state_view view(ts);
+            sol::table out = view.create_table();
+            int i = 1;
+            for (const HotLine& line : sampler().hot_lines(static_cast<size_t>(std::max(n.value_or(20), 0)))) {
+                out[i++] = view.create_table_with("location", line.location, "samples", line.samples);
+            }
+            return out;
+        },
+        "---@param n? integer\n---@return {location: string, samples: integer}[]",
+        "Script lines with the most samples at the top of the stack, hottest first.");
+}
+
+} // namespace lua_profiler
@@ -0,0 +1,155 @@
+#pragma once
+
+// Sampling Lua profiler
+//
+// lua_profiler.hpp times C++ entry points; this answers which Lua function
+// (and line) the time goes to. Samples are whole Lua call stacks, taken
+//
+//   - Instructions: from a count hook every N VM instructions. Deterministic,
+//     so headless runs reproduce; on LuaJIT it only sees interpreted code.
+//     PUC Lua keeps hooks per coroutine: threads created after start() inherit
+//     the hook, older ones are hooked by attach() (the task scheduler attaches
+//     every coroutine it resumes). A hook set by a script (debug.sethook) is
+//     chained behind ours when rearm() finds it, and rearm() puts ours back
+//     once a script clears it.
+//   - Timer (LuaJIT): from the VM's built-in profiler every N ms, which also
+//     samples JIT-compiled traces.
+//
+// The hook copies the stack as interned frame ids into a preallocated ring and
+// returns; the ring is folded into the aggregate when it fills up or is read,
+// so sampling never allocates except the first time a frame is seen.
+//
+// Frames are "name (scripts/path.lua:line)", with the line the function
+// starts at (or the current line, with `lines`). Export as folded stacks
+// ("root;...;leaf count", for flamegraph.pl, inferno or speedscope) or as a
+// Chrome trace flame chart.
+//
+// Usage:
+//   lua_profiler::sampler().start(L);
+//   ...
+//   lua_profiler::sampler().stop();
+//   lua_profiler::sampler().write_folded("out/lua.folded");
+//
+// From Lua: lua_profiler.start{ mode = "timer", interval_ms = 1 }, stop(),
+// write_folded(path), write_trace(path), hot_lines(n). Headless tests:
+// --lua-profile <path>.
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "sol/sol.hpp"
+
+namespace lua_profiler {
+
+enum class SampleMode : uint8_t {
+    Auto,         // Timer on LuaJIT, Instructions otherwise
+    Instructions,
+    Timer,
+};
+
+struct SamplerConfig {
+    SampleMode mode = SampleMode::Auto;
+    int instruction_interval = 10000; // Instructions: VM instructions between samples
+    int interval_ms = 1;              // Timer: wall time between samples
+    int max_depth = 48;               // frames kept per sample, from the leaf
+    bool lines = false;               // label frames by current line, not function
+    size_t ring_capacity = 4096;      // samples buffered between folds
+    size_t timeline_capacity = 200000; // samples kept in order for the Chrome trace
+};
+
+struct HotLine {
+    std::string location; // scripts/path.lua:line
+    uint64_t samples = 0; // samples with this line at the top of the stack
+};
+
+class Sampler {
+public:
+    static constexpr int kMaxDepth = 64;
+
+    // False if already running, L is null, or the mode is not available here.
+    bool start(lua_State* L, const SamplerConfig& config = {});
+    void stop();
+
+    // Instructions mode: hooks `thread` if it is not hooked yet, keeping a hook
+    // that was already there running behind the sampler's. No-op otherwise.
+    void attach(lua_State* thread);
+    // attach() for the state passed to start(); called once per frame.
+    void rearm();
+    bool running() const { return L_ != nullptr; }
+
+    // Folds buffered samples into the aggregate (done by every reader).
+    void drain();
+    void reset();
+
+    uint64_t sample_count();
+
+    std::string folded();
+    std::string chrome_trace();
+    bool write_folded(const std::filesystem::path& path);
+    bool write_chrome_trace(const std::filesystem::path& path);
+
+    // Lines with the most self samples, hottest first.
+    std::vector<HotLine> hot_lines(size_t n);
+
+    // Takes one sample of L's stack; called from the hooks.
+    void record(lua_State* L, uint32_t weight, int vmstate);
+
+private:
+    struct RawSample {
+        uint64_t ts_us = 0;
+        uint32_t weight = 0;
+        uint32_t leaf_line = 0;  // frame id of the innermost Lua line, UINT32_MAX if none
+        uint16_t depth = 0;
+        uint32_t frames[kMaxDepth]; // leaf first
+    };
+
+    struct FrameKey {
+        const void* source;
+        int line;
+        bool operator==(const FrameKey& o) const { return source == o.source && line == o.line; }
+    };
+    struct FrameKeyHash {
+        size_t operator()(const FrameKey& k) const {
+            return std::hash<const void*>()(k.source) ^ (static_cast<size_t>(k.line) * 0x9E3779B97F4A7C15ull);
+        }
+    };
+
+    struct FrameEntry {
+        uint32_t id;
+        std::string identity; // what key.source pointed at, in case the address was reused
+    };
+
+    // Id of the frame `ar` describes; `line_only` for the file:line of hot_lines.
+    uint32_t frame_id(const lua_Debug& ar, bool line_only);
+    uint32_t label_id(const std::string& label);
+
+    lua_State* L_ = nullptr;
+    SamplerConfig config_;
+    SampleMode active_mode_ = SampleMode::Instructions;
+    uint64_t start_us_ = 0;
+
+    std::vector<RawSample> ring_;
+    size_t ring_head_ = 0, ring_tail_ = 0; // samples written / folded
+
+    std::unordered_map<FrameKey, FrameEntry, FrameKeyHash> frame_ids_;
+    std::unordered_map<FrameKey, FrameEntry, FrameKeyHash> line_ids_;
+    std::vector<std::string> frame_labels_; // by id
+    std::unordered_map<std::string, uint32_t> label_ids_;
+
+    std::map<std::vector<uint32_t>, uint64_t> stacks_; // root first
+    std::unordered_map<uint32_t, uint64_t> line_self_;
+    std::vector<std::pair<uint64_t, std::vector<uint32_t>>> timeline_;
+    uint64_t total_ = 0;
+};
+
+// The sampler for the master Lua state (main thread only).
+Sampler& sampler();
+
+// Lua table `lua_profiler`.
+void exposeToLua(sol::state& lua);
+
+} // namespace lua_profiler
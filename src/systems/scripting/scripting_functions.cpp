@@ -18,6 +18,7 @@
 #include "../sound/sound_system.hpp"
 #include "../text/textVer2.hpp"
 #include "../timer/timer.hpp"
+#include "../timer/tween_system.hpp"
 #include "../transform/transform_functions.hpp"
 #include "../tutorial/tutorial_system_v2.hpp"
 #include "../ui/ui.hpp"
@@ -57,7 +58,10 @@
 #include "core/ownership.hpp"
 
 #include "lua_hot_reload.hpp"
+#include "lua_sampler.hpp"
+#include "ffi_component_views.hpp"
 
+#include "bytecode_cache.hpp"
 #include "meta_helper.hpp"
 #include "registry_bond.hpp"
 #include "script_process.hpp"
@@ -125,6 +129,11 @@ auto initLuaMasterState(sol::state &stateToInit,
   });
   SPDLOG_DEBUG("Lua path set to: {}", lua_path_cmd);
 
+  // scripts and require()d modules load from precompiled bytecode when unchanged
+  bytecode_cache::configure(base1,
+                            util::getRawAssetPathNoUUID("cache/lua_bytecode/"));
+  bytecode_cache::install_searcher(stateToInit);
+
   //---------------------------------------------------------
   // methods from ai_system.cpp. These can be called from lua,
   // binding before anything else because it is used in the init function
@@ -260,6 +269,7 @@ auto initLuaMasterState(sol::state &stateToInit,
   // methods from timer.cpp. These can be called from lua✅
   //---------------------------------------------------------
   // timer::exposeToLua(stateToInit);
+  timer::TweenSystem::exposeToLua(stateToInit);
 
   //---------------------------------------------------------
   // methods from sound_system.cpp. These can be called from lua✅
@@ -276,6 +286,16 @@ auto initLuaMasterState(sol::state &stateToInit,
   //---------------------------------------------------------
   telemetry::exposeToLua(stateToInit);
 
+  //---------------------------------------------------------
+  // sampling profiler for Lua call stacks (lua_sampler.cpp)
+  //---------------------------------------------------------
+  lua_profiler::exposeToLua(stateToInit);
+
+  //---------------------------------------------------------
+  // LuaJIT FFI views into component storage (ffi_component_views.cpp)
+  //---------------------------------------------------------
+  ffi_views::exposeToLua(stateToInit);
+
   //---------------------------------------------------------
   // ownership validation (game stealing prevention)
   //---------------------------------------------------------
@@ -405,7 +425,7 @@ auto initLuaMasterState(sol::state &stateToInit,
   stateToInit.set_function("safe_script_file",
                            [](const std::string &path, sol::this_state s) {
                              sol::state_view lua(s);
-                             return lua.script_file(path);
+                             return bytecode_cache::script_file(lua, path);
                            });
 
   for (auto &filename : scriptFilesToRead) {
@@ -446,6 +466,9 @@ auto initLuaMasterState(sol::state &stateToInit,
                        }
                        return pfr;
                      });
+  const auto &cacheStats = bytecode_cache::stats();
+  SPDLOG_INFO("Lua bytecode cache: {} chunks from cache, {} compiled ({} stale)",
+              cacheStats.hits, cacheStats.compiled, cacheStats.stale);
 
   // 5) Finally dump out your definitions:
   rec.dump_lua_defs(
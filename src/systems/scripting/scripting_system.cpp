@@ -1,11 +1,17 @@
 #include <thread>
 #include <chrono>
+#include <cstring>
+#include <vector>
 #include "util/common_headers.hpp" // common headers like json, spdlog, tracy etc.
 #include "scripting_system.hpp"
 #include "util/crash_reporter.hpp"
 
 #include "registry_bond.hpp"
+#include "bulk_component_access.hpp"
+#include "ffi_component_views.hpp"
+#include "lua_sampler.hpp"
 
+#include "systems/entity_gamestate_management/entity_gamestate_management.hpp"
 #include "systems/spring/spring.hpp"
 #include "systems/ui/ui.hpp"
 #include "systems/particles/particle.hpp"
@@ -59,6 +65,7 @@ namespace scripting
                          static_cast<uint32_t>(entity));
         }
 
+        script.owner = entity;
         script.self["id"] = sol::readonly_property([entity]
                                                    { return entity; });
         script.self["owner"] = std::ref(registry);
@@ -87,10 +94,7 @@ namespace scripting
     void release_script(entt::registry &registry, entt::entity entity)
     {
         auto &script = registry.get<ScriptComponent>(entity);
-        // Drop coroutine refs first so their destructors don't touch a dead lua_State.
-        for (auto &task : script.tasks)
-            task.abandon();
-        script.tasks.clear();
+        task_scheduler().cancel_owner(entity);
 
         lua_State *script_state = script.self.lua_state();
         lua_State *master_state = ai_system::masterStateLua.lua_state();
@@ -104,6 +108,8 @@ namespace scripting
                                  static_cast<uint32_t>(entity), err.what());
                 }
             }
+            // A batched update already in flight skips scripts released mid-batch.
+            script.self["__entity_id"] = sol::lua_nil;
         }
 
         // Clear hooks before abandoning to prevent dangling references
@@ -120,76 +126,194 @@ namespace scripting
     /**
      * @brief Updates all active script components in the registry.
      *
-     * For each entity with a `ScriptComponent`, it calls the cached `update` hook
-     * from the Lua table, passing the Lua `self` and the delta time.
+     * Calls the cached `update` hook of each active `ScriptComponent` (passing
+     * `self` and the delta time) the way set_script_update_dispatch() says,
+     * then resumes the script tasks that are due.
      *
      * @param registry The ECS registry containing entities with scripts.
      * @param delta_time The time elapsed since the last frame.
      */
+    namespace
+    {
+        ScriptUpdateDispatch g_updateDispatch = ScriptUpdateDispatch::Off;
+
+        // Lua side of ScriptUpdateDispatch::Batched. C++ fills selves/hooks and
+        // calls run once; failures come back in errors as (index, message) pairs.
+        // run empties selves/hooks again, so the driver never keeps a released
+        // script's table or hook alive between frames (or after the mode changes).
+        constexpr const char *kBatchedUpdateDriver = R"lua(
+local pcall, tostring = pcall, tostring
+local selves, hooks, errors = {}, {}, {}
+local function run(n, dt)
+    local failed = 0
+    for i = 1, n do
+        local self = selves[i]
+        -- nil once a hook earlier in this batch destroyed the entity
+        if self.__entity_id ~= nil then
+            local ok, err = pcall(hooks[i], self, dt)
+            if not ok then
+                errors[failed * 2 + 1] = i
+                errors[failed * 2 + 2] = tostring(err)
+                failed = failed + 1
+            end
+        end
+    end
+    for i = 1, n do
+        selves[i] = nil
+        hooks[i] = nil
+    end
+    return failed
+end
+return { run = run, selves = selves, hooks = hooks, errors = errors }
+)lua";
+
+        // Registry key of the driver table; it lives in the Lua state, so a
+        // state reset simply builds a new one.
+        char g_batchedDriverKey;
+
+        bool update_is_active(entt::registry &registry, entt::entity entity)
+        {
+            if (auto *tag = registry.try_get<entity_gamestate_management::StateTag>(entity)) {
+                return entity_gamestate_management::active_states_instance().is_active(*tag);
+            }
+            return true;
+        }
+
+        void dispatch_per_entity(entt::registry &registry, float delta_time)
+        {
+            auto view = registry.view<ScriptComponent>();
+            for (auto [entity, script] : view.each()) {
+                if (!script.hooks.update.valid() || !update_is_active(registry, entity))
+                    continue;
+                auto result = script.hooks.update(script.self, delta_time);
+                if (!result.valid()) {
+                    sol::error err = result;
+                    spdlog::error("[Script Error] Entity {}: {}", static_cast<uint32_t>(entity), err.what());
+                }
+            }
+        }
+
+        // Pushes the driver table, building it on first use in this state.
+        bool push_batched_driver(lua_State *L)
+        {
+            lua_pushlightuserdata(L, &g_batchedDriverKey);
+            lua_rawget(L, LUA_REGISTRYINDEX);
+            if (lua_istable(L, -1))
+                return true;
+            lua_pop(L, 1);
+
+            if (luaL_loadbuffer(L, kBatchedUpdateDriver, std::strlen(kBatchedUpdateDriver), "=batched_update") != 0 ||
+                lua_pcall(L, 0, 1, 0) != 0) {
+                spdlog::error("[scripting] Batched update driver failed to load: {}", lua_tostring(L, -1));
+                lua_pop(L, 1);
+                return false;
+            }
+            lua_pushlightuserdata(L, &g_batchedDriverKey);
+            lua_pushvalue(L, -2);
+            lua_rawset(L, LUA_REGISTRYINDEX);
+            return true;
+        }
+
+        void dispatch_batched(entt::registry &registry, float delta_time)
+        {
+            static std::vector<entt::entity> batch; // batch order, to name failing entities
+            lua_State *L = ai_system::masterStateLua.lua_state();
+            const int top = lua_gettop(L);
+            if (!push_batched_driver(L)) {
+                g_updateDispatch = ScriptUpdateDispatch::PerEntity;
+                return;
+            }
+            const int driver = lua_gettop(L);
+            lua_getfield(L, driver, "selves");
+            lua_getfield(L, driver, "hooks");
+            const int selves = driver + 1;
+            const int hooks = driver + 2;
+
+            batch.clear();
+            auto view = registry.view<ScriptComponent>();
+            for (auto [entity, script] : view.each()) {
+                if (!script.hooks.update.valid() || !update_is_active(registry, entity))
+                    continue;
+                batch.push_back(entity);
+                const int index = static_cast<int>(batch.size());
+                script.self.push(L);
+                lua_rawseti(L, selves, index);
+                script.hooks.update.push(L);
+                lua_rawseti(L, hooks, index);
+            }
+
+            lua_getfield(L, driver, "run");
+            lua_pushinteger(L, static_cast<lua_Integer>(batch.size()));
+            lua_pushnumber(L, delta_time);
+            if (lua_pcall(L, 2, 1, 0) != 0) {
+                spdlog::error("[Script Error] Batched update: {}", lua_tostring(L, -1));
+                // run did not get to empty the arrays
+                for (int i = 1; i <= static_cast<int>(batch.size()); ++i) {
+                    lua_pushnil(L);
+                    lua_rawseti(L, selves, i);
+                    lua_pushnil(L);
+                    lua_rawseti(L, hooks, i);
+                }
+                lua_settop(L, top);
+                return;
+            }
+
+            const int failed = static_cast<int>(lua_tointeger(L, -1));
+            if (failed > 0) {
+                lua_getfield(L, driver, "errors");
+                const int errors = lua_gettop(L);
+                for (int i = 0; i < failed; ++i) {
+                    lua_rawgeti(L, errors, i * 2 + 1);
+                    lua_rawgeti(L, errors, i * 2 + 2);
+                    const auto index = static_cast<size_t>(lua_tointeger(L, -2));
+                    const char *message = lua_tostring(L, -1);
+                    const auto entity = index >= 1 && index <= batch.size() ? batch[index - 1] : entt::entity{entt::null};
+                    spdlog::error("[Script Error] Entity {}: {}", static_cast<uint32_t>(entity),
+                                  message ? message : "(error object is not a string)");
+                    lua_pop(L, 2);
+                }
+            }
+            lua_settop(L, top);
+        }
+    }
+
+    void set_script_update_dispatch(ScriptUpdateDispatch mode)
+    {
+        g_updateDispatch = mode;
+    }
+
+    ScriptUpdateDispatch script_update_dispatch()
+    {
+        return g_updateDispatch;
+    }
+
+    bool parse_script_update_dispatch(std::string_view name, ScriptUpdateDispatch &out)
+    {
+        if (name == "off") out = ScriptUpdateDispatch::Off;
+        else if (name == "per_entity") out = ScriptUpdateDispatch::PerEntity;
+        else if (name == "batched") out = ScriptUpdateDispatch::Batched;
+        else return false;
+        return true;
+    }
+
     void script_system_update(entt::registry &registry, float delta_time)
     {
         ZONE_SCOPED("scripting::script_system_update");
-        // Note: Don't use static view - it can become stale if registry structure changes
-        auto view = registry.view<ScriptComponent>();
-        // for (auto [entity, script] : view.each()) {
-            
-        //     ZONE_SCOPED("scripting::script_system_update - per entity");
-        //     {
-        //         ZONE_SCOPED("scripting::script_system_update - is active check");
-        //         // Filter only if tagged
-        //         if (auto *tag = registry.try_get<entity_gamestate_management::StateTag>(entity)) {
-        //             if (!entity_gamestate_management::active_states_instance().is_active(*tag))
-        //                 continue;
-        //         }
-        //     }
-            
-        //     // 1. Run normal update
-        //     try {
-        //         script.hooks.update(script.self, delta_time);
-        //     } catch (const sol::error& e) {
-        //         spdlog::error("[Script Error] Entity {}: {}", static_cast<uint32_t>(entity), e.what());
-        //     }
+        lua_profiler::sampler().rearm(); // in case a script replaced or cleared the hook
+
+        switch (g_updateDispatch) {
+        case ScriptUpdateDispatch::PerEntity:
+            dispatch_per_entity(registry, delta_time);
+            break;
+        case ScriptUpdateDispatch::Batched:
+            dispatch_batched(registry, delta_time);
+            break;
+        case ScriptUpdateDispatch::Off:
+            break;
+        }
 
-            
-        //     // FIXME: just removing tasks, we don't need this, and it's a performance hog.
-            
-        //     // // 2. Process all coroutine tasks using a safe-swap pattern
-        //     // auto& tasks = script.tasks;
-        //     // if (tasks.empty()) {
-        //     //     continue;
-        //     // }
-            
-        //     // // Create a new vector to hold tasks that are still active for the next frame.
-        //     // std::vector<sol::coroutine> next_tasks;
-        //     // next_tasks.reserve(tasks.size());
-
-        //     // // Process each task from the current list.
-        //     // for (auto& task : tasks) {
-        //     //     // Skip any tasks that might already be invalid.
-        //     //     if (!task.valid()) {
-        //     //         continue;
-        //     //     }
-                
-        //     //     // Resume any task that is not finished. This includes 'suspended' (new) and 'yielded' tasks.
-        //     //     sol::protected_function_result result = task(delta_time);
-        //     //     if (!result.valid()) {
-        //     //         sol::error err = result;
-        //     //         std::cerr << "[Coroutine Error] " << err.what() << "\n";
-        //     //         // Do not add the failed task to the next_tasks list, effectively removing it.
-        //     //         continue;
-        //     //     }
-
-        //     //     // After running, if the task is still valid and not finished, keep it.
-        //     //     if (task.valid() && task.status() != sol::call_status::ok) {
-        //     //         next_tasks.push_back(task);
-        //     //     }
-        //     // }
-
-        //     // // Replace the old task list with the new list of active tasks.
-        //     // tasks = std::move(next_tasks);
-                        
-
-        // }
+        // Coroutine tasks: only the ones whose wait is over are resumed.
+        task_scheduler().update(delta_time);
     }
     
 
@@ -390,6 +514,55 @@ namespace scripting
 
         }
         
+        // Fields scripts can move with bulk.read / bulk.write (see bulk_component_access.hpp).
+        static void register_bulk_fields()
+        {
+            using transform::Transform;
+            using transform::GameObject;
+            using physics::ColliderComponent;
+
+            bulk::register_field<Transform>("actual_x", [](Transform &t) { return t.getActualX(); }, [](Transform &t, double v) { t.setActualX(static_cast<float>(v)); });
+            bulk::register_field<Transform>("actual_y", [](Transform &t) { return t.getActualY(); }, [](Transform &t, double v) { t.setActualY(static_cast<float>(v)); });
+            bulk::register_field<Transform>("actual_w", [](Transform &t) { return t.getActualW(); }, [](Transform &t, double v) { t.setActualW(static_cast<float>(v)); });
+            bulk::register_field<Transform>("actual_h", [](Transform &t) { return t.getActualH(); }, [](Transform &t, double v) { t.setActualH(static_cast<float>(v)); });
+            bulk::register_field<Transform>("actual_r", [](Transform &t) { return t.getActualRotation(); }, [](Transform &t, double v) { t.setActualRotation(static_cast<float>(v)); });
+            bulk::register_field<Transform>("actual_s", [](Transform &t) { return t.getActualScale(); }, [](Transform &t, double v) { t.setActualScale(static_cast<float>(v)); });
+            bulk::register_field<Transform>("visual_x", [](Transform &t) { return t.getVisualX(); }, [](Transform &t, double v) { t.setVisualX(static_cast<float>(v)); });
+            bulk::register_field<Transform>("visual_y", [](Transform &t) { return t.getVisualY(); }, [](Transform &t, double v) { t.setVisualY(static_cast<float>(v)); });
+            bulk::register_field<Transform>("visual_w", [](Transform &t) { return t.getVisualW(); }, [](Transform &t, double v) { t.setVisualW(static_cast<float>(v)); });
+            bulk::register_field<Transform>("visual_h", [](Transform &t) { return t.getVisualH(); }, [](Transform &t, double v) { t.setVisualH(static_cast<float>(v)); });
+            bulk::register_field<Transform>("visual_r", [](Transform &t) { return t.getVisualR(); }, [](Transform &t, double v) { t.setVisualRotation(static_cast<float>(v)); });
+            bulk::register_field<Transform>("visual_s", [](Transform &t) { return t.getVisualScale(); }, [](Transform &t, double v) { t.setVisualScale(static_cast<float>(v)); });
+
+            // GameObject flags, as 0 or 1
+            bulk::register_field<GameObject>("visible", [](GameObject &g) { return g.state.visible; }, [](GameObject &g, double v) { g.state.visible = v != 0.0; });
+            bulk::register_field<GameObject>("collision_enabled", [](GameObject &g) { return g.state.collisionEnabled; }, [](GameObject &g, double v) { g.state.collisionEnabled = v != 0.0; });
+            bulk::register_field<GameObject>("hover_enabled", [](GameObject &g) { return g.state.hoverEnabled; }, [](GameObject &g, double v) { g.state.hoverEnabled = v != 0.0; });
+            bulk::register_field<GameObject>("click_enabled", [](GameObject &g) { return g.state.clickEnabled; }, [](GameObject &g, double v) { g.state.clickEnabled = v != 0.0; });
+            bulk::register_field<GameObject>("drag_enabled", [](GameObject &g) { return g.state.dragEnabled; }, [](GameObject &g, double v) { g.state.dragEnabled = v != 0.0; });
+            bulk::register_field<GameObject>("is_being_hovered", [](GameObject &g) { return g.state.isBeingHovered; });
+
+            // Chipmunk body of the collider (0 when it has none)
+            bulk::register_field<ColliderComponent>("body_x",
+                [](ColliderComponent &c) { return c.body ? cpBodyGetPosition(c.body.get()).x : 0.0; },
+                [](ColliderComponent &c, double v) { if (c.body) cpBodySetPosition(c.body.get(), cpv(v, cpBodyGetPosition(c.body.get()).y)); });
+            bulk::register_field<ColliderComponent>("body_y",
+                [](ColliderComponent &c) { return c.body ? cpBodyGetPosition(c.body.get()).y : 0.0; },
+                [](ColliderComponent &c, double v) { if (c.body) cpBodySetPosition(c.body.get(), cpv(cpBodyGetPosition(c.body.get()).x, v)); });
+            bulk::register_field<ColliderComponent>("velocity_x",
+                [](ColliderComponent &c) { return c.body ? cpBodyGetVelocity(c.body.get()).x : 0.0; },
+                [](ColliderComponent &c, double v) { if (c.body) cpBodySetVelocity(c.body.get(), cpv(v, cpBodyGetVelocity(c.body.get()).y)); });
+            bulk::register_field<ColliderComponent>("velocity_y",
+                [](ColliderComponent &c) { return c.body ? cpBodyGetVelocity(c.body.get()).y : 0.0; },
+                [](ColliderComponent &c, double v) { if (c.body) cpBodySetVelocity(c.body.get(), cpv(cpBodyGetVelocity(c.body.get()).x, v)); });
+            bulk::register_field<ColliderComponent>("angle",
+                [](ColliderComponent &c) { return c.body ? cpBodyGetAngle(c.body.get()) : 0.0; },
+                [](ColliderComponent &c, double v) { if (c.body) cpBodySetAngle(c.body.get(), v); });
+            bulk::register_field<ColliderComponent>("angular_velocity",
+                [](ColliderComponent &c) { return c.body ? cpBodyGetAngularVelocity(c.body.get()) : 0.0; },
+                [](ColliderComponent &c, double v) { if (c.body) cpBodySetAngularVelocity(c.body.get(), v); });
+        }
+
         /**
          * @brief Initializes the scripting system.
          *
@@ -451,6 +624,11 @@ namespace scripting
             */
             lua.require("registry", sol::c_call<AUTO_ARG(&open_registry)>, false);
 
+            register_bulk_fields();
+            bulk::exposeToLua(lua);
+            ffi_views::install(registry); // ecs_ffi is defined in initLuaMasterState
+            exposeTaskSchedulerToLua(lua);
+
             // Register crash reporter game state callback
             crash_reporter::SetGameStateCallback([&registry, &lua](crash_reporter::Report& report) {
                 // Set current scene from game state
@@ -508,23 +686,22 @@ namespace scripting
         auto update(entt::registry &registry, float delta_time) -> void
         {
             script_system_update(registry, delta_time);
+            ffi_views::flush();
         }
 
         void shutdown(entt::registry &registry)
         {
             // Avoid firing release_script during registry.clear on shutdown.
             registry.on_destroy<ScriptComponent>().disconnect<&release_script>();
+            ffi_views::uninstall();
 
             // Drop Lua references while the state is still alive to prevent destructor crashes later.
+            task_scheduler().clear();
             auto view = registry.view<ScriptComponent>();
             for (auto entity : view)
             {
                 if (auto *sc = registry.try_get<ScriptComponent>(entity))
                 {
-                    for (auto &task : sc->tasks)
-                        task.abandon();
-                    sc->tasks.clear();
-
                     sc->hooks.update = sol::lua_nil;
                     sc->hooks.on_collision = sol::lua_nil;
                     sc->self = sol::lua_nil;
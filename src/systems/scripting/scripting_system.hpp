@@ -2,8 +2,10 @@
 
 #include <thread>
 #include <chrono>
+#include <string_view>
 
 #include "registry_bond.hpp"
+#include "task_scheduler.hpp"
 
 #include "systems/ui/ui.hpp"
 #include "systems/particles/particle.hpp"
@@ -33,48 +35,27 @@ namespace scripting
         sol::table self;
         struct
         {
-            sol::function update; ///< Update hook called every frame (if exists)
+            sol::protected_function update; ///< Update hook called every frame (if exists)
             sol::function on_collision; // called for collisions with other entities
         } hooks;
         
-        // list of currently running Lua coroutines (tasks)
-        std::vector<sol::coroutine> tasks;
+        // the entity this script is attached to; owns the script's tasks
+        entt::entity owner{entt::null};
 
+        // Runs obj (a function or coroutine) on the task scheduler, owned by
+        // this entity: cancelled when the script is released. Refused before
+        // init_script has set the owner, since nothing would cancel the task.
         void add_task(sol::object obj) {
-            try {
-                if (obj.is<sol::function>()) {
-                    sol::function fn = obj.as<sol::function>();
-                    sol::thread thread = sol::thread::create(ai_system::masterStateLua);
-                    sol::state_view ts = thread.state();
-                    ts["__fn"] = fn;
-                    sol::coroutine co = ts["__fn"];
-                    tasks.emplace_back(std::move(co));
-                    SPDLOG_DEBUG("Added coroutine from function via new thread.");
-                }
-                else if (obj.is<sol::coroutine>()) {
-                    tasks.emplace_back(obj.as<sol::coroutine>());
-                    SPDLOG_DEBUG("Added coroutine.");
-                }
-                else if (obj.get_type() == sol::type::thread) {
-                    sol::thread th = obj;
-                    tasks.emplace_back(sol::coroutine(th));
-                    SPDLOG_DEBUG("Added coroutine from thread object.");
-                }
-                else {
-                    spdlog::warn("Invalid coroutine object: type = {}", static_cast<int>(obj.get_type()));
-                }
-            }
-            catch (const sol::error& e) {
-                spdlog::error("Lua error in add_task: {}", e.what());
-            }
-            catch (const std::exception& e) {
-                spdlog::error("Exception in add_task: {}", e.what());
+            if (owner == entt::null) {
+                spdlog::warn("add_task: script is not attached to an entity yet; task not scheduled");
+                return;
             }
+            if (task_scheduler().spawn(obj, owner) == kNoTask)
+                spdlog::warn("Invalid coroutine object: type = {}", static_cast<int>(obj.get_type()));
         }
-        
 
         std::size_t count_tasks() const {
-            return tasks.size();
+            return task_scheduler().count(owner);
         }
         
         // Keep the default constructor for other C++ systems.
@@ -120,13 +101,31 @@ namespace scripting
     /**
      * @brief Updates all active script components in the registry.
      *
-     * For each entity with a `ScriptComponent`, it calls the cached `update` hook
-     * from the Lua table, passing the Lua `self` and the delta time.
+     * Calls the cached `update` hook of each active `ScriptComponent` (passing
+     * `self` and the delta time) the way set_script_update_dispatch() says,
+     * then resumes the script tasks that are due.
      *
      * @param registry The ECS registry containing entities with scripts.
      * @param delta_time The time elapsed since the last frame.
      */
     extern void script_system_update(entt::registry &registry, float delta_time);
+
+    /**
+     * @brief How script_system_update calls the cached `update` hooks.
+     *
+     * - Off: hooks are not called; scripts run through tasks and timers.
+     * - PerEntity: one call from C++ per scripted entity.
+     * - Batched: C++ collects the active scripts in view order and makes a
+     *   single protected call into a Lua-side driver, which runs each hook
+     *   under pcall. Errors are still reported per entity.
+     */
+    enum class ScriptUpdateDispatch { Off, PerEntity, Batched };
+
+    extern void set_script_update_dispatch(ScriptUpdateDispatch mode);
+    extern ScriptUpdateDispatch script_update_dispatch();
+
+    /// "off", "per_entity" or "batched"; false (and `out` untouched) otherwise.
+    extern bool parse_script_update_dispatch(std::string_view name, ScriptUpdateDispatch &out);
     
 
     namespace monobehavior_system {
@@ -0,0 +1,493 @@
+#include "task_scheduler.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "binding_recorder.hpp"
+#include "lua_sampler.hpp"
+#include "spdlog/spdlog.h"
+
+namespace scripting
+{
+    namespace
+    {
+        constexpr uint32_t kIndexBits = 20;
+        constexpr uint32_t kIndexMask = (1u << kIndexBits) - 1;
+        constexpr uint32_t kGenerationMask = 0xFFFu; // what is left of 32 bits
+
+        int resume_coroutine(lua_State *co, lua_State *from, int nargs, int *nresults)
+        {
+#if LUA_VERSION_NUM >= 504
+            return lua_resume(co, from, nargs, nresults);
+#else
+            const int status = lua_resume(co, from, nargs); // sol's compat layer drops `from` on 5.1
+            *nresults = lua_gettop(co);
+            return status;
+#endif
+        }
+
+        // A coroutine that can be resumed: yielded, or created and not started yet.
+        bool resumable(lua_State *co)
+        {
+            if (lua_status(co) == LUA_YIELD) return true;
+            if (lua_status(co) != 0) return false;
+            lua_Debug ar;
+            if (lua_getstack(co, 0, &ar)) return false; // running, or resuming another
+            return lua_gettop(co) > 0;                  // the function is waiting on its stack
+        }
+
+        // --- Lua side -------------------------------------------------
+
+        // The wait helpers are C functions that yield, so resume values come
+        // back as their results (dt, or the arguments given to notify).
+        int lua_wait(lua_State *L)
+        {
+            luaL_checknumber(L, 1);
+            lua_settop(L, 1);
+            return lua_yield(L, 1);
+        }
+
+        int lua_wait_frames(lua_State *L)
+        {
+            const lua_Number frames = luaL_optnumber(L, 1, 1);
+            lua_settop(L, 0);
+            lua_pushliteral(L, "frames");
+            lua_pushnumber(L, frames);
+            return lua_yield(L, 2);
+        }
+
+        int lua_wait_event(lua_State *L)
+        {
+            luaL_checkany(L, 1);
+            if (lua_type(L, 1) == LUA_TNUMBER)
+            {
+                const lua_Integer event = lua_tointeger(L, 1);
+                if (event < 0 || static_cast<size_t>(event) >= task_scheduler().event_count())
+                    return luaL_argerror(L, 1, "unknown event id; get one from tasks.event_id");
+            }
+            lua_settop(L, 1);
+            lua_pushliteral(L, "event");
+            lua_insert(L, 1);
+            return lua_yield(L, 2);
+        }
+
+        int lua_next_frame(lua_State *L) { return lua_yield(L, 0); }
+
+        int lua_notify(lua_State *L)
+        {
+            TaskScheduler &tasks = task_scheduler();
+            TaskEventId event;
+            if (lua_type(L, 1) == LUA_TNUMBER)
+            {
+                event = static_cast<TaskEventId>(lua_tointeger(L, 1));
+            }
+            else
+            {
+                size_t length = 0;
+                const char *name = luaL_checklstring(L, 1, &length);
+                event = tasks.event_id(std::string(name, length));
+            }
+            const size_t woken = tasks.notify(event, L, 2, lua_gettop(L) - 1);
+            lua_pushinteger(L, static_cast<lua_Integer>(woken));
+            return 1;
+        }
+    }
+
+    TaskScheduler &task_scheduler()
+    {
+        static TaskScheduler scheduler;
+        return scheduler;
+    }
+
+    TaskHandle TaskScheduler::handle_of(uint32_t index) const
+    {
+        return (slots_[index].generation << kIndexBits) | index;
+    }
+
+    TaskScheduler::Slot *TaskScheduler::slot_for(TaskHandle handle)
+    {
+        const uint32_t index = handle & kIndexMask;
+        if (handle == kNoTask || index >= slots_.size()) return nullptr;
+        Slot &slot = slots_[index];
+        if (!slot.alive || slot.cancelled || slot.generation != (handle >> kIndexBits)) return nullptr;
+        return &slot;
+    }
+
+    const TaskScheduler::Slot *TaskScheduler::slot_for(TaskHandle handle) const
+    {
+        return const_cast<TaskScheduler *>(this)->slot_for(handle);
+    }
+
+    TaskHandle TaskScheduler::spawn(const sol::object &fn, entt::entity owner)
+    {
+        lua_State *L = fn.lua_state();
+        if (!L) return kNoTask;
+        lua_State *main = sol::main_thread(L, L); // references outlive whichever coroutine spawned us
+
+        lua_State *co = nullptr;
+        if (fn.get_type() == sol::type::function)
+        {
+            co = lua_newthread(main);
+            fn.push(co);
+        }
+        else if (fn.get_type() == sol::type::thread)
+        {
+            fn.push(main);
+            co = lua_tothread(main, -1);
+            if (!resumable(co))
+            {
+                lua_pop(main, 1);
+                SPDLOG_WARN("tasks: coroutine is running or dead; not scheduled");
+                return kNoTask;
+            }
+        }
+        else
+        {
+            SPDLOG_WARN("tasks: expected a function or coroutine, got {}", sol::type_name(L, fn.get_type()));
+            return kNoTask;
+        }
+
+        uint32_t index;
+        if (!freeSlots_.empty())
+        {
+            index = freeSlots_.back();
+            freeSlots_.pop_back();
+        }
+        else
+        {
+            index = static_cast<uint32_t>(slots_.size());
+            slots_.emplace_back();
+        }
+
+        Slot &slot = slots_[index];
+        slot.thread = sol::thread(main, -1);
+        lua_pop(main, 1);
+        slot.co = co;
+        slot.main = main;
+        slot.owner = owner;
+        slot.alive = true;
+        slot.wait = Wait::NextFrame;
+        ++live_;
+
+        const TaskHandle handle = handle_of(index);
+        nextFrame_.push_back(handle);
+        if (owner != entt::null) owned_[owner].push_back(handle);
+        return handle;
+    }
+
+    bool TaskScheduler::cancel(TaskHandle handle)
+    {
+        if (!slot_for(handle)) return false;
+        erase(handle & kIndexMask);
+        return true;
+    }
+
+    size_t TaskScheduler::cancel_owner(entt::entity owner)
+    {
+        auto it = owned_.find(owner);
+        if (it == owned_.end()) return 0;
+        const std::vector<TaskHandle> handles = std::move(it->second);
+        owned_.erase(it);
+
+        size_t cancelled = 0;
+        for (TaskHandle handle : handles)
+        {
+            if (Slot *slot = slot_for(handle))
+            {
+                slot->owner = entt::null; // already disowned
+                erase(handle & kIndexMask);
+                ++cancelled;
+            }
+        }
+        return cancelled;
+    }
+
+    bool TaskScheduler::alive(TaskHandle handle) const { return slot_for(handle) != nullptr; }
+
+    size_t TaskScheduler::count(entt::entity owner) const
+    {
+        auto it = owned_.find(owner);
+        return it == owned_.end() ? 0 : it->second.size();
+    }
+
+    TaskEventId TaskScheduler::event_id(const std::string &name)
+    {
+        auto [it, inserted] = eventIds_.try_emplace(name, static_cast<TaskEventId>(eventWaiters_.size()));
+        if (inserted) eventWaiters_.emplace_back();
+        return it->second;
+    }
+
+    size_t TaskScheduler::notify(TaskEventId event, lua_State *L, int firstArg, int argCount)
+    {
+        if (event >= eventWaiters_.size() || eventWaiters_[event].empty()) return 0;
+
+        // Tasks that wait on the event again while being resumed go on the fresh list.
+        std::vector<TaskHandle> waiters;
+        waiters.swap(eventWaiters_[event]);
+
+        size_t woken = 0;
+        for (TaskHandle handle : waiters)
+        {
+            Slot *slot = slot_for(handle);
+            if (!slot || slot->wait != Wait::Event || slot->event != event || slot->running) continue;
+
+            if (L && argCount > 0)
+            {
+                lua_checkstack(slot->co, argCount);
+                for (int i = 0; i < argCount; ++i) lua_pushvalue(L, firstArg + i);
+                lua_xmove(L, slot->co, argCount);
+            }
+            resume(handle & kIndexMask, L ? argCount : 0);
+            ++woken;
+        }
+
+        if (eventWaiters_[event].empty())
+        {
+            waiters.clear();
+            eventWaiters_[event].swap(waiters); // keep the capacity
+        }
+        return woken;
+    }
+
+    void TaskScheduler::update(float dt)
+    {
+        clock_ += dt;
+        ++frame_;
+        dt_ = dt;
+
+        // Take what is due before resuming anything: a task resumed below that
+        // waits 0 seconds or frames is keyed at now and must not run again
+        // until the next update.
+        dueFrames_.clear();
+        frames_.popDue(static_cast<double>(frame_), dueFrames_);
+        dueSeconds_.clear();
+        seconds_.popDue(clock_, dueSeconds_);
+
+        resuming_.clear();
+        resuming_.swap(nextFrame_);
+        for (TaskHandle handle : resuming_)
+        {
+            const Slot *slot = slot_for(handle);
+            if (slot && slot->wait == Wait::NextFrame && !slot->running) resume_with_dt(handle & kIndexMask);
+        }
+        resuming_.clear();
+
+        for (timer::TimerSchedule::Key index : dueFrames_)
+        {
+            if (slots_[index].alive && slots_[index].wait == Wait::Frames && !frames_.scheduled(index))
+                resume_with_dt(index);
+        }
+
+        for (timer::TimerSchedule::Key index : dueSeconds_)
+        {
+            if (slots_[index].alive && slots_[index].wait == Wait::Seconds && !seconds_.scheduled(index))
+                resume_with_dt(index);
+        }
+    }
+
+    bool TaskScheduler::in_task(lua_State *L) const
+    {
+        return running_ != UINT32_MAX && slots_[running_].co == L;
+    }
+
+    void TaskScheduler::clear()
+    {
+        for (uint32_t index = 0; index < slots_.size(); ++index)
+        {
+            if (slots_[index].alive) erase(index);
+        }
+        nextFrame_.clear();
+        for (auto &waiters : eventWaiters_) waiters.clear();
+        owned_.clear();
+    }
+
+    void TaskScheduler::resume_with_dt(uint32_t index)
+    {
+        lua_pushnumber(slots_[index].co, dt_);
+        resume(index, 1);
+    }
+
+    // The arguments are already on the coroutine's stack.
+    void TaskScheduler::resume(uint32_t index, int nargs)
+    {
+        lua_State *co = slots_[index].co;
+        slots_[index].wait = Wait::None;
+        slots_[index].running = true;
+        const uint32_t outer = running_;
+        running_ = index;
+
+        lua_profiler::sampler().attach(co); // PUC Lua hooks coroutines one by one
+
+        int nresults = 0;
+        const int status = resume_coroutine(co, nullptr, nargs, &nresults);
+
+        running_ = outer;
+        Slot &slot = slots_[index]; // slots_ is a deque: still the same slot
+        slot.running = false;
+
+        if (status == LUA_YIELD && !slot.cancelled)
+        {
+            wait_on(index, nresults);
+            return;
+        }
+        if (status != LUA_YIELD && status != 0)
+        {
+            const char *message = lua_tostring(co, -1);
+            luaL_traceback(slot.main, co, message ? message : "(error object is not a string)", 0);
+            spdlog::error("[Task Error] entity {}: {}", static_cast<uint32_t>(entt::to_integral(slot.owner)),
+                          lua_tostring(slot.main, -1));
+            lua_pop(slot.main, 1);
+        }
+        erase(index); // finished, failed or cancelled while running
+    }
+
+    // Reads what the task yielded (the top `nresults` values of its stack).
+    void TaskScheduler::wait_on(uint32_t index, int nresults)
+    {
+        Slot &slot = slots_[index];
+        lua_State *co = slot.co;
+        const int base = lua_gettop(co) - nresults + 1;
+        const TaskHandle handle = handle_of(index);
+
+        slot.wait = Wait::NextFrame;
+        if (nresults > 0 && lua_type(co, base) == LUA_TNUMBER)
+        {
+            slot.wait = Wait::Seconds;
+            seconds_.schedule(index, clock_ + std::max(0.0, static_cast<double>(lua_tonumber(co, base))));
+        }
+        else if (nresults > 0 && lua_type(co, base) == LUA_TSTRING)
+        {
+            const char *kind = lua_tostring(co, base);
+            if (std::strcmp(kind, "frames") == 0)
+            {
+                const lua_Number frames = nresults > 1 ? lua_tonumber(co, base + 1) : 1;
+                slot.wait = Wait::Frames;
+                frames_.schedule(index, static_cast<double>(frame_) + std::max<lua_Number>(1, frames));
+            }
+            else if (std::strcmp(kind, "event") == 0 && nresults > 1)
+            {
+                TaskEventId event;
+                if (lua_type(co, base + 1) == LUA_TNUMBER)
+                {
+                    event = static_cast<TaskEventId>(lua_tointeger(co, base + 1));
+                }
+                else
+                {
+                    size_t length = 0;
+                    const char *name = lua_tolstring(co, base + 1, &length);
+                    event = event_id(name ? std::string(name, length) : std::string{});
+                }
+                if (event >= eventWaiters_.size())
+                {
+                    // only a raw coroutine.yield gets here; wait_event raises instead
+                    spdlog::error("[Task Error] entity {}: waits on event id {}, which was never interned",
+                                  static_cast<uint32_t>(entt::to_integral(slot.owner)), event);
+                    lua_pop(co, nresults);
+                    erase(index);
+                    return;
+                }
+                slot.wait = Wait::Event;
+                slot.event = event;
+                eventWaiters_[event].push_back(handle);
+            }
+        }
+        if (slot.wait == Wait::NextFrame) nextFrame_.push_back(handle);
+        lua_pop(co, nresults);
+    }
+
+    // Frees the slot; handles to it go stale. A running task is only marked,
+    // and erased once its resume returns.
+    void TaskScheduler::erase(uint32_t index)
+    {
+        Slot &slot = slots_[index];
+        if (slot.owner != entt::null)
+        {
+            auto it = owned_.find(slot.owner);
+            if (it != owned_.end())
+            {
+                auto &handles = it->second;
+                handles.erase(std::remove(handles.begin(), handles.end(), handle_of(index)), handles.end());
+                if (handles.empty()) owned_.erase(it);
+            }
+            slot.owner = entt::null;
+        }
+        if (slot.running)
+        {
+            slot.cancelled = true;
+            return;
+        }
+
+        seconds_.unschedule(index);
+        frames_.unschedule(index);
+        slot.thread = sol::thread{}; // drops the reference; the coroutine is collected
+        slot.co = nullptr;
+        slot.main = nullptr;
+        slot.wait = Wait::None;
+        slot.alive = false;
+        slot.cancelled = false;
+        slot.generation = (slot.generation + 1) & kGenerationMask;
+        if (slot.generation == 0) slot.generation = 1;
+        freeSlots_.push_back(index);
+        --live_;
+    }
+
+    void exposeTaskSchedulerToLua(sol::state &lua)
+    {
+        auto &rec = BindingRecorder::instance();
+        rec.add_type("tasks").doc =
+            "Coroutine scheduler: tasks yield what they wait for and are only resumed once it is due.";
+
+        rec.bind_function(lua, {"tasks"}, "spawn",
+            [](sol::object fn, sol::optional<entt::entity> owner) {
+                return task_scheduler().spawn(fn, owner.value_or(entt::null));
+            },
+            "---@param fn function|thread # Runs as a coroutine, starting next update.\n"
+            "---@param owner? Entity # Cancelled when this entity's script is released.\n"
+            "---@return integer # Task handle, 0 if fn cannot be scheduled.",
+            "Starts a coroutine task.");
+        rec.bind_function(lua, {"tasks"}, "cancel",
+            [](TaskHandle handle) { return task_scheduler().cancel(handle); },
+            "---@param handle integer\n---@return boolean # false if the task was already gone.",
+            "Cancels a task. A task may cancel itself; it stops at its next yield.");
+        rec.bind_function(lua, {"tasks"}, "cancel_owner",
+            [](entt::entity owner) { return task_scheduler().cancel_owner(owner); },
+            "---@param owner Entity\n---@return integer # Tasks cancelled.",
+            "Cancels every task owned by the entity.");
+        rec.bind_function(lua, {"tasks"}, "alive",
+            [](TaskHandle handle) { return task_scheduler().alive(handle); },
+            "---@param handle integer\n---@return boolean",
+            "Whether the task is still scheduled.");
+        rec.bind_function(lua, {"tasks"}, "count",
+            [](sol::optional<entt::entity> owner) {
+                return owner ? task_scheduler().count(*owner) : task_scheduler().size();
+            },
+            "---@param owner? Entity\n---@return integer",
+            "Number of live tasks, or of those owned by `owner`.");
+        rec.bind_function(lua, {"tasks"}, "event_id",
+            [](const std::string &name) { return task_scheduler().event_id(name); },
+            "---@param name string\n---@return integer",
+            "Interns an event name. Waiting on and notifying the id skips the string lookup.");
+        rec.bind_function(lua, {"tasks"}, "in_task",
+            [](sol::this_state s) { return task_scheduler().in_task(s); },
+            "---@return boolean",
+            "True when called from a coroutine the scheduler is running.");
+
+        rec.bind_function(lua, {"tasks"}, "notify", &lua_notify,
+            "---@param event string|integer\n---@param ... any # Returned by wait_event in the woken tasks.\n"
+            "---@return integer # Tasks resumed.",
+            "Resumes every task waiting on the event, immediately.");
+        rec.bind_function(lua, {"tasks"}, "wait", &lua_wait,
+            "---@param seconds number\n---@return number # dt of the update that resumed the task.",
+            "Sleeps the current task for `seconds` of game update time.");
+        rec.bind_function(lua, {"tasks"}, "wait_frames", &lua_wait_frames,
+            "---@param frames? integer # Default 1.\n---@return number # dt of the update that resumed the task.",
+            "Sleeps the current task for a number of updates.");
+        rec.bind_function(lua, {"tasks"}, "wait_event", &lua_wait_event,
+            "---@param event string|integer # An id must come from tasks.event_id.\n"
+            "---@return any ... # The values passed to tasks.notify.",
+            "Sleeps the current task until the event is notified.");
+        rec.bind_function(lua, {"tasks"}, "next_frame", &lua_next_frame,
+            "---@return number # dt of the next update.",
+            "Sleeps the current task until the next update.");
+    }
+}
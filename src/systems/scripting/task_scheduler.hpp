@@ -0,0 +1,136 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "entt/entity/entity.hpp"
+#include "sol/sol.hpp"
+#include "systems/timer/timer_schedule.hpp"
+
+// Central scheduler for script coroutines (ScriptComponent tasks and
+// tasks.spawn). A task says what it waits for when it yields, and is only
+// resumed once that is due, so sleeping tasks cost nothing per frame:
+//
+//   coroutine.yield()                   next frame (resumed with dt)
+//   coroutine.yield(seconds)            after `seconds` of update time
+//   coroutine.yield("frames", n)        after n updates
+//   coroutine.yield("event", ev)        when tasks.notify(ev, ...) is called,
+//                                       resumed with notify's extra arguments;
+//                                       ev is a name or an id from event_id
+//
+// tasks.wait / wait_frames / wait_event / next_frame wrap these. Seconds and
+// frames waits sit in min-heaps, event waits in one list per event, and
+// next-frame waits in a plain list. Tasks may have an owner entity;
+// cancel_owner drops all of them at once when the entity goes away.
+namespace scripting
+{
+    // Slot index in the low 20 bits, the slot's generation in the high 12, so a
+    // handle to a finished task never reaches its slot's next occupant.
+    using TaskHandle = uint32_t;
+    constexpr TaskHandle kNoTask = 0;
+
+    using TaskEventId = uint32_t;
+
+    class TaskScheduler
+    {
+    public:
+        // fn is a function (run on a new coroutine) or a coroutine that has not
+        // finished. It first runs on the next update. kNoTask if fn is neither.
+        TaskHandle spawn(const sol::object &fn, entt::entity owner = entt::null);
+
+        // Safe from inside the task itself: it stops at its next yield.
+        bool cancel(TaskHandle handle);
+        size_t cancel_owner(entt::entity owner);
+
+        [[nodiscard]] bool alive(TaskHandle handle) const;
+        [[nodiscard]] size_t size() const { return live_; }
+        [[nodiscard]] size_t count(entt::entity owner) const;
+
+        // Event names are interned once; waiting on and notifying an id is a
+        // vector index.
+        TaskEventId event_id(const std::string &name);
+        [[nodiscard]] size_t event_count() const { return eventWaiters_.size(); }
+
+        // Resumes every task waiting on the event, right away, passing the
+        // values at stack indices [firstArg, firstArg + argCount) of L.
+        // Returns how many were resumed.
+        size_t notify(TaskEventId event, lua_State *L = nullptr, int firstArg = 0, int argCount = 0);
+
+        // Advances the scheduler clock and resumes the tasks that are due:
+        // next-frame waits, then frame waits, then seconds waits, each task at
+        // most once. Tasks that become due during the update (spawned, or
+        // waiting 0) run next update.
+        void update(float dt);
+
+        // True while L is the coroutine of the task being resumed.
+        [[nodiscard]] bool in_task(lua_State *L) const;
+
+        [[nodiscard]] double now() const { return clock_; }
+        [[nodiscard]] uint64_t frame() const { return frame_; }
+
+        // Drops every task. Call while their Lua state is still alive.
+        void clear();
+
+    private:
+        enum class Wait : uint8_t
+        {
+            None,
+            NextFrame,
+            Frames,
+            Seconds,
+            Event,
+        };
+
+        struct Slot
+        {
+            sol::thread thread;          // keeps the coroutine alive
+            lua_State *co = nullptr;
+            lua_State *main = nullptr;   // the state's main thread, for error reporting
+            entt::entity owner = entt::null;
+            uint32_t generation = 1;     // never 0, so no handle is kNoTask
+            Wait wait = Wait::None;
+            TaskEventId event = 0;       // for Wait::Event
+            bool alive = false;
+            bool running = false;
+            bool cancelled = false;      // while running; erased once it yields
+        };
+
+        TaskHandle handle_of(uint32_t index) const;
+        Slot *slot_for(TaskHandle handle);
+        const Slot *slot_for(TaskHandle handle) const;
+
+        void resume(uint32_t index, int nargs);
+        void resume_with_dt(uint32_t index);
+        void wait_on(uint32_t index, int nresults);
+        void erase(uint32_t index);
+
+        std::deque<Slot> slots_;
+        std::vector<uint32_t> freeSlots_;
+        size_t live_ = 0;
+
+        timer::TimerSchedule seconds_; // keyed by slot, due on clock_
+        timer::TimerSchedule frames_;  // keyed by slot, due on frame_
+        std::vector<TaskHandle> nextFrame_, resuming_;
+        std::vector<timer::TimerSchedule::Key> dueFrames_, dueSeconds_; // scratch
+
+        std::unordered_map<std::string, TaskEventId> eventIds_;
+        std::vector<std::vector<TaskHandle>> eventWaiters_; // by event id
+
+        std::unordered_map<entt::entity, std::vector<TaskHandle>> owned_;
+
+        double clock_ = 0.0;
+        uint64_t frame_ = 0;
+        float dt_ = 0.0f;
+        uint32_t running_ = UINT32_MAX; // slot being resumed, innermost
+    };
+
+    // The scheduler that drives script coroutines of the master Lua state.
+    TaskScheduler &task_scheduler();
+
+    // Lua table `tasks`: spawn, cancel, cancel_owner, count, notify, event_id,
+    // in_task, and the wait helpers.
+    void exposeTaskSchedulerToLua(sol::state &lua);
+}
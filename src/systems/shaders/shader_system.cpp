@@ -24,6 +24,7 @@ using json = nlohmann::json;
 #include <functional>
 #include <filesystem>
 
+#include "systems/file_watch/file_watch.hpp"
 #include "systems/scripting/binding_recorder.hpp"
 #include "systems/telemetry/telemetry.hpp"
 
@@ -701,16 +702,17 @@ namespace shaders
         }
     }
 
-    auto hotReloadShaders() -> void
-    {
-        ZONE_SCOPED("HotReloadShaders"); // custom label
-        for (auto &[shaderName, shader] : loadedShaders)
+    namespace {
+        file_watch::SubscriptionId s_shaderWatch = 0;
+
+        // Reloads shaderName if either of its files has a new write time.
+        void reloadIfModified(const std::string &shaderName, Shader &shader)
         {
             // Retrieve shader paths from the map
             if (shaderPaths.find(shaderName) == shaderPaths.end())
             {
                 SPDLOG_WARN("Paths for shader {} not found. Skipping hot reload.", shaderName);
-                continue;
+                return;
             }
 
             const auto &[vertexPath, fragmentPath] = shaderPaths[shaderName];
@@ -719,7 +721,7 @@ namespace shaders
             if (vertexPath.empty() && fragmentPath.empty())
             {
                 SPDLOG_WARN("Shader {} has no valid paths. Skipping hot reload.", shaderName);
-                continue;
+                return;
             }
 
             // Get the last modified times
@@ -755,6 +757,61 @@ namespace shaders
                 }
             }
         }
+
+        bool samePath(const std::string &shaderFile, const std::filesystem::path &changed)
+        {
+            if (shaderFile.empty())
+                return false;
+            std::error_code ec;
+            return std::filesystem::absolute(shaderFile, ec).lexically_normal() == changed;
+        }
+    }
+
+    auto hotReloadShaders() -> void
+    {
+        ZONE_SCOPED("HotReloadShaders"); // custom label
+        for (auto &[shaderName, shader] : loadedShaders)
+        {
+            reloadIfModified(shaderName, shader);
+        }
+    }
+
+    auto reloadShadersForFiles(const std::vector<std::filesystem::path> &changedFiles) -> void
+    {
+        ZONE_SCOPED("ReloadShadersForFiles");
+        for (auto &[shaderName, shader] : loadedShaders)
+        {
+            auto paths = shaderPaths.find(shaderName);
+            if (paths == shaderPaths.end())
+                continue;
+            const auto &[vertexPath, fragmentPath] = paths->second;
+            for (const auto &changed : changedFiles)
+            {
+                if (samePath(vertexPath, changed) || samePath(fragmentPath, changed))
+                {
+                    reloadIfModified(shaderName, shader);
+                    break;
+                }
+            }
+        }
+    }
+
+    auto watchShaderFiles() -> void
+    {
+        if (s_shaderWatch != 0)
+            return;
+        s_shaderWatch = file_watch::watcher().subscribe(
+            util::getRawAssetPathNoUUID("shaders"), {},
+            [](const file_watch::Paths &changed) { reloadShadersForFiles(changed); });
+    }
+
+    // Back to polling in update().
+    auto unwatchShaderFiles() -> void
+    {
+        if (s_shaderWatch == 0)
+            return;
+        file_watch::watcher().unsubscribe(s_shaderWatch);
+        s_shaderWatch = 0;
     }
 
     // Set shader mode
@@ -854,8 +911,9 @@ namespace shaders
             static float s_hotReloadTimer = 0.0f;
             s_hotReloadTimer += dt;
 
-            // Check every 500ms or on F5 keypress for manual trigger
-            if (s_hotReloadTimer > 0.5f || IsKeyPressed(KEY_F5)) {
+            // Check every 500ms or on F5 keypress for manual trigger; with a
+            // file watch the watcher reports edits, so only F5 forces a check.
+            if ((s_shaderWatch == 0 && s_hotReloadTimer > 0.5f) || IsKeyPressed(KEY_F5)) {
                 hotReloadShaders();
                 s_hotReloadTimer = 0.0f;
             }
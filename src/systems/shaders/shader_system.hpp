@@ -5,6 +5,8 @@
 #include <functional>
 #include <variant>
 #include <unordered_map>
+#include <vector>
+#include <filesystem>
 
 #include "util/common_headers.hpp"
 
@@ -317,6 +319,11 @@ namespace shaders
 
     extern auto disableAllShadersViaOverride(bool enabled) -> void;
     extern auto hotReloadShaders() -> void;
+    // Reloads the shaders that use any of `changedFiles` (if their files changed).
+    extern auto reloadShadersForFiles(const std::vector<std::filesystem::path> &changedFiles) -> void;
+    // Reload shaders from file_watch notifications instead of polling in update().
+    extern auto watchShaderFiles() -> void;
+    extern auto unwatchShaderFiles() -> void;
 
     extern auto setShaderMode(std::string shaderName) -> void;
     extern auto unsetShaderMode() -> void;
@@ -36,10 +36,6 @@ namespace spring {
         float lastTargetValue = 0.f;   // for auto wake-up
         float lastStiffness   = 0.f;
         float lastDamping     = 0.f;
-        
-        
-        // Index in SoA pool
-        size_t poolIndex = SIZE_MAX;
 
     };
     
@@ -2,8 +2,10 @@
 #pragma once
 #include <sol/sol.hpp>
 #include "spring.hpp"
+#include "spring_pool.hpp"
 #include "entt/entt.hpp"
 #include "systems/scripting/binding_recorder.hpp" // your recorder
+#include <stdexcept>
 #include <tuple>
 #include "util/error_handling.hpp"
 
@@ -157,6 +159,43 @@ inline void bind_spring(sol::state& lua) {
         "---@return nil",
         "Snap value to target; zero velocity."});
 
+    // Pooled springs (Transform x/y/w/h/r/s): a live view into spring::GetSpringPool().
+    // Scripts can keep one after its Transform is gone, when the slot may
+    // already belong to another spring, so every access checks the handle.
+    // Writes wake the spring, since the view may have been taken frames ago.
+    using spring::SpringRef;
+    static constexpr auto checked = [](SpringRef& s) -> SpringRef& {
+        if (!s.alive()) throw std::runtime_error("SpringRef used after its spring was destroyed");
+        return s;
+    };
+    lua.new_usertype<SpringRef>("SpringRef",
+        sol::no_constructor,
+        "value",       sol::property([](SpringRef& s){ return checked(s).value; },       [](SpringRef& s, float v){ checked(s).value = v; s.wake(); }),
+        "targetValue", sol::property([](SpringRef& s){ return checked(s).targetValue; }, [](SpringRef& s, float v){ checked(s).targetValue = v; s.wake(); }),
+        "velocity",    sol::property([](SpringRef& s){ return checked(s).velocity; },    [](SpringRef& s, float v){ checked(s).velocity = v; s.wake(); }),
+        "stiffness",   sol::property([](SpringRef& s){ return checked(s).stiffness; },   [](SpringRef& s, float v){ checked(s).stiffness = v; s.wake(); }),
+        "damping",     sol::property([](SpringRef& s){ return checked(s).damping; },     [](SpringRef& s, float v){ checked(s).damping = v; s.wake(); }),
+        "enabled",     sol::property([](SpringRef& s){ return checked(s).enabled; },     [](SpringRef& s, bool v){ checked(s).enabled = v; s.wake(); }),
+        "alive",       sol::property([](SpringRef& s){ return s.alive(); }),
+        "snap_to_target", +[](SpringRef& s){ checked(s).snapToTarget(); s.wake(); }
+    );
+
+    rec.add_type("SpringRef").doc =
+        "Pooled spring owned by a Transform. Integrated in bulk; sleeps once settled "
+        "and wakes when value, target or velocity is changed. Using one after its "
+        "Transform is destroyed raises an error; check `alive` first.";
+    rec.record_property("SpringRef", {"value", "number", "Current value."});
+    rec.record_property("SpringRef", {"targetValue", "number", "Current target value."});
+    rec.record_property("SpringRef", {"velocity", "number", "Current velocity."});
+    rec.record_property("SpringRef", {"stiffness", "number", "Hooke coefficient (k)."});
+    rec.record_property("SpringRef", {"damping", "number", "Damping factor (c)."});
+    rec.record_property("SpringRef", {"enabled", "boolean", "If false, the spring is not integrated."});
+    rec.record_property("SpringRef", {"alive", "boolean", "False once the owning Transform is destroyed."});
+    rec.record_method("SpringRef", {"snap_to_target",
+        "---@param self SpringRef\n"
+        "---@return nil",
+        "Snap value to target; zero velocity."});
+
     // Factories (one-liners)
     lua["spring"]["make"] = +[](entt::registry& reg, float value, float k, float d, sol::optional<sol::table> opts) {
         auto [e, sp] = make_and_attach(reg, value, k, d, opts);
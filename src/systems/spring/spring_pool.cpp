@@ -1,89 +1,402 @@
 #include "spring_pool.hpp"
-#include "util/common_headers.hpp" // common headers like json, spdlog, tracy etc.
 
-// Only include SIMD intrinsics if we are on x86/x64
-// #if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
-//     #include <immintrin.h>
-//     #define SPRINGPOOL_USE_AVX2 1
-// #else
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+
+// AVX2 is compiled in on x86-64 builds (per-function target attribute, so no
+// global -mavx2 is needed) and only used if the CPU reports it at runtime.
+#if !defined(__EMSCRIPTEN__) && (defined(__x86_64__) || defined(_M_X64))
+    #include <immintrin.h>
+    #define SPRINGPOOL_USE_AVX2 1
+    #if defined(_MSC_VER) && !defined(__clang__)
+        #include <intrin.h>
+        #define SPRINGPOOL_AVX2_TARGET
+    #else
+        #define SPRINGPOOL_AVX2_TARGET __attribute__((target("avx2")))
+    #endif
+#else
     #define SPRINGPOOL_USE_AVX2 0
-// #endif
+#endif
 
 namespace spring {
 
-SpringPool gPool;
+namespace {
+
+struct Lanes {
+    float *value;
+    float *target;
+    float *velocity;
+    const float *stiffness;
+    const float *damping;
+    const bool *enabled;
+    size_t count; // multiple of 8
+};
+
+// Both kernels evaluate the same expressions in the same order, so they agree
+// up to FMA contraction of the scalar path. Returns how many springs are
+// still awake.
+size_t stepScalar(const Lanes &l, int steps, float dt) {
+    size_t awake = 0;
+    for (size_t i = 0; i < l.count; ++i) {
+        if (!l.enabled[i]) continue;
+
+        const float t = l.target[i];
+        float v = l.value[i];
+        float vel = l.velocity[i];
+        if (v == t && vel == 0.f) continue; // asleep
+
+        const float k = l.stiffness[i];
+        const float d = l.damping[i];
+        for (int s = 0; s < steps; ++s) {
+            const float a = k * (t - v) - d * vel;
+            vel = vel + a * dt;
+            v = v + vel * dt;
+        }
+
+        if (std::fabs(v - t) <= SpringPool::kRestEpsilon &&
+            std::fabs(vel) <= SpringPool::kRestEpsilon) {
+            v = t;
+            vel = 0.f;
+        } else {
+            ++awake;
+        }
+        l.value[i] = v;
+        l.velocity[i] = vel;
+    }
+    return awake;
+}
+
+#if SPRINGPOOL_USE_AVX2
+
+SPRINGPOOL_AVX2_TARGET
+size_t stepAVX2(const Lanes &l, int steps, float dt) {
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 vdt = _mm256_set1_ps(dt);
+    const __m256 eps = _mm256_set1_ps(SpringPool::kRestEpsilon);
+    const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+
+    size_t awake = 0;
+    for (size_t i = 0; i < l.count; i += 8) {
+        const __m256 t = _mm256_load_ps(l.target + i);
+        const __m256 v0 = _mm256_load_ps(l.value + i);
+        const __m256 vel0 = _mm256_load_ps(l.velocity + i);
+
+        const __m128i en8 = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(l.enabled + i));
+        const __m256 enabled = _mm256_castsi256_ps(
+            _mm256_cmpgt_epi32(_mm256_cvtepu8_epi32(en8), _mm256_setzero_si256()));
+        const __m256 resting = _mm256_and_ps(_mm256_cmp_ps(v0, t, _CMP_EQ_OQ),
+                                             _mm256_cmp_ps(vel0, zero, _CMP_EQ_OQ));
+        const __m256 active = _mm256_andnot_ps(resting, enabled);
+        const int activeBits = _mm256_movemask_ps(active);
+        if (activeBits == 0) continue; // whole group asleep
+
+        const __m256 k = _mm256_load_ps(l.stiffness + i);
+        const __m256 d = _mm256_load_ps(l.damping + i);
+        __m256 v = v0;
+        __m256 vel = vel0;
+        for (int s = 0; s < steps; ++s) {
+            const __m256 a = _mm256_sub_ps(_mm256_mul_ps(k, _mm256_sub_ps(t, v)),
+                                           _mm256_mul_ps(d, vel));
+            vel = _mm256_add_ps(vel, _mm256_mul_ps(a, vdt));
+            v = _mm256_add_ps(v, _mm256_mul_ps(vel, vdt));
+        }
 
-//------------------------------------------------------------
-// Register spring in pool (call after emplace<Spring>())
-//------------------------------------------------------------
-void registerSpring(entt::registry &r, entt::entity e) {
-    auto &s = r.get<Spring>(e);
-    s.poolIndex = gPool.add(e, s);
+        const __m256 settled = _mm256_and_ps(
+            _mm256_cmp_ps(_mm256_and_ps(_mm256_sub_ps(v, t), absMask), eps, _CMP_LE_OQ),
+            _mm256_cmp_ps(_mm256_and_ps(vel, absMask), eps, _CMP_LE_OQ));
+        v = _mm256_blendv_ps(v, t, settled);
+        vel = _mm256_blendv_ps(vel, zero, settled);
+
+        // lanes that were asleep or disabled keep their state
+        _mm256_store_ps(l.value + i, _mm256_blendv_ps(v0, v, active));
+        _mm256_store_ps(l.velocity + i, _mm256_blendv_ps(vel0, vel, active));
+
+        const int stillAwake = activeBits & ~_mm256_movemask_ps(settled);
+        awake += static_cast<size_t>(std::popcount(static_cast<unsigned>(stillAwake)));
+    }
+    return awake;
 }
 
-//------------------------------------------------------------
-// SIMD-optimized update loop
-//------------------------------------------------------------
-void updateSpringPool(float dt) {
-    ZONE_SCOPED("SpringPool::updateAll");
-    const size_t count = gPool.value.size();
-    if (count == 0) return;
+// Appends the owners of lanes whose value or target moved off the snapshot
+// and refreshes the snapshot. Groups of 8 that are unchanged are skipped.
+SPRINGPOOL_AVX2_TARGET
+void collectChangedAVX2(float *value, float *target, float *seenValue, float *seenTarget,
+                        const uint32_t *owner, size_t count, std::vector<uint32_t> &owners) {
+    for (size_t i = 0; i < count; i += 8) {
+        const __m256 changed = _mm256_or_ps(
+            _mm256_cmp_ps(_mm256_load_ps(value + i), _mm256_load_ps(seenValue + i), _CMP_NEQ_UQ),
+            _mm256_cmp_ps(_mm256_load_ps(target + i), _mm256_load_ps(seenTarget + i), _CMP_NEQ_UQ));
+        int bits = _mm256_movemask_ps(changed);
+        while (bits != 0) {
+            const size_t lane = i + static_cast<size_t>(std::countr_zero(static_cast<unsigned>(bits)));
+            bits &= bits - 1;
+            seenValue[lane] = value[lane];
+            seenTarget[lane] = target[lane];
+            if (owner[lane] != SpringPool::kNoOwner) owners.push_back(owner[lane]);
+        }
+    }
+}
 
-#if defined(__EMSCRIPTEN__)
-    // --- WebAssembly SIMD128 or scalar fallback ---
+bool cpuHasAVX2() {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx     = (info[2] & (1 << 28)) != 0;
+    if (!(osxsave && avx)) return false;
+    if ((_xgetbv(0) & 0x6) != 0x6) return false; // OS saves YMM state
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif // SPRINGPOOL_USE_AVX2
+
+void collectChangedScalar(float *value, float *target, float *seenValue, float *seenTarget,
+                          const uint32_t *owner, size_t count, std::vector<uint32_t> &owners) {
     for (size_t i = 0; i < count; ++i) {
-        float mask = gPool.enabled[i] ? 1.f : 0.f;
-        float a = (-gPool.stiffness[i] * (gPool.value[i] - gPool.target[i])
-                   - gPool.damping[i] * gPool.velocity[i]) * mask;
-        gPool.velocity[i] += a * dt;
-        gPool.value[i] += gPool.velocity[i] * dt;
+        if (value[i] == seenValue[i] && target[i] == seenTarget[i]) continue;
+        seenValue[i] = value[i];
+        seenTarget[i] = target[i];
+        if (owner[i] != SpringPool::kNoOwner) owners.push_back(owner[i]);
     }
+}
+
+} // namespace
 
-#elif SPRINGPOOL_USE_AVX2
-    // --- Native x86/x64 AVX2 path ---
-    const size_t step = 8;
-    const size_t aligned = count - (count % step);
-    const __m256 vdt   = _mm256_set1_ps(dt);
-    const __m256 vneg1 = _mm256_set1_ps(-1.f);
-
-    size_t i = 0;
-    for (; i < aligned; i += step) {
-        __m256 vVal = _mm256_loadu_ps(&gPool.value[i]);
-        __m256 vTar = _mm256_loadu_ps(&gPool.target[i]);
-        __m256 vVel = _mm256_loadu_ps(&gPool.velocity[i]);
-        __m256 vK   = _mm256_loadu_ps(&gPool.stiffness[i]);
-        __m256 vD   = _mm256_loadu_ps(&gPool.damping[i]);
-
-        __m256 vDiff = _mm256_sub_ps(vVal, vTar);
-        __m256 vA = _mm256_fmadd_ps(vD, vVel, _mm256_mul_ps(vK, vDiff));
-        vA = _mm256_mul_ps(vA, vneg1);
-        vA = _mm256_mul_ps(vA, vdt);
-
-        vVel = _mm256_add_ps(vVel, vA);
-        vVal = _mm256_fmadd_ps(vVel, vdt, vVal);
-
-        _mm256_storeu_ps(&gPool.velocity[i], vVel);
-        _mm256_storeu_ps(&gPool.value[i], vVal);
+bool SpringKernelAvailable(SpringKernel kernel) {
+    switch (kernel) {
+    case SpringKernel::Scalar:
+        return true;
+    case SpringKernel::AVX2:
+#if SPRINGPOOL_USE_AVX2
+    {
+        static const bool hasAVX2 = cpuHasAVX2();
+        return hasAVX2;
+    }
+#else
+        return false;
+#endif
+    }
+    return false;
+}
+
+SpringKernel ActiveSpringKernel() {
+    static const SpringKernel active = SpringKernelAvailable(SpringKernel::AVX2)
+                                           ? SpringKernel::AVX2
+                                           : SpringKernel::Scalar;
+    return active;
+}
+
+uint32_t SpringPool::allocateSlot() {
+    if (!freeSlots_.empty()) {
+        const uint32_t index = freeSlots_.back();
+        freeSlots_.pop_back();
+        return index;
     }
 
-    for (; i < count; ++i) {
-        if (!gPool.enabled[i]) continue;
-        float a = -gPool.stiffness[i] * (gPool.value[i] - gPool.target[i])
-                - gPool.damping[i] * gPool.velocity[i];
-        gPool.velocity[i] += a * dt;
-        gPool.value[i] += gPool.velocity[i] * dt;
+    const uint32_t index = static_cast<uint32_t>(generations_.size());
+    if (index % kChunkSize == 0) {
+        auto chunk = std::make_unique<Chunk>();
+        std::fill(std::begin(chunk->value), std::end(chunk->value), 0.f);
+        std::fill(std::begin(chunk->target), std::end(chunk->target), 0.f);
+        std::fill(std::begin(chunk->velocity), std::end(chunk->velocity), 0.f);
+        std::fill(std::begin(chunk->stiffness), std::end(chunk->stiffness), 0.f);
+        std::fill(std::begin(chunk->damping), std::end(chunk->damping), 0.f);
+        std::fill(std::begin(chunk->enabled), std::end(chunk->enabled), false);
+        std::fill(std::begin(chunk->seenValue), std::end(chunk->seenValue), 0.f);
+        std::fill(std::begin(chunk->seenTarget), std::end(chunk->seenTarget), 0.f);
+        std::fill(std::begin(chunk->owner), std::end(chunk->owner), kNoOwner);
+        chunks_.push_back(std::move(chunk));
     }
+    generations_.push_back(0);
+    return index;
+}
+
+SpringHandle SpringPool::create(float value, float stiffness, float damping) {
+    const uint32_t index = allocateSlot();
+    Chunk &c = chunkOf(index);
+    const uint32_t lane = index % kChunkSize;
+    c.value[lane] = value;
+    c.target[lane] = value;
+    c.velocity[lane] = 0.f;
+    c.stiffness[lane] = stiffness;
+    c.damping[lane] = damping;
+    c.enabled[lane] = true;
+    c.seenValue[lane] = value;
+    c.seenTarget[lane] = value;
+    c.owner[lane] = kNoOwner;
+    ++c.live;
+    ++live_;
+    return SpringHandle{index, generations_[index]};
+}
+
+SpringHandle SpringPool::clone(SpringHandle source) {
+    if (!alive(source)) return SpringHandle{};
 
+    const SpringRef from = get(source);
+    const SpringHandle handle = create(from.value, from.stiffness, from.damping);
+    // `from` stays valid: chunks never move when the pool grows
+    SpringRef to = get(handle);
+    to.targetValue = from.targetValue;
+    to.velocity = from.velocity;
+    to.enabled = from.enabled;
+    return handle;
+}
+
+void SpringPool::destroy(SpringHandle handle) {
+    if (!alive(handle)) return;
+
+    Chunk &c = chunkOf(handle.index);
+    const uint32_t lane = handle.index % kChunkSize;
+    // a free lane is disabled and at rest, so the kernels skip it
+    c.value[lane] = c.target[lane] = c.velocity[lane] = 0.f;
+    c.stiffness[lane] = c.damping[lane] = 0.f;
+    c.enabled[lane] = false;
+    c.seenValue[lane] = c.seenTarget[lane] = 0.f;
+    c.owner[lane] = kNoOwner;
+    --c.live;
+    --live_;
+
+    ++generations_[handle.index];
+    releasedSlots_.push_back(handle.index);
+    ++releases_;
+}
+
+bool SpringPool::alive(SpringHandle handle) const {
+    return handle.index < generations_.size() && generations_[handle.index] == handle.generation;
+}
+
+SpringRef SpringPool::get(SpringHandle handle) {
+    assert(alive(handle) && "stale or invalid spring handle");
+    markAwake(handle.index);
+    Chunk &c = chunkOf(handle.index);
+    const uint32_t lane = handle.index % kChunkSize;
+    return SpringRef{c.value[lane], c.target[lane], c.velocity[lane],
+                     c.stiffness[lane], c.damping[lane], c.enabled[lane], this, handle};
+}
+
+void SpringPool::wake(SpringHandle handle) {
+    if (alive(handle)) markAwake(handle.index);
+}
+
+void SpringPool::markAwake(uint32_t index) {
+    Chunk &c = chunkOf(index);
+    const uint32_t group = index % kChunkSize / kGroupWidth;
+    const uint64_t bit = uint64_t{1} << (group % 64);
+    // most calls find the bits already set; skip the read-modify-write then
+    if ((c.awake[group / 64].load(std::memory_order_relaxed) & bit) == 0)
+        c.awake[group / 64].fetch_or(bit, std::memory_order_relaxed);
+    if ((c.touched[group / 64].load(std::memory_order_relaxed) & bit) == 0)
+        c.touched[group / 64].fetch_or(bit, std::memory_order_relaxed);
+}
+
+size_t SpringPool::awakeGroups() const {
+    size_t groups = 0;
+    for (const auto &c : chunks_)
+        for (const auto &word : c->awake)
+            groups += static_cast<size_t>(std::popcount(word.load(std::memory_order_relaxed)));
+    return groups;
+}
+
+void SpringPool::setOwner(SpringHandle handle, uint32_t owner) {
+    assert(alive(handle) && "stale or invalid spring handle");
+    chunkOf(handle.index).owner[handle.index % kChunkSize] = owner;
+}
+
+uint32_t SpringPool::owner(SpringHandle handle) const {
+    if (!alive(handle)) return kNoOwner;
+    return chunkOf(handle.index).owner[handle.index % kChunkSize];
+}
+
+void SpringPool::collectChanged(std::vector<uint32_t> &owners) {
+    collectChanged(owners, ActiveSpringKernel());
+}
+
+void SpringPool::collectChanged(std::vector<uint32_t> &owners, SpringKernel kernel) {
+#if SPRINGPOOL_USE_AVX2
+    const bool useAVX2 = kernel == SpringKernel::AVX2 && SpringKernelAvailable(SpringKernel::AVX2);
 #else
-    // --- Generic scalar fallback (ARM, Apple Silicon, etc.) ---
-    for (size_t i = 0; i < count; ++i) {
-        if (!gPool.enabled[i]) continue;
-        float a = -gPool.stiffness[i] * (gPool.value[i] - gPool.target[i])
-                - gPool.damping[i] * gPool.velocity[i];
-        gPool.velocity[i] += a * dt;
-        gPool.value[i] += gPool.velocity[i] * dt;
+    (void)kernel;
+#endif
+
+    for (const auto &chunk : chunks_) {
+        Chunk &c = *chunk;
+        for (uint32_t w = 0; w < kGroupWords; ++w) {
+            uint64_t groups = c.touched[w].exchange(0, std::memory_order_relaxed);
+            while (groups != 0) {
+                const size_t first = (w * 64 + static_cast<size_t>(std::countr_zero(groups))) * kGroupWidth;
+                groups &= groups - 1;
+#if SPRINGPOOL_USE_AVX2
+                if (useAVX2) {
+                    collectChangedAVX2(c.value + first, c.target + first, c.seenValue + first,
+                                       c.seenTarget + first, c.owner + first, kGroupWidth, owners);
+                    continue;
+                }
+#endif
+                collectChangedScalar(c.value + first, c.target + first, c.seenValue + first,
+                                     c.seenTarget + first, c.owner + first, kGroupWidth, owners);
+            }
+        }
     }
+}
+
+void SpringPool::update(float deltaTime) { update(deltaTime, ActiveSpringKernel()); }
+
+void SpringPool::update(float deltaTime, SpringKernel kernel) {
+    // slots destroyed during the last frame can be handed out again
+    freeSlots_.insert(freeSlots_.end(), releasedSlots_.begin(), releasedSlots_.end());
+    releasedSlots_.clear();
+
+    awake_ = 0;
+    if (live_ == 0 || deltaTime <= 0.f) return;
+
+    const int steps = std::max(1, static_cast<int>(std::ceil(deltaTime / kMaxStep)));
+    const float stepDt = deltaTime / static_cast<float>(steps);
+#if SPRINGPOOL_USE_AVX2
+    const bool useAVX2 = kernel == SpringKernel::AVX2 && SpringKernelAvailable(SpringKernel::AVX2);
+#else
+    (void)kernel;
 #endif
+
+    for (const auto &chunk : chunks_) {
+        Chunk &c = *chunk;
+        if (c.live == 0) continue;
+
+        for (uint32_t w = 0; w < kGroupWords; ++w) {
+            const uint64_t visit = c.awake[w].load(std::memory_order_relaxed);
+            uint64_t stillAwake = 0;
+            for (uint64_t groups = visit; groups != 0; groups &= groups - 1) {
+                const uint32_t bit = static_cast<uint32_t>(std::countr_zero(groups));
+                const size_t first = (w * 64 + bit) * kGroupWidth;
+                // unallocated lanes of the last chunk are disabled, like free ones
+                const Lanes l{c.value + first, c.target + first, c.velocity + first,
+                              c.stiffness + first, c.damping + first, c.enabled + first, kGroupWidth};
+#if SPRINGPOOL_USE_AVX2
+                const size_t moving = useAVX2 ? stepAVX2(l, steps, stepDt) : stepScalar(l, steps, stepDt);
+#else
+                const size_t moving = stepScalar(l, steps, stepDt);
+#endif
+                if (moving != 0) stillAwake |= uint64_t{1} << bit;
+                awake_ += moving;
+            }
+            // settled groups moved onto their targets this update; collectChanged() sees them once more
+            c.awake[w].store(stillAwake, std::memory_order_relaxed);
+            c.touched[w].fetch_or(visit, std::memory_order_relaxed);
+        }
+    }
+}
+
+SpringPool &GetSpringPool() {
+    // Never destroyed: transforms held by static registries are released
+    // during shutdown and still need the pool.
+    static SpringPool *pool = new SpringPool();
+    return *pool;
 }
 
 } // namespace spring
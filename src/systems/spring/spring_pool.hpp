@@ -1,80 +1,218 @@
 #pragma once
-#include <vector>
-#include <unordered_map>
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
-#include "spring.hpp"
+#include <memory>
+#include <vector>
 
 namespace spring {
 
 //------------------------------------------------------------
-// SIMD-friendly Structure of Arrays storage
+// Persistent Structure of Arrays storage for springs.
+//
+// The pool is the only copy of a pooled spring's state; nothing is gathered
+// or scattered per frame. Slots live in fixed-size chunks that never move,
+// so a SpringRef stays valid for as long as its handle is alive, and a
+// handle is a slot index plus a generation so stale handles are detected.
+// A destroyed spring's slot is only reused after the next update(), so a raw
+// pointer into its lanes never reaches another spring within the same update.
+//
+// A spring that settles at its target is snapped to it with zero velocity
+// and goes to sleep. Each chunk keeps a bitmask of its 8-wide groups that may
+// be awake, and update() only visits the groups in it; a group whose lanes
+// all end up asleep (or disabled) drops out of the mask. get() hands out
+// write access, so it puts the spring's group back in the mask: writing a
+// new value, target or velocity through a SpringRef taken since the last
+// update() wakes the spring. A SpringRef kept across an update() has to be
+// taken again (or wake() called) before writes through it are seen.
+//
+// Each spring can carry an owner id. collectChanged() reports the owners of
+// springs whose value or target differs from the previous call, whether the
+// integrator or someone writing through a SpringRef moved them, so owners
+// can skip work while nothing changed. It only looks at groups that were
+// integrated or handed out by get() since the previous call.
 //------------------------------------------------------------
-struct SpringPool {
-    std::vector<float> value;
-    std::vector<float> target;
-    std::vector<float> velocity;
-    std::vector<float> stiffness;
-    std::vector<float> damping;
-    std::vector<uint8_t> enabled;
-    std::unordered_map<entt::entity, size_t> entityToIndex;
-
-    inline void reserve(size_t n) {
-        value.reserve(n); target.reserve(n); velocity.reserve(n);
-        stiffness.reserve(n); damping.reserve(n); enabled.reserve(n);
-    }
 
-    inline size_t add(entt::entity e, const Spring &s) {
-        size_t idx = value.size();
-        value.push_back(s.value);
-        target.push_back(s.targetValue);
-        velocity.push_back(s.velocity);
-        stiffness.push_back(s.stiffness);
-        damping.push_back(s.damping);
-        enabled.push_back(s.enabled ? 1 : 0);
-        entityToIndex[e] = idx;
-        return idx;
-    }
+struct SpringHandle {
+    static constexpr uint32_t kInvalidIndex = UINT32_MAX;
+
+    uint32_t index = kInvalidIndex;
+    uint32_t generation = 0;
+
+    bool valid() const { return index != kInvalidIndex; }
+    bool operator==(const SpringHandle &) const = default;
+};
+
+class SpringPool;
+
+// Live view of one pooled spring; same field names as spring::Spring.
+// Copying a SpringRef copies the view, not the spring: `auto s = t.getXSpring()`
+// writes through to the pool, where the old `auto s` over a Spring& took a
+// private copy. The view remembers the handle it was taken for, so holders
+// that outlive the spring (Lua) can check alive() before touching the lanes,
+// which by then may belong to another spring.
+struct SpringRef {
+    float &value;
+    float &targetValue;
+    float &velocity;
+    float &stiffness;
+    float &damping;
+    bool &enabled; // disabled springs keep their state and are not integrated
+    SpringPool *pool = nullptr;
+    SpringHandle handle;
 
-    inline size_t getIndex(entt::entity e) const {
-        auto it = entityToIndex.find(e);
-        return (it == entityToIndex.end()) ? SIZE_MAX : it->second;
+    void snapToTarget() {
+        value = targetValue;
+        velocity = 0.f;
     }
 
-    inline void setEnabled(entt::entity e, bool en) {
-        size_t i = getIndex(e);
-        if (i != SIZE_MAX) enabled[i] = en;
+    bool alive() const;
+    void wake() const;
+};
+
+// Integration kernels. AVX2 is picked at runtime when the CPU supports it;
+// Scalar is the reference implementation and the fallback everywhere else.
+enum class SpringKernel : uint8_t {
+    Scalar,
+    AVX2,
+};
+
+bool SpringKernelAvailable(SpringKernel kernel);
+SpringKernel ActiveSpringKernel();
+
+class SpringPool {
+public:
+    static constexpr uint32_t kChunkSize = 1024; // multiple of the SIMD width
+    static constexpr float kMaxStep = 0.016f;    // integration substep cap
+    static constexpr float kRestEpsilon = 1e-3f; // |value - target| and |velocity| to fall asleep
+    static constexpr uint32_t kNoOwner = UINT32_MAX;
+
+    // New spring at rest on `value`.
+    SpringHandle create(float value, float stiffness, float damping);
+    // New spring with the full state of `source` and no owner; whoever holds
+    // the copy claims it with setOwner().
+    SpringHandle clone(SpringHandle source);
+    void destroy(SpringHandle handle);
+
+    bool alive(SpringHandle handle) const;
+    // Also marks the spring as possibly awake for the next update() and
+    // collectChanged(); safe to call from several threads at once.
+    SpringRef get(SpringHandle handle);
+    // Marks a spring written through an older SpringRef as possibly awake.
+    void wake(SpringHandle handle);
+
+    // Owner id reported by collectChanged().
+    void setOwner(SpringHandle handle, uint32_t owner);
+    uint32_t owner(SpringHandle handle) const;
+
+    // Appends the owner of every spring whose value or target changed since the
+    // last call (once per spring, in slot order) and remembers the current state.
+    void collectChanged(std::vector<uint32_t> &owners);
+    void collectChanged(std::vector<uint32_t> &owners, SpringKernel kernel);
+
+    // Advances every awake spring by deltaTime, in substeps of at most kMaxStep.
+    void update(float deltaTime);
+    void update(float deltaTime, SpringKernel kernel);
+
+    size_t size() const { return live_; }
+    size_t awake() const { return awake_; } // springs still moving after the last update
+    size_t awakeGroups() const;              // 8-wide groups the next update() will visit
+    size_t capacity() const { return chunks_.size() * kChunkSize; }
+    // Bumped by every destroy(); a raw pointer into a lane is only known to
+    // still belong to the same spring while this is unchanged (or, for one
+    // taken since the last update(), until the next one).
+    uint32_t releases() const { return releases_; }
+
+private:
+    static constexpr uint32_t kGroupWidth = 8;
+    static constexpr uint32_t kGroupWords = kChunkSize / kGroupWidth / 64;
+
+    struct Chunk {
+        alignas(32) float value[kChunkSize];
+        alignas(32) float target[kChunkSize];
+        alignas(32) float velocity[kChunkSize];
+        alignas(32) float stiffness[kChunkSize];
+        alignas(32) float damping[kChunkSize];
+        alignas(32) bool enabled[kChunkSize];
+        // value and target as of the last collectChanged()
+        alignas(32) float seenValue[kChunkSize];
+        alignas(32) float seenTarget[kChunkSize];
+        uint32_t owner[kChunkSize];
+        uint32_t live = 0;
+        // one bit per 8-wide group: may be awake / may have moved since the
+        // last collectChanged(). Atomic because transforms updated by the job
+        // system call get() from workers.
+        std::atomic<uint64_t> awake[kGroupWords]{};
+        std::atomic<uint64_t> touched[kGroupWords]{};
+    };
+
+    uint32_t allocateSlot();
+    void markAwake(uint32_t index);
+    Chunk &chunkOf(uint32_t index) { return *chunks_[index / kChunkSize]; }
+    const Chunk &chunkOf(uint32_t index) const { return *chunks_[index / kChunkSize]; }
+
+    std::vector<std::unique_ptr<Chunk>> chunks_;
+    std::vector<uint32_t> generations_;
+    std::vector<uint32_t> freeSlots_;
+    std::vector<uint32_t> releasedSlots_; // destroyed since the last update(), not reusable yet
+    size_t live_ = 0;
+    size_t awake_ = 0;
+    uint32_t releases_ = 0;
+};
+
+inline bool SpringRef::alive() const { return pool != nullptr && pool->alive(handle); }
+inline void SpringRef::wake() const {
+    if (alive()) pool->wake(handle);
+}
+
+// The pool behind every Transform spring (main thread only).
+SpringPool &GetSpringPool();
+
+//------------------------------------------------------------
+// Owning handle into GetSpringPool(). Copies clone the spring state, so a
+// copied component owns its own springs; the slot is freed on destruction.
+//------------------------------------------------------------
+class PooledSpring {
+public:
+    PooledSpring(float value, float stiffness, float damping)
+        : handle_(GetSpringPool().create(value, stiffness, damping)) {}
+
+    PooledSpring(const PooledSpring &other)
+        : handle_(GetSpringPool().clone(other.handle_)) {}
+
+    PooledSpring(PooledSpring &&other) noexcept : handle_(other.handle_) {
+        other.handle_ = SpringHandle{};
     }
 
-    inline void syncFromSpring(entt::entity e, const Spring &s) {
-        size_t i = getIndex(e);
-        if (i == SIZE_MAX) return;
-        value[i] = s.value;
-        target[i] = s.targetValue;
-        velocity[i] = s.velocity;
-        stiffness[i] = s.stiffness;
-        damping[i] = s.damping;
-        enabled[i] = s.enabled ? 1 : 0;
+    PooledSpring &operator=(const PooledSpring &other) {
+        if (this != &other) {
+            release();
+            handle_ = GetSpringPool().clone(other.handle_);
+        }
+        return *this;
     }
 
-    inline void syncToSpring(entt::entity e, Spring &s) const {
-        size_t i = getIndex(e);
-        if (i == SIZE_MAX) return;
-        s.value = value[i];
-        s.targetValue = target[i];
-        s.velocity = velocity[i];
-        s.stiffness = stiffness[i];
-        s.damping = damping[i];
-        s.enabled = enabled[i] != 0;
+    PooledSpring &operator=(PooledSpring &&other) noexcept {
+        if (this != &other) {
+            release();
+            handle_ = other.handle_;
+            other.handle_ = SpringHandle{};
+        }
+        return *this;
     }
 
-    void clear() {
-        value.clear(); target.clear(); velocity.clear();
-        stiffness.clear(); damping.clear(); enabled.clear();
-        entityToIndex.clear();
+    ~PooledSpring() { release(); }
+
+    SpringRef ref() const { return GetSpringPool().get(handle_); }
+    SpringHandle handle() const { return handle_; }
+
+private:
+    void release() {
+        if (handle_.valid()) GetSpringPool().destroy(handle_);
+        handle_ = SpringHandle{};
     }
-};
 
-// Global instance
-extern SpringPool gPool;
+    SpringHandle handle_;
+};
 
 } // namespace spring
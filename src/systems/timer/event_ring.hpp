@@ -0,0 +1,106 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace timer {
+
+//------------------------------------------------------------
+// Double-ended ring of (Header, Payload) pairs, kept in two parallel
+// arrays. The header is the few bytes an update scan reads for every entry
+// (flags, wake time); the payload is only touched when the entry is
+// actually handled, so a scan past waiting or blocked entries stays in
+// the small array.
+//
+// push_back/push_front are O(1) amortized. Entries are not erased one at a
+// time: compact() drops every entry matching a predicate in one stable
+// pass. Indices are logical (0 is the front) and shift on push_front and
+// compact().
+//------------------------------------------------------------
+template <typename Header, typename Payload>
+class EventRing {
+public:
+    void push_back(const Header &header, Payload payload)
+    {
+        reserveOneMore();
+        const size_t slot = physical(size_);
+        headers_[slot] = header;
+        payloads_[slot] = std::move(payload);
+        ++size_;
+    }
+
+    void push_front(const Header &header, Payload payload)
+    {
+        reserveOneMore();
+        head_ = (head_ + capacity() - 1) & mask();
+        headers_[head_] = header;
+        payloads_[head_] = std::move(payload);
+        ++size_;
+    }
+
+    Header &header(size_t i) { return headers_[physical(i)]; }
+    const Header &header(size_t i) const { return headers_[physical(i)]; }
+    Payload &payload(size_t i) { return payloads_[physical(i)]; }
+    const Payload &payload(size_t i) const { return payloads_[physical(i)]; }
+
+    // Removes every entry for which remove(header, payload) is true, keeping
+    // the order of the rest. Returns how many were removed.
+    template <typename Pred>
+    size_t compact(Pred remove)
+    {
+        size_t kept = 0;
+        for (size_t i = 0; i < size_; ++i) {
+            const size_t from = physical(i);
+            if (remove(headers_[from], payloads_[from])) continue;
+            if (kept != i) {
+                const size_t to = physical(kept);
+                headers_[to] = headers_[from];
+                payloads_[to] = std::move(payloads_[from]);
+            }
+            ++kept;
+        }
+        for (size_t i = kept; i < size_; ++i) payloads_[physical(i)] = Payload{}; // release what they hold
+        const size_t removed = size_ - kept;
+        size_ = kept;
+        return removed;
+    }
+
+    void clear()
+    {
+        for (size_t i = 0; i < size_; ++i) payloads_[physical(i)] = Payload{};
+        head_ = 0;
+        size_ = 0;
+    }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    size_t capacity() const { return headers_.size(); }
+
+private:
+    size_t mask() const { return capacity() - 1; }
+    size_t physical(size_t i) const { return (head_ + i) & mask(); }
+
+    // Capacity stays a power of two; growing unrolls the ring to start at 0.
+    void reserveOneMore()
+    {
+        if (size_ < capacity()) return;
+        const size_t grown = capacity() == 0 ? 16 : capacity() * 2;
+        std::vector<Header> headers(grown);
+        std::vector<Payload> payloads(grown);
+        for (size_t i = 0; i < size_; ++i) {
+            headers[i] = headers_[physical(i)];
+            payloads[i] = std::move(payloads_[physical(i)]);
+        }
+        headers_.swap(headers);
+        payloads_.swap(payloads);
+        head_ = 0;
+    }
+
+    std::vector<Header> headers_;
+    std::vector<Payload> payloads_;
+    size_t head_ = 0;
+    size_t size_ = 0;
+};
+
+} // namespace timer
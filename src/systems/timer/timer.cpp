@@ -8,7 +8,10 @@
 
 #include "systems/ai/ai_system.hpp"
 #include "systems/scripting/binding_recorder.hpp"
+#include "event_ring.hpp"
+#include "tween_system.hpp"
 #include <cstdlib>
+#include <deque>
 
 namespace timer
 {
@@ -22,6 +25,14 @@ namespace timer
         TimerSystem::timer_tween(d, getter, setter, target_value, tag);
     }
     
+    // Lua refers to a timer by the handle a creation function returned, or by its tag.
+    static TimerHandle lua_timer_handle(const sol::object &id)
+    {
+        if (id.get_type() == sol::type::number) return id.as<TimerHandle>();
+        if (id.get_type() == sol::type::string) return TimerSystem::find_timer(id.as<std::string>());
+        return kNoTimer;
+    }
+
     static std::function<bool()>
 wrap_condition(sol::function f) {
     if (!f.valid()) {
@@ -232,14 +243,14 @@ wrap_timer_action(sol::function action) {
         rec.record_property("timer.TimerType", {"EVERY_RENDER_FRAME_ONLY", std::to_string(static_cast<int>(timer::TimerType::EVERY_RENDER_FRAME_ONLY)), "Runs every render frame, ignoring time scaling."});
 
         // 4) Core control/query
-        t.set_function("cancel",            &timer::TimerSystem::cancel_timer);
-        t.set_function("get_every_index",   &timer::TimerSystem::timer_get_every_index);
-        t.set_function("reset",             &timer::TimerSystem::timer_reset);
-        t.set_function("get_delay",         &timer::TimerSystem::timer_get_delay);
-        t.set_function("set_multiplier",    &timer::TimerSystem::timer_set_multiplier);
-        t.set_function("get_multiplier",    &timer::TimerSystem::timer_get_multiplier);
-        t.set_function("get_for_elapsed",   &timer::TimerSystem::timer_get_for_elapsed_time);
-        t.set_function("get_timer_and_delay",&timer::TimerSystem::timer_get_timer_and_delay);
+        t.set_function("cancel",            [](sol::object id) { timer::TimerSystem::cancel_timer(lua_timer_handle(id)); });
+        t.set_function("get_every_index",   [](sol::object id) { return timer::TimerSystem::timer_get_every_index(lua_timer_handle(id)); });
+        t.set_function("reset",             [](sol::object id) { timer::TimerSystem::timer_reset(lua_timer_handle(id)); });
+        t.set_function("get_delay",         [](sol::object id) { return timer::TimerSystem::timer_get_delay(lua_timer_handle(id)); });
+        t.set_function("set_multiplier",    [](sol::object id, float multiplier) { timer::TimerSystem::timer_set_multiplier(lua_timer_handle(id), multiplier); });
+        t.set_function("get_multiplier",    [](sol::object id) { return timer::TimerSystem::timer_get_multiplier(lua_timer_handle(id)); });
+        t.set_function("get_for_elapsed",   [](sol::object id) { return timer::TimerSystem::timer_get_for_elapsed_time(lua_timer_handle(id)); });
+        t.set_function("get_timer_and_delay",[](sol::object id) { return timer::TimerSystem::timer_get_timer_and_delay(lua_timer_handle(id)); });
         
         t.set_function("clear_all", &timer::TimerSystem::clear_all_timers);
         rec.record_free_function({"timer"}, {
@@ -252,7 +263,7 @@ wrap_timer_action(sol::function action) {
         // Recorder: control/query functions
         rec.record_free_function({"timer"}, {
             "cancel",
-            "---@param timerHandle integer # The handle of the timer to cancel.\n"
+            "---@param timer integer|string # The handle returned when the timer was created, or its tag.\n"
             "---@return nil",
             "Cancels and destroys an active timer.",
             true, false
@@ -260,7 +271,7 @@ wrap_timer_action(sol::function action) {
 
         rec.record_free_function({"timer"}, {
             "get_every_index",
-            "---@param timerHandle integer # The handle of an 'every' timer.\n"
+            "---@param timer integer|string # The handle or tag of an 'every' timer.\n"
             "---@return integer|nil # The current invocation count, or nil if not found.",
             "Gets the current invocation count for an 'every' timer.",
             true, false
@@ -268,7 +279,7 @@ wrap_timer_action(sol::function action) {
 
         rec.record_free_function({"timer"}, {
             "reset",
-            "---@param timerHandle integer # The handle of the timer to reset.\n"
+            "---@param timer integer|string # The handle or tag of the timer to reset.\n"
             "---@return nil",
             "Resets a timer's elapsed time, such as for a 'cooldown'.",
             true, false
@@ -276,7 +287,7 @@ wrap_timer_action(sol::function action) {
 
         rec.record_free_function({"timer"}, {
             "get_delay",
-            "---@param timerHandle integer # The handle of the timer.\n"
+            "---@param timer integer|string # The handle or tag of the timer.\n"
             "---@return number|nil # The timer's current delay, or nil if not found.",
             "Gets the configured delay time for a timer.",
             true, false
@@ -284,24 +295,24 @@ wrap_timer_action(sol::function action) {
 
         rec.record_free_function({"timer"}, {
             "set_multiplier",
-            // This Lua binding appears to set a global multiplier,
-            // whereas the C++ header shows a per-timer setter. The doc reflects the global intent.
-            "---@param multiplier number # The new global speed multiplier.\n"
+            "---@param timer integer|string # The handle or tag of the timer.\n"
+            "---@param multiplier number # The new speed multiplier.\n"
             "---@return nil",
-            "Sets the global speed multiplier for all timers.",
+            "Sets the speed multiplier of a timer.",
             true, false
         });
 
         rec.record_free_function({"timer"}, {
             "get_multiplier",
-            "---@return number",
-            "Gets the global timer speed multiplier.",
+            "---@param timer integer|string # The handle or tag of the timer.\n"
+            "---@return number|nil # The timer's speed multiplier, or nil if not found.",
+            "Gets the speed multiplier of a timer.",
             true, false
         });
 
         rec.record_free_function({"timer"}, {
             "get_for_elapsed",
-            "---@param timerHandle integer # The handle of a 'for' timer.\n"
+            "---@param timer integer|string # The handle or tag of a 'for' timer.\n"
             "---@return number|nil # The normalized elapsed time (0.0 to 1.0), or nil if not found.",
             "Gets the elapsed time for a 'for' timer.",
             true, false
@@ -309,7 +320,7 @@ wrap_timer_action(sol::function action) {
 
         rec.record_free_function({"timer"}, {
             "get_timer_and_delay",
-            "---@param timerHandle integer # The handle of the timer.\n"
+            "---@param timer integer|string # The handle or tag of the timer.\n"
             "---@return number, number # Returns two values: the elapsed time and the total delay. Returns a single nil if not found.",
             "Returns the timer object's elapsed time and its configured delay.",
             true, false
@@ -349,7 +360,7 @@ wrap_timer_action(sol::function action) {
                 auto afterWrapper  = wrap_noarg_callback(std::move(after));
                 std::string tag = maybeTag.value_or("");
                 std::string group = maybeGroup.value_or("");
-                timer::TimerSystem::timer_run(actionWrapper, afterWrapper, tag, group);
+                return timer::TimerSystem::timer_run(actionWrapper, afterWrapper, tag, group);
             });
         // timer_run_every_render_frame(action, after, tag)
         t.set_function("run_every_render_frame", [clone_to_main](sol::function action,
@@ -362,7 +373,7 @@ wrap_timer_action(sol::function action) {
             std::string tag = maybeTag.value_or("");
             std::string group = maybeGroup.value_or("");
 
-            timer::TimerSystem::timer_run_every_render_frame(actionWrapper, afterWrapper, tag, group);
+            return timer::TimerSystem::timer_run_every_render_frame(actionWrapper, afterWrapper, tag, group);
         });
         rec.record_free_function({"timer"}, {
             "run_every_render_frame",
@@ -385,7 +396,7 @@ wrap_timer_action(sol::function action) {
             {
                 auto actionWrapper = wrap_timer_action(clone_to_main(action));
                 std::string tag = maybeTag.value_or("");
-                timer::TimerSystem::timer_after(delay, actionWrapper, tag, maybeGroup.value_or(""));
+                return timer::TimerSystem::timer_after(delay, actionWrapper, tag, maybeGroup.value_or(""));
             });
         // timer_cooldown(delay, condition, action, times, after, tag)
         t.set_function("cooldown",
@@ -402,7 +413,7 @@ wrap_timer_action(sol::function action) {
                 auto actionWrapper = wrap_timer_action(clone_to_main(action));
                 auto afterWrapper  = wrap_noarg_callback(clone_to_main(after));
                 std::string tag = maybeTag.value_or("");
-                timer::TimerSystem::timer_cooldown(
+                return timer::TimerSystem::timer_cooldown(
                     delay, condWrapper, actionWrapper, times, afterWrapper, tag, maybeGroup.value_or(""));
             });
         // t.set_function("every",      &timer::TimerSystem::timer_every);
@@ -422,7 +433,7 @@ wrap_timer_action(sol::function action) {
             // std::function<void()> after = maybeAfter.value_or(sol::function{});
             auto maybeAfterWrapper = wrap_noarg_callback(clone_to_main(maybeAfter));
             std::string tag = maybeTag.value_or("");
-            timer::TimerSystem::timer_every(interval, actionWrapper, times, immediate, maybeAfterWrapper, tag, maybeGroup.value_or(""));
+            return timer::TimerSystem::timer_every(interval, actionWrapper, times, immediate, maybeAfterWrapper, tag, maybeGroup.value_or(""));
         });
         // timer_every_step(start, end, times, action, immediate, step, after, tag)
         t.set_function("every_step",
@@ -441,7 +452,7 @@ wrap_timer_action(sol::function action) {
                 auto stepWrapper   = wrap_ff(clone_to_main(step_method));
                 auto afterWrapper  = wrap_noarg_callback(clone_to_main(after));
                 std::string tag = maybeTag.value_or("");
-                timer::TimerSystem::timer_every_step(
+                return timer::TimerSystem::timer_every_step(
                     start_delay, end_delay, times,
                     actionWrapper, immediate,
                     stepWrapper, afterWrapper,
@@ -458,7 +469,7 @@ wrap_timer_action(sol::function action) {
                 auto actionWrapper = wrap_timer_action(clone_to_main(action));
                 auto afterWrapper  = wrap_noarg_callback(clone_to_main(after));
                 std::string tag = maybeTag.value_or("");
-                timer::TimerSystem::timer_for(duration, actionWrapper, afterWrapper, tag, maybeGroup.value_or(""));
+                return timer::TimerSystem::timer_for(duration, actionWrapper, afterWrapper, tag, maybeGroup.value_or(""));
             });
         
         
@@ -732,7 +743,7 @@ wrap_timer_action(sol::function action) {
 
             auto afterWrapper = wrap_noarg_callback(clone_to_main(after));
 
-            timer::TimerSystem::timer_tween(
+            return timer::TimerSystem::timer_tween(
                 duration, getWrapper, setWrapper, target_value,
                 /*tag*/   maybeTag.value_or(""),
                 /*group*/ maybeGroup.value_or(""),
@@ -785,7 +796,7 @@ wrap_timer_action(sol::function action) {
 
             if (tracks.empty()) {
                 if (maybeAfter && (*maybeAfter).valid()) { sol::protected_function pf(clone_to_main(*maybeAfter)); auto r = pf(); (void)r; }
-                return;
+                return timer::kNoTimer;
             }
 
             auto ease = (maybeMethod && (*maybeMethod).valid()) ? wrap_ff(clone_to_main(*maybeMethod))
@@ -797,7 +808,7 @@ wrap_timer_action(sol::function action) {
 
             auto afterWrapper = (maybeAfter && (*maybeAfter).valid()) ? wrap_noarg_callback(clone_to_main(*maybeAfter)) : [](){};
 
-            timer::TimerSystem::timer_tween(
+            return timer::TimerSystem::timer_tween(
                 duration,
                 [](){ return 0.f; },
                 compositeSetter,
@@ -833,7 +844,7 @@ wrap_timer_action(sol::function action) {
 
             if (tracks.empty()) {
                 if (maybeAfter && (*maybeAfter).valid()) { sol::protected_function pf(clone_to_main(*maybeAfter)); auto r = pf(); (void)r; }
-                return;
+                return timer::kNoTimer;
             }
 
             auto ease = (maybeMethod && (*maybeMethod).valid()) ? wrap_ff(clone_to_main(*maybeMethod))
@@ -847,7 +858,7 @@ wrap_timer_action(sol::function action) {
 
             auto afterWrapper = (maybeAfter && (*maybeAfter).valid()) ? wrap_noarg_callback(clone_to_main(*maybeAfter)) : [](){};
 
-            timer::TimerSystem::timer_tween(
+            return timer::TimerSystem::timer_tween(
                 duration,
                 [](){ return 0.0f; },
                 setter,
@@ -985,17 +996,17 @@ wrap_timer_action(sol::function action) {
         });
         
         
-        // timer.pause(tag)
+        // timer.pause(handle | tag)
         t.set_function("pause",
-            [](const std::string& tag) {
-                timer::TimerSystem::pause_timer(tag);
+            [](sol::object id) {
+                timer::TimerSystem::pause_timer(lua_timer_handle(id));
             }
         );
 
-        // timer.resume(tag)
+        // timer.resume(handle | tag)
         t.set_function("resume",
-            [](const std::string& tag) {
-                timer::TimerSystem::resume_timer(tag);
+            [](sol::object id) {
+                timer::TimerSystem::resume_timer(lua_timer_handle(id));
             }
         );
 
@@ -1026,7 +1037,7 @@ wrap_timer_action(sol::function action) {
 
         rec.record_free_function({"timer"}, {
             "pause",
-            "---@param tag string # The tag/handle of the timer to pause.\n"
+            "---@param timer integer|string # The handle or tag of the timer to pause.\n"
             "---@return nil",
             "Pauses the timer with the given tag.",
             true, false
@@ -1034,7 +1045,7 @@ wrap_timer_action(sol::function action) {
 
         rec.record_free_function({"timer"}, {
             "resume",
-            "---@param tag string # The tag/handle of the timer to resume.\n"
+            "---@param timer integer|string # The handle or tag of the timer to resume.\n"
             "---@return nil",
             "Resumes a previously paused timer.",
             true, false
@@ -1069,7 +1080,7 @@ wrap_timer_action(sol::function action) {
         
         rec.record_free_function({"timer"}, {
             "cancel",
-            "---@param timerHandle integer # The handle of the timer to cancel.\n"
+            "---@param timer integer|string # The handle returned when the timer was created, or its tag.\n"
             "---@return nil",
             "Cancels and destroys an active timer.",
             true, false
@@ -1077,7 +1088,7 @@ wrap_timer_action(sol::function action) {
 
         rec.record_free_function({"timer"}, {
             "get_every_index",
-            "---@param timerHandle integer # The handle of an 'every' timer.\n"
+            "---@param timer integer|string # The handle or tag of an 'every' timer.\n"
             "---@return integer|nil # The current invocation count, or nil if not found.",
             "Gets the current invocation count for an 'every' timer.",
             true, false
@@ -1085,7 +1096,7 @@ wrap_timer_action(sol::function action) {
 
         rec.record_free_function({"timer"}, {
             "reset",
-            "---@param timerHandle integer # The handle of the timer to reset.\n"
+            "---@param timer integer|string # The handle or tag of the timer to reset.\n"
             "---@return nil",
             "Resets a timer's elapsed time, such as for a 'cooldown'.",
             true, false
@@ -1093,7 +1104,7 @@ wrap_timer_action(sol::function action) {
 
         rec.record_free_function({"timer"}, {
             "get_delay",
-            "---@param timerHandle integer # The handle of the timer.\n"
+            "---@param timer integer|string # The handle or tag of the timer.\n"
             "---@return number|nil # The timer's current delay, or nil if not found.",
             "Gets the configured delay time for a timer.",
             true, false
@@ -1101,24 +1112,24 @@ wrap_timer_action(sol::function action) {
 
         rec.record_free_function({"timer"}, {
             "set_multiplier",
-            // This Lua binding appears to set a global multiplier,
-            // whereas the C++ header shows a per-timer setter. The doc reflects the global intent.
-            "---@param multiplier number # The new global speed multiplier.\n"
+            "---@param timer integer|string # The handle or tag of the timer.\n"
+            "---@param multiplier number # The new speed multiplier.\n"
             "---@return nil",
-            "Sets the global speed multiplier for all timers.",
+            "Sets the speed multiplier of a timer.",
             true, false
         });
 
         rec.record_free_function({"timer"}, {
             "get_multiplier",
-            "---@return number",
-            "Gets the global timer speed multiplier.",
+            "---@param timer integer|string # The handle or tag of the timer.\n"
+            "---@return number|nil # The timer's speed multiplier, or nil if not found.",
+            "Gets the speed multiplier of a timer.",
             true, false
         });
 
         rec.record_free_function({"timer"}, {
             "get_for_elapsed",
-            "---@param timerHandle integer # The handle of a 'for' timer.\n"
+            "---@param timer integer|string # The handle or tag of a 'for' timer.\n"
             "---@return number|nil # The normalized elapsed time (0.0 to 1.0), or nil if not found.",
             "Gets the elapsed time for a 'for' timer.",
             true, false
@@ -1126,7 +1137,7 @@ wrap_timer_action(sol::function action) {
 
         rec.record_free_function({"timer"}, {
             "get_timer_and_delay",
-            "---@param timerHandle integer # The handle of the timer.\n"
+            "---@param timer integer|string # The handle or tag of the timer.\n"
             "---@return number, number # Returns two values: the elapsed time and the total delay. Returns a single nil if not found.",
             "Returns the timer object's elapsed time and its configured delay.",
             true, false
@@ -1308,7 +1319,7 @@ wrap_timer_action(sol::function action) {
         rec.record_method("EventQueueSystem.EventBuilder", {"AddToQueue", "---@return nil", "Builds the event and adds it directly to the queue.", false, false});
 
         // 5) Core API
-        eq.set_function("add_event",        &timer::EventQueueSystem::EventManager::add_event);
+        eq.set_function("add_event",        static_cast<void (*)(const timer::EventQueueSystem::Event &, const std::string &, bool)>(&timer::EventQueueSystem::EventManager::add_event));
         eq.set_function("get_event_by_tag", &timer::EventQueueSystem::EventManager::get_event_by_tag);
         eq.set_function("clear_queue",      &timer::EventQueueSystem::EventManager::clear_queue);
         eq.set_function("update",           &timer::EventQueueSystem::EventManager::update);
@@ -1356,57 +1367,587 @@ wrap_timer_action(sol::function action) {
     {
         // in TimerSystem globals
         bool inUpdate = false;
-        std::vector<std::string> pendingCancels;
-        std::unordered_map<std::string, Timer> timers{}; // Timer Storage
-        std::unordered_map<std::string, std::vector<std::string>> groups{}; // Groups of timers w/ tags
-        int uuid_counter = base_uid;                     // Counter for generating unique IDs
+        std::unordered_map<std::string, std::vector<TimerHandle>> groups{}; // Groups of timers w/ handles
+        double clock_seconds = 0.0;
+
+        namespace
+        {
+            constexpr uint32_t kIndexBits = 20;
+            constexpr uint32_t kIndexMask = (1u << kIndexBits) - 1;
+            constexpr uint32_t kGenerationMask = 0xFFFu; // what is left of 32 bits
+            constexpr uint32_t kNoTag = UINT32_MAX;
+
+            // Timer storage. A deque so callbacks can add timers while a Timer& is
+            // held; slots are reused, the generation tells their occupants apart.
+            struct TimerSlot
+            {
+                Timer timer;
+                uint32_t generation = 1; // never 0, so no handle is kNoTimer
+                uint32_t tag = kNoTag;   // interned tag, if the timer has one
+                bool alive = false;
+            };
+
+            std::deque<TimerSlot> slots;
+            std::vector<uint32_t> freeSlots;
+            size_t liveTimers = 0;
+
+            // Tags are interned once; after that a tag is an index into tagOwners.
+            std::unordered_map<std::string, uint32_t> tagIds;
+            std::vector<TimerHandle> tagOwners; // by tag id, kNoTimer if unused
+
+            TimerSchedule schedule;                   // timers waiting for a delay, by slot
+            std::vector<TimerSchedule::Key> perFrame; // timers that act every update
+            std::vector<TimerSchedule::Key> perRenderFrame;
+            std::vector<TimerSchedule::Key> pendingErase; // finished during an update
+            std::vector<TimerSchedule::Key> frameKeys, dueKeys; // scratch, reused
+
+            TimerHandle handleOf(uint32_t index)
+            {
+                return (slots[index].generation << kIndexBits) | index;
+            }
+
+            uint32_t internTag(const std::string &tag)
+            {
+                auto [it, inserted] = tagIds.try_emplace(tag, static_cast<uint32_t>(tagOwners.size()));
+                if (inserted) tagOwners.push_back(kNoTimer);
+                return it->second;
+            }
+
+            std::vector<TimerSchedule::Key> &frameListFor(const Timer &timer)
+            {
+                return timer.type == TimerType::EVERY_RENDER_FRAME_ONLY ? perRenderFrame : perFrame;
+            }
+
+            // Elapsed time a waiting timer has to pass before it fires.
+            float threshold(const Timer &timer)
+            {
+                switch (timer.type)
+                {
+                case TimerType::AFTER:
+                    return timer.delay;
+                case TimerType::EVERY_STEP:
+                    return timer.delays[std::min<size_t>(timer.index, timer.delays.size() - 1)] * timer.multiplier;
+                default:
+                    return timer.delay * timer.multiplier;
+                }
+            }
+
+            bool runsEveryFrame(const Timer &timer)
+            {
+                switch (timer.type)
+                {
+                case TimerType::RUN:
+                case TimerType::FOR:
+                case TimerType::EVERY_RENDER_FRAME_ONLY:
+                    return true;
+                case TimerType::COOLDOWN:
+                    // past its delay it polls the condition every frame
+                    return timer.timer > threshold(timer);
+                default:
+                    return false;
+                }
+            }
+
+            TweenSystem::TweenId tweenOf(const Timer &timer)
+            {
+                return {TweenSystem::TweenChannelKind::Function, timer.tween};
+            }
+
+            // Puts a timer where update_timers will find it: the per-frame list, or
+            // the schedule at the clock time its threshold is crossed. A tween keeps
+            // its lane in the tween channel and is only resumed there.
+            void link(Timer &timer)
+            {
+                if (timer.paused || timer.finished) return;
+
+                if (timer.type == TimerType::TWEEN)
+                {
+                    TweenSystem::pause_tween(tweenOf(timer), false);
+                    return;
+                }
+
+                if (runsEveryFrame(timer))
+                {
+                    auto &list = frameListFor(timer);
+                    timer.active_slot = static_cast<uint32_t>(list.size());
+                    list.push_back(timer.schedule_key);
+                    return;
+                }
+
+                timer.on_clock = true;
+                timer.synced_at = clock_seconds;
+                schedule.schedule(timer.schedule_key, clock_seconds + std::max(0.0f, threshold(timer) - timer.timer));
+            }
+
+            // Takes a timer out of the list or schedule, folding clock time into `timer`.
+            void unlink(Timer &timer)
+            {
+                if (timer.type == TimerType::TWEEN) TweenSystem::pause_tween(tweenOf(timer), true);
+                if (timer.on_clock)
+                {
+                    timer.timer = timer_elapsed(timer);
+                    timer.on_clock = false;
+                    schedule.unschedule(timer.schedule_key);
+                }
+                if (timer.active_slot != UINT32_MAX)
+                {
+                    auto &list = frameListFor(timer);
+                    const TimerSchedule::Key last = list.back();
+                    list[timer.active_slot] = last;
+                    slots[last].timer.active_slot = timer.active_slot;
+                    list.pop_back();
+                    timer.active_slot = UINT32_MAX;
+                }
+            }
+
+            void relink(Timer &timer)
+            {
+                unlink(timer);
+                link(timer);
+            }
+
+            // Frees the slot; handles to it go stale.
+            void erase(TimerSchedule::Key index)
+            {
+                TimerSlot &slot = slots[index];
+                unlink(slot.timer);
+                if (slot.timer.type == TimerType::TWEEN) TweenSystem::cancel_tween(tweenOf(slot.timer));
+                if (slot.tag != kNoTag && tagOwners[slot.tag] == handleOf(index))
+                    tagOwners[slot.tag] = kNoTimer;
+
+                slot.timer = Timer{}; // drops the callbacks and what they capture
+                slot.tag = kNoTag;
+                slot.alive = false;
+                slot.generation = (slot.generation + 1) & kGenerationMask;
+                if (slot.generation == 0) slot.generation = 1;
+                freeSlots.push_back(index);
+            }
+
+            // Stops a timer for good. Inside an update the entry itself stays until the
+            // update is over, since a callback of this very timer may be running.
+            void finish(Timer &timer)
+            {
+                unlink(timer);
+                if (timer.finished) return;
+                if (timer.type == TimerType::TWEEN) TweenSystem::cancel_tween(tweenOf(timer)); // without its after()
+                timer.finished = true;
+                liveTimers--;
+                if (inUpdate)
+                {
+                    pendingErase.push_back(timer.schedule_key);
+                }
+                else
+                {
+                    erase(timer.schedule_key);
+                }
+            }
+
+            void erasePending()
+            {
+                for (TimerSchedule::Key index : pendingErase)
+                {
+                    if (slots[index].alive) erase(index);
+                }
+                pendingErase.clear();
+            }
+
+            // Callbacks may cancel their own timer or replace it (same tag, which
+            // finishes the old one); either way the rest of the step must leave it alone.
+            bool stillCurrent(const Timer &timer)
+            {
+                return !timer.finished;
+            }
+
+            // times > 0 counts down the remaining repeats; returns false once done.
+            bool countRepeat(Timer &timer)
+            {
+                if (timer.times <= 0) return true;
+                timer.times--;
+                if (timer.times > 0) return true;
+
+                // Call the after action and remove the timer
+                timer.after();
+                if (stillCurrent(timer)) finish(timer);
+                return false;
+            }
+
+            // A cooldown past its delay: fires once the condition holds.
+            void stepCooldown(Timer &timer)
+            {
+                if (!(timer.timer > threshold(timer) && timer.condition())) return;
+                if (!stillCurrent(timer)) return;
+
+                timer.action(std::nullopt);                                // Execute the action
+                if (!stillCurrent(timer)) return;
+                timer.timer = 0.0f;                                        // Reset the timer
+                timer.delay = timer_resolve_delay(timer.unresolved_delay); // Recalculate delay
+
+                if (countRepeat(timer)) relink(timer); // back to waiting for the delay
+            }
+
+            // Timers in the per-frame list.
+            void stepEveryFrame(Timer &timer, float dt)
+            {
+                timer.timer += dt;
+
+                switch (timer.type)
+                {
+                case TimerType::RUN:
+                    timer.action(std::nullopt); // Call the action every frame
+                    break;
+                case TimerType::FOR:
+                    if (timer.timer <= timer.delay)
+                    {
+                        timer.action(dt); // Call the action with delta time
+                    }
+                    else
+                    {
+                        // Call the after action and remove the timer
+                        timer.after();
+                        if (stillCurrent(timer)) finish(timer);
+                    }
+                    break;
+                case TimerType::COOLDOWN:
+                    stepCooldown(timer);
+                    break;
+                default:
+                    break;
+                }
+            }
+
+            // Timers popped from the schedule.
+            void stepDue(Timer &timer)
+            {
+                timer.timer = timer_elapsed(timer);
+                timer.synced_at = clock_seconds;
+
+                const float limit = threshold(timer);
+                if (!(timer.timer > limit))
+                {
+                    // exactly on the threshold (the check is strict): next update
+                    schedule.schedule(timer.schedule_key, clock_seconds + (limit - timer.timer));
+                    return;
+                }
+
+                switch (timer.type)
+                {
+                case TimerType::AFTER:
+                    // Execute the action, then remove the timer
+                    timer.action(std::nullopt);
+                    if (stillCurrent(timer)) finish(timer);
+                    break;
+                case TimerType::COOLDOWN:
+                    // from now on it polls its condition every frame
+                    relink(timer);
+                    stepCooldown(timer);
+                    break;
+                case TimerType::EVERY:
+                    timer.action(std::nullopt);                                // Execute the action
+                    if (!stillCurrent(timer)) break;
+                    timer.timer -= limit;                                      // Reset timer for the next interval
+                    timer.delay = timer_resolve_delay(timer.unresolved_delay); // Recalculate delay
+                    if (countRepeat(timer)) relink(timer);
+                    break;
+                case TimerType::EVERY_STEP:
+                    timer.action(std::nullopt); // Execute the action
+                    if (!stillCurrent(timer)) break;
+                    timer.timer -= limit;       // Reset timer
+                    timer.index++;              // Move to the next delay step
+                    if (countRepeat(timer)) relink(timer);
+                    break;
+                default:
+                    break;
+                }
+            }
+
+            // The tween channel's after() for a tween timer: it has written the final
+            // value and dropped the tween.
+            void finishTween(TimerHandle handle)
+            {
+                Timer *timer = get_timer(handle);
+                if (!timer) return;
+                timer->tween = {};
+                const std::function<void()> after = timer->after; // after() may replace this timer
+                after();
+                if ((timer = get_timer(handle))) finish(*timer);
+            }
+
+            // Runs `step` on every timer of a per-frame list. Iterates a copy: callbacks
+            // may add, cancel or pause timers (new ones start next update).
+            template <typename Step>
+            void runFrameList(const std::vector<TimerSchedule::Key> &list, Step step)
+            {
+                frameKeys.assign(list.begin(), list.end());
+                for (TimerSchedule::Key index : frameKeys)
+                {
+                    Timer &timer = slots[index].timer;
+                    if (timer.finished || timer.active_slot == UINT32_MAX) continue;
+                    step(timer);
+                }
+            }
+        }
+
+        TimerHandle add_timer(const Timer &timer, const std::string &tag, const std::string& group)
+        {
+            uint32_t tagId = kNoTag;
+            if (!tag.empty())
+            {
+                // same tag: the new timer replaces the old one
+                tagId = internTag(tag);
+                if (Timer *previous = get_timer(tagOwners[tagId])) finish(*previous);
+            }
+
+            uint32_t index;
+            if (!freeSlots.empty())
+            {
+                index = freeSlots.back();
+                freeSlots.pop_back();
+            }
+            else
+            {
+                if (slots.size() > kIndexMask)
+                    throw std::length_error("add_timer: too many live timers");
+                index = static_cast<uint32_t>(slots.size());
+                slots.emplace_back();
+            }
+
+            TimerSlot &slot = slots[index];
+            slot.timer = timer;
+            slot.timer.schedule_key = index;
+            slot.timer.active_slot = UINT32_MAX;
+            slot.timer.on_clock = false;
+            slot.timer.finished = false;
+            slot.tag = tagId;
+            slot.alive = true;
+            liveTimers++;
+
+            const TimerHandle handle = handleOf(index);
+            if (tagId != kNoTag) tagOwners[tagId] = handle;
+            link(slot.timer);
+
+            if (!group.empty())
+            {
+                auto &members = groups[group];
+                // drop finished timers before the vector would have to grow
+                if (members.size() == members.capacity())
+                    std::erase_if(members, [](TimerHandle h) { return get_timer(h) == nullptr; });
+                members.push_back(handle);
+            }
+            return handle;
+        }
+
+        Timer *get_timer(TimerHandle handle)
+        {
+            const uint32_t index = handle & kIndexMask;
+            if (index >= slots.size()) return nullptr;
+            TimerSlot &slot = slots[index];
+            if (!slot.alive || slot.generation != (handle >> kIndexBits) || slot.timer.finished) return nullptr;
+            return &slot.timer;
+        }
+
+        TimerHandle find_timer(const std::string &tag)
+        {
+            auto it = tagIds.find(tag);
+            if (it == tagIds.end()) return kNoTimer;
+            const TimerHandle handle = tagOwners[it->second];
+            return get_timer(handle) ? handle : kNoTimer;
+        }
+
+        size_t timer_count()
+        {
+            return liveTimers;
+        }
+
+        void pause_timer(TimerHandle handle)
+        {
+            Timer *timer = get_timer(handle);
+            if (!timer || timer->paused) return;
+            unlink(*timer);
+            timer->paused = true;
+        }
+
+        void resume_timer(TimerHandle handle)
+        {
+            Timer *timer = get_timer(handle);
+            if (!timer || !timer->paused) return;
+            timer->paused = false;
+            link(*timer);
+        }
+
+        void cancel_timer(TimerHandle handle)
+        {
+            Timer *timer = get_timer(handle);
+            if (!timer) return;
+
+            // call the after() if you want
+            if (timer->after) timer->after();
+
+            // after() may have replaced or cancelled it
+            timer = get_timer(handle);
+            if (!timer) return;
+            finish(*timer);
+            SPDLOG_DEBUG("Canceled timer {}", handle);
+        }
+
+        void timer_reset(TimerHandle handle)
+        {
+            if (Timer *timer = get_timer(handle))
+            {
+                // Reset the timer to zero
+                unlink(*timer);
+                timer->timer = 0.0f;
+                if (timer->type == TimerType::TWEEN) TweenSystem::rewind_tween(tweenOf(*timer));
+                link(*timer);
+
+                // Debug: Notify the timer was reset
+                std::cout << "Reset timer " << handle << "\n";
+            }
+            else
+            {
+                // Debug: Timer not found
+                std::cout << "Attempted to reset non-existent timer " << handle << "\n";
+            }
+        }
+
+        void timer_set_multiplier(TimerHandle handle, float multiplier)
+        {
+            if (Timer *timer = get_timer(handle))
+            {
+                // Set the multiplier (moves the fire time of a waiting timer)
+                unlink(*timer);
+                timer->multiplier = multiplier;
+                if (timer->type == TimerType::TWEEN) TweenSystem::set_tween_duration(tweenOf(*timer), timer->delay * multiplier);
+                link(*timer);
+
+                // Debug: Notify the multiplier was updated
+                std::cout << "Updated multiplier for timer " << handle << " to " << multiplier << "\n";
+            }
+            else
+            {
+                // Debug: Timer not found
+                std::cout << "Attempted to set multiplier for non-existent timer " << handle << "\n";
+            }
+        }
+
+        void kill_group(const std::string& group)
+        {
+            auto it = groups.find(group);
+            if (it == groups.end()) return;
+            for (TimerHandle handle : it->second) {
+                if (Timer *timer = get_timer(handle)) finish(*timer);
+            }
+            groups.erase(it);
+        }
+
+        void pause_group(const std::string& group)
+        {
+            auto it = groups.find(group);
+            if (it == groups.end()) return;
+            for (TimerHandle handle : it->second) pause_timer(handle);
+        }
+
+        void resume_group(const std::string& group)
+        {
+            auto it = groups.find(group);
+            if (it == groups.end()) return;
+            for (TimerHandle handle : it->second) resume_timer(handle);
+        }
+
+        void update_render_timers(float dt)
+        {
+            inUpdate = true;
+            runFrameList(perRenderFrame, [dt](Timer &timer) { timer.action(dt); });
+            inUpdate = false;
+            erasePending();
+        }
+
+        void update_timers(float dt)
+        {
+            inUpdate = true;
+
+            ZONE_SCOPED("Update Timers"); // custom label
+            clock_seconds += dt;
+
+            runFrameList(perFrame, [dt](Timer &timer) { stepEveryFrame(timer, dt); });
+
+            // Only timers whose delay ran out; the rest are not touched.
+            dueKeys.clear();
+            schedule.popDue(clock_seconds, dueKeys);
+            for (TimerSchedule::Key key : dueKeys)
+            {
+                Timer &timer = slots[key].timer;
+                // cancelled, paused or reset by an earlier callback this update
+                if (timer.finished || !timer.on_clock || schedule.scheduled(key)) continue;
+                stepDue(timer);
+            }
+
+            inUpdate = false;
+            
+            // now perform any deferred cancels
+            erasePending();
+        }
+
+        void clear_all_timers()
+        {
+            if (inUpdate)
+            {
+                // called from a timer callback: the running timer must outlive this call
+                for (TimerSlot &slot : slots)
+                    if (slot.alive) finish(slot.timer);
+                groups.clear();
+                return;
+            }
+
+            // slots are kept (and their generations bumped) so old handles stay stale
+            for (uint32_t index = 0; index < slots.size(); ++index)
+                if (slots[index].alive) erase(index);
+            liveTimers = 0;
+            groups.clear();
+            pendingErase.clear();
+        }
 
         // ------------------------------------------------
         // Base timer management functions
         // ------------------------------------------------
 
         // Timer Run: Calls an action every frame until canceled, then potentially calls an after action
-        void timer_run(const std::function<void(std::optional<float>)> &action, const std::function<void()> &after, const std::string &tag, const std::string& group)
+        TimerHandle timer_run(const std::function<void(std::optional<float>)> &action, const std::function<void()> &after, const std::string &tag, const std::string& group)
         {
-            // Generate a random tag if none is provided
-            std::string final_tag = tag.empty() ? random_uid() : tag;
-
             // Create and add the timer
             Timer timer;
             timer.type = TimerType::RUN;
             timer.action = action;
             timer.after = after;
 
-            add_timer(final_tag, std::move(timer), group);
+            const TimerHandle handle = add_timer(std::move(timer), tag, group);
 
             // Debug: Notify the timer was added
-            // SPDLOG_DEBUG("Added 'run' timer with tag: {}", final_tag);
+            // SPDLOG_DEBUG("Added 'run' timer {}", handle);
+
+            return handle;
         }
         
         // Timer Run Every Render Frame: Calls an action every render frame until canceled, then potentially calls an after action
-        void timer_run_every_render_frame(const std::function<void(std::optional<float>)> &action,
+        TimerHandle timer_run_every_render_frame(const std::function<void(std::optional<float>)> &action,
                                   const std::function<void()> &after,
                                   const std::string &tag,
                                   const std::string &group)
         {
-            std::string final_tag = tag.empty() ? random_uid() : tag;
-
             Timer timer;
             timer.type = TimerType::EVERY_RENDER_FRAME_ONLY;
             timer.action = action;
             timer.after = after;
             timer.timer = 0.0f;
 
-            add_timer(final_tag, std::move(timer), group);
+            const TimerHandle handle = add_timer(std::move(timer), tag, group);
+
+            return handle;
         }
 
 
         // Timer After: Calls an action after a delay
-        void timer_after(std::variant<float, std::pair<float, float>> delay, const std::function<void(std::optional<float>)> &action, const std::string &tag, const std::string& group)
+        TimerHandle timer_after(std::variant<float, std::pair<float, float>> delay, const std::function<void(std::optional<float>)> &action, const std::string &tag, const std::string& group)
         {
-            // Generate a random tag if none is provided
-            std::string final_tag = tag.empty() ? random_uid() : tag;
-
             // Create the timer and set its attributes
             Timer timer;
             timer.type = TimerType::AFTER;
@@ -1419,10 +1960,10 @@ wrap_timer_action(sol::function action) {
             timer.delay = timer_resolve_delay(delay);
 
             // Add the timer to the system
-            add_timer(final_tag, std::move(timer), group);
+            const TimerHandle handle = add_timer(std::move(timer), tag, group);
 
             // Debug: Notify the timer was added
-            // SPDLOG_DEBUG("Added 'after' timer with tag: {} and delay: {}", final_tag, std::visit([](auto &&arg) -> std::string
+            // SPDLOG_DEBUG("Added 'after' timer {} and delay: {}", handle, std::visit([](auto &&arg) -> std::string
                     //                                                                              {
                     // using T = std::decay_t<decltype(arg)>;
                     // if constexpr (std::is_same_v<T, float>) {
@@ -1430,14 +1971,13 @@ wrap_timer_action(sol::function action) {
                     // } else if constexpr (std::is_same_v<T, std::pair<float, float>>) {
                     //     return fmt::format("[{}, {}]", arg.first, arg.second); // Pair of floats
                     // } }, delay));
+
+            return handle;
         }
 
         // Timer Cooldown: Calls an action every delay seconds until a condition is met
-        void timer_cooldown(std::variant<float, std::pair<float, float>> delay, const std::function<bool()> &condition, const std::function<void(std::optional<float>)> &action, int times, const std::function<void()> &after, const std::string &tag, const std::string& group)
+        TimerHandle timer_cooldown(std::variant<float, std::pair<float, float>> delay, const std::function<bool()> &condition, const std::function<void(std::optional<float>)> &action, int times, const std::function<void()> &after, const std::string &tag, const std::string& group)
         {
-            // Generate a random tag if none is provided
-            std::string final_tag = tag.empty() ? random_uid() : tag;
-
             // Create the timer and set its attributes
             Timer timer;
             timer.type = TimerType::COOLDOWN;
@@ -1451,10 +1991,10 @@ wrap_timer_action(sol::function action) {
             timer.after = after;
 
             // Add the timer to the system
-            add_timer(final_tag, std::move(timer), group);
+            const TimerHandle handle = add_timer(std::move(timer), tag, group);
 
             // Debug: Notify the timer was added
-            // SPDLOG_DEBUG("Added 'cooldown' timer with tag: {} and delay: {}", final_tag, std::visit([](auto &&arg) -> std::string
+            // SPDLOG_DEBUG("Added 'cooldown' timer {} and delay: {}", handle, std::visit([](auto &&arg) -> std::string
             //                                                                                         {
             //         using T = std::decay_t<decltype(arg)>;
             //         if constexpr (std::is_same_v<T, float>) {
@@ -1462,14 +2002,13 @@ wrap_timer_action(sol::function action) {
             //         } else if constexpr (std::is_same_v<T, std::pair<float, float>>) {
             //             return fmt::format("[{}, {}]", arg.first, arg.second); // Pair of floats
             //         } }, delay));
+
+            return handle;
         }
 
         // Timer Every: Calls an action every delay seconds, potentially a limited number of times
-        void timer_every(std::variant<float, std::pair<float, float>> delay, const std::function<void(std::optional<float>)> &action, int times, bool immediate, const std::function<void()> &after, const std::string &tag, const std::string& group)
+        TimerHandle timer_every(std::variant<float, std::pair<float, float>> delay, const std::function<void(std::optional<float>)> &action, int times, bool immediate, const std::function<void()> &after, const std::string &tag, const std::string& group)
         {
-            // Generate a random tag if none is provided
-            std::string final_tag = tag.empty() ? random_uid() : tag;
-
             // Create the timer and set its attributes
             Timer timer;
             timer.type = TimerType::EVERY;
@@ -1482,7 +2021,7 @@ wrap_timer_action(sol::function action) {
             timer.after = after;
 
             // Add the timer to the system
-            add_timer(final_tag, std::move(timer), group);
+            const TimerHandle handle = add_timer(std::move(timer), tag, group);
 
             // Execute the action immediately if required
             if (immediate)
@@ -1491,7 +2030,7 @@ wrap_timer_action(sol::function action) {
             }
 
             // Debug: Notify the timer was added
-            // SPDLOG_DEBUG("Added 'every' timer with tag: {} and delay: {}", final_tag, std::visit([](auto &&arg) -> std::string
+            // SPDLOG_DEBUG("Added 'every' timer {} and delay: {}", handle, std::visit([](auto &&arg) -> std::string
             //                                                                                      {
             //         using T = std::decay_t<decltype(arg)>;
             //         if constexpr (std::is_same_v<T, float>) {
@@ -1499,19 +2038,18 @@ wrap_timer_action(sol::function action) {
             //         } else if constexpr (std::is_same_v<T, std::pair<float, float>>) {
             //             return fmt::format("[{}, {}]", arg.first, arg.second); // Pair of floats
             //         } }, delay));
+
+            return handle;
         }
 
         // Timer Every Step: Calls an action at regular intervals, potentially a limited number of times
-        void timer_every_step(float start_delay, float end_delay, int times, const std::function<void(std::optional<float>)> &action, bool immediate, const std::function<float(float)> &step_method, const std::function<void()> &after, const std::string &tag, const std::string& group)
+        TimerHandle timer_every_step(float start_delay, float end_delay, int times, const std::function<void(std::optional<float>)> &action, bool immediate, const std::function<float(float)> &step_method, const std::function<void()> &after, const std::string &tag, const std::string& group)
         {
             if (times < 2)
             {
                 throw std::invalid_argument("timer_every_step: 'times' must be >= 2");
             }
 
-            // Generate a random tag if none is provided
-            std::string final_tag = tag.empty() ? random_uid() : tag;
-
             // Calculate the step delay values
             std::vector<float> delays(times);
             float step = (end_delay - start_delay) / (times - 1);
@@ -1542,7 +2080,7 @@ wrap_timer_action(sol::function action) {
             timer.after = after;
 
             // Add the timer to the system
-            add_timer(final_tag, std::move(timer), group);
+            const TimerHandle handle = add_timer(std::move(timer), tag, group);
 
             // Execute the action immediately if required
             if (immediate)
@@ -1551,15 +2089,14 @@ wrap_timer_action(sol::function action) {
             }
 
             // Debug: Notify the timer was added
-            // SPDLOG_DEBUG("Added 'every_step' timer with tag: {} from {} to {} with {} steps", final_tag, start_delay, end_delay, times);
+            // SPDLOG_DEBUG("Added 'every_step' timer {} from {} to {} with {} steps", handle, start_delay, end_delay, times);
+
+            return handle;
         }
 
         // Timer For: Calls an action every frame for a duration
-        void timer_for(std::variant<float, std::pair<float, float>> duration, const std::function<void(std::optional<float>)> &action, const std::function<void()> &after, const std::string &tag, const std::string& group)
+        TimerHandle timer_for(std::variant<float, std::pair<float, float>> duration, const std::function<void(std::optional<float>)> &action, const std::function<void()> &after, const std::string &tag, const std::string& group)
         {
-            // Generate a random tag if none is provided
-            std::string final_tag = tag.empty() ? random_uid() : tag;
-
             // Create the timer and set its attributes
             Timer timer;
             timer.type = TimerType::FOR;
@@ -1571,10 +2108,10 @@ wrap_timer_action(sol::function action) {
             timer.after = after;
 
             // Add the timer to the system
-            add_timer(final_tag, std::move(timer), group);
+            const TimerHandle handle = add_timer(std::move(timer), tag, group);
 
             // Debug: Notify the timer was added
-            // SPDLOG_DEBUG("Added 'for' timer with tag: {} and duration: {}", final_tag, std::visit([](auto &&arg) -> std::string
+            // SPDLOG_DEBUG("Added 'for' timer {} and duration: {}", handle, std::visit([](auto &&arg) -> std::string
             //                                                                                       {
             //         using T = std::decay_t<decltype(arg)>;
             //         if constexpr (std::is_same_v<T, float>) {
@@ -1582,6 +2119,8 @@ wrap_timer_action(sol::function action) {
             //         } else if constexpr (std::is_same_v<T, std::pair<float, float>>) {
             //             return fmt::format("[{}, {}]", arg.first, arg.second); // Pair of floats
             //         } }, duration));
+
+            return handle;
         }
 
         /**
@@ -1597,17 +2136,20 @@ wrap_timer_action(sol::function action) {
          * @param easing_method A `std::function<float(float)>` that defines the easing method to apply. The input
          *                      is a normalized time value (0.0 to 1.0), and the output is the eased time.
          * @param after A `std::function<void()>` that will be called after the tween completes.
-         * @param tag A string identifier for the timer. If empty, a random unique identifier will be generated.
+         * @param tag Optional name for the timer; a later timer with the same tag replaces it.
          *
          * @details This function creates a timer of type `TWEEN` that interpolates a value from its current state
          *          (retrieved via `getter`) to the specified `target_value` over the resolved duration. The interpolation
          *          is performed using the provided `easing_method`. The timer is added to the system with the specified
          *          or generated tag. Once the tween completes, the `after` callback is invoked.
          *
+         *          The interpolation runs in TweenSystem's function channel, advanced by `update_tweens`; pausing,
+         *          resetting, cancelling or re-timing the timer (multiplier) acts on that tween.
+         *
          * @note The function logs debug information about the created timer, including its tag, start value, target value,
          *       and duration.
          */
-        void timer_tween(std::variant<float, std::pair<float, float>> duration,
+        TimerHandle timer_tween(std::variant<float, std::pair<float, float>> duration,
                          const std::function<float()> &getter,
                          const std::function<void(float)> &setter,
                          float target_value,
@@ -1617,42 +2159,29 @@ wrap_timer_action(sol::function action) {
                          const std::function<void()> &after
                          )
         {
-            // Generate a random tag if none is provided
-            std::string final_tag = tag.empty() ? random_uid() : tag;
-
             // Resolve delay
             float resolved_delay = timer_resolve_delay(duration);
 
             // Cache the start value at the time of tween creation
             float start_value = getter();
 
-            // Create the timer and set its attributes
+            // Create the timer and set its attributes; it only carries the handle,
+            // tag and group, the function channel does the interpolating
             Timer timer;
             timer.type = TimerType::TWEEN;
             timer.timer = 0.0f;
             timer.unresolved_delay = duration;
             timer.delay = resolved_delay;
-            timer.getter = getter;
-            timer.setter = setter;
-            timer.target_value = target_value;
-            timer.easing_method = easing_method;
             timer.after = after;
 
-            // Set up the tweening action
-            timer.action = [start_value, setter, easing_method, resolved_delay, target_value](std::optional<float> elapsed_time)
-            {
-                // SPDLOG_DEBUG("Tweening from {} to {} with elapsed time: {}", start_value, target_value, elapsed_time.value_or(0.0f));
-                float t = std::clamp(elapsed_time.value_or(0.0f) / resolved_delay, 0.0f, 1.0f); // Normalized time
-                float eased_t = easing_method(t);                                               // Apply easing
-                float interpolated_value = math::lerp(start_value, target_value, eased_t);
-                setter(interpolated_value); // Update the value
-            };
-
             // Add the timer to the system
-            add_timer(final_tag, std::move(timer), group);
+            const TimerHandle handle = add_timer(std::move(timer), tag, group);
+
+            get_timer(handle)->tween = TweenSystem::tween_custom(start_value, target_value, resolved_delay, setter, easing_method,
+                                                                 [handle] { finishTween(handle); }).handle;
 
             // Debug: Notify the timer was added
-            // SPDLOG_DEBUG("Added 'tween' timer with tag: {} to tween from {} to {} over {} seconds", final_tag, start_value, target_value,
+            // SPDLOG_DEBUG("Added 'tween' timer {} to tween from {} to {} over {} seconds", handle, start_value, target_value,
             //              std::visit([](auto &&arg) -> std::string
             //                         {
             // using T = std::decay_t<decltype(arg)>;
@@ -1661,6 +2190,8 @@ wrap_timer_action(sol::function action) {
             // } else if constexpr (std::is_same_v<T, std::pair<float, float>>) {
             //     return fmt::format("[{}, {}]", arg.first, arg.second);
             // } }, duration));
+
+            return handle;
         }
 
     }
@@ -1670,16 +2201,88 @@ wrap_timer_action(sol::function action) {
 
         namespace EventManager
         {
-            // Main queues for processing events
-            std::map<std::string, std::vector<Event>> queues = {
-                {"unlock", {}},
-                {"base", {}},
-                {"tutorial", {}},
-                {"achievement", {}},
-                {"other", {}}};
+            namespace
+            {
+                // What update() reads for every event, kept apart from the Event so
+                // the scan past blocked or waiting events never touches the payload.
+                struct EventSlot
+                {
+                    float wakeAt = 0.0f;        // a started AFTER event has nothing to do before this
+                    bool waiting = false;       // wakeAt is set
+                    bool realTime = true;       // which clock wakeAt is on
+                    bool canBeBlocked = true;
+                    bool blocksQueue = true;
+                    bool createdWhileGamePaused = false;
+                    bool remove = false;        // dropped at the next compaction
+                };
+
+                struct EventQueue
+                {
+                    std::string name;
+                    EventRing<EventSlot, Event> events;
+                    std::vector<Event> deferred; // added while events are being processed
+                    size_t unblockable = 0;      // events with canBeBlocked == false
+                    size_t removals = 0;         // slots flagged remove, not yet compacted
+                };
+
+                std::deque<EventQueue> queueStore; // indexed by QueueId
+                std::unordered_map<std::string, QueueId> queueIds;
+                std::vector<QueueId> queueOrder; // by name, the order update() visits queues
+
+                EventSlot slot_for(const Event &event)
+                {
+                    EventSlot slot;
+                    slot.realTime = event.timerTypeToUse == TimerType::REAL_TIME;
+                    slot.canBeBlocked = event.canBeBlocked;
+                    slot.blocksQueue = event.blocksQueue;
+                    slot.createdWhileGamePaused = event.createdWhileGamePaused;
+                    slot.remove = event.deleteNextCycleImmediately;
+                    return slot;
+                }
+
+                void push_event(EventQueue &q, Event event, bool front)
+                {
+                    const EventSlot slot = slot_for(event);
+                    if (!slot.canBeBlocked) q.unblockable++;
+                    if (slot.remove) q.removals++;
+                    if (front) q.events.push_front(slot, std::move(event));
+                    else q.events.push_back(slot, std::move(event));
+                }
+
+                template <typename Pred>
+                void compact(EventQueue &q, Pred remove)
+                {
+                    q.events.compact(remove);
+                    q.removals = 0;
+                    q.unblockable = 0;
+                    for (size_t i = 0; i < q.events.size(); ++i)
+                        if (!q.events.header(i).canBeBlocked) q.unblockable++;
+                }
+
+                // Drops events here and now, or flags them when update() is walking the queues.
+                template <typename Pred>
+                void remove_events(EventQueue &q, bool processing, Pred remove)
+                {
+                    if (!processing)
+                    {
+                        compact(q, [&](const EventSlot &slot, const Event &e) { return slot.remove || remove(e); });
+                        return;
+                    }
+                    for (size_t i = 0; i < q.events.size(); ++i)
+                    {
+                        EventSlot &slot = q.events.header(i);
+                        if (slot.remove || !remove(q.events.payload(i))) continue;
+                        slot.remove = true;
+                        q.removals++;
+                    }
+                }
 
-            // Deferred queues for events added during processing
-            std::map<std::string, std::vector<Event>> deferred_queues;
+                template <typename Fn>
+                void for_each_queue(Fn &&fn)
+                {
+                    for (QueueId id : queueOrder) fn(queueStore[id]);
+                }
+            }
 
             float queue_timer = globals::getTimerReal();
             float queue_dt = 1.0f / 60.0f; // 60 FPS
@@ -1688,142 +2291,143 @@ wrap_timer_action(sol::function action) {
             // Flag to indicate if events are being processed
             bool processing_events = false;
 
+            QueueId queue_id(const std::string &queue)
+            {
+                if (auto it = queueIds.find(queue); it != queueIds.end()) return it->second;
+
+                const QueueId id = static_cast<QueueId>(queueStore.size());
+                queueStore.emplace_back().name = queue;
+                queueIds.emplace(queue, id);
+                queueOrder.insert(std::lower_bound(queueOrder.begin(), queueOrder.end(), queue,
+                                                   [](QueueId a, const std::string &name)
+                                                   { return queueStore[a].name < name; }),
+                                  id);
+                return id;
+            }
+
+            const std::string &queue_name(QueueId queue)
+            {
+                return queueStore.at(queue).name;
+            }
+
+            size_t queue_size(const std::string &queue)
+            {
+                auto it = queueIds.find(queue);
+                if (it == queueIds.end()) return 0;
+                const EventQueue &q = queueStore[it->second];
+                return q.events.size() - q.removals + q.deferred.size();
+            }
+
             // Function to add an event to a queue
-            void add_event(const Event &event, const std::string &queue, bool front)
+            void add_event(const Event &event, QueueId queue, bool front)
             {
-                // Use the appropriate queue based on whether events are being processed
-                auto &target_queue = processing_events ? deferred_queues[queue] : queues[queue];
+                EventQueue &q = queueStore.at(queue);
 
                 // Check for tag collision if the event has a tag
                 if (!event.tag.empty())
                 {
-                    auto it = std::find_if(target_queue.begin(), target_queue.end(), [&](const Event &e)
-                                           { return e.tag == event.tag; });
-
-                    if (it != target_queue.end())
+                    if (processing_events)
                     {
-                        // Replace the existing event with the new one
-                        *it = event;
-                        init_event(const_cast<Event &>(*it));
-                        return;
+                        auto it = std::find_if(q.deferred.begin(), q.deferred.end(), [&](const Event &e)
+                                               { return e.tag == event.tag; });
+                        if (it != q.deferred.end())
+                        {
+                            // Replace the existing event with the new one
+                            *it = event;
+                            init_event(*it);
+                            return;
+                        }
+                    }
+                    else
+                    {
+                        for (size_t i = 0; i < q.events.size(); ++i)
+                        {
+                            EventSlot &slot = q.events.header(i);
+                            Event &existing = q.events.payload(i);
+                            if (slot.remove || existing.tag != event.tag) continue;
+
+                            // Replace the existing event with the new one
+                            existing = event;
+                            init_event(existing);
+                            if (!slot.canBeBlocked) q.unblockable--;
+                            slot = slot_for(existing);
+                            if (!slot.canBeBlocked) q.unblockable++;
+                            if (slot.remove) q.removals++;
+                            return;
+                        }
                     }
                 }
 
-                // Add the event to the appropriate queue
-                if (front)
-                {
-                    init_event(const_cast<Event &>(event));
-                    target_queue.insert(target_queue.begin(), event);
-                }
-                else
+                Event added = event;
+                if (front) init_event(added);
+
+                // Events added while processing wait until the queues have been walked
+                if (processing_events)
                 {
-                    target_queue.push_back(event);
+                    if (front) q.deferred.insert(q.deferred.begin(), std::move(added));
+                    else q.deferred.push_back(std::move(added));
+                    return;
                 }
+                push_event(q, std::move(added), front);
+            }
+
+            void add_event(const Event &event, const std::string &queue, bool front)
+            {
+                add_event(event, queue_id(queue), front);
             }
 
             // use "tag" to remove all events with a specific tag. This will make replacing certain events easier.
             // if no queue is provided or is empty, events with the tag will be removed from all queues
             void remove_event_by_tag(const std::string &tag, const std::string &queue = "")
             {
-                if (processing_events)
+                const auto hasTag = [&](const Event &e) { return e.tag == tag; };
+                if (queue.empty())
                 {
-                    if (queue.empty())
-                    {
-                        // Mark events for deletion across all queues
-                        for (auto &[key, events] : queues)
-                        {
-                            for (auto &event : events)
-                            {
-                                if (event.tag == tag)
-                                {
-                                    event.deleteNextCycleImmediately = true;
-                                }
-                            }
-                        }
-                    }
-                    else
-                    {
-                        // Mark events for deletion in a specific queue
-                        auto &events = queues[queue];
-                        for (auto &event : events)
-                        {
-                            if (event.tag == tag)
-                            {
-                                event.deleteNextCycleImmediately = true;
-                            }
-                        }
-                    }
+                    for_each_queue([&](EventQueue &q) { remove_events(q, processing_events, hasTag); });
                 }
                 else
                 {
-                    if (queue.empty())
-                    {
-                        // Remove events directly across all queues
-                        for (auto &[key, events] : queues)
-                        {
-                            events.erase(std::remove_if(events.begin(), events.end(),
-                                                        [&](const Event &e)
-                                                        { return e.tag == tag; }),
-                                         events.end());
-                        }
-                    }
-                    else
-                    {
-                        // Remove events directly from a specific queue
-                        auto &events = queues[queue];
-                        events.erase(std::remove_if(events.begin(), events.end(),
-                                                    [&](const Event &e)
-                                                    { return e.tag == tag; }),
-                                     events.end());
-                    }
+                    remove_events(queueStore[queue_id(queue)], processing_events, hasTag);
                 }
             }
 
             // Function to query if an event with a specific tag exists and return it
             std::optional<Event> get_event_by_tag(const std::string &tag, const std::string &queue)
             {
-                // Search all queues if no specific queue is provided
-                if (queue.empty())
+                std::optional<Event> found;
+                const auto search = [&](const EventQueue &q)
                 {
-                    for (const auto &[key, events] : queues)
+                    for (size_t i = 0; i < q.events.size() && !found; ++i)
                     {
-                        auto it = std::find_if(events.begin(), events.end(), [&](const Event &e)
-                                               { return e.tag == tag; });
-
-                        if (it != events.end())
-                        {
-                            return *it; // Return the found event
-                        }
+                        if (!q.events.header(i).remove && q.events.payload(i).tag == tag)
+                            found = q.events.payload(i); // Return the found event
                     }
+                };
+
+                // Search all queues if no specific queue is provided
+                if (queue.empty())
+                {
+                    for_each_queue([&](EventQueue &q) { if (!found) search(q); });
                 }
                 else
                 {
                     // Search within the specified queue
-                    auto &events = queues[queue];
-                    auto it = std::find_if(events.begin(), events.end(), [&](const Event &e)
-                                           { return e.tag == tag; });
-
-                    if (it != events.end())
-                    {
-                        return *it; // Return the found event
-                    }
+                    search(queueStore[queue_id(queue)]);
                 }
 
                 // Return an empty optional if no event is found
-                return std::nullopt;
+                return found;
             }
 
             // Function to merge deferred events into the main queues
             void merge_deferred_events()
             {
-                for (auto &[queue, deferred_events] : deferred_queues)
-                {
-                    queues[queue].insert(
-                        queues[queue].end(),
-                        std::make_move_iterator(deferred_events.begin()),
-                        std::make_move_iterator(deferred_events.end()));
-                    deferred_events.clear(); // Clear the deferred queue after merging
-                }
+                for_each_queue([](EventQueue &q)
+                               {
+                    for (Event &event : q.deferred)
+                        push_event(q, std::move(event), false);
+                    q.deferred.clear(); // Clear the deferred queue after merging
+                });
             }
 
             void init_event(Event &event)
@@ -1850,35 +2454,24 @@ wrap_timer_action(sol::function action) {
 
             void clear_queue(const std::string &queue, const std::string &exception)
             {
+                const auto notRetained = [](const Event &event)
+                { return !event.retainInQueueAfterCompletion; };
+
                 if (queue.empty())
                 {
-                    for (auto &[key, events] : queues)
-                    {
-                        events.erase(std::remove_if(events.begin(), events.end(),
-                                                    [](const Event &event)
-                                                    { return !event.retainInQueueAfterCompletion; }),
-                                     events.end());
-                    }
+                    for_each_queue([&](EventQueue &q)
+                                   { remove_events(q, processing_events, notRetained); });
                 }
                 else if (!exception.empty())
                 {
-                    for (auto &[key, events] : queues)
-                    {
-                        if (key != exception)
-                        {
-                            events.erase(std::remove_if(events.begin(), events.end(),
-                                                        [](const Event &event)
-                                                        { return !event.retainInQueueAfterCompletion; }),
-                                         events.end());
-                        }
-                    }
+                    for_each_queue([&](EventQueue &q)
+                                   {
+                        if (q.name != exception)
+                            remove_events(q, processing_events, notRetained); });
                 }
                 else
                 {
-                    queues[queue].erase(std::remove_if(queues[queue].begin(), queues[queue].end(),
-                                                       [](const Event &event)
-                                                       { return !event.retainInQueueAfterCompletion; }),
-                                        queues[queue].end());
+                    remove_events(queueStore[queue_id(queue)], processing_events, notRetained);
                 }
             }
 
@@ -2094,60 +2687,76 @@ wrap_timer_action(sol::function action) {
 
                     processing_events = true;
 
-                    for (auto &[key, events] : queues)
+                    const float nowReal = globals::getTimerReal();
+                    const float nowTotal = globals::getTimerTotal();
+
+                    // A callback may create a queue, which reorders queueOrder but never moves
+                    // an existing queue; walk a copy of the order.
+                    static std::vector<QueueId> visiting;
+                    visiting = queueOrder;
+                    for (QueueId id : visiting)
                     {
+                        EventQueue &q = queueStore[id];
                         bool blocked = false;
-                        auto it = events.begin();
-                        while (it != events.end())
+
+                        // Only events due this frame get handled; the scan decides that from
+                        // the slots alone. An event handled earlier in the loop may add events
+                        // (deferred) or flag removals, but never moves the ring.
+                        for (size_t i = 0; i < q.events.size(); ++i)
                         {
-                            // Check if the event is marked for immediate deletion
-                            if (it->deleteNextCycleImmediately)
+                            EventSlot &slot = q.events.header(i);
+                            if (slot.remove)
+                                continue;
+
+                            if (blocked && slot.canBeBlocked)
+                            {
+                                if (q.unblockable == 0)
+                                    break; // nothing further down can run this frame
+                                continue;
+                            }
+
+                            // paused: skipped without blocking the queue
+                            if (!slot.createdWhileGamePaused && game::isPaused)
+                                continue;
+
+                            // an AFTER event that is still counting down only blocks
+                            if (slot.waiting && (slot.realTime ? nowReal : nowTotal) < slot.wakeAt)
                             {
-                                it = events.erase(it);
+                                blocked = blocked || slot.blocksQueue;
                                 continue;
                             }
 
+                            Event &event = q.events.payload(i);
                             bool blocking = false;
                             bool completed = false;
                             bool time_done = false;
                             bool pause_skip = false;
 
-                            if (!blocked || !it->canBeBlocked)
-                            {
-                                handle_event(*it, blocking, completed, time_done, pause_skip);
-                            }
+                            handle_event(event, blocking, completed, time_done, pause_skip);
 
                             if (pause_skip)
-                            {
-                                ++it;
                                 continue;
-                            }
 
                             if (!blocked && blocking)
                             {
                                 blocked = true;
                             }
 
-                            if (completed && time_done)
+                            if (completed && time_done && !event.retainInQueueAfterCompletion)
                             {
-                                if (!it->retainInQueueAfterCompletion)
-                                {
-                                    it = events.erase(it);
-                                    if (events.empty())
-                                    {
-                                        break;
-                                    }
-                                }
-                                else
-                                {
-                                    ++it;
-                                }
+                                slot.remove = true;
+                                q.removals++;
                             }
                             else
                             {
-                                ++it;
+                                slot.waiting = event.eventTrigger == TriggerType::AFTER && event.timerStarted && !time_done;
+                                slot.wakeAt = event.time + event.delaySeconds;
                             }
                         }
+
+                        // Completed events go in one pass, not one erase each
+                        if (q.removals > 0)
+                            compact(q, [](const EventSlot &s, const Event &) { return s.remove; });
                     }
 
                     processing_events = false;
@@ -16,6 +16,9 @@
 
 #include "sol/sol.hpp"
 
+#include "timer_schedule.hpp"
+#include "tween_channel.hpp"
+
 #include "util/common_headers.hpp" // common headers like json, spdlog, tracy etc.
 
 
@@ -74,13 +77,26 @@ namespace timer
         
         bool paused = false; // Whether the timer is paused
 
-        // Tween-specific fields
-        std::function<float()> getter;             // Getter function for the value to be tweened
-        std::function<void(float)> setter;         // Setter function to update the value being tweened
-        float target_value = 0.0f;                 // Target value for tweening
-        std::function<float(float)> easing_method; // Easing function for smooth transitions
+        // A TWEEN timer is interpolated by this tween in TweenSystem's function
+        // channel; the timer itself only carries the handle, tag and group.
+        TweenHandle tween;
+
+        // Scheduling state, owned by TimerSystem. A timer waiting for a delay is not
+        // touched per frame: `timer` holds the elapsed time as of `synced_at` (on the
+        // TimerSystem clock) and keeps running on that clock while `on_clock` is set.
+        TimerSchedule::Key schedule_key = 0; // the timer's slot
+        uint32_t active_slot = UINT32_MAX;   // position in the per-frame list, if it runs every frame
+        double synced_at = 0.0;
+        bool on_clock = false;
+        bool finished = false;               // done or cancelled; erased once the update is over
     };
 
+    // Identifies a timer: slot index in the low 20 bits, the slot's generation in
+    // the high 12, so a handle to a finished timer never reaches its slot's next
+    // occupant. 0 is never a live timer.
+    using TimerHandle = uint32_t;
+    constexpr TimerHandle kNoTimer = 0;
+
     // TODO: document which timers use mutilplier
     //  TODO: what happens if I want to ease values that are not float? what about colors?\
     //TODO: clarify when action gets sent in a dt value and when it does not
@@ -89,17 +105,16 @@ namespace timer
     {
         // in TimerSystem globals
         extern bool inUpdate;
-        extern std::vector<std::string> pendingCancels;
-        
-        extern std::unordered_map<std::string, Timer> timers; // Timer Storage
         
-        // new: store groups of timers by tag, does not interfere with the main timers map
-        extern std::unordered_map<std::string, std::vector<std::string>> groups;
+        // new: store groups of timers by tag, does not interfere with timer storage
+        extern std::unordered_map<std::string, std::vector<TimerHandle>> groups;
         
         const std::string default_group_tag = "default"; // Default group for timers. All timers without a group will be added to this group.
 
-        const int base_uid = 0;
-        extern int uuid_counter;
+        // Sum of every dt passed to update_timers. Timers waiting for a delay are
+        // scheduled on this clock instead of being advanced each frame.
+        extern double clock_seconds;
+
         // ------------------------------------------------
         // Base timer management functions
         // ------------------------------------------------
@@ -109,217 +124,131 @@ namespace timer
             // nothing
         }
 
-        // Utility functions for randomization
-        inline std::string random_uid()
-        {
-            // increment the counter
-            uuid_counter++;
-            return std::to_string(uuid_counter);
-        }
+        // Timers live in a slot map and are identified by their handle. A tag is
+        // optional: it is interned once and only used to find the timer by name
+        // (the string overloads below), or to replace a timer with the same tag.
+        extern TimerHandle add_timer(const Timer &timer, const std::string &tag = "", const std::string& group=default_group_tag);
 
-        // Core timer management functions
-        inline void add_timer(const std::string &tag, const Timer &timer, const std::string& group=default_group_tag)
-        { // add a new timer to the system
-            timers[tag] = std::move(timer);
-            if (!group.empty())
-                groups[group].push_back(tag);
-        }
-        
-        inline void pause_timer(const std::string& tag)   { timers.at(tag).paused = true; }
-        inline void resume_timer(const std::string& tag)  { timers.at(tag).paused = false; }
-
-        // inline void cancel_timer(const std::string &tag)
-        // {
-        //     auto it = timers.find(tag);
-        //     if (it != timers.end())
-        //     {
-        //         // Call the "after" function before removing the timer
-        //         if (it->second.after)
-        //         {
-        //             it->second.after();
-        //         }
-
-        //         // Remove the timer
-        //         timers.erase(it);
-
-        //         // Debug: Notify the timer was canceled
-        //         std::cout << "Canceled timer with tag: " << tag << "\n";
-        //     }
-        // }
+        extern Timer *get_timer(TimerHandle handle);   // nullptr once the timer is gone
+        extern TimerHandle find_timer(const std::string &tag); // kNoTimer if no live timer has the tag
+        extern size_t timer_count();
         
-        inline void cancel_timer(const std::string &tag)
+        extern void pause_timer(TimerHandle handle);
+        extern void resume_timer(TimerHandle handle);
+        extern void cancel_timer(TimerHandle handle);
+        extern void timer_reset(TimerHandle handle);
+        extern void timer_set_multiplier(TimerHandle handle, float multiplier);
+
+        inline void pause_timer(const std::string& tag)   { pause_timer(find_timer(tag)); }
+        inline void resume_timer(const std::string& tag)  { resume_timer(find_timer(tag)); }
+        inline void cancel_timer(const std::string &tag)  { cancel_timer(find_timer(tag)); }
+        inline void timer_reset(const std::string &tag)   { timer_reset(find_timer(tag)); }
+        inline void timer_set_multiplier(const std::string &tag, float multiplier) { timer_set_multiplier(find_timer(tag), multiplier); }
+
+        // Elapsed time of a timer, including time on the clock since it was last synced.
+        inline float timer_elapsed(const Timer &timer)
         {
-            auto it = timers.find(tag);
-            if (it == timers.end()) return;
-
-            // call the after() if you want
-            if (it->second.after) it->second.after();
-
-            // if we’re inside update_timers, defer the actual erase
-            if (inUpdate) {
-                pendingCancels.push_back(tag);
-            } else {
-                timers.erase(it);
-            }
+            return timer.on_clock ? timer.timer + static_cast<float>(clock_seconds - timer.synced_at) : timer.timer;
         }
 
-        inline std::optional<int> timer_get_every_index(const std::string &tag)
+        inline std::optional<int> timer_get_every_index(TimerHandle handle)
         {
-            // Find the timer by tag
-            auto it = timers.find(tag);
-
-            if (it != timers.end())
+            if (const Timer *timer = get_timer(handle))
             {
-                const Timer &timer = it->second;
-
                 // Ensure the timer type is 'Every'
-                if (timer.type == TimerType::EVERY)
+                if (timer->type == TimerType::EVERY)
                 {
-                    return timer.index; // Return the current iteration index
+                    return timer->index; // Return the current iteration index
                 }
                 else
                 {
                     // Debug: Timer is not of type 'Every'
-                    std::cout << "Timer with tag: " << tag << " is not of type 'Every'.\n";
+                    std::cout << "Timer " << handle << " is not of type 'Every'.\n";
                     return std::nullopt;
                 }
             }
             else
             {
                 // Debug: Timer not found
-                std::cout << "Attempted to get index of non-existent timer with tag: " << tag << "\n";
+                std::cout << "Attempted to get index of non-existent timer " << handle << "\n";
                 return std::nullopt; // Timer does not exist
             }
         }
 
-        inline void timer_reset(const std::string &tag)
-        {
-            // Find the timer by tag
-            auto it = timers.find(tag);
-
-            if (it != timers.end())
-            {
-                Timer &timer = it->second;
-
-                // Reset the timer to zero
-                timer.timer = 0.0f;
-
-                // Debug: Notify the timer was reset
-                std::cout << "Reset timer with tag: " << tag << "\n";
-            }
-            else
-            {
-                // Debug: Timer not found
-                std::cout << "Attempted to reset non-existent timer with tag: " << tag << "\n";
-            }
-        }
-
-        inline std::optional<float> timer_get_delay(const std::string &tag)
+        inline std::optional<float> timer_get_delay(TimerHandle handle)
         {
-            // Find the timer by tag
-            auto it = timers.find(tag);
-
-            if (it != timers.end())
+            if (const Timer *timer = get_timer(handle))
             {
-                return it->second.delay; // Return the current delay value
+                return timer->delay; // Return the current delay value
             }
             else
             {
                 // Debug: Timer not found
-                std::cout << "Attempted to get delay of non-existent timer with tag: " << tag << "\n";
+                std::cout << "Attempted to get delay of non-existent timer " << handle << "\n";
                 return std::nullopt; // Timer does not exist
             }
         }
 
-        inline void timer_set_multiplier(const std::string &tag, float multiplier)
+        inline std::optional<float> timer_get_multiplier(TimerHandle handle)
         {
-            // Find the timer by tag
-            auto it = timers.find(tag);
-
-            if (it != timers.end())
+            if (const Timer *timer = get_timer(handle))
             {
-                Timer &timer = it->second;
-
-                // Set the multiplier
-                timer.multiplier = multiplier;
-
-                // Debug: Notify the multiplier was updated
-                std::cout << "Updated multiplier for timer with tag: " << tag << " to " << multiplier << "\n";
+                return timer->multiplier; // Return the current multiplier
             }
             else
             {
                 // Debug: Timer not found
-                std::cout << "Attempted to set multiplier for non-existent timer with tag: " << tag << "\n";
-            }
-        }
-
-        inline std::optional<float> timer_get_multiplier(const std::string &tag)
-        {
-            // Find the timer by tag
-            auto it = timers.find(tag);
-
-            if (it != timers.end())
-            {
-                return it->second.multiplier; // Return the current multiplier
-            }
-            else
-            {
-                // Debug: Timer not found
-                std::cout << "Attempted to get multiplier for non-existent timer with tag: " << tag << "\n";
+                std::cout << "Attempted to get multiplier for non-existent timer " << handle << "\n";
                 return std::nullopt;
             }
         }
 
-        inline std::optional<float> timer_get_for_elapsed_time(const std::string &tag)
+        inline std::optional<float> timer_get_for_elapsed_time(TimerHandle handle)
         {
-            // Find the timer by tag
-            auto it = timers.find(tag);
-
-            if (it != timers.end())
+            if (const Timer *timer = get_timer(handle))
             {
-                const Timer &timer = it->second;
-
                 // Ensure the timer type is 'For'
-                if (timer.type == TimerType::FOR)
+                if (timer->type == TimerType::FOR)
                 {
                     // Calculate the normalized elapsed time
-                    return std::clamp(timer.timer / timer.delay, 0.0f, 1.0f);
+                    return std::clamp(timer_elapsed(*timer) / timer->delay, 0.0f, 1.0f);
                 }
                 else
                 {
                     // Debug: Timer is not of type 'For'
-                    std::cout << "Timer with tag: " << tag << " is not of type 'For'.\n";
+                    std::cout << "Timer " << handle << " is not of type 'For'.\n";
                     return std::nullopt;
                 }
             }
             else
             {
                 // Debug: Timer not found
-                std::cout << "Attempted to get elapsed time for non-existent timer with tag: " << tag << "\n";
+                std::cout << "Attempted to get elapsed time for non-existent timer " << handle << "\n";
                 return std::nullopt;
             }
         }
 
-        inline std::optional<std::pair<float, float>> timer_get_timer_and_delay(const std::string &tag)
+        inline std::optional<std::pair<float, float>> timer_get_timer_and_delay(TimerHandle handle)
         {
-            // Find the timer by tag
-            auto it = timers.find(tag);
-
-            if (it != timers.end())
+            if (const Timer *timer = get_timer(handle))
             {
-                const Timer &timer = it->second;
-
                 // Return both the elapsed time and the delay
-                return std::make_pair(timer.timer, timer.delay);
+                return std::make_pair(timer_elapsed(*timer), timer->delay);
             }
             else
             {
                 // Debug: Timer not found
-                std::cout << "Attempted to get timer and delay for non-existent timer with tag: " << tag << "\n";
+                std::cout << "Attempted to get timer and delay for non-existent timer " << handle << "\n";
                 return std::nullopt;
             }
         }
 
+        inline std::optional<int> timer_get_every_index(const std::string &tag) { return timer_get_every_index(find_timer(tag)); }
+        inline std::optional<float> timer_get_delay(const std::string &tag) { return timer_get_delay(find_timer(tag)); }
+        inline std::optional<float> timer_get_multiplier(const std::string &tag) { return timer_get_multiplier(find_timer(tag)); }
+        inline std::optional<float> timer_get_for_elapsed_time(const std::string &tag) { return timer_get_for_elapsed_time(find_timer(tag)); }
+        inline std::optional<std::pair<float, float>> timer_get_timer_and_delay(const std::string &tag) { return timer_get_timer_and_delay(find_timer(tag)); }
+
         inline float timer_resolve_delay(const std::variant<float, std::pair<float, float>> &delay)
         {
             if (std::holds_alternative<float>(delay))
@@ -339,220 +268,36 @@ namespace timer
             }
         }
         
-        inline void kill_group(const std::string& group) {
-            auto it = groups.find(group);
-            if (it == groups.end()) return;
-            for (auto& tag : it->second) {
-              timers.erase(tag);
-            }
-            groups.erase(it);
-          }
-          
-        inline void pause_group(const std::string& group) {
-            auto it = groups.find(group);
-            if (it == groups.end()) return;
-            for (auto& tag : it->second) {
-                timers[tag].paused = true;
-            }
-        }
+        extern void kill_group(const std::string& group);
+        extern void pause_group(const std::string& group);
+        extern void resume_group(const std::string& group);
         
-        inline void resume_group(const std::string& group) {
-            auto it = groups.find(group);
-            if (it == groups.end()) return;
-            for (auto& tag : it->second) {
-                timers[tag].paused = false;
-            }
-        }
+        // Runs EVERY_RENDER_FRAME_ONLY timers.
+        extern void update_render_timers(float dt);
+
+        // Advances the clock and runs what is due: timers that act every frame (run,
+        // for, a cooldown waiting on its condition) are kept in a dense list,
+        // timers waiting for a delay sit in a TimerSchedule and are only touched once
+        // they are due. Tween timers advance in TweenSystem::update_tweens.
+        extern void update_timers(float dt);
         
-        inline void update_render_timers(float dt)
-        {
-            inUpdate = true;
-            std::vector<std::string> toRemove;
-
-            for (auto &[tag, timer] : timers)
-            {
-                if (timer.type == TimerType::EVERY_RENDER_FRAME_ONLY)
-                {
-                    timer.action(dt);
-                }
-            }
-
-            inUpdate = false;
-        }
-
-
-        inline void update_timers(float dt)
-        {
-            inUpdate = true;
-
-            ZONE_SCOPED("Update Timers"); // custom label
-            for (auto it = timers.begin(); it != timers.end();)
-            {
-                Timer &timer = it->second;
-                
-                if (timer.paused)
-                {
-                    // If the timer is paused, skip to the next timer
-                    ++it;
-                    continue;
-                }
-
-                // update timer
-                timer.timer += dt;
-
-                // Handle "run" timers
-                if (timer.type == TimerType::RUN)
-                {
-                    timer.action(std::nullopt); // Call the action every frame
-                }
-                else if (timer.type == TimerType::AFTER)
-                {
-                    if (timer.timer > timer.delay)
-                    {
-                        // Execute the action
-                        timer.action(std::nullopt);
-
-                        // Remove the timer after execution
-                        it = timers.erase(it);
-
-                        // Continue to the next timer
-                        continue;
-                    }
-                }
-                else if (timer.type == TimerType::COOLDOWN)
-                {
-                    // Check if delay has passed and condition is met
-                    if (timer.timer > timer.delay * timer.multiplier && timer.condition())
-                    {
-                        timer.action(std::nullopt);                                // Execute the action
-                        timer.timer = 0.0f;                                        // Reset the timer
-                        timer.delay = timer_resolve_delay(timer.unresolved_delay); // Recalculate delay
-
-                        // Decrease the remaining times count if applicable
-                        if (timer.times > 0)
-                        {
-                            timer.times--;
-                            if (timer.times <= 0)
-                            {
-                                // Call the after action and remove the timer
-                                timer.after();
-                                it = timers.erase(it);
-                                continue;
-                            }
-                        }
-                    }
-                }
-                else if (timer.type == TimerType::EVERY)
-                {
-                    if (timer.timer > timer.delay * timer.multiplier)
-                    {
-                        timer.action(std::nullopt);                                // Execute the action
-                        timer.timer -= timer.delay * timer.multiplier;             // Reset timer for the next interval
-                        timer.delay = timer_resolve_delay(timer.unresolved_delay); // Recalculate delay
-
-                        // Decrease the remaining times count if applicable
-                        if (timer.times > 0)
-                        {
-                            timer.times--;
-                            if (timer.times <= 0)
-                            {
-                                // Call the after action and remove the timer
-                                timer.after();
-                                it = timers.erase(it);
-                                continue;
-                            }
-                        }
-                    }
-                }
-                else if (timer.type == TimerType::EVERY_STEP)
-                {
-                    if (timer.timer > timer.delays[timer.index] * timer.multiplier)
-                    {
-                        timer.action(std::nullopt);                                  // Execute the action
-                        timer.timer -= timer.delays[timer.index] * timer.multiplier; // Reset timer
-                        timer.index++;                                               // Move to the next delay step
-
-                        // Decrease the remaining times count if applicable
-                        if (timer.times > 0)
-                        {
-                            timer.times--;
-                            if (timer.times <= 0)
-                            {
-                                // Call the after action and remove the timer
-                                timer.after();
-                                it = timers.erase(it);
-                                continue;
-                            }
-                        }
-                    }
-                }
-                else if (timer.type == TimerType::FOR)
-                {
-                    if (timer.timer <= timer.delay)
-                    {
-                        timer.action(dt); // Call the action with delta time
-                    }
-                    else
-                    {
-                        // Call the after action and remove the timer
-                        timer.after();
-                        it = timers.erase(it);
-                        continue;
-                    }
-                }
-                else if (timer.type == TimerType::TWEEN)
-                {
-                    float effective = timer.delay * timer.multiplier;  // if you ever use multiplier
-                    if (timer.timer < effective)
-                    {
-                        // Normal interpolated step
-                        timer.action(timer.timer);
-                    }
-                    else
-                    {
-                        // Final eased step at t = 1.0
-                        timer.action(effective);
-                        timer.after();
-                        it = timers.erase(it);
-                        continue;
-                    }
-                }
-
-
-                ++it; // Move to the next timer
-            }
-            inUpdate = false;
-            
-            // now perform any deferred cancels
-            for (auto &tag : pendingCancels) {
-                timers.erase(tag);  // safe now, we’re outside the loop
-                // Debug: Notify the timer was canceled
-                SPDLOG_DEBUG("Canceled timer with tag: {}", tag);
-            }
-            pendingCancels.clear();
-        }
-        
-        inline void clear_all_timers()
-        {
-            timers.clear();
-            groups.clear();
-        }
+        extern void clear_all_timers();
 
         // ------------------------------------------------
         // Timer creation functions
         // ------------------------------------------------
 
-        extern void timer_run(const std::function<void(std::optional<float>)> &action, const std::function<void()> &after = []() {}, const std::string &tag = "", const std::string& group=default_group_tag);
-        extern void timer_run_every_render_frame(const std::function<void(std::optional<float>)> &action,
+        extern TimerHandle timer_run(const std::function<void(std::optional<float>)> &action, const std::function<void()> &after = []() {}, const std::string &tag = "", const std::string& group=default_group_tag);
+        extern TimerHandle timer_run_every_render_frame(const std::function<void(std::optional<float>)> &action,
                                   const std::function<void()> &after = []() {},
                                   const std::string &tag = "",
                                   const std::string& group=default_group_tag);
-        extern void timer_after(std::variant<float, std::pair<float, float>> delay, const std::function<void(std::optional<float>)> &action, const std::string &tag = "", const std::string& group=default_group_tag);
-        extern void timer_cooldown(std::variant<float, std::pair<float, float>> delay, const std::function<bool()> &condition, const std::function<void(std::optional<float>)> &action, int times = 0, const std::function<void()> &after = []() {}, const std::string &tag = "", const std::string& group=default_group_tag);
-        extern void timer_every(std::variant<float, std::pair<float, float>> delay, const std::function<void(std::optional<float>)> &action, int times = 0, bool immediate = false, const std::function<void()> &after = []() {}, const std::string &tag = "", const std::string& group=default_group_tag);
-        extern void timer_every_step(float start_delay, float end_delay, int times, const std::function<void(std::optional<float>)> &action, bool immediate = false, const std::function<float(float)> &step_method = nullptr, const std::function<void()> &after = []() {}, const std::string &tag = "", const std::string& group=default_group_tag);
-        extern void timer_for(std::variant<float, std::pair<float, float>> duration, const std::function<void(std::optional<float>)> &action, const std::function<void()> &after = []() {}, const std::string &tag = "", const std::string& group=default_group_tag);
-        extern void timer_tween(std::variant<float, std::pair<float, float>> duration, const std::function<float()> &getter, const std::function<void(float)> &setter, float target_value, const std::string &tag = "", const std::string& group=default_group_tag, const std::function<float(float)> &easing_method = [](float t)
+        extern TimerHandle timer_after(std::variant<float, std::pair<float, float>> delay, const std::function<void(std::optional<float>)> &action, const std::string &tag = "", const std::string& group=default_group_tag);
+        extern TimerHandle timer_cooldown(std::variant<float, std::pair<float, float>> delay, const std::function<bool()> &condition, const std::function<void(std::optional<float>)> &action, int times = 0, const std::function<void()> &after = []() {}, const std::string &tag = "", const std::string& group=default_group_tag);
+        extern TimerHandle timer_every(std::variant<float, std::pair<float, float>> delay, const std::function<void(std::optional<float>)> &action, int times = 0, bool immediate = false, const std::function<void()> &after = []() {}, const std::string &tag = "", const std::string& group=default_group_tag);
+        extern TimerHandle timer_every_step(float start_delay, float end_delay, int times, const std::function<void(std::optional<float>)> &action, bool immediate = false, const std::function<float(float)> &step_method = nullptr, const std::function<void()> &after = []() {}, const std::string &tag = "", const std::string& group=default_group_tag);
+        extern TimerHandle timer_for(std::variant<float, std::pair<float, float>> duration, const std::function<void(std::optional<float>)> &action, const std::function<void()> &after = []() {}, const std::string &tag = "", const std::string& group=default_group_tag);
+        extern TimerHandle timer_tween(std::variant<float, std::pair<float, float>> duration, const std::function<float()> &getter, const std::function<void(float)> &setter, float target_value, const std::string &tag = "", const std::string& group=default_group_tag, const std::function<float(float)> &easing_method = [](float t)
                                                                                                                                                                                            { return t < 0.5 ? 2 * t * t : t * (4 - 2 * t) - 1; }, // Default easing method (ease-in-out quad)
                                 const std::function<void()> &after = []() {});
                   
@@ -626,11 +371,19 @@ namespace timer
 
         namespace EventManager
         {
-            extern std::map<std::string, std::vector<Event>> queues;
+            // Queues are addressed by interned ids; the string overloads intern on use.
+            // Queues are processed in name order.
+            using QueueId = uint32_t;
+
             extern float queue_timer;
             extern float queue_dt;
             extern float queue_last_processed;
 
+            extern QueueId queue_id(const std::string &queue); // creates the queue if needed
+            extern const std::string &queue_name(QueueId queue);
+            extern size_t queue_size(const std::string &queue); // includes retained events
+
+            extern void add_event(const Event &event, QueueId queue, bool front = false);
             extern void add_event(const Event &event, const std::string &queue = "base", bool front = false);
             extern void init_event(Event &event);
             extern std::optional<Event> get_event_by_tag(const std::string &tag, const std::string &queue = "");
@@ -0,0 +1,91 @@
+#include "timer_schedule.hpp"
+
+namespace timer {
+
+void TimerSchedule::schedule(Key key, double due) {
+    if (key >= position_.size()) position_.resize(key + 1, kNotQueued);
+
+    const uint32_t at = position_[key];
+    if (at == kNotQueued) {
+        heap_.push_back({due, key});
+        position_[key] = static_cast<uint32_t>(heap_.size() - 1);
+        siftUp(heap_.size() - 1);
+        return;
+    }
+
+    const double before = heap_[at].due;
+    heap_[at].due = due;
+    if (due < before) {
+        siftUp(at);
+    } else {
+        siftDown(at);
+    }
+}
+
+void TimerSchedule::unschedule(Key key) {
+    if (!scheduled(key)) return;
+    removeAt(position_[key]);
+}
+
+bool TimerSchedule::scheduled(Key key) const {
+    return key < position_.size() && position_[key] != kNotQueued;
+}
+
+double TimerSchedule::due(Key key) const {
+    return heap_[position_[key]].due;
+}
+
+void TimerSchedule::popDue(double now, std::vector<Key> &out) {
+    while (!heap_.empty() && heap_.front().due <= now) {
+        out.push_back(heap_.front().key);
+        removeAt(0);
+    }
+}
+
+void TimerSchedule::clear() {
+    heap_.clear();
+    position_.clear();
+}
+
+void TimerSchedule::place(size_t i, const Entry &entry) {
+    heap_[i] = entry;
+    position_[entry.key] = static_cast<uint32_t>(i);
+}
+
+void TimerSchedule::siftUp(size_t i) {
+    const Entry entry = heap_[i];
+    while (i > 0) {
+        const size_t parent = (i - 1) / 2;
+        if (!(entry.due < heap_[parent].due)) break;
+        place(i, heap_[parent]);
+        i = parent;
+    }
+    place(i, entry);
+}
+
+void TimerSchedule::siftDown(size_t i) {
+    const Entry entry = heap_[i];
+    const size_t count = heap_.size();
+    for (;;) {
+        size_t child = i * 2 + 1;
+        if (child >= count) break;
+        if (child + 1 < count && heap_[child + 1].due < heap_[child].due) ++child;
+        if (!(heap_[child].due < entry.due)) break;
+        place(i, heap_[child]);
+        i = child;
+    }
+    place(i, entry);
+}
+
+void TimerSchedule::removeAt(size_t i) {
+    position_[heap_[i].key] = kNotQueued;
+    const Entry last = heap_.back();
+    heap_.pop_back();
+    if (i == heap_.size()) return;
+
+    place(i, last);
+    siftUp(i);
+    siftDown(position_[last.key]);
+}
+
+} // namespace timer
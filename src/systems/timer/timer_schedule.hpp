@@ -0,0 +1,54 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace timer {
+
+//------------------------------------------------------------
+// Keys ordered by the time they are due: a binary min-heap that also knows
+// where each key sits, so a timer can be moved or removed in O(log n)
+// (reset, pause, cancel) instead of being left behind as a stale entry.
+//
+// TimerSystem keeps every timer that waits for a delay here and only pops
+// what is due each update, so timers that fire far in the future cost
+// nothing per frame. Keys are small dense integers (index into the
+// TimerSystem's timer table).
+//------------------------------------------------------------
+class TimerSchedule {
+public:
+    using Key = uint32_t;
+
+    // Inserts key, or moves it if it is already scheduled.
+    void schedule(Key key, double due);
+    void unschedule(Key key);
+
+    bool scheduled(Key key) const;
+    double due(Key key) const; // only valid if scheduled(key)
+
+    // Removes every key due at or before `now` and appends them to `out`,
+    // earliest first (ties in no particular order).
+    void popDue(double now, std::vector<Key> &out);
+
+    size_t size() const { return heap_.size(); }
+    bool empty() const { return heap_.empty(); }
+    void clear();
+
+private:
+    static constexpr uint32_t kNotQueued = 0xFFFFFFFFu;
+
+    struct Entry {
+        double due;
+        Key key;
+    };
+
+    void siftUp(size_t i);
+    void siftDown(size_t i);
+    void place(size_t i, const Entry &entry);
+    void removeAt(size_t i);
+
+    std::vector<Entry> heap_;
+    std::vector<uint32_t> position_; // heap index per key, kNotQueued if absent
+};
+
+} // namespace timer
@@ -0,0 +1,95 @@
+#include "tween_channel.hpp"
+
+#include <cmath>
+
+namespace timer {
+
+namespace {
+
+constexpr float kPi = 3.14159265358979323846f;
+constexpr float kBackC1 = 1.70158f;
+constexpr float kBackC3 = kBackC1 + 1.f;
+constexpr float kElasticC4 = 2.f * kPi / 3.f;
+
+// One loop per easing so each is branch-free over its run (the ternaries
+// compile to blends).
+void easeRun(TweenEase ease, float *t, size_t count)
+{
+    switch (ease) {
+    case TweenEase::Linear:
+    case TweenEase::Count:
+        return;
+    case TweenEase::QuadIn:
+        for (size_t i = 0; i < count; ++i) t[i] = t[i] * t[i];
+        return;
+    case TweenEase::QuadOut:
+        for (size_t i = 0; i < count; ++i) t[i] = t[i] * (2.f - t[i]);
+        return;
+    case TweenEase::QuadInOut:
+        for (size_t i = 0; i < count; ++i) {
+            const float x = t[i];
+            t[i] = x < 0.5f ? 2.f * x * x : x * (4.f - 2.f * x) - 1.f;
+        }
+        return;
+    case TweenEase::CubicIn:
+        for (size_t i = 0; i < count; ++i) t[i] = t[i] * t[i] * t[i];
+        return;
+    case TweenEase::CubicOut:
+        for (size_t i = 0; i < count; ++i) {
+            const float u = t[i] - 1.f;
+            t[i] = u * u * u + 1.f;
+        }
+        return;
+    case TweenEase::CubicInOut:
+        for (size_t i = 0; i < count; ++i) {
+            const float x = t[i];
+            const float u = 2.f * x - 2.f;
+            t[i] = x < 0.5f ? 4.f * x * x * x : 0.5f * u * u * u + 1.f;
+        }
+        return;
+    case TweenEase::SineIn:
+        for (size_t i = 0; i < count; ++i) t[i] = 1.f - std::cos(t[i] * kPi * 0.5f);
+        return;
+    case TweenEase::SineOut:
+        for (size_t i = 0; i < count; ++i) t[i] = std::sin(t[i] * kPi * 0.5f);
+        return;
+    case TweenEase::SineInOut:
+        for (size_t i = 0; i < count; ++i) t[i] = 0.5f - 0.5f * std::cos(t[i] * kPi);
+        return;
+    case TweenEase::BackOut:
+        for (size_t i = 0; i < count; ++i) {
+            const float u = t[i] - 1.f;
+            t[i] = 1.f + kBackC3 * u * u * u + kBackC1 * u * u;
+        }
+        return;
+    case TweenEase::ElasticOut:
+        for (size_t i = 0; i < count; ++i) {
+            const float x = t[i];
+            t[i] = x <= 0.f ? 0.f
+                 : x >= 1.f ? 1.f
+                            : std::exp2(-10.f * x) * std::sin((x * 10.f - 0.75f) * kElasticC4) + 1.f;
+        }
+        return;
+    }
+}
+
+} // namespace
+
+float EvaluateTweenEase(TweenEase ease, float t)
+{
+    easeRun(ease, &t, 1);
+    return t;
+}
+
+void EaseTweenProgress(const TweenEase *ease, float *t, size_t count)
+{
+    size_t i = 0;
+    while (i < count) {
+        size_t end = i + 1;
+        while (end < count && ease[end] == ease[i]) ++end;
+        easeRun(ease[i], t + i, end - i);
+        i = end;
+    }
+}
+
+} // namespace timer
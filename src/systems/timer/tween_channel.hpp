@@ -0,0 +1,252 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace timer {
+
+//------------------------------------------------------------
+// Typed tweens.
+//
+// A TweenChannel holds the tweens of one target type as SoA columns (start,
+// delta, elapsed time, easing), so an update is a few flat passes over
+// arrays -- progress, easing, interpolation -- followed by one write per
+// tween through its Target. Easing is an enum; runs of tweens with the same
+// easing are evaluated by one branch-free loop.
+//
+// A Target is a small value type with
+//
+//     bool write(const float *value); // Width floats; false once the target is gone
+//
+// A tween whose target is gone is dropped without calling its after().
+// TweenSystem (tween_system.hpp) owns the channels the engine uses;
+// TimerSystem::timer_tween runs its tweens on the function channel.
+//------------------------------------------------------------
+
+enum class TweenEase : uint8_t {
+    Linear,
+    QuadIn,
+    QuadOut,
+    QuadInOut,
+    CubicIn,
+    CubicOut,
+    CubicInOut,
+    SineIn,
+    SineOut,
+    SineInOut,
+    BackOut,
+    ElasticOut,
+    Count
+};
+
+// Eased progress for t in [0, 1].
+float EvaluateTweenEase(TweenEase ease, float t);
+
+// t[i] = EvaluateTweenEase(ease[i], t[i]) for `count` lanes.
+void EaseTweenProgress(const TweenEase *ease, float *t, size_t count);
+
+struct TweenHandle {
+    static constexpr uint32_t kInvalidIndex = UINT32_MAX;
+
+    uint32_t index = kInvalidIndex;
+    uint32_t generation = 0;
+
+    bool valid() const { return index != kInvalidIndex; }
+    bool operator==(const TweenHandle &) const = default;
+};
+
+template <typename Target, size_t Width>
+class TweenChannel {
+public:
+    using Value = std::array<float, Width>;
+
+    // Starts a tween from `from` to `to`. The first write happens on the next update.
+    TweenHandle add(Target target, const Value &from, const Value &to, float duration,
+                    TweenEase ease = TweenEase::Linear, std::function<void()> after = {})
+    {
+        uint32_t slot;
+        if (!freeSlots_.empty()) {
+            slot = freeSlots_.back();
+            freeSlots_.pop_back();
+        } else {
+            slot = static_cast<uint32_t>(denseOf_.size());
+            denseOf_.push_back(TweenHandle::kInvalidIndex);
+            generations_.push_back(0);
+        }
+
+        denseOf_[slot] = static_cast<uint32_t>(slotOf_.size());
+        slotOf_.push_back(slot);
+        for (size_t c = 0; c < Width; ++c) {
+            start_[c].push_back(from[c]);
+            delta_[c].push_back(to[c] - from[c]);
+        }
+        elapsed_.push_back(0.f);
+        invDuration_.push_back(1.f / std::max(duration, 1e-6f));
+        paused_.push_back(0);
+        ease_.push_back(ease);
+        target_.push_back(std::move(target));
+        after_.push_back(std::move(after));
+        return {slot, generations_[slot]};
+    }
+
+    // Stops a tween where it is, without calling its after().
+    void cancel(TweenHandle handle)
+    {
+        if (!active(handle)) return;
+        removeAt(denseOf_[handle.index]);
+    }
+
+    // A paused tween keeps its lane but neither advances nor writes its target.
+    void setPaused(TweenHandle handle, bool paused)
+    {
+        if (active(handle)) paused_[denseOf_[handle.index]] = paused ? 1 : 0;
+    }
+
+    // Back to the start value on the next update.
+    void rewind(TweenHandle handle)
+    {
+        if (active(handle)) elapsed_[denseOf_[handle.index]] = 0.f;
+    }
+
+    // Keeps the elapsed time, so a shorter duration can finish the tween next update.
+    void setDuration(TweenHandle handle, float duration)
+    {
+        if (active(handle)) invDuration_[denseOf_[handle.index]] = 1.f / std::max(duration, 1e-6f);
+    }
+
+    bool active(TweenHandle handle) const
+    {
+        return handle.index < denseOf_.size() && generations_[handle.index] == handle.generation &&
+               denseOf_[handle.index] != TweenHandle::kInvalidIndex;
+    }
+
+    // Advances every tween by dt and writes its targets. Finished tweens are
+    // removed before their after() callbacks run, so callbacks may add or
+    // cancel tweens; targets must not.
+    void update(float dt)
+    {
+        const size_t count = size();
+        if (count == 0) return;
+
+        progress_.resize(count);
+        done_.clear();
+        for (size_t i = 0; i < count; ++i) {
+            if (!paused_[i]) elapsed_[i] += dt;
+            progress_[i] = std::min(elapsed_[i] * invDuration_[i], 1.f);
+        }
+        EaseTweenProgress(ease_.data(), progress_.data(), count);
+
+        for (size_t c = 0; c < Width; ++c) {
+            value_[c].resize(count);
+            const float *start = start_[c].data();
+            const float *delta = delta_[c].data();
+            float *value = value_[c].data();
+            for (size_t i = 0; i < count; ++i) value[i] = start[i] + delta[i] * progress_[i];
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            if (paused_[i]) continue;
+            float lane[Width];
+            for (size_t c = 0; c < Width; ++c) lane[c] = value_[c][i];
+            const bool alive = target_[i].write(lane);
+            if (!alive || elapsed_[i] * invDuration_[i] >= 1.f) {
+                if (alive && after_[i]) finished_.push_back(std::move(after_[i]));
+                done_.push_back(static_cast<uint32_t>(i));
+            }
+        }
+
+        // highest first, so swapping in the last lane never moves one still to remove
+        for (auto it = done_.rbegin(); it != done_.rend(); ++it) removeAt(*it);
+
+        if (finished_.empty()) return;
+        std::vector<std::function<void()>> callbacks;
+        callbacks.swap(finished_);
+        for (auto &after : callbacks) after();
+        callbacks.clear();
+        if (finished_.empty()) finished_.swap(callbacks); // keep the capacity
+    }
+
+    void clear()
+    {
+        for (uint32_t slot : slotOf_) release(slot);
+        for (size_t c = 0; c < Width; ++c) {
+            start_[c].clear();
+            delta_[c].clear();
+        }
+        elapsed_.clear();
+        invDuration_.clear();
+        paused_.clear();
+        ease_.clear();
+        target_.clear();
+        after_.clear();
+        slotOf_.clear();
+    }
+
+    size_t size() const { return slotOf_.size(); }
+
+private:
+    void release(uint32_t slot)
+    {
+        denseOf_[slot] = TweenHandle::kInvalidIndex;
+        generations_[slot]++;
+        freeSlots_.push_back(slot);
+    }
+
+    // Swap-removes dense lane i.
+    void removeAt(size_t i)
+    {
+        release(slotOf_[i]);
+        const size_t last = size() - 1;
+        if (i != last) {
+            for (size_t c = 0; c < Width; ++c) {
+                start_[c][i] = start_[c][last];
+                delta_[c][i] = delta_[c][last];
+            }
+            elapsed_[i] = elapsed_[last];
+            invDuration_[i] = invDuration_[last];
+            paused_[i] = paused_[last];
+            ease_[i] = ease_[last];
+            target_[i] = std::move(target_[last]);
+            after_[i] = std::move(after_[last]);
+            slotOf_[i] = slotOf_[last];
+            denseOf_[slotOf_[i]] = static_cast<uint32_t>(i);
+        }
+        for (size_t c = 0; c < Width; ++c) {
+            start_[c].pop_back();
+            delta_[c].pop_back();
+        }
+        elapsed_.pop_back();
+        invDuration_.pop_back();
+        paused_.pop_back();
+        ease_.pop_back();
+        target_.pop_back();
+        after_.pop_back();
+        slotOf_.pop_back();
+    }
+
+    // dense lanes
+    std::array<std::vector<float>, Width> start_, delta_;
+    std::vector<float> elapsed_, invDuration_;
+    std::vector<uint8_t> paused_;
+    std::vector<TweenEase> ease_;
+    std::vector<Target> target_;
+    std::vector<std::function<void()>> after_;
+    std::vector<uint32_t> slotOf_;
+
+    // slots, for handles
+    std::vector<uint32_t> denseOf_; // kInvalidIndex if free
+    std::vector<uint32_t> generations_;
+    std::vector<uint32_t> freeSlots_;
+
+    // scratch, reused between updates
+    std::vector<float> progress_;
+    std::array<std::vector<float>, Width> value_;
+    std::vector<uint32_t> done_;
+    std::vector<std::function<void()>> finished_;
+};
+
+} // namespace timer
@@ -0,0 +1,381 @@
+#include "tween_system.hpp"
+
+#include "core/globals.hpp"
+#include "systems/scripting/binding_recorder.hpp"
+#include "systems/shaders/shader_system.hpp"
+#include "systems/transform/transform.hpp"
+#include "util/common_headers.hpp"
+#include "util/error_handling.hpp"
+
+#include <cmath>
+
+namespace timer
+{
+    namespace TweenSystem
+    {
+        namespace
+        {
+            SpringChannel springs;
+            ColorChannel colors;
+            UniformChannel uniforms;
+            LuaFieldsChannel luaFields;
+            FunctionChannel functions;
+
+            template <typename F>
+            decltype(auto) withChannel(TweenChannelKind kind, F &&f)
+            {
+                switch (kind)
+                {
+                case TweenChannelKind::Spring:    return f(springs);
+                case TweenChannelKind::Color:     return f(colors);
+                case TweenChannelKind::Uniform:   return f(uniforms);
+                case TweenChannelKind::LuaFields: return f(luaFields);
+                default:                          return f(functions);
+                }
+            }
+
+            unsigned char toColorByte(float value)
+            {
+                return static_cast<unsigned char>(std::clamp(std::lround(value), 0L, 255L));
+            }
+
+            shaders::ShaderUniformComponent *uniformsOf(entt::registry *registry, entt::entity entity)
+            {
+                if (entity == entt::null) return &globals::getGlobalShaderUniforms();
+                if (!registry || !registry->valid(entity)) return nullptr;
+                return registry->try_get<shaders::ShaderUniformComponent>(entity);
+            }
+
+            // A Lua callback held by the main state, so it outlives the coroutine that passed it.
+            std::function<void()> wrapLuaCallback(sol::optional<sol::function> fn)
+            {
+                if (!fn || !fn->valid()) return {};
+                sol::main_protected_function pf(*fn);
+                return [pf = std::move(pf)]() mutable {
+                    auto result = util::safeLuaCall(pf, "tween callback");
+                    if (result.isErr()) SPDLOG_ERROR("Tween callback failed: {}", result.error());
+                };
+            }
+
+            std::optional<transform::TransformSpring> transformSpringByName(const std::string &name)
+            {
+                if (name == "x") return transform::TransformSpring::X;
+                if (name == "y") return transform::TransformSpring::Y;
+                if (name == "w") return transform::TransformSpring::W;
+                if (name == "h") return transform::TransformSpring::H;
+                if (name == "r") return transform::TransformSpring::R;
+                if (name == "s") return transform::TransformSpring::S;
+                return std::nullopt;
+            }
+        }
+
+        bool SpringTweenTarget::write(const float *value) const
+        {
+            auto &pool = spring::GetSpringPool();
+            if (!pool.alive(spring)) return false;
+            spring::SpringRef ref = pool.get(spring);
+            (moveValue ? ref.value : ref.targetValue) = value[0];
+            return true;
+        }
+
+        bool ColorTweenTarget::write(const float *value) const
+        {
+            apply(Color{toColorByte(value[0]), toColorByte(value[1]), toColorByte(value[2]), toColorByte(value[3])});
+            return true;
+        }
+
+        bool UniformTweenTarget::write(const float *value) const
+        {
+            shaders::ShaderUniformComponent *component = uniformsOf(registry, entity);
+            if (!component) return false;
+
+            switch (components)
+            {
+            case 1:
+                component->set(shader, uniform, value[0]);
+                break;
+            case 2:
+                component->set(shader, uniform, Vector2{value[0], value[1]});
+                break;
+            case 3:
+                component->set(shader, uniform, Vector3{value[0], value[1], value[2]});
+                break;
+            default:
+                component->set(shader, uniform, Vector4{value[0], value[1], value[2], value[3]});
+                break;
+            }
+            return true;
+        }
+
+        bool LuaFieldsTweenTarget::write(const float *value)
+        {
+            if (!table.valid()) return false;
+            for (const Field &field : fields) table.raw_set(field.key, field.start + field.delta * value[0]);
+            return true;
+        }
+
+        bool FunctionTweenTarget::write(const float *value) const
+        {
+            set(ease ? from + (to - from) * ease(value[0]) : value[0]);
+            return true;
+        }
+
+        TweenId tween_spring(spring::SpringHandle spring, float target_value, float duration, TweenEase ease, std::function<void()> after, bool move_value)
+        {
+            auto &pool = spring::GetSpringPool();
+            if (!pool.alive(spring)) return {};
+
+            const spring::SpringRef ref = pool.get(spring);
+            const float from = move_value ? ref.value : ref.targetValue;
+            return {TweenChannelKind::Spring, springs.add({spring, move_value}, {from}, {target_value}, duration, ease, std::move(after))};
+        }
+
+        TweenId tween_transform(entt::registry &registry, entt::entity entity, transform::TransformSpring which, float target_value, float duration, TweenEase ease, std::function<void()> after)
+        {
+            auto *transform = registry.valid(entity) ? registry.try_get<transform::Transform>(entity) : nullptr;
+            if (!transform) return {};
+            return tween_spring(transform->springs[static_cast<size_t>(which)].handle(), target_value, duration, ease, std::move(after));
+        }
+
+        TweenId tween_color(Color from, Color to, float duration, std::function<void(Color)> apply, TweenEase ease, std::function<void()> after)
+        {
+            return {TweenChannelKind::Color,
+                    colors.add({std::move(apply)},
+                               {static_cast<float>(from.r), static_cast<float>(from.g), static_cast<float>(from.b), static_cast<float>(from.a)},
+                               {static_cast<float>(to.r), static_cast<float>(to.g), static_cast<float>(to.b), static_cast<float>(to.a)},
+                               duration, ease, std::move(after))};
+        }
+
+        TweenId tween_uniform(entt::registry &registry, entt::entity entity, const std::string &shader, const std::string &uniform, const std::variant<float, Vector2, Vector3, Vector4> &target_value, float duration, TweenEase ease, std::function<void()> after)
+        {
+            if (entity != entt::null)
+            {
+                if (!registry.valid(entity)) return {};
+                registry.get_or_emplace<shaders::ShaderUniformComponent>(entity);
+            }
+
+            UniformChannel::Value to{};
+            uint8_t components = 1;
+            std::visit([&](const auto &v) {
+                using T = std::decay_t<decltype(v)>;
+                if constexpr (std::is_same_v<T, float>) { to = {v, 0.f, 0.f, 0.f}; components = 1; }
+                else if constexpr (std::is_same_v<T, Vector2>) { to = {v.x, v.y, 0.f, 0.f}; components = 2; }
+                else if constexpr (std::is_same_v<T, Vector3>) { to = {v.x, v.y, v.z, 0.f}; components = 3; }
+                else { to = {v.x, v.y, v.z, v.w}; components = 4; }
+            }, target_value);
+
+            // start from the current value if it has the same shape
+            UniformChannel::Value from{};
+            const shaders::ShaderUniformSet *set = uniformsOf(&registry, entity)->getSet(shader);
+            if (const ShaderUniformValue *current = set ? set->get(uniform) : nullptr)
+            {
+                if (components == 1 && std::holds_alternative<float>(*current)) from[0] = std::get<float>(*current);
+                else if (components == 2 && std::holds_alternative<Vector2>(*current)) { const auto v = std::get<Vector2>(*current); from = {v.x, v.y, 0.f, 0.f}; }
+                else if (components == 3 && std::holds_alternative<Vector3>(*current)) { const auto v = std::get<Vector3>(*current); from = {v.x, v.y, v.z, 0.f}; }
+                else if (components == 4 && std::holds_alternative<Vector4>(*current)) { const auto v = std::get<Vector4>(*current); from = {v.x, v.y, v.z, v.w}; }
+            }
+
+            return {TweenChannelKind::Uniform,
+                    uniforms.add({&registry, entity, shader, uniform, components}, from, to, duration, ease, std::move(after))};
+        }
+
+        TweenId tween_lua_fields(sol::table target, sol::table source, float duration, TweenEase ease, std::function<void()> after)
+        {
+            LuaFieldsTweenTarget tweenTarget;
+            tweenTarget.table = sol::main_table(target);
+            for (auto &[key, goal] : source)
+            {
+                if (goal.get_type() != sol::type::number) continue;
+                sol::object current = target.raw_get<sol::object>(key);
+                if (current.get_type() != sol::type::number)
+                {
+                    SPDLOG_ERROR("tween.fields: target field is not a number");
+                    continue;
+                }
+                const double start = current.as<double>();
+                tweenTarget.fields.push_back({sol::main_object(key), start, goal.as<double>() - start});
+            }
+
+            if (tweenTarget.fields.empty())
+            {
+                if (after) after();
+                return {};
+            }
+            return {TweenChannelKind::LuaFields, luaFields.add(std::move(tweenTarget), {0.f}, {1.f}, duration, ease, std::move(after))};
+        }
+
+        TweenId tween_custom(float from, float to, float duration, std::function<void(float)> set, std::function<float(float)> easing_method, std::function<void()> after)
+        {
+            // with a custom curve the channel runs 0 -> 1 and the target maps it
+            const bool custom = static_cast<bool>(easing_method);
+            return {TweenChannelKind::Function,
+                    functions.add({std::move(set), std::move(easing_method), from, to},
+                                  {custom ? 0.f : from}, {custom ? 1.f : to}, duration, TweenEase::Linear, std::move(after))};
+        }
+
+        void cancel_tween(TweenId id)
+        {
+            withChannel(id.channel, [&](auto &channel) { channel.cancel(id.handle); });
+        }
+
+        void pause_tween(TweenId id, bool paused)
+        {
+            withChannel(id.channel, [&](auto &channel) { channel.setPaused(id.handle, paused); });
+        }
+
+        void rewind_tween(TweenId id)
+        {
+            withChannel(id.channel, [&](auto &channel) { channel.rewind(id.handle); });
+        }
+
+        void set_tween_duration(TweenId id, float duration)
+        {
+            withChannel(id.channel, [&](auto &channel) { channel.setDuration(id.handle, duration); });
+        }
+
+        bool tween_active(TweenId id)
+        {
+            return withChannel(id.channel, [&](auto &channel) { return channel.active(id.handle); });
+        }
+
+        size_t tween_count()
+        {
+            return springs.size() + colors.size() + uniforms.size() + luaFields.size() + functions.size();
+        }
+
+        void update_tweens(float dt)
+        {
+            ZONE_SCOPED("Update Tweens");
+            springs.update(dt);
+            colors.update(dt);
+            uniforms.update(dt);
+            luaFields.update(dt);
+            functions.update(dt);
+        }
+
+        void clear_all_tweens()
+        {
+            springs.clear();
+            colors.clear();
+            uniforms.clear();
+            luaFields.clear();
+            functions.clear();
+        }
+
+        void exposeToLua(sol::state &lua)
+        {
+            auto &rec = BindingRecorder::instance();
+
+            sol::state_view luaView{lua};
+            auto t = luaView["tween"].get_or_create<sol::table>();
+            rec.add_type("tween").doc = "Typed tweens for transforms, shader uniforms and Lua table fields, updated in batches.";
+
+            t.new_enum<TweenEase>("Ease", {
+                {"Linear",     TweenEase::Linear},
+                {"QuadIn",     TweenEase::QuadIn},
+                {"QuadOut",    TweenEase::QuadOut},
+                {"QuadInOut",  TweenEase::QuadInOut},
+                {"CubicIn",    TweenEase::CubicIn},
+                {"CubicOut",   TweenEase::CubicOut},
+                {"CubicInOut", TweenEase::CubicInOut},
+                {"SineIn",     TweenEase::SineIn},
+                {"SineOut",    TweenEase::SineOut},
+                {"SineInOut",  TweenEase::SineInOut},
+                {"BackOut",    TweenEase::BackOut},
+                {"ElasticOut", TweenEase::ElasticOut}
+            });
+            rec.add_type("tween.Ease").doc = "Easing curves evaluated natively by the tween channels.";
+            for (const char *name : {"Linear", "QuadIn", "QuadOut", "QuadInOut", "CubicIn", "CubicOut", "CubicInOut",
+                                     "SineIn", "SineOut", "SineInOut", "BackOut", "ElasticOut"})
+            {
+                rec.record_property("tween.Ease", {name, std::to_string(static_cast<int>(t["Ease"][name].get<TweenEase>())), ""});
+            }
+
+            t.set_function("fields",
+                [](float duration, sol::table target, sol::table source, sol::optional<TweenEase> ease, sol::optional<sol::function> after) {
+                    return tween_lua_fields(target, source, duration, ease.value_or(TweenEase::Linear), wrapLuaCallback(after));
+                });
+            rec.record_free_function({"tween"}, {
+                "fields",
+                "---@param duration number\n"
+                "---@param target table # Table whose numeric fields are tweened.\n"
+                "---@param source table<string, number> # Field -> final value.\n"
+                "---@param ease? integer # tween.Ease value, Linear by default.\n"
+                "---@param after? fun()\n"
+                "---@return userdata # tween id",
+                "Tweens numeric fields of a Lua table; start values are captured now.",
+                true, false
+            });
+
+            t.set_function("transform",
+                [](entt::entity entity, const std::string &which, float target_value, float duration, sol::optional<TweenEase> ease, sol::optional<sol::function> after) {
+                    const auto spring = transformSpringByName(which);
+                    if (!spring)
+                    {
+                        SPDLOG_ERROR("tween.transform: unknown spring '{}' (expected x, y, w, h, r or s)", which);
+                        return TweenId{};
+                    }
+                    return tween_transform(globals::getRegistry(), entity, *spring, target_value, duration, ease.value_or(TweenEase::Linear), wrapLuaCallback(after));
+                });
+            rec.record_free_function({"tween"}, {
+                "transform",
+                "---@param entity Entity\n"
+                "---@param which string # \"x\", \"y\", \"w\", \"h\", \"r\" or \"s\".\n"
+                "---@param target_value number\n"
+                "---@param duration number\n"
+                "---@param ease? integer # tween.Ease value, Linear by default.\n"
+                "---@param after? fun()\n"
+                "---@return userdata # tween id",
+                "Tweens the target of one of the entity's Transform springs; the spring follows it.",
+                true, false
+            });
+
+            t.set_function("uniform",
+                [](sol::object entity, const std::string &shader, const std::string &uniform, sol::object target_value, float duration, sol::optional<TweenEase> ease, sol::optional<sol::function> after) {
+                    std::variant<float, Vector2, Vector3, Vector4> to;
+                    if (target_value.get_type() == sol::type::number) to = target_value.as<float>();
+                    else if (target_value.is<Vector2>()) to = target_value.as<Vector2>();
+                    else if (target_value.is<Vector3>()) to = target_value.as<Vector3>();
+                    else if (target_value.is<Vector4>()) to = target_value.as<Vector4>();
+                    else
+                    {
+                        SPDLOG_ERROR("tween.uniform: '{}' needs a number or a Vector2/3/4", uniform);
+                        return TweenId{};
+                    }
+                    const entt::entity e = entity.is<entt::entity>() ? entity.as<entt::entity>() : static_cast<entt::entity>(entt::null);
+                    return tween_uniform(globals::getRegistry(), e, shader, uniform, to, duration, ease.value_or(TweenEase::Linear), wrapLuaCallback(after));
+                });
+            rec.record_free_function({"tween"}, {
+                "uniform",
+                "---@param entity Entity|nil # nil for the global uniforms.\n"
+                "---@param shader string\n"
+                "---@param uniform string\n"
+                "---@param target_value number|Vector2|Vector3|Vector4\n"
+                "---@param duration number\n"
+                "---@param ease? integer # tween.Ease value, Linear by default.\n"
+                "---@param after? fun()\n"
+                "---@return userdata # tween id",
+                "Tweens a shader uniform from its current value.",
+                true, false
+            });
+
+            t.set_function("cancel", [](TweenId id) { cancel_tween(id); });
+            rec.record_free_function({"tween"}, {
+                "cancel",
+                "---@param id userdata # A tween id.\n"
+                "---@return nil",
+                "Stops a tween where it is, without calling its after callback.",
+                true, false
+            });
+
+            t.set_function("active", [](TweenId id) { return tween_active(id); });
+            rec.record_free_function({"tween"}, {
+                "active",
+                "---@param id userdata # A tween id.\n"
+                "---@return boolean",
+                "Whether the tween is still running.",
+                true, false
+            });
+        }
+    }
+}
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "entt/entt.hpp"
+#include "raylib.h"
+#include "sol/sol.hpp"
+
+#include "tween_channel.hpp"
+#include "systems/spring/spring_pool.hpp"
+
+namespace transform
+{
+    enum class TransformSpring : uint8_t;
+}
+
+namespace timer
+{
+    namespace TweenSystem
+    {
+        // ------------------------------------------------
+        // Targets, one per channel
+        // ------------------------------------------------
+
+        // A pooled spring, e.g. one of a Transform's. Moves the target the spring
+        // chases, or its value directly.
+        struct SpringTweenTarget
+        {
+            spring::SpringHandle spring;
+            bool moveValue = false;
+
+            bool write(const float *value) const;
+        };
+
+        // RGBA, interpolated as floats and rounded on write. Colours live in many
+        // different components, so the result goes to one setter.
+        struct ColorTweenTarget
+        {
+            std::function<void(Color)> apply;
+
+            bool write(const float *value) const;
+        };
+
+        // A float/vec2/vec3/vec4 uniform of an entity's ShaderUniformComponent, or of
+        // the global uniforms when entity is entt::null.
+        struct UniformTweenTarget
+        {
+            entt::registry *registry = nullptr;
+            entt::entity entity = entt::null;
+            std::string shader;
+            std::string uniform;
+            uint8_t components = 1;
+
+            bool write(const float *value) const;
+        };
+
+        // Numeric fields of a Lua table, all driven by one progress value (0 to 1).
+        struct LuaFieldsTweenTarget
+        {
+            struct Field
+            {
+                sol::main_object key;
+                double start = 0.0;
+                double delta = 0.0;
+            };
+
+            sol::main_table table;
+            std::vector<Field> fields;
+
+            bool write(const float *value);
+        };
+
+        // Fallback for anything else. Gets the progress (0 to 1) when `ease` is set,
+        // so a custom curve can be used; otherwise the interpolated value.
+        struct FunctionTweenTarget
+        {
+            std::function<void(float)> set;
+            std::function<float(float)> ease;
+            float from = 0.f;
+            float to = 0.f;
+
+            bool write(const float *value) const;
+        };
+
+        using SpringChannel    = TweenChannel<SpringTweenTarget, 1>;
+        using ColorChannel     = TweenChannel<ColorTweenTarget, 4>;
+        using UniformChannel   = TweenChannel<UniformTweenTarget, 4>;
+        using LuaFieldsChannel = TweenChannel<LuaFieldsTweenTarget, 1>;
+        using FunctionChannel  = TweenChannel<FunctionTweenTarget, 1>;
+
+        enum class TweenChannelKind : uint8_t
+        {
+            Spring,
+            Color,
+            Uniform,
+            LuaFields,
+            Function
+        };
+
+        // Identifies a tween across channels.
+        struct TweenId
+        {
+            TweenChannelKind channel = TweenChannelKind::Function;
+            TweenHandle handle;
+
+            bool valid() const { return handle.valid(); }
+            bool operator==(const TweenId &) const = default;
+        };
+
+        // ------------------------------------------------
+        // Tween creation functions
+        // ------------------------------------------------
+
+        extern TweenId tween_spring(spring::SpringHandle spring, float target_value, float duration, TweenEase ease = TweenEase::Linear, std::function<void()> after = {}, bool move_value = false);
+        // One of the entity's Transform springs (x, y, w, h, r, s); invalid if it has no Transform.
+        extern TweenId tween_transform(entt::registry &registry, entt::entity entity, transform::TransformSpring which, float target_value, float duration, TweenEase ease = TweenEase::Linear, std::function<void()> after = {});
+        extern TweenId tween_color(Color from, Color to, float duration, std::function<void(Color)> apply, TweenEase ease = TweenEase::Linear, std::function<void()> after = {});
+        // Starts from the uniform's current value (zero if it is unset or of another type).
+        extern TweenId tween_uniform(entt::registry &registry, entt::entity entity, const std::string &shader, const std::string &uniform, const std::variant<float, Vector2, Vector3, Vector4> &target_value, float duration, TweenEase ease = TweenEase::Linear, std::function<void()> after = {});
+        // Tweens every numeric field of `target` named in `source` towards its value there.
+        extern TweenId tween_lua_fields(sol::table target, sol::table source, float duration, TweenEase ease = TweenEase::Linear, std::function<void()> after = {});
+        extern TweenId tween_custom(float from, float to, float duration, std::function<void(float)> set, std::function<float(float)> easing_method = {}, std::function<void()> after = {});
+
+        // ------------------------------------------------
+        // Control
+        // ------------------------------------------------
+
+        extern void cancel_tween(TweenId id); // no after()
+        extern void pause_tween(TweenId id, bool paused);
+        extern void rewind_tween(TweenId id);
+        extern void set_tween_duration(TweenId id, float duration); // keeps the elapsed time
+        extern bool tween_active(TweenId id);
+        extern size_t tween_count();
+
+        // Advances every channel; call once per frame, before springs are integrated.
+        extern void update_tweens(float dt);
+        extern void clear_all_tweens();
+
+        extern void exposeToLua(sol::state &lua);
+    }
+}
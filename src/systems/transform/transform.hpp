@@ -1,6 +1,10 @@
 #pragma once
 
 #include "../spring/spring.hpp"
+#include "../spring/spring_pool.hpp"
+#include "transform_affine.hpp"
+#include "transform_hierarchy.hpp"
+#include "transform_method_hooks.hpp"
 
 #include "core/globals.hpp"
 
@@ -12,6 +16,7 @@
 #include "systems/main_loop_enhancement/main_loop.hpp"
 #include "systems/physics/physics_manager.hpp"
 
+#include <array>
 #include <vector>
 #include <optional>
 
@@ -79,7 +84,6 @@ namespace transform
         HandleDefaultTransformDrag,
         CreateOrEmplace,
         CreateGameWorldContainerEntity,
-        UpdateTransformSmoothingFactors,
         AlignToMaster,
         MoveWithMaster,
         UpdateLocation,
@@ -115,6 +119,24 @@ namespace transform
         RemoveEntity
     };
 
+    constexpr size_t kTransformMethodCount = static_cast<size_t>(TransformMethod::RemoveEntity) + 1;
+    static_assert(kTransformMethodCount <= 64, "GameObject::transformHookMask has one bit per method");
+
+    // Expands a 2D affine matrix to the 4x4 raylib/rlgl work with.
+    inline Matrix ToMatrix(const Affine2D &m)
+    {
+        Matrix out{};
+        out.m0 = m.a;
+        out.m1 = m.b;
+        out.m4 = m.c;
+        out.m5 = m.d;
+        out.m10 = 1.0f;
+        out.m12 = m.tx;
+        out.m13 = m.ty;
+        out.m15 = 1.0f;
+        return out;
+    }
+
     extern bool debugMode; // set to true to allow debug drawing of transforms
 
     const float COLLISION_BUFFER_ON_HOVER_PERCENTAGE = 0.03f; // buffer for collision detection when hovering over an entity, in pixels (applies to each side separately), this is a percentage of the entity's size
@@ -192,9 +214,9 @@ namespace transform
 
             // default handlers for release, click, update, animate, hover, stop_hover, drag, stop_drag, can_drag
         };
-        // configure defaults
-        std::unordered_map<TransformMethod, std::any> transformFunctions;
-        std::unordered_map<TransformMethod, std::any> hooksToCallBefore, hooksToCallAfter; // methods which should be called before or after the default methods, respectively
+        // one bit per TransformMethod this entity hooks (before/replace/after); the hooks live in
+        // the flat tables of transform_method_hooks.hpp, see SetTransformHook
+        uint64_t transformHookMask = 0;
 
         // these methods are actually replaceable to mimic inheritance.
         // They can be called with the util::call_method function.
@@ -411,16 +433,28 @@ namespace transform
     };
     
 
-    // Auto-adds springs as entities to registry, which will be updated by the spring system automatically
+    // Slots of the springs owned by Transform::springs
+    enum class TransformSpring : uint8_t
+    {
+        X,
+        Y,
+        W,
+        H,
+        R,
+        S,
+        Count
+    };
+
+    // Springs live in spring::GetSpringPool() (no separate entities) and are integrated by spring::updateAllSprings
     /**
      * Basic transform component for entities. Contains x, y, w, h, r, and s springs for position, size, rotation, and scale.
      */
     struct Transform
     {
-        entt::entity self; // the entity this transform is attached to, for convenience
+        entt::entity self{entt::null}; // the entity this transform is attached to, for convenience
         
-        // cached matrix for rendering optimizations
-        Matrix cachedMatrix;
+        // cached 2D world matrix for rendering optimizations (ToMatrix() where rlgl needs 4x4)
+        Affine2D cachedMatrix;
         bool matrixDirty = true;
         void markDirty() { matrixDirty = true; }
 
@@ -453,12 +487,20 @@ namespace transform
         std::optional<entt::entity> middleEntityForAlignment; // used for alignment to this entity's middle. Used by ui.
 
         // The x, y values of a transform are in world space unless they are children of another entity, in which case they are in local space, relative to their parent (or parents, if they are children of children)
-        entt::entity x;
-        entt::entity y;
-        entt::entity w;
-        entt::entity h;
-        entt::entity r;
-        entt::entity s;
+        // Indexed by TransformSpring. The state lives in the spring pool; copying a transform clones it.
+        std::array<PooledSpring, static_cast<size_t>(TransformSpring::Count)> springs{
+            PooledSpring{DEFAULT_SPRING_ZERO.value, DEFAULT_SPRING_ZERO.stiffness, DEFAULT_SPRING_ZERO.damping}, // x
+            PooledSpring{DEFAULT_SPRING_ZERO.value, DEFAULT_SPRING_ZERO.stiffness, DEFAULT_SPRING_ZERO.damping}, // y
+            PooledSpring{DEFAULT_SPRING_ONE.value, DEFAULT_SPRING_ONE.stiffness, DEFAULT_SPRING_ONE.damping},    // w
+            PooledSpring{DEFAULT_SPRING_ONE.value, DEFAULT_SPRING_ONE.stiffness, DEFAULT_SPRING_ONE.damping},    // h
+            PooledSpring{DEFAULT_SPRING_ZERO.value, DEFAULT_SPRING_ZERO.stiffness, DEFAULT_SPRING_ZERO.damping}, // r
+            PooledSpring{DEFAULT_SPRING_ONE.value, DEFAULT_SPRING_ONE.stiffness, DEFAULT_SPRING_ONE.damping}     // s
+        };
+
+        auto getSpring(TransformSpring which) -> SpringRef
+        {
+            return springs[static_cast<size_t>(which)].ref();
+        }
 
         // ====== CACHED VALUES, updated once per frame ======
         // PERF: Removed duplicate individual cachedActualX/cachedVisualX floats
@@ -478,7 +520,7 @@ namespace transform
         //==========================================================================
         // This is the function you call at the start of every getter. It checks
         // if we've already filled 'cache' for the current frame. If not, it
-        // reads all Springs (and other data) exactly once and populates the cache.
+        // reads all six springs (and other data) once and populates the cache.
         //==========================================================================
         void updateCachedValues(bool forceUpdate = false)
         {
@@ -489,13 +531,12 @@ namespace transform
             if (lastCacheFrame == currentFrame && !forceUpdate)
                 return;
 
-            // --- Read every Spring exactly once and store into local temporaries ---
-            Spring& springX = registry->get<Spring>(x);
-            Spring& springY = registry->get<Spring>(y);
-            Spring& springW = registry->get<Spring>(w);
-            Spring& springH = registry->get<Spring>(h);
-            Spring& springR = registry->get<Spring>(r);
-            Spring& springS = registry->get<Spring>(s);
+            const SpringRef springX = getSpring(TransformSpring::X);
+            const SpringRef springY = getSpring(TransformSpring::Y);
+            const SpringRef springW = getSpring(TransformSpring::W);
+            const SpringRef springH = getSpring(TransformSpring::H);
+            const SpringRef springR = getSpring(TransformSpring::R);
+            const SpringRef springS = getSpring(TransformSpring::S);
 
             // Fill “actual” values straight from targetValue:
             cache.actualX = springX.targetValue;
@@ -609,22 +650,22 @@ namespace transform
             return cache.visualX;
         }
 
-        auto getXSpring() -> Spring &
+        auto getXSpring() -> SpringRef
         {
-            return registry->get<Spring>(x);
+            return getSpring(TransformSpring::X);
         }
 
         auto setActualX(float newX) -> void
         {
             // 1) Update the Spring
-            registry->get<Spring>(this->x).targetValue = newX;
+            getSpring(TransformSpring::X).targetValue = newX;
 
             updateCachedValues(true);
         }
 
         auto setVisualX(float newX) -> void
         {
-            registry->get<Spring>(this->x).value = newX;
+            getSpring(TransformSpring::X).value = newX;
 
             updateCachedValues(true);
         }
@@ -643,21 +684,21 @@ namespace transform
             return cache.visualY;
         }
 
-        auto getYSpring() -> Spring &
+        auto getYSpring() -> SpringRef
         {
-            return registry->get<Spring>(y);
+            return getSpring(TransformSpring::Y);
         }
 
         auto setActualY(float newY) -> void
         {
-            registry->get<Spring>(this->y).targetValue = newY;
+            getSpring(TransformSpring::Y).targetValue = newY;
 
             updateCachedValues(true);
         }
 
         auto setVisualY(float newY) -> void
         {
-            registry->get<Spring>(this->y).value = newY;
+            getSpring(TransformSpring::Y).value = newY;
 
             updateCachedValues(true);
         }
@@ -676,21 +717,21 @@ namespace transform
             return cache.visualW;
         }
 
-        auto getWSpring() -> Spring &
+        auto getWSpring() -> SpringRef
         {
-            return registry->get<Spring>(w);
+            return getSpring(TransformSpring::W);
         }
 
         auto setActualW(float newW) -> void
         {
-            registry->get<Spring>(this->w).targetValue = newW;
+            getSpring(TransformSpring::W).targetValue = newW;
 
             updateCachedValues(true);
         }
 
         auto setVisualW(float newW) -> void
         {
-            registry->get<Spring>(this->w).value = newW;
+            getSpring(TransformSpring::W).value = newW;
 
             updateCachedValues(true);
         }
@@ -709,21 +750,21 @@ namespace transform
             return cache.visualH;
         }
 
-        auto getHSpring() -> Spring &
+        auto getHSpring() -> SpringRef
         {
-            return registry->get<Spring>(h);
+            return getSpring(TransformSpring::H);
         }
 
         auto setActualH(float newH) -> void
         {
-            registry->get<Spring>(this->h).targetValue = newH;
+            getSpring(TransformSpring::H).targetValue = newH;
 
             updateCachedValues(true);
         }
 
         auto setVisualH(float newH) -> void
         {
-            registry->get<Spring>(this->h).value = newH;
+            getSpring(TransformSpring::H).value = newH;
 
             updateCachedValues(true);
         }
@@ -749,21 +790,21 @@ namespace transform
             return cache.visualRWithDynamicMotionAndXLeaning;
         }
 
-        auto getRSpring() -> Spring &
+        auto getRSpring() -> SpringRef
         {
-            return registry->get<Spring>(r);
+            return getSpring(TransformSpring::R);
         }
 
         auto setActualRotation(float newR) -> void
         {
-            registry->get<Spring>(this->r).targetValue = newR;
+            getSpring(TransformSpring::R).targetValue = newR;
 
             updateCachedValues(true);
         }
 
         auto setVisualRotation(float newR) -> void
         {
-            registry->get<Spring>(this->r).value = newR;
+            getSpring(TransformSpring::R).value = newR;
 
             updateCachedValues(true);
         }
@@ -789,21 +830,21 @@ namespace transform
             return cache.visualSWithHoverAndDynamicMotionReflected;
         }
 
-        auto getSSpring() -> Spring &
+        auto getSSpring() -> SpringRef
         {
-            return registry->get<Spring>(s);
+            return getSpring(TransformSpring::S);
         }
 
         auto setActualScale(float newS) -> void
         {
-            registry->get<Spring>(this->s).targetValue = newS;
+            getSpring(TransformSpring::S).targetValue = newS;
 
             updateCachedValues(true);
         }
 
         auto setVisualScale(float newS) -> void
         {
-            registry->get<Spring>(this->s).value = newS;
+            getSpring(TransformSpring::S).value = newS;
 
             updateCachedValues(true);
         }
@@ -826,47 +867,11 @@ namespace transform
         Transform()
         {
             this->registry = &globals::getRegistry();
-
-            x = registry->create();
-            y = registry->create();
-            w = registry->create();
-            h = registry->create();
-            r = registry->create();
-            s = registry->create();
-
-            auto XSpring = registry->emplace<Spring>(x, DEFAULT_SPRING_ZERO);
-            auto YSpring = registry->emplace<Spring>(y, DEFAULT_SPRING_ZERO);
-            auto WSpring = registry->emplace<Spring>(w, DEFAULT_SPRING_ONE);
-            auto HSpring = registry->emplace<Spring>(h, DEFAULT_SPRING_ONE);
-            auto RSpring = registry->emplace<Spring>(r, DEFAULT_SPRING_ZERO);
-            auto SSpring = registry->emplace<Spring>(s, DEFAULT_SPRING_ONE);
-        }
-        
-
-        ~Transform()
-        {
-            // registry->destroy(x);
-            // registry->destroy(y);
-            // registry->destroy(w);
-            // registry->destroy(h);
-            // registry->destroy(r);
-            // registry->destroy(s);
         }
     };
 
     // Function that gets called when a transform component is destroyed
     inline void onTransformDestroyed(entt::registry &registry, entt::entity entity) {
-        if (registry.any_of<Transform>(entity)) {
-            auto &transform = registry.get<Transform>(entity);
-            registry.destroy(transform.x);
-            registry.destroy(transform.y);
-            registry.destroy(transform.w);
-            registry.destroy(transform.h);
-            registry.destroy(transform.r);
-            registry.destroy(transform.s);
-            // std::cout << "Particle " << particle.id << " destroyed!" << std::endl;
-        }
-        
         // 1) If there’s no collider, nothing else to do.
         if (!registry.any_of<physics::ColliderComponent>(entity)) return;
 
@@ -886,9 +891,44 @@ namespace transform
 
     }
 
+    // Keeps the depth index on the role's master as roles are emplaced or
+    // replaced. AssignRole updates it itself; code that writes `master` in
+    // place must go through AssignRole or patch() the component.
+    inline void onInheritedPropertiesChanged(entt::registry &registry, entt::entity entity) {
+        const auto id = entt::to_integral(entity);
+        const auto master = entt::to_integral(registry.get<InheritedProperties>(entity).master);
+        auto &index = GetTransformDepthIndex();
+        if (!index.contains(id) || index.master(id) != master) index.setMaster(id, master);
+    }
+
+    // Keeps the depth index free of destroyed masters; their slaves become roots.
+    inline void onInheritedPropertiesDestroyed(entt::registry &registry, entt::entity entity) {
+        GetTransformDepthIndex().erase(entt::to_integral(entity));
+    }
+
+    // Tags the transform's pooled springs with their entity, so spring changes
+    // can be traced back to the transform (dirty-only updates).
+    inline void onTransformConstructed(entt::registry &registry, entt::entity entity) {
+        auto &pool = spring::GetSpringPool();
+        for (const auto &s : registry.get<Transform>(entity).springs)
+            pool.setOwner(s.handle(), entt::to_integral(entity));
+    }
+
+    // Drops the entity's method hooks; entities without any skip the tables.
+    inline void onGameObjectDestroyed(entt::registry &registry, entt::entity entity) {
+        if (registry.get<GameObject>(entity).transformHookMask != 0)
+            EraseTransformHooks(&registry, entity);
+    }
+
     // Function to register the destruction callback
     inline void registerDestroyListeners(entt::registry &registry) {
+        registry.on_construct<Transform>().connect<&onTransformConstructed>();
+        registry.on_update<Transform>().connect<&onTransformConstructed>();
         registry.on_destroy<Transform>().connect<&onTransformDestroyed>();
+        registry.on_construct<InheritedProperties>().connect<&onInheritedPropertiesChanged>();
+        registry.on_update<InheritedProperties>().connect<&onInheritedPropertiesChanged>();
+        registry.on_destroy<InheritedProperties>().connect<&onInheritedPropertiesDestroyed>();
+        registry.on_destroy<GameObject>().connect<&onGameObjectDestroyed>();
     }
 
     // used to cache master lookups in a global map.
@@ -901,12 +941,12 @@ namespace transform
     };
     
     struct SpringCacheBundle {
-        Spring* x;
-        Spring* y;
-        Spring* r;
-        Spring* s;
-        Spring* w;
-        Spring* h;
+        SpringRef x;
+        SpringRef y;
+        SpringRef r;
+        SpringRef s;
+        SpringRef w;
+        SpringRef h;
     };
 
 }
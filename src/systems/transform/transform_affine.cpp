@@ -0,0 +1,208 @@
+#include "transform_affine.hpp"
+
+#include <cmath>
+
+// AVX2 is compiled in on x86-64 builds (per-function target attribute, so no
+// global -mavx2 is needed) and only used if the CPU reports it at runtime.
+#if !defined(__EMSCRIPTEN__) && (defined(__x86_64__) || defined(_M_X64))
+    #include <immintrin.h>
+    #define AFFINE_USE_AVX2 1
+    #if defined(_MSC_VER) && !defined(__clang__)
+        #include <intrin.h>
+        #define AFFINE_AVX2_TARGET
+    #else
+        #define AFFINE_AVX2_TARGET __attribute__((target("avx2,fma")))
+    #endif
+#else
+    #define AFFINE_USE_AVX2 0
+#endif
+
+namespace transform {
+
+namespace {
+
+constexpr float kDegToRad = 3.14159265358979323846f / 180.0f;
+
+#if AFFINE_USE_AVX2
+
+// sin and cos of eight angles (Cephes single precision: reduction to
+// [-pi/4, pi/4] in three steps, then a minimax polynomial each). Within a
+// couple of ulp of std::sin/std::cos for the angles transforms use.
+AFFINE_AVX2_TARGET
+void sincosAVX2(__m256 x, __m256 &sinOut, __m256 &cosOut) {
+    const __m256 signMask = _mm256_set1_ps(-0.0f);
+
+    __m256 sinSign = _mm256_and_ps(x, signMask);
+    x = _mm256_andnot_ps(signMask, x); // |x|
+
+    // octant j, rounded up to even so the remainder is centred on 0
+    __m256i j = _mm256_cvttps_epi32(_mm256_mul_ps(x, _mm256_set1_ps(1.27323954473516f))); // 4 / pi
+    j = _mm256_and_si256(_mm256_add_epi32(j, _mm256_set1_epi32(1)), _mm256_set1_epi32(~1));
+    const __m256 y = _mm256_cvtepi32_ps(j);
+
+    const __m256 swapSign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(j, _mm256_set1_epi32(4)), 29));
+    const __m256 useSinPoly = _mm256_castsi256_ps(
+        _mm256_cmpeq_epi32(_mm256_and_si256(j, _mm256_set1_epi32(2)), _mm256_setzero_si256()));
+    const __m256 cosSign = _mm256_castsi256_ps(
+        _mm256_slli_epi32(_mm256_andnot_si256(_mm256_sub_epi32(j, _mm256_set1_epi32(2)), _mm256_set1_epi32(4)), 29));
+    sinSign = _mm256_xor_ps(sinSign, swapSign);
+
+    // x - j * pi/4, pi/4 split in three so the product stays exact
+    x = _mm256_fmadd_ps(y, _mm256_set1_ps(-0.78515625f), x);
+    x = _mm256_fmadd_ps(y, _mm256_set1_ps(-2.4187564849853515625e-4f), x);
+    x = _mm256_fmadd_ps(y, _mm256_set1_ps(-3.77489497744594108e-8f), x);
+    const __m256 z = _mm256_mul_ps(x, x);
+
+    __m256 cosPoly = _mm256_set1_ps(2.443315711809948e-5f);
+    cosPoly = _mm256_fmadd_ps(cosPoly, z, _mm256_set1_ps(-1.388731625493765e-3f));
+    cosPoly = _mm256_fmadd_ps(cosPoly, z, _mm256_set1_ps(4.166664568298827e-2f));
+    cosPoly = _mm256_mul_ps(_mm256_mul_ps(cosPoly, z), z);
+    cosPoly = _mm256_fnmadd_ps(_mm256_set1_ps(0.5f), z, cosPoly);
+    cosPoly = _mm256_add_ps(cosPoly, _mm256_set1_ps(1.0f));
+
+    __m256 sinPoly = _mm256_set1_ps(-1.9515295891e-4f);
+    sinPoly = _mm256_fmadd_ps(sinPoly, z, _mm256_set1_ps(8.3321608736e-3f));
+    sinPoly = _mm256_fmadd_ps(sinPoly, z, _mm256_set1_ps(-1.6666654611e-1f));
+    sinPoly = _mm256_fmadd_ps(_mm256_mul_ps(sinPoly, z), x, x);
+
+    const __m256 s = _mm256_blendv_ps(cosPoly, sinPoly, useSinPoly);
+    const __m256 c = _mm256_blendv_ps(sinPoly, cosPoly, useSinPoly);
+    sinOut = _mm256_xor_ps(s, sinSign);
+    cosOut = _mm256_xor_ps(c, cosSign);
+}
+
+AFFINE_AVX2_TARGET
+size_t composeAVX2(const float *cx, const float *cy, const float *ox, const float *oy,
+                   const float *scale, const float *rotation,
+                   float *a, float *b, float *tx, float *ty, size_t count) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 sn, cs;
+        sincosAVX2(_mm256_mul_ps(_mm256_loadu_ps(rotation + i), _mm256_set1_ps(kDegToRad)), sn, cs);
+
+        const __m256 s = _mm256_loadu_ps(scale + i);
+        const __m256 sc = _mm256_mul_ps(s, cs);
+        const __m256 ss = _mm256_mul_ps(s, sn);
+        const __m256 x = _mm256_loadu_ps(ox + i);
+        const __m256 y = _mm256_loadu_ps(oy + i);
+
+        // tx = cx - ox*sc + oy*ss, ty = cy - ox*ss - oy*sc
+        const __m256 outX = _mm256_fmadd_ps(y, ss, _mm256_fnmadd_ps(x, sc, _mm256_loadu_ps(cx + i)));
+        const __m256 outY = _mm256_fnmadd_ps(y, sc, _mm256_fnmadd_ps(x, ss, _mm256_loadu_ps(cy + i)));
+
+        _mm256_storeu_ps(a + i, sc);
+        _mm256_storeu_ps(b + i, ss);
+        _mm256_storeu_ps(tx + i, outX);
+        _mm256_storeu_ps(ty + i, outY);
+    }
+    return i; // the tail is left to the scalar kernel
+}
+
+bool cpuHasAVX2() {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx     = (info[2] & (1 << 28)) != 0;
+    const bool fma     = (info[2] & (1 << 12)) != 0;
+    if (!(osxsave && avx && fma)) return false;
+    if ((_xgetbv(0) & 0x6) != 0x6) return false; // OS saves YMM state
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#endif
+}
+
+#endif // AFFINE_USE_AVX2
+
+} // namespace
+
+Affine2D ComposeAffine(float cx, float cy, float ox, float oy, float scale, float rotationDegrees) {
+    const float r = rotationDegrees * kDegToRad;
+    const float c = std::cos(r);
+    const float sn = std::sin(r);
+    const float s = scale;
+
+    // M = T(center) * R * S * T(-origin)
+    Affine2D m;
+    m.a = s * c;
+    m.b = s * sn;
+    m.c = -s * sn;
+    m.d = s * c;
+    m.tx = cx + (-ox * s * c + oy * s * sn);
+    m.ty = cy + (-ox * s * sn - oy * s * c);
+    return m;
+}
+
+bool AffineKernelAvailable(AffineKernel kernel) {
+    switch (kernel) {
+    case AffineKernel::Scalar:
+        return true;
+    case AffineKernel::AVX2:
+#if AFFINE_USE_AVX2
+    {
+        static const bool hasAVX2 = cpuHasAVX2();
+        return hasAVX2;
+    }
+#else
+        return false;
+#endif
+    }
+    return false;
+}
+
+AffineKernel ActiveAffineKernel() {
+    static const AffineKernel active = AffineKernelAvailable(AffineKernel::AVX2)
+                                           ? AffineKernel::AVX2
+                                           : AffineKernel::Scalar;
+    return active;
+}
+
+size_t AffineBatch::push(float cx, float cy, float ox, float oy, float scale, float rotationDegrees) {
+    cx_.push_back(cx);
+    cy_.push_back(cy);
+    ox_.push_back(ox);
+    oy_.push_back(oy);
+    scale_.push_back(scale);
+    rotation_.push_back(rotationDegrees);
+    return cx_.size() - 1;
+}
+
+void AffineBatch::compose() {
+    compose(ActiveAffineKernel());
+}
+
+void AffineBatch::compose(AffineKernel kernel) {
+    const size_t count = size();
+    a_.resize(count);
+    b_.resize(count);
+    tx_.resize(count);
+    ty_.resize(count);
+
+    size_t i = 0;
+#if AFFINE_USE_AVX2
+    if (kernel == AffineKernel::AVX2 && AffineKernelAvailable(AffineKernel::AVX2)) {
+        i = composeAVX2(cx_.data(), cy_.data(), ox_.data(), oy_.data(), scale_.data(), rotation_.data(),
+                        a_.data(), b_.data(), tx_.data(), ty_.data(), count);
+    }
+#else
+    (void)kernel;
+#endif
+    for (; i < count; ++i) {
+        const Affine2D m = ComposeAffine(cx_[i], cy_[i], ox_[i], oy_[i], scale_[i], rotation_[i]);
+        a_[i] = m.a;
+        b_[i] = m.b;
+        tx_[i] = m.tx;
+        ty_[i] = m.ty;
+    }
+}
+
+void AffineBatch::clear() {
+    cx_.clear(); cy_.clear(); ox_.clear(); oy_.clear();
+    scale_.clear(); rotation_.clear();
+    a_.clear(); b_.clear(); tx_.clear(); ty_.clear();
+}
+
+} // namespace transform
@@ -0,0 +1,68 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace transform {
+
+//------------------------------------------------------------
+// 2D world matrices for transforms.
+//
+// A transform's render matrix is T(center) * R * S * T(-origin): a 2D affine
+// map, so only six of the sixteen floats of a raylib Matrix carry anything.
+// Affine2D stores those six (column-major, like raylib's m0, m1, m4, m5, m12,
+// m13):
+//
+//     | a  c  tx |
+//     | b  d  ty |
+//
+// AffineBatch composes many of them at once: callers push the inputs, which
+// are kept as SoA columns, compose() runs the kernel over all lanes, and the
+// results are read back by index. UpdateAllTransforms fills one batch per job
+// chunk; the 4x4 expansion (ToMatrix in transform.hpp) only happens where
+// rlgl wants a float[16].
+//------------------------------------------------------------
+struct Affine2D {
+    float a = 1.f, b = 0.f;
+    float c = 0.f, d = 1.f;
+    float tx = 0.f, ty = 0.f;
+
+    bool operator==(const Affine2D &) const = default;
+};
+
+// Reference composition, used by single transforms and the Scalar kernel.
+// (cx, cy) is where the origin (ox, oy) ends up; rotation is in degrees.
+Affine2D ComposeAffine(float cx, float cy, float ox, float oy, float scale, float rotationDegrees);
+
+// Composition kernels. AVX2 is picked at runtime when the CPU supports it;
+// Scalar is the reference implementation and the fallback everywhere else.
+enum class AffineKernel : uint8_t {
+    Scalar,
+    AVX2,
+};
+
+bool AffineKernelAvailable(AffineKernel kernel);
+AffineKernel ActiveAffineKernel();
+
+class AffineBatch {
+public:
+    // Queues one matrix and returns its index in the batch.
+    size_t push(float cx, float cy, float ox, float oy, float scale, float rotationDegrees);
+
+    void compose();
+    // Same, forcing a kernel (falls back to Scalar if it is unavailable).
+    void compose(AffineKernel kernel);
+
+    Affine2D result(size_t i) const { return {a_[i], b_[i], -b_[i], a_[i], tx_[i], ty_[i]}; }
+
+    size_t size() const { return cx_.size(); }
+    void clear();
+
+private:
+    // inputs
+    std::vector<float> cx_, cy_, ox_, oy_, scale_, rotation_;
+    // outputs; c == -b and d == a for rotation + uniform scale
+    std::vector<float> a_, b_, tx_, ty_;
+};
+
+} // namespace transform
@@ -19,6 +19,7 @@
 #include "systems/entity_gamestate_management/entity_gamestate_management.hpp"
 #include "systems/physics/transform_physics_hook.hpp"
 #include "systems/camera/camera_manager.hpp"
+#include "systems/job_system/job_system.hpp"
 
 #include "systems/scripting/binding_recorder.hpp"
 
@@ -28,47 +29,48 @@
 namespace transform
 {
 
-    std::unordered_map<TransformMethod, std::any> transformFunctionsDefault = {
-        {TransformMethod::UpdateAllTransforms, std::function<void(entt::registry *, float)>(UpdateAllTransforms)},
-        {TransformMethod::HandleDefaultTransformDrag, std::function<void(entt::registry *, entt::entity, std::optional<Vector2>)>(handleDefaultTransformDrag)},
-        {TransformMethod::CreateOrEmplace, std::function<entt::entity(entt::registry *, entt::entity, float, float, float, float, std::optional<entt::entity>)>(CreateOrEmplace)},
-        {TransformMethod::CreateGameWorldContainerEntity, std::function<entt::entity(entt::registry *, float, float, float, float)>(CreateGameWorldContainerEntity)},
-        {TransformMethod::UpdateTransformSmoothingFactors, std::function<void(entt::registry *, entt::entity, float)>(UpdateTransformSmoothingFactors)},
-        {TransformMethod::AlignToMaster, std::function<void(entt::registry *, entt::entity, bool)>(AlignToMaster)},
-        {TransformMethod::MoveWithMaster, std::function<void(entt::entity, float, transform::Transform &, transform::InheritedProperties &, transform::GameObject &)>(MoveWithMaster)},
-        {TransformMethod::UpdateLocation, std::function<void(entt::entity, float, Transform &, spring::Spring &, spring::Spring &)>(UpdateLocation)},
-        {TransformMethod::UpdateRotation, std::function<void(entt::entity, float, Transform &, spring::Spring &, spring::Spring &)>(UpdateRotation)},
-        {TransformMethod::UpdateScale, std::function<void(entt::entity, float, Transform &, spring::Spring &)>(UpdateScale)},
-        {TransformMethod::GetMaster, std::function<Transform::FrameCalculation::MasterCache(entt::entity, Transform &, InheritedProperties &, GameObject &, Transform*&, InheritedProperties*& )>(GetMaster)},
-        {TransformMethod::SyncPerfectlyToMaster, std::function<void( entt::entity, entt::entity, Transform &, InheritedProperties &, Transform &, InheritedProperties &)>(SyncPerfectlyToMaster)},
-        {TransformMethod::UpdateDynamicMotion, std::function<void(entt::entity, float, Transform &)>(UpdateDynamicMotion)},
-        {TransformMethod::InjectDynamicMotion, std::function<void(entt::registry *, entt::entity, float, float)>(InjectDynamicMotion)},
-        {TransformMethod::UpdateParallaxCalculations, std::function<void(entt::registry *, entt::entity)>(UpdateParallaxCalculations)},
-        {TransformMethod::ConfigureAlignment, std::function<void(entt::registry *, entt::entity, bool, entt::entity, std::optional<InheritedProperties::Sync>, std::optional<InheritedProperties::Sync>, std::optional<InheritedProperties::Sync>, std::optional<InheritedProperties::Sync>, std::optional<int>, std::optional<Vector2>)>(ConfigureAlignment)},
-        {TransformMethod::AssignRole, std::function<void(entt::registry *, entt::entity, std::optional<InheritedProperties::Type>, entt::entity, std::optional<InheritedProperties::Sync>, std::optional<InheritedProperties::Sync>, std::optional<InheritedProperties::Sync>, std::optional<InheritedProperties::Sync>, std::optional<Vector2>)>(AssignRole)},
-        {TransformMethod::UpdateTransform, std::function<void(entt::entity, float, Transform &, InheritedProperties &, GameObject &)>(UpdateTransform)},
-        {TransformMethod::SnapTransformValues, std::function<void(entt::registry *, entt::entity, float, float, float, float)>(SnapTransformValues)},
-        {TransformMethod::SnapVisualTransformValues, std::function<void(entt::registry *, entt::entity)>(SnapVisualTransformValues)},
-        {TransformMethod::DrawBoundingBoxAndDebugInfo, std::function<void(entt::registry *, entt::entity, std::shared_ptr<layer::Layer>)>(DrawBoundingBoxAndDebugInfo)},
-        {TransformMethod::CalculateCursorPositionWithinFocus, std::function<Vector2(entt::registry *, entt::entity)>(CalculateCursorPositionWithinFocus)},
-        {TransformMethod::CheckCollisionWithPoint, std::function<bool(entt::registry *, entt::entity, Vector2)>(CheckCollisionWithPoint)},
-        {TransformMethod::HandleClick, std::function<void(entt::registry *, entt::entity)>(HandleClick)},
-        {TransformMethod::HandleClickReleased, std::function<void(entt::registry *, entt::entity)>(HandleClickReleased)},
-        {TransformMethod::SetClickOffset, std::function<void(entt::registry *, entt::entity, Vector2, bool)>(SetClickOffset)},
-        {TransformMethod::GetObjectToDrag, std::function<entt::entity(entt::registry *, entt::entity)>(GetObjectToDrag)},
-        {TransformMethod::Draw, std::function<void(std::shared_ptr<layer::Layer>, entt::registry *, entt::entity)>(Draw)},
-        {TransformMethod::StartDrag, std::function<void(entt::registry *, entt::entity, bool)>(StartDrag)},
-        {TransformMethod::StopDragging, std::function<void(entt::registry *, entt::entity)>(StopDragging)},
-        {TransformMethod::StartHover, std::function<void(entt::registry *, entt::entity)>(StartHover)},
-        {TransformMethod::StopHover, std::function<void(entt::registry *, entt::entity)>(StopHover)},
-        {TransformMethod::GetCursorOnFocus, std::function<Vector2(entt::registry *, entt::entity)>(GetCursorOnFocus)},
-        {TransformMethod::ConfigureContainerForEntity, std::function<void(entt::registry *, entt::entity, entt::entity)>(ConfigureContainerForEntity)},
-        {TransformMethod::ApplyTranslationFromEntityContainer, std::function<void(entt::registry *, entt::entity, std::shared_ptr<layer::Layer>)>(ApplyTranslationFromEntityContainer)},
-        {TransformMethod::GetDistanceBetween, std::function<float(entt::registry *, entt::entity, entt::entity)>(GetDistanceBetween)},
-        {TransformMethod::RemoveEntity, std::function<void(entt::registry *, entt::entity)>(RemoveEntity)}
-    };
-    
-    std::unordered_map<TransformMethod, std::any> hooksToCallBeforeDefault{}, hooksToCallAfterDefault{};
+    std::array<TransformMethodDefault, kTransformMethodCount> transformFunctionsDefault = [] {
+        std::array<TransformMethodDefault, kTransformMethodCount> defaults{};
+        auto set = [&](TransformMethod method, TransformMethodDefault fn) { defaults[static_cast<size_t>(method)] = fn; };
+        set(TransformMethod::UpdateAllTransforms, UpdateAllTransforms);
+        set(TransformMethod::HandleDefaultTransformDrag, handleDefaultTransformDrag);
+        set(TransformMethod::CreateOrEmplace, CreateOrEmplace);
+        set(TransformMethod::CreateGameWorldContainerEntity, CreateGameWorldContainerEntity);
+        set(TransformMethod::AlignToMaster, AlignToMaster);
+        set(TransformMethod::MoveWithMaster, MoveWithMaster);
+        set(TransformMethod::UpdateLocation, UpdateLocation);
+        set(TransformMethod::UpdateSize, UpdateSize);
+        set(TransformMethod::UpdateRotation, UpdateRotation);
+        set(TransformMethod::UpdateScale, UpdateScale);
+        set(TransformMethod::GetMaster, GetMaster);
+        set(TransformMethod::SyncPerfectlyToMaster, SyncPerfectlyToMaster);
+        set(TransformMethod::UpdateDynamicMotion, UpdateDynamicMotion);
+        set(TransformMethod::InjectDynamicMotion, InjectDynamicMotion);
+        set(TransformMethod::UpdateParallaxCalculations, UpdateParallaxCalculations);
+        set(TransformMethod::ConfigureAlignment, ConfigureAlignment);
+        set(TransformMethod::AssignRole, AssignRole);
+        set(TransformMethod::UpdateTransform, UpdateTransform);
+        set(TransformMethod::SnapTransformValues, SnapTransformValues);
+        set(TransformMethod::SnapVisualTransformValues, SnapVisualTransformValues);
+        set(TransformMethod::DrawBoundingBoxAndDebugInfo, DrawBoundingBoxAndDebugInfo);
+        set(TransformMethod::CalculateCursorPositionWithinFocus, CalculateCursorPositionWithinFocus);
+        set(TransformMethod::CheckCollisionWithPoint, CheckCollisionWithPoint);
+        set(TransformMethod::HandleClick, HandleClick);
+        set(TransformMethod::HandleClickReleased, HandleClickReleased);
+        set(TransformMethod::SetClickOffset, SetClickOffset);
+        set(TransformMethod::GetObjectToDrag, GetObjectToDrag);
+        set(TransformMethod::Draw, Draw);
+        set(TransformMethod::StartDrag, StartDrag);
+        set(TransformMethod::StopDragging, StopDragging);
+        set(TransformMethod::StartHover, StartHover);
+        set(TransformMethod::StopHover, StopHover);
+        set(TransformMethod::GetCursorOnFocus, GetCursorOnFocus);
+        set(TransformMethod::ConfigureContainerForEntity, ConfigureContainerForEntity);
+        set(TransformMethod::ApplyTranslationFromEntityContainer, ApplyTranslationFromEntityContainer);
+        set(TransformMethod::GetDistanceBetween, GetDistanceBetween);
+        set(TransformMethod::RemoveEntity, RemoveEntity);
+        return defaults;
+    }();
 
     //EXPOSED publicly
     // creates an empty entity with a transform component, node component, and role component
@@ -104,14 +106,14 @@ namespace transform
         transform.setVisualRotation(0.0f);
         // const spring::Spring DEFAULT_SPRING_ZERO = {.value = 0, .stiffness = 200.f, .damping = 40.f, .targetValue = 0};
         // customize xy spring
-        auto &xSpring = registry->get<Spring>(transform.x);
+        auto xSpring = transform.getXSpring();
         xSpring.damping = 100.f;
         xSpring.stiffness = 1600.f;
-        auto &ySpring = registry->get<Spring>(transform.y);
+        auto ySpring = transform.getYSpring();
         ySpring.damping = 100.f;
         ySpring.stiffness = 1600.f;
 
-        auto &scaleSpring = registry->get<Spring>(transform.s);
+        auto scaleSpring = transform.getSSpring();
         scaleSpring.damping = 100.f;
         scaleSpring.stiffness = 1600.f;
 
@@ -128,8 +130,6 @@ namespace transform
         node.layerDisplacement = {0, 0};
         node.shadowDisplacement = {0, -1.5f};
 
-        node.transformFunctions =  transformFunctionsDefault;
-
         // example hover customization
         setJiggleOnHover(registry, e, 0.1f);
 
@@ -232,6 +232,20 @@ namespace transform
         }
     }
 
+    // True when AlignToMaster has work to do without being forced: the alignment
+    // flags or offsets changed since the last alignment.
+    static bool AlignmentPending(Transform &transform, InheritedProperties &role)
+    {
+        if (!role.flags) return false;
+
+        bool extraOffsetUnchanged = role.flags->extraAlignmentFinetuningOffset.x == role.flags->prevExtraAlignmentFinetuningOffset.x
+            && role.flags->extraAlignmentFinetuningOffset.y == role.flags->prevExtraAlignmentFinetuningOffset.y;
+
+        return !(role.flags->alignment == role.flags->prevAlignment && extraOffsetUnchanged
+            && role.offset->x == role.prevOffset->x && role.offset->y == role.prevOffset->y
+            && transform.frameCalculation.alignmentChanged == false);
+    }
+
     // not exposed publicly
     auto AlignToMaster(entt::registry *registry, entt::entity e, bool forceAlign) -> void
     {
@@ -255,9 +269,7 @@ namespace transform
             && role.flags->extraAlignmentFinetuningOffset.y == role.flags->prevExtraAlignmentFinetuningOffset.y;
 
         // if alignment and offset unchanged
-        if (role.flags->alignment == role.flags->prevAlignment && extraOffsetUnchanged
-            && role.offset->x == role.prevOffset->x && role.offset->y == role.prevOffset->y
-            && forceAlign == false && transform.frameCalculation.alignmentChanged == false)
+        if (!AlignmentPending(transform, role) && forceAlign == false)
         {
             // SPDLOG_DEBUG("Alignment and offset unchanged");
             return;
@@ -397,26 +409,41 @@ namespace transform
         role.prevOffset->y = role.offset->y;
     }
     
-    // Fetch—or build and cache—a SpringBundle for entity 'e'
-    SpringCacheBundle& getSpringBundleCached(entt::entity e, Transform &t) {
-        auto it = globals::g_springCache.find(e);
-        if ( it == globals::g_springCache.end() ) {
-            // first time this frame → pull all six springs once
-            SpringCacheBundle b {
-                &t.getXSpring(),
-                &t.getYSpring(),
-                &t.getRSpring(),
-                &t.getSSpring(),
-                &t.getWSpring(),
-                &t.getHSpring()
-            };
-            auto ins = globals::g_springCache.emplace(e, b);
-            return ins.first->second;
-        }
-        return it->second;
+    // Springs live in the spring pool, so the bundle is just six views into it
+    SpringCacheBundle getSpringBundleCached(entt::entity e, Transform &t) {
+        return SpringCacheBundle {
+            t.getXSpring(),
+            t.getYSpring(),
+            t.getRSpring(),
+            t.getSSpring(),
+            t.getWSpring(),
+            t.getHSpring()
+        };
     }
 
     
+    // The master GetMaster would return, found by walking up the hierarchy
+    // instead of through the global master cache, so it never writes anything.
+    static entt::entity ResolveMaster(entt::registry &registry, entt::entity e, InheritedProperties &role)
+    {
+        entt::entity self = e;
+        InheritedProperties *selfRole = &role;
+        while (true)
+        {
+            if (selfRole->master == globals::getGameWorldContainer() || selfRole->role_type == InheritedProperties::Type::RoleRoot || selfRole->master == self)
+                return self;
+            if (selfRole->location_bond == InheritedProperties::Sync::Weak && selfRole->rotation_bond == InheritedProperties::Sync::Weak)
+                return self;
+
+            auto [parentTransform, parentRole, parentNode] = registry.try_get<Transform, InheritedProperties, GameObject>(selfRole->master);
+            if (!parentTransform || !parentRole || !parentNode)
+                return self;
+
+            self = selfRole->master;
+            selfRole = parentRole;
+        }
+    }
+
     auto MoveWithMaster(entt::entity e, float dt, Transform &selfTransform, InheritedProperties &selfRole, GameObject &selfNode) -> void
     {
         auto registry = &globals::getRegistry();
@@ -446,40 +473,19 @@ namespace transform
         Transform *parentTransform = nullptr;
         InheritedProperties *parentRole = nullptr;
         
-        
-        
-        auto parentRetVal = GetMaster(e, selfTransform, selfRole, selfNode, parentTransform, parentRole);
-        auto parent = parentRetVal.master.value();
+        auto parent = ResolveMaster(*registry, e, selfRole);
         auto* uiCfg = registry->try_get<ui::UIConfig>(e);
         // getmaster for a ui root entity returns the ui box's master, which is not what we want. if this is a ui root, use the immediate master instead.
         if (uiCfg && uiCfg->uiType == ui::UITypeEnum::ROOT)
         {
             parent = selfRole.master; // use the immediate master instead of the master of the ui box
         }
-        //FIXME: parent != selfRole.master after the lambda below. why?
+        // read-only: this runs inside transform jobs
         static auto fillParentTransformAndRole = [](entt::entity parent, Transform *&parentTransform, InheritedProperties *&parentRole)
         {
             auto &registry = globals::getRegistry();
-            auto it = globals::getMasterCacheEntityToParentCompMap.find(parent);
-
-            if (it != globals::getMasterCacheEntityToParentCompMap.end())
-            {
-                auto &entry = it->second;
-
-                // if (entry.parentTransform == nullptr)
-                    entry.parentTransform = registry.try_get<Transform>(parent);
-
-                // if (entry.parentRole == nullptr)
-                    entry.parentRole = registry.try_get<InheritedProperties>(parent);
-
-                parentTransform = entry.parentTransform;
-                parentRole = entry.parentRole;
-            }
-            else
-            {
-                parentTransform = registry.try_get<Transform>(parent);
-                parentRole = registry.try_get<InheritedProperties>(parent);
-            }
+            parentTransform = registry.try_get<Transform>(parent);
+            parentRole = registry.try_get<InheritedProperties>(parent);
         }; 
 
         fillParentTransformAndRole(parent, parentTransform, parentRole);
@@ -511,20 +517,20 @@ namespace transform
         auto selfSprings = getSpringBundleCached(e, selfTransform);
         auto parentSprings = getSpringBundleCached(parent, *parentTransform);
         
-        auto selfActualW = selfSprings.w->targetValue;
-        auto selfActualH = selfSprings.h->targetValue;
-        auto selfVisualX = selfSprings.x->value;
-        auto selfVisualY = selfSprings.y->value;
-        auto selfVisualW = selfSprings.w->value;
-        auto selfVisualH = selfSprings.h->value;
+        auto selfActualW = selfSprings.w.targetValue;
+        auto selfActualH = selfSprings.h.targetValue;
+        auto selfVisualX = selfSprings.x.value;
+        auto selfVisualY = selfSprings.y.value;
+        auto selfVisualW = selfSprings.w.value;
+        auto selfVisualH = selfSprings.h.value;
         // FIXME: for root, ui box x, y is different. why is it pulling wrong 
-        auto parentActualW = parentSprings.w->targetValue;
-        auto parentActualH = parentSprings.h->targetValue;
-        auto parentVisualX = parentSprings.x->value;
-        auto parentVisualY = parentSprings.y->value;
-        auto parentVisualW = parentSprings.w->value;
-        auto parentVisualH = parentSprings.h->value;
-        auto parentVisualR = parentSprings.r->value;
+        auto parentActualW = parentSprings.w.targetValue;
+        auto parentActualH = parentSprings.h.targetValue;
+        auto parentVisualX = parentSprings.x.value;
+        auto parentVisualY = parentSprings.y.value;
+        auto parentVisualW = parentSprings.w.value;
+        auto parentVisualH = parentSprings.h.value;
+        auto parentVisualR = parentSprings.r.value;
         
         
         
@@ -564,60 +570,60 @@ namespace transform
         }
         
         
-        selfSprings.x->targetValue = parentSprings.x->value + tempRotatedOffset.x;
-        selfSprings.y->targetValue = parentSprings.y->value + tempRotatedOffset.y;
+        selfSprings.x.targetValue = parentSprings.x.value + tempRotatedOffset.x;
+        selfSprings.y.targetValue = parentSprings.y.value + tempRotatedOffset.y;
         
         if (selfRole.location_bond == InheritedProperties::Sync::Strong) {
             // snap to target values immediately
-            selfSprings.x->value = selfSprings.x->targetValue;
-            selfSprings.y->value = selfSprings.y->targetValue;
+            selfSprings.x.value = selfSprings.x.targetValue;
+            selfSprings.y.value = selfSprings.y.targetValue;
         }
         // SPDLOG_DEBUG("Moving with master set to targets: x: {}, y: {}", selfTransform.getXSpring().targetValue, selfTransform.getYSpring().targetValue);
 
         if (selfRole.location_bond == InheritedProperties::Sync::Strong)
         {
-            selfSprings.x->value = selfSprings.x->targetValue;
-            selfSprings.y->value = selfSprings.y->targetValue;
+            selfSprings.x.value = selfSprings.x.targetValue;
+            selfSprings.y.value = selfSprings.y.targetValue;
         }
         else if (selfRole.location_bond == InheritedProperties::Sync::Weak)
         {
 
-            UpdateLocation(e, dt, selfTransform, *selfSprings.x, *selfSprings.y);
+            UpdateLocation(e, dt, selfTransform, selfSprings.x, selfSprings.y);
         }
         
         
         // force spring update
         // selfTransform.updateCachedValues( true);
-        // selfTransform.updateCachedValues(*selfSprings.x, *selfSprings.y, *selfSprings.w, *selfSprings.h, *selfSprings.r, *selfSprings.s, true);
+        // selfTransform.updateCachedValues(selfSprings.x, selfSprings.y, selfSprings.w, selfSprings.h, selfSprings.r, selfSprings.s, true);
         // parentTransform->updateCachedValues(true);
         
-        selfActualW = selfSprings.w->targetValue;
-        selfActualH = selfSprings.h->targetValue;
-        selfVisualX = selfSprings.x->value;
-        selfVisualY = selfSprings.y->value;
-        selfVisualW = selfSprings.w->value;
-        selfVisualH = selfSprings.h->value;
-        auto selfActualR = selfSprings.r->targetValue;
-        auto selfVisualR = selfSprings.r->value;
-        auto selfVisualS = selfSprings.s->value;
-        auto selfActualS = selfSprings.s->targetValue;
-        
-        parentActualW = parentSprings.w->targetValue;
-        parentActualH = parentSprings.h->targetValue;
-        parentVisualX = parentSprings.x->value;
-        parentVisualY = parentSprings.y->value;
-        parentVisualW = parentSprings.w->value;
-        parentVisualH = parentSprings.h->value;
-        parentVisualR = parentSprings.r->value;
-        auto parentActualS = parentSprings.s->targetValue;
-        auto parentVisualS = parentSprings.s->value;
-        
-        auto setSelfVisualX = [&](float v) { selfSprings.x->value = v; };
-        auto setSelfVisualY = [&](float v) { selfSprings.y->value = v; };
-        auto setSelfVisualW = [&](float v) { selfSprings.w->value = v; };
-        auto setSelfVisualH = [&](float v) { selfSprings.h->value = v; };
-        auto setSelfVisualR = [&](float v) { selfSprings.r->value = v; };
-        auto setSelfVisualS = [&](float v) { selfSprings.s->value = v; };
+        selfActualW = selfSprings.w.targetValue;
+        selfActualH = selfSprings.h.targetValue;
+        selfVisualX = selfSprings.x.value;
+        selfVisualY = selfSprings.y.value;
+        selfVisualW = selfSprings.w.value;
+        selfVisualH = selfSprings.h.value;
+        auto selfActualR = selfSprings.r.targetValue;
+        auto selfVisualR = selfSprings.r.value;
+        auto selfVisualS = selfSprings.s.value;
+        auto selfActualS = selfSprings.s.targetValue;
+        
+        parentActualW = parentSprings.w.targetValue;
+        parentActualH = parentSprings.h.targetValue;
+        parentVisualX = parentSprings.x.value;
+        parentVisualY = parentSprings.y.value;
+        parentVisualW = parentSprings.w.value;
+        parentVisualH = parentSprings.h.value;
+        parentVisualR = parentSprings.r.value;
+        auto parentActualS = parentSprings.s.targetValue;
+        auto parentVisualS = parentSprings.s.value;
+        
+        auto setSelfVisualX = [&](float v) { selfSprings.x.value = v; };
+        auto setSelfVisualY = [&](float v) { selfSprings.y.value = v; };
+        auto setSelfVisualW = [&](float v) { selfSprings.w.value = v; };
+        auto setSelfVisualH = [&](float v) { selfSprings.h.value = v; };
+        auto setSelfVisualR = [&](float v) { selfSprings.r.value = v; };
+        auto setSelfVisualS = [&](float v) { selfSprings.s.value = v; };
 
         if (selfRole.rotation_bond == InheritedProperties::Sync::Strong)
         {
@@ -634,7 +640,7 @@ namespace transform
         }
         else if (selfRole.rotation_bond == InheritedProperties::Sync::Weak)
         {
-            UpdateRotation(e, dt, selfTransform, *selfSprings.r, *selfSprings.x);
+            UpdateRotation(e, dt, selfTransform, selfSprings.r, selfSprings.x);
         }
 
         if (selfRole.scale_bond == InheritedProperties::Sync::Strong)
@@ -657,7 +663,7 @@ namespace transform
         }
         else if (selfRole.scale_bond == InheritedProperties::Sync::Weak)
         {
-            UpdateScale(e, dt, selfTransform, *selfSprings.s);
+            UpdateScale(e, dt, selfTransform, selfSprings.s);
         }
 
         if (selfRole.size_bond == InheritedProperties::Sync::Strong)
@@ -678,14 +684,14 @@ namespace transform
         }
         else if (selfRole.size_bond == InheritedProperties::Sync::Weak)
         {
-            UpdateSize(e, dt, selfTransform, *selfSprings.w, *selfSprings.h);
+            UpdateSize(e, dt, selfTransform, selfSprings.w, selfSprings.h);
         }
 
         UpdateParallaxCalculations(registry, e);
     }
 
     // not exposed
-    auto UpdateLocation(entt::entity e, float dt, Transform &transform, spring::Spring &springX, spring::Spring &springY) -> void
+    auto UpdateLocation(entt::entity e, float dt, Transform &transform, spring::SpringRef springX, spring::SpringRef springY) -> void
     {
         // nothing to do here, springs will update on their own
         if (springX.velocity > 0.0001f || springY.velocity > 0.0001f)
@@ -695,7 +701,7 @@ namespace transform
     }
 
     // not exposed
-    auto UpdateSize(entt::entity e, float dt, Transform &transform, spring::Spring &springW, spring::Spring springH) -> void
+    auto UpdateSize(entt::entity e, float dt, Transform &transform, spring::SpringRef springW, spring::SpringRef springH) -> void
     {
         // nothing to do here, springs will update on their own
 
@@ -740,7 +746,7 @@ namespace transform
     }
 
     // not exposed
-    auto UpdateRotation(entt::entity e, float dt, Transform &transform, spring::Spring &springR, spring::Spring &springX) -> void
+    auto UpdateRotation(entt::entity e, float dt, Transform &transform, spring::SpringRef springR, spring::SpringRef springX) -> void
     {
         // nothing to do here, springs will update on their own
         float dynamicMotionAddedR = 0;
@@ -801,7 +807,7 @@ namespace transform
     }
 
     // not exposed
-    auto UpdateScale(entt::entity e, float dt, Transform &transform, spring::Spring &springS) -> void
+    auto UpdateScale(entt::entity e, float dt, Transform &transform, spring::SpringRef springS) -> void
     {
         // nothing to do here, springs will update on their own
         if (springS.velocity > 0.0001f)
@@ -1079,6 +1085,11 @@ double taperedOscillation(double t, double T, double A, double freq, double D) {
         {
             role.flags->extraAlignmentFinetuningOffset = offset.value();
         }
+
+        if (alignment || offset)
+        {
+            MarkTransformDirty(e);
+        }
     }
 
     auto AssignRole(entt::registry *registry, entt::entity e, std::optional<InheritedProperties::Type> roleType, entt::entity parent, std::optional<InheritedProperties::Sync> xy, std::optional<InheritedProperties::Sync> wh, std::optional<InheritedProperties::Sync> rotation, std::optional<InheritedProperties::Sync> scale, std::optional<Vector2> offset) -> void
@@ -1125,6 +1136,11 @@ double taperedOscillation(double t, double T, double A, double freq, double D) {
         {
             role.master = entt::null;
         }
+
+        if (registry == &globals::getRegistry())
+        {
+            GetTransformDepthIndex().setMaster(entt::to_integral(e), entt::to_integral(role.master));
+        }
     }
     
     void UpdateTransformMatrices(entt::registry& registry, entt::entity e)
@@ -1134,45 +1150,26 @@ double taperedOscillation(double t, double T, double A, double freq, double D) {
         if (!registry.valid(e) || !registry.all_of<Transform>(e)) return;
 
         auto &t = registry.get<Transform>(e);
-
-        const float cx = t.getVisualX() + t.getVisualW() * 0.5f;
-        const float cy = t.getVisualY() + t.getVisualH() * 0.5f;
-        const float s  = t.getVisualScaleWithHoverAndDynamicMotionReflected();
-        const float r  = (t.getVisualR() + t.rotationOffset) * DEG2RAD;
-        const float ox = t.getVisualW() * 0.5f;
-        const float oy = t.getVisualH() * 0.5f;
-
-        const float c  = cosf(r);
-        const float sn = sinf(r);
-
-        // Compose M = T(center) * R * S * T(-origin)
-        Matrix m;
-
-        m.m0  =  s * c;
-        m.m1  =  s * sn;
-        m.m2  =  0.0f;
-        m.m3  =  0.0f;
-
-        m.m4  = -s * sn;
-        m.m5  =  s * c;
-        m.m6  =  0.0f;
-        m.m7  =  0.0f;
-
-        m.m8  =  0.0f;
-        m.m9  =  0.0f;
-        m.m10 =  1.0f;
-        m.m11 =  0.0f;
-
-        // Final translation (same as T(center) * R * S * T(-origin))
-        m.m12 = cx + (-ox * s * c + oy * s * sn);
-        m.m13 = cy + (-ox * s * sn - oy * s * c);
-        m.m14 = 0.0f;
-        m.m15 = 1.0f;
-
-        t.cachedMatrix = m;
+        t.cachedMatrix = ComposeAffine(t.getVisualX() + t.getVisualW() * 0.5f,
+                                       t.getVisualY() + t.getVisualH() * 0.5f,
+                                       t.getVisualW() * 0.5f,
+                                       t.getVisualH() * 0.5f,
+                                       t.getVisualScaleWithHoverAndDynamicMotionReflected(),
+                                       t.getVisualR() + t.rotationOffset);
         t.matrixDirty = false;
     }
 
+    // Queues t's matrix in a batch; the caller composes it and stores the result.
+    static void QueueTransformMatrix(AffineBatch &batch, Transform &t)
+    {
+        batch.push(t.getVisualX() + t.getVisualW() * 0.5f,
+                   t.getVisualY() + t.getVisualH() * 0.5f,
+                   t.getVisualW() * 0.5f,
+                   t.getVisualH() * 0.5f,
+                   t.getVisualScaleWithHoverAndDynamicMotionReflected(),
+                   t.getVisualR() + t.rotationOffset);
+    }
+
     
     // // store in full-owning group for efficiency
     // static auto transformSpringGroup = globals::getRegistry().group<Spring>();
@@ -1184,29 +1181,267 @@ double taperedOscillation(double t, double T, double A, double freq, double D) {
     //     return actualX;
     // }
 
+    // UpdateTransform minus the GameObject update callback (which may run Lua).
+    // Returns false if the transform had already been updated this frame.
+    static bool UpdateTransformState(entt::entity e, float dt, Transform &transform, InheritedProperties &role, GameObject &node);
+
+    namespace
+    {
+        constexpr size_t kTransformChunkSize = 256;
+
+        bool dirtyOnlyUpdates = false;
+
+        // Output of one chunk of a hierarchy level, handled on the main thread
+        // once the level's jobs are done.
+        struct TransformLevelChunk
+        {
+            std::vector<entt::entity> serial;   // need UpdateTransform on the main thread
+            std::vector<entt::entity> scripted; // updated; callback and matrix still to come
+            std::vector<entt::entity> moved;    // dirty-only: slaves have to follow
+            std::vector<entt::entity> restless; // dirty-only: must be visited again next frame
+            std::vector<Transform *> composed;  // matrices queued in `matrices`, same order
+            AffineBatch matrices;
+        };
+
+        // Everything a slave reads from its master, plus what ends up in the matrix.
+        using TransformOutputs = std::array<float, 15>;
+
+        TransformOutputs CaptureOutputs(Transform &transform)
+        {
+            TransformOutputs out{};
+            for (size_t i = 0; i < static_cast<size_t>(TransformSpring::Count); ++i)
+            {
+                const auto spring = transform.getSpring(static_cast<TransformSpring>(i));
+                out[i * 2] = spring.value;
+                out[i * 2 + 1] = spring.targetValue;
+            }
+            out[12] = transform.rotationOffset;
+            out[13] = transform.getVisualScaleWithHoverAndDynamicMotionReflected();
+            out[14] = transform.getVisualRWithDynamicMotionAndXLeaning();
+            return out;
+        }
+
+        // Things that change a transform's output without touching its springs
+        // for as long as they last, and update callbacks, which run every frame.
+        bool StaysRestless(Transform &transform, GameObject &node)
+        {
+            return transform.dynamicMotion.has_value() || node.state.isBeingHovered || node.state.isBeingDragged
+                || static_cast<bool>(node.methods.update);
+        }
+
+        // Jobs only touch the entity they update and read its master. Anything
+        // else goes to the main thread: alignment (which may read a sibling),
+        // a raised alignmentChanged (set by drags whatever the flags hold; an
+        // inheritor then updates its master again), and a master that was not
+        // updated by the previous level (inactive, or deferred itself), because
+        // UpdateTransform would recurse into it or fill its per-frame cache.
+        bool NeedsSerialUpdate(entt::registry &registry, entt::entity e, Transform &transform, InheritedProperties &role, int frame)
+        {
+            if (transform.frameCalculation.alignmentChanged) return true;
+            if (AlignmentPending(transform, role)) return true;
+            if (role.master == e || !registry.valid(role.master)) return false;
+
+            auto *masterTransform = registry.try_get<Transform>(role.master);
+            if (!masterTransform) return false;
+            return masterTransform->frameCalculation.lastUpdatedFrame < frame || masterTransform->lastCacheFrame != frame;
+        }
+    }
+
+    void SetDirtyOnlyTransformUpdates(bool enabled)
+    {
+        dirtyOnlyUpdates = enabled;
+    }
+
+    bool DirtyOnlyTransformUpdates()
+    {
+        return dirtyOnlyUpdates;
+    }
+
+    void MarkTransformDirty(entt::entity e)
+    {
+        auto &depthIndex = GetTransformDepthIndex();
+        depthIndex.markDirty(entt::to_integral(e));
+        depthIndex.markSlavesDirty(entt::to_integral(e));
+    }
+
     auto UpdateAllTransforms(entt::registry *registry, float dt) -> void
     {
         ZONE_SCOPED("Update all transforms");
         
-        // updateTransformCacheForAllTransforms();
-        
         using namespace entity_gamestate_management;
-        
-        static auto group = registry->group<InheritedProperties>(entt::get<Transform, GameObject>, entt::exclude<InactiveTag>);
-        
-        group.each([dt, registry](entt::entity e, InheritedProperties &role, Transform &transform, GameObject &node) {
-            UpdateTransform(e, dt, transform, role, node);
-            UpdateTransformMatrices(*registry, e);
-        });
+
+        // Kept current by the InheritedProperties signals and AssignRole.
+        auto &depthIndex = GetTransformDepthIndex();
+
+        // Dirty-only: start from transforms whose springs changed since the last
+        // pass (integrated or written by anyone), plus whatever was marked.
+        static bool wasDirtyOnly = false;
+        static std::vector<uint32_t> changedOwners;
+        const bool dirtyOnly = dirtyOnlyUpdates;
+        if (dirtyOnly)
+        {
+            ZONE_SCOPED("Collect changed transforms");
+            changedOwners.clear();
+            spring::GetSpringPool().collectChanged(changedOwners);
+            if (!wasDirtyOnly)
+            {
+                depthIndex.markAllDirty(); // nothing was tracked until now
+            }
+            for (uint32_t owner : changedOwners) depthIndex.markDirty(owner);
+        }
+        wasDirtyOnly = dirtyOnly;
+
+        // Create every pool the jobs look at up front; a job must not add one.
+        auto &roles = registry->storage<InheritedProperties>();
+        auto &transforms = registry->storage<Transform>();
+        auto &nodes = registry->storage<GameObject>();
+        auto &inactive = registry->storage<InactiveTag>();
+        registry->storage<ui::UIConfig>();
+        registry->storage<ui::ObjectAttachedToUITag>();
+
+        // Roots read the game world container for parallax, so it goes first.
+        const entt::entity world = globals::getGameWorldContainer();
+        if (roles.contains(world) && transforms.contains(world) && nodes.contains(world) && !inactive.contains(world))
+        {
+            auto &worldTransform = transforms.get(world);
+            TransformOutputs before{};
+            if (dirtyOnly) before = CaptureOutputs(worldTransform);
+            UpdateTransform(world, dt, worldTransform, roles.get(world), nodes.get(world));
+            UpdateTransformMatrices(*registry, world);
+            if (dirtyOnly && CaptureOutputs(worldTransform) != before)
+            {
+                depthIndex.markAllDirty(); // every root's parallax reads it
+            }
+        }
+
+        static std::vector<TransformDepthIndex::Id> dirtyIds;
+        static std::vector<entt::entity> level;            // reused, main thread only
+        static std::vector<TransformLevelChunk> chunks;
+        const int frame = main_loop::mainLoop.frame;
+
+        // Masters before slaves: each level only reads levels above it, so its
+        // entities update in parallel. Copied out because callbacks run between
+        // levels and may reparent or destroy entities.
+        for (size_t depth = 0; depth < depthIndex.levels().size(); ++depth)
+        {
+            ZONE_SCOPED("UpdateAllTransforms level");
+            if (dirtyOnly)
+            {
+                depthIndex.takeDirty(depth, dirtyIds);
+            }
+            const auto &ids = dirtyOnly ? dirtyIds : depthIndex.levels()[depth];
+            level.resize(ids.size());
+            for (size_t i = 0; i < ids.size(); ++i) level[i] = static_cast<entt::entity>(ids[i]);
+            if (level.empty()) continue;
+
+            const size_t chunkCount = (level.size() + kTransformChunkSize - 1) / kTransformChunkSize;
+            if (chunks.size() < chunkCount) chunks.resize(chunkCount);
+
+            job_system::parallelFor(chunkCount, 1, [&](size_t first, size_t last) {
+                for (size_t c = first; c < last; ++c)
+                {
+                    auto &chunk = chunks[c];
+                    chunk.serial.clear();
+                    chunk.scripted.clear();
+                    chunk.moved.clear();
+                    chunk.restless.clear();
+                    chunk.composed.clear();
+                    chunk.matrices.clear();
+
+                    const size_t end = std::min(level.size(), (c + 1) * kTransformChunkSize);
+                    for (size_t i = c * kTransformChunkSize; i < end; ++i)
+                    {
+                        const entt::entity e = level[i];
+                        if (e == world || !registry->valid(e)) continue;
+                        if (!transforms.contains(e) || !nodes.contains(e) || !roles.contains(e)) continue;
+                        if (inactive.contains(e))
+                        {
+                            // picked up again once it is active
+                            if (dirtyOnly) chunk.restless.push_back(e);
+                            continue;
+                        }
+
+                        auto &transform = transforms.get(e);
+                        auto &role = roles.get(e);
+                        auto &node = nodes.get(e);
+                        if (NeedsSerialUpdate(*registry, e, transform, role, frame))
+                        {
+                            chunk.serial.push_back(e);
+                            continue;
+                        }
+
+                        TransformOutputs before{};
+                        if (dirtyOnly) before = CaptureOutputs(transform);
+
+                        // A callback may still move a scripted transform, so its
+                        // matrix is composed after the callback runs.
+                        if (UpdateTransformState(e, dt, transform, role, node) && node.methods.update)
+                        {
+                            chunk.scripted.push_back(e);
+                        }
+                        else
+                        {
+                            QueueTransformMatrix(chunk.matrices, transform);
+                            chunk.composed.push_back(&transform);
+                        }
+
+                        if (dirtyOnly)
+                        {
+                            if (CaptureOutputs(transform) != before) chunk.moved.push_back(e);
+                            if (StaysRestless(transform, node)) chunk.restless.push_back(e);
+                        }
+                    }
+
+                    // all of the chunk's matrices in one SIMD pass
+                    chunk.matrices.compose();
+                    for (size_t i = 0; i < chunk.composed.size(); ++i)
+                    {
+                        chunk.composed[i]->cachedMatrix = chunk.matrices.result(i);
+                        chunk.composed[i]->matrixDirty = false;
+                    }
+                }
+            });
+
+            // In chunk order, so the result does not depend on the thread count.
+            for (size_t c = 0; c < chunkCount; ++c)
+            {
+                for (entt::entity e : chunks[c].serial)
+                {
+                    if (!registry->valid(e) || !transforms.contains(e) || !nodes.contains(e) || !roles.contains(e)) continue;
+                    auto &transform = transforms.get(e);
+                    auto &node = nodes.get(e);
+                    TransformOutputs before{};
+                    if (dirtyOnly) before = CaptureOutputs(transform);
+
+                    UpdateTransform(e, dt, transform, roles.get(e), node);
+                    UpdateTransformMatrices(*registry, e);
+
+                    if (dirtyOnly)
+                    {
+                        if (CaptureOutputs(transform) != before) depthIndex.markSlavesDirty(entt::to_integral(e));
+                        if (StaysRestless(transform, node)) depthIndex.markDirty(entt::to_integral(e));
+                    }
+                }
+                for (entt::entity e : chunks[c].moved) depthIndex.markSlavesDirty(entt::to_integral(e));
+                for (entt::entity e : chunks[c].restless) depthIndex.markDirty(entt::to_integral(e));
+            }
+            for (size_t c = 0; c < chunkCount; ++c)
+            {
+                for (entt::entity e : chunks[c].scripted)
+                {
+                    if (!registry->valid(e) || !nodes.contains(e)) continue;
+                    auto &node = nodes.get(e);
+                    if (node.methods.update) node.methods.update(*registry, e, dt);
+                    UpdateTransformMatrices(*registry, e);
+                }
+            }
+        }
+
+        // Marks left over from a full pass are already handled.
+        if (!dirtyOnly) depthIndex.clearDirty();
 
         // Keep UIBox roots synced to their boxes for collision correctness.
         ui::box::SyncAllUIRootsToBoxes(*registry);
-        
-        
-        
-        
-        // auto test = GetActualX(transformSpringGroup, registry->get<Transform>(globals::gameWorldContainerEntity));
-        // SPDLOG_DEBUG("Game world container actual X: {}", test);
     }
 
     // // these are used in frame calculations to determine if the transform needs to be updated
@@ -1219,7 +1454,7 @@ double taperedOscillation(double t, double T, double A, double freq, double D) {
     //     bool stationary = false; // if true, the transform will not move
     //     bool alignmentChanged = false; // if true, the alignment has changed
     // };
-    auto UpdateTransform(entt::entity e, float dt, Transform &transform, InheritedProperties &role, GameObject &node) -> void
+    static bool UpdateTransformState(entt::entity e, float dt, Transform &transform, InheritedProperties &role, GameObject &node)
     {
         ZONE_SCOPED("UpdateTransform");
         
@@ -1234,7 +1469,7 @@ double taperedOscillation(double t, double T, double A, double freq, double D) {
         if (transform.frameCalculation.lastUpdatedFrame >= main_loop::mainLoop.frame && transform.frameCalculation.alignmentChanged == false)
         {
             // SPDLOG_DEBUG("Transform already updated this frame");
-            return; // already updated this frame
+            return false; // already updated this frame
         }
 
         // cache some values here
@@ -1249,7 +1484,10 @@ double taperedOscillation(double t, double T, double A, double freq, double D) {
         // }
         
         auto [parentTransform, parentRole, parentNode] = registry->try_get<Transform, InheritedProperties, GameObject>(role.master);
-        
+
+        // Views into the spring pool. These used to be copies, so UpdateSize's
+        // enabled toggle during a pinch and UpdateRotation's velocity snap were
+        // lost; they now reach the springs.
         auto selfXSpring = transform.getXSpring();
         auto selfYSpring = transform.getYSpring();
         auto selfRSpring = transform.getRSpring();
@@ -1384,20 +1622,27 @@ double taperedOscillation(double t, double T, double A, double freq, double D) {
         transform.frameCalculation.alignmentChanged = false;
 
         node.state.isColliding = false; // clear flag
-        
+
+        return true;
+    }
+
+    auto UpdateTransform(entt::entity e, float dt, Transform &transform, InheritedProperties &role, GameObject &node) -> void
+    {
+        if (!UpdateTransformState(e, dt, transform, role, node)) return;
+
         // call custom update function if it exists
-        if (node.methods.update) node.methods.update(*registry, e, dt);
+        if (node.methods.update) node.methods.update(globals::getRegistry(), e, dt);
     }
 
     auto SnapTransformValues(entt::registry *registry, entt::entity e, float x, float y, float w, float h) -> void
     {
         auto &transform = registry->get<Transform>(e);
-        auto &springX = transform.getXSpring();
-        auto &springY = transform.getYSpring();
-        auto &springW = transform.getWSpring();
-        auto &springH = transform.getHSpring();
-        auto &springR = transform.getRSpring();
-        auto &springS = transform.getSSpring();
+        auto springX = transform.getXSpring();
+        auto springY = transform.getYSpring();
+        auto springW = transform.getWSpring();
+        auto springH = transform.getHSpring();
+        auto springR = transform.getRSpring();
+        auto springS = transform.getSSpring();
 
         springX.targetValue = x;
         springY.targetValue = y;
@@ -1428,12 +1673,12 @@ double taperedOscillation(double t, double T, double A, double freq, double D) {
     auto SnapVisualTransformValues(entt::registry *registry, entt::entity e) -> void
     {
         auto &transform = registry->get<Transform>(e);
-        auto &springX = transform.getXSpring();
-        auto &springY = transform.getYSpring();
-        auto &springW = transform.getWSpring();
-        auto &springH = transform.getHSpring();
-        auto &springR = transform.getRSpring();
-        auto &springS = transform.getSSpring();
+        auto springX = transform.getXSpring();
+        auto springY = transform.getYSpring();
+        auto springW = transform.getWSpring();
+        auto springH = transform.getHSpring();
+        auto springR = transform.getRSpring();
+        auto springS = transform.getSSpring();
 
         springX.value = springX.targetValue;
         springY.value = springY.targetValue;
@@ -1489,12 +1734,12 @@ double taperedOscillation(double t, double T, double A, double freq, double D) {
 
         auto &transform = registry->get<Transform>(e);
         auto &role = registry->get<InheritedProperties>(e);
-        auto &springX = transform.getXSpring();
-        auto &springY = transform.getYSpring();
-        auto &springW = transform.getWSpring();
-        auto &springH = transform.getHSpring();
-        auto &springR = transform.getRSpring();
-        auto &springS = transform.getSSpring();
+        auto springX = transform.getXSpring();
+        auto springY = transform.getYSpring();
+        auto springW = transform.getWSpring();
+        auto springH = transform.getHSpring();
+        auto springR = transform.getRSpring();
+        auto springS = transform.getSSpring();
         
         // check if buffer is full and if so, flush batch
         
@@ -2405,31 +2650,6 @@ double taperedOscillation(double t, double T, double A, double freq, double D) {
         });
     }
 
-    // this method should be called every frame for a transform/node entity
-    auto UpdateTransformSmoothingFactors(entt::registry *registry, entt::entity e, float dt) -> void
-    {
-        // customizing the smoothing factors for the transform based on delta time
-        auto &transform = registry->get<Transform>(e);
-
-        auto &springX = transform.getXSpring();
-        auto &springY = transform.getYSpring();
-        auto &springS = transform.getWSpring();
-        auto &springR = transform.getRSpring();
-
-        // At 60 FPS, self.real_dt (delta time) is approximately 1 / 60 = 0.0167 seconds.
-
-        // higher smoothing factor means slower response to changes (between 0 and 1, where 1 is no slowing of velocity)
-        springX.smoothingFactor = exp(-50 * dt);  // for 60 fps, this is 0.434
-        springY.smoothingFactor = exp(-50 * dt);  // for 60 fps, this is 0.434
-        springS.smoothingFactor = exp(-60 * dt);  // for 60 fps, this is 0.367
-        springR.smoothingFactor = exp(-190 * dt); // for 60 fps, this is 0.042
-
-        // max vel only for xy
-        float move_dt = std::min(1.0f / 20.f, dt); // cap dt at 20 fps at the slowest when moving
-        springX.maxVelocity = 70 * move_dt;
-        springY.maxVelocity = 70 * move_dt;
-    }
-
     // Returns the squared (fast) distance in game units from the center of one node to the center of another node
     auto GetDistanceBetween(entt::registry *registry, entt::entity e1, entt::entity e2) -> float
     {
@@ -2535,12 +2755,12 @@ auto exposeToLua(sol::state &lua, EngineContext* /*ctx*/) -> void {
         rec.record_property("Transform", {"scale", "number", "The logical scale multiplier."});
         rec.record_method("Transform", {"visualS", "---@param self Transform\n---@return number", "Gets the visual scale.", false, false});
         rec.record_method("Transform", {"visualSWithMotion", "---@param self Transform\n---@return number", "Gets the visual scale including dynamic motion.", false, false});
-        rec.record_method("Transform", {"xSpring", "---@param self Transform\n---@return Spring", "Gets the X position spring.", false, false});
-        rec.record_method("Transform", {"ySpring", "---@param self Transform\n---@return Spring", "Gets the Y position spring.", false, false});
-        rec.record_method("Transform", {"wSpring", "---@param self Transform\n---@return Spring", "Gets the width spring.", false, false});
-        rec.record_method("Transform", {"hSpring", "---@param self Transform\n---@return Spring", "Gets the height spring.", false, false});
-        rec.record_method("Transform", {"rSpring", "---@param self Transform\n---@return Spring", "Gets the rotation spring.", false, false});
-        rec.record_method("Transform", {"sSpring", "---@param self Transform\n---@return Spring", "Gets the scale spring.", false, false});
+        rec.record_method("Transform", {"xSpring", "---@param self Transform\n---@return SpringRef", "Gets the X position spring.", false, false});
+        rec.record_method("Transform", {"ySpring", "---@param self Transform\n---@return SpringRef", "Gets the Y position spring.", false, false});
+        rec.record_method("Transform", {"wSpring", "---@param self Transform\n---@return SpringRef", "Gets the width spring.", false, false});
+        rec.record_method("Transform", {"hSpring", "---@param self Transform\n---@return SpringRef", "Gets the height spring.", false, false});
+        rec.record_method("Transform", {"rSpring", "---@param self Transform\n---@return SpringRef", "Gets the rotation spring.", false, false});
+        rec.record_method("Transform", {"sSpring", "---@param self Transform\n---@return SpringRef", "Gets the scale spring.", false, false});
         rec.record_method("Transform", {"hoverBufferX", "---@param self Transform\n---@return number", "Gets the X-axis hover buffer.", false, false});
         rec.record_method("Transform", {"hoverBufferY", "---@param self Transform\n---@return number", "Gets the Y-axis hover buffer.", false, false});
 
@@ -2633,7 +2853,7 @@ auto exposeToLua(sol::state &lua, EngineContext* /*ctx*/) -> void {
     lua.new_usertype<InheritedProperties>("InheritedProperties",
         sol::constructors<>(),
         "role_type",       &InheritedProperties::role_type,
-        "master",          &InheritedProperties::master,
+        "master",          sol::readonly(&InheritedProperties::master), // reparent with AssignRole
         "offset",          &InheritedProperties::offset,
         "prevOffset",      &InheritedProperties::prevOffset,
         "location_bond",   &InheritedProperties::location_bond,
@@ -2667,7 +2887,7 @@ auto exposeToLua(sol::state &lua, EngineContext* /*ctx*/) -> void {
     auto& ipDef = rec.add_type("InheritedProperties", /*is_data_class=*/true);
     ipDef.doc = "Defines how an entity inherits transform properties from a master entity.";
     rec.record_property("InheritedProperties", {"role_type", "InheritedPropertiesType", "The role of this entity in the hierarchy."});
-    rec.record_property("InheritedProperties", {"master", "Entity", "The master entity this entity inherits from."});
+    rec.record_property("InheritedProperties", {"master", "Entity", "The master entity this entity inherits from. Read-only; use transform.AssignRole to change it."});
     rec.record_property("InheritedProperties", {"offset", "Vector2", "The current offset from the master."});
     rec.record_property("InheritedProperties", {"prevOffset", "Vector2", "The previous frame's offset."});
     rec.record_property("InheritedProperties", {"location_bond", "InheritedPropertiesSync|nil", "The sync bond for location."});
@@ -3005,6 +3225,19 @@ auto exposeToLua(sol::state &lua, EngineContext* /*ctx*/) -> void {
         false}
     );
 
+    // --- mark_dirty ---
+    transform_tbl.set_function("mark_dirty", [](entt::entity e) {
+        MarkTransformDirty(e);
+    });
+    rec.record_free_function(
+        {"transform"},
+        {"mark_dirty",
+        "---@param e Entity\n---@return nil",
+        "Makes the next transform update visit e and its slaves. Only needed with dirty-only transform updates, after changing role offsets, alignment, displacement or the update callback of an existing entity directly.",
+        true,
+        false}
+    );
+
     // --- set_space ---
     transform_tbl.set_function("set_space", [](entt::entity e, const std::string& space, sol::optional<bool> /*convert*/) {
         if (space == "screen") {
@@ -3046,8 +3279,6 @@ auto exposeToLua(sol::state &lua, EngineContext* /*ctx*/) -> void {
     transform_tbl.set_function("CreateGameWorldContainerEntity", &transform::CreateGameWorldContainerEntity);
     rec.record_free_function({"transform"}, {"CreateGameWorldContainerEntity", "---@param registry registry\n---@param x number\n---@param y number\n---@param w number\n---@param h number\n---@return Entity", "Creates a root container entity for the game world.", true, false});
 
-    transform_tbl.set_function("UpdateTransformSmoothingFactors", &transform::UpdateTransformSmoothingFactors);
-    rec.record_free_function({"transform"}, {"UpdateTransformSmoothingFactors", "---@param registry registry\n---@param e Entity\n---@param dt number\n---@return nil", "Updates spring smoothing factors for a transform.", true, false});
     
     transform_tbl.set_function("InjectDynamicMotion", 
         [](entt::entity e, float amount, float rotationAmount) {
@@ -3359,7 +3590,6 @@ auto exposeToLua(sol::state &lua, EngineContext* /*ctx*/) -> void {
         // lua.set_function("CreateGameWorldContainerEntity", &transform::CreateGameWorldContainerEntity);
 
         // // 3) Per‐entity updates & alignment
-        // lua.set_function("UpdateTransformSmoothingFactors", &transform::UpdateTransformSmoothingFactors);
         // lua.set_function("AlignToMaster",                   &transform::AlignToMaster);
         // lua.set_function("MoveWithMaster",                  &transform::MoveWithMaster);
         // lua.set_function("UpdateLocation",                  &transform::UpdateLocation);
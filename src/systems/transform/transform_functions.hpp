@@ -19,77 +19,125 @@ namespace transform
         transform::registerDestroyListeners(globals::getRegistry());
     }
 
-    extern std::unordered_map<TransformMethod, std::any> transformFunctionsDefault, hooksToCallBeforeDefault, hooksToCallAfterDefault;
+    // The default implementation of every method, indexed by TransformMethod.
+    extern std::array<TransformMethodDefault, kTransformMethodCount> transformFunctionsDefault;
     
     //TODO: use this as public interface?
     //TODO: apply this within transform class, also hide the implementation details from public 
     /**
-     * @brief Executes a registered transform function for a given entity, while also invoking 
+     * @brief Executes a transform method for a given entity, while also invoking 
      *        any registered "before" and "after" hooks.
      * 
      * @tparam Ret The return type of the function (typically `void` in this case).
      * @tparam Args The argument types expected by the transform method.
      * @param registry Reference to the EnTT registry containing entity-component data.
-     * @param e The entity whose transform function is being executed.
+     * @param e The entity whose transform function is being executed (entt::null uses the global hooks).
      * @param method The transformation method to execute (e.g., `TransformMethod::UpdateTransform`).
      * @param args The arguments to be passed to the function (typically `dt` for delta time).
      * 
      * @note The function:
-     *       - Ensures the requested method exists in `transformFunctions`.
-     *       - Calls any registered "before" hooks.
-     *       - Calls the actual transform function.
-     *       - Calls any registered "after" hooks.
+     *       - Tests the method's bit in the entity's `transformHookMask`; if it is clear
+     *         (the common case) the default is called directly and nothing is looked up.
+     *       - Otherwise calls the "before" hook, the replacement (or the default), then
+     *         the "after" hook, from the hook table for `Ret(Args...)`.
      * 
-     * @warning If the requested function is not found in `transformFunctions`, an assertion failure occurs.
+     * @warning `Ret(Args...)` must be the exact signature the method was registered with;
+     *          a mismatch is an assertion failure.
      * 
      * @example
      * ```
-     * ExecuteCallsForTransformMethod<void>(registry, entity, TransformMethod::UpdateTransform, 0.16f);
+     * // UpdateAllTransforms is registered as void(entt::registry *, float)
+     * ExecuteCallsForTransformMethod<void>(registry, entt::null, TransformMethod::UpdateAllTransforms, &registry, dt);
+     *
+     * // Args are deduced by value, so reference parameters are spelled out
+     * ExecuteCallsForTransformMethod<void, entt::entity, float, Transform &, InheritedProperties &, GameObject &>(
+     *     registry, e, TransformMethod::UpdateTransform, e, dt, transform, role, node);
      * ```
      */
     template <typename Ret, typename... Args>
     inline auto ExecuteCallsForTransformMethod(entt::registry& registry, entt::entity e, TransformMethod method, Args... args) -> void {
 
-        // if e is null, use the default definitions for the methods (some methods don't work for a specific entity)
-        std::unordered_map<TransformMethod, std::any>* transformFunctions, * hooksToCallBefore, * hooksToCallAfter;
+        // if e is null, use the global hooks (some methods don't work for a specific entity)
+        const bool hasEntity = registry.valid(e);
+        const uint64_t mask = hasEntity ? registry.get<GameObject>(e).transformHookMask : transformHookMaskDefault;
+        const auto &fallback = transformFunctionsDefault[static_cast<size_t>(method)];
 
-        if (registry.valid(e)) {
-            auto &gameObject = registry.get<GameObject>(e);
-            transformFunctions = &gameObject.transformFunctions;
-            hooksToCallBefore = &gameObject.hooksToCallBefore;
-            hooksToCallAfter = &gameObject.hooksToCallAfter;
-        }
-        else {
-            transformFunctions = &transformFunctionsDefault;
-            hooksToCallBefore = &hooksToCallBeforeDefault;
-            hooksToCallAfter = &hooksToCallAfterDefault;
+        if (!(mask & TransformMethodBit(method))) [[likely]] {
+            AssertThat(fallback.signature == TransformSignatureTag<Ret(Args...)>(), Is().EqualTo(true));
+            fallback.call<Ret>(args...);
+            return;
         }
 
-        // Ensure the default method exists
-        AssertThat(transformFunctions->find(method) != transformFunctions->end(), Is().EqualTo(true));
+        const auto *hooks = detail::TransformHookTable<Ret(Args...)>::get().find(
+            hasEntity ? &registry : nullptr, hasEntity ? e : static_cast<entt::entity>(entt::null), method);
 
         // Call before hooks
-        if (hooksToCallBefore->find(method) != hooksToCallBefore->end()) {
-            auto &hook = hooksToCallBefore->at(method);
-            auto castHook = std::any_cast<std::function<Ret(Args...)>>(hook);
-            castHook(args...);
+        if (hooks && hooks->before) hooks->before(args...);
+
+        // Call the replacement, or the default method
+        if (hooks && hooks->replace) {
+            hooks->replace(args...);
+        } else {
+            AssertThat(fallback.signature == TransformSignatureTag<Ret(Args...)>(), Is().EqualTo(true));
+            fallback.call<Ret>(args...);
         }
 
-        // Call the default method
-        auto &func = transformFunctions->at(method);
-        auto castFunc = std::any_cast<std::function<Ret(Args...)>>(func);
-        castFunc(args...);
-
         // Call after hooks
-        if (hooksToCallAfter->find(method) != hooksToCallAfter->end()) {
-            auto &hook = hooksToCallAfter->at(method);
-            auto castHook = std::any_cast<std::function<Ret(Args...)>>(hook);
-            castHook(args...);
+        if (hooks && hooks->after) hooks->after(args...);
+    }
+
+    /**
+     * Registers a hook for one stage of `method` on entity e (entt::null for the
+     * global hooks) and sets the method's bit in its mask. `Fn` must be the
+     * signature ExecuteCallsForTransformMethod is called with, e.g.
+     * `SetTransformHook<void(entt::registry *, float)>(...)`. An empty function
+     * removes that stage; the bit stays set until ClearTransformHooks.
+     */
+    template <typename Fn>
+    inline auto SetTransformHook(entt::registry &registry, entt::entity e, TransformMethod method, TransformHookStage stage, std::function<Fn> fn) -> void {
+        const bool hasEntity = registry.valid(e);
+        auto &hooks = detail::TransformHookTable<Fn>::get().findOrAdd(
+            hasEntity ? &registry : nullptr, hasEntity ? e : static_cast<entt::entity>(entt::null), method);
+
+        switch (stage) {
+        case TransformHookStage::Before: hooks.before = std::move(fn); break;
+        case TransformHookStage::Replace: hooks.replace = std::move(fn); break;
+        case TransformHookStage::After: hooks.after = std::move(fn); break;
         }
+
+        uint64_t &mask = hasEntity ? registry.get<GameObject>(e).transformHookMask : transformHookMaskDefault;
+        mask |= TransformMethodBit(method);
+    }
+
+    // Removes every hook of e (entt::null: the global ones) and clears its mask.
+    inline auto ClearTransformHooks(entt::registry &registry, entt::entity e) -> void {
+        const bool hasEntity = registry.valid(e);
+        EraseTransformHooks(hasEntity ? &registry : nullptr, hasEntity ? e : static_cast<entt::entity>(entt::null));
+        (hasEntity ? registry.get<GameObject>(e).transformHookMask : transformHookMaskDefault) = 0;
     }
 
 
+    /**
+     * Update every active transform, masters before their slaves. Transforms are
+     * walked one hierarchy depth at a time (see TransformDepthIndex) and each
+     * depth runs as parallel jobs; GameObject update callbacks run on the main
+     * thread once their depth is done.
+     */
     auto UpdateAllTransforms(entt::registry *registry, float dt) -> void;
+
+    /**
+     * Dirty-only updates: UpdateAllTransforms visits only transforms whose springs
+     * changed, whose role changed, whose master moved, or that were marked, and
+     * skips clean subtrees (including their matrices). Off by default
+     * ("performance.transform_dirty_updates").
+     *
+     * Code that changes other inputs of an existing transform directly (role
+     * offsets, alignment flags, layer or scroll displacement, the update
+     * callback) must call MarkTransformDirty, which marks e and its slaves.
+     */
+    void SetDirtyOnlyTransformUpdates(bool enabled);
+    bool DirtyOnlyTransformUpdates();
+    void MarkTransformDirty(entt::entity e);
     
     auto handleDefaultTransformDrag(entt::registry *registry, entt::entity e, std::optional<Vector2> offset = std::nullopt) -> void;
 
@@ -101,11 +149,6 @@ namespace transform
 
     auto CreateGameWorldContainerEntity(entt::registry *registry, float x, float y, float w, float h) -> entt::entity;
 
-    /**
-     * This method should be called every frame for a transform/node entity
-     */
-    auto UpdateTransformSmoothingFactors(entt::registry *registry, entt::entity e, float dt) -> void;
-
     /**
      * Align a child entity to its parent based on alignment and offset properties.
      */
@@ -120,23 +163,23 @@ namespace transform
     /**
      * Update X and Y springs for smooth transformations.
      */
-    auto UpdateLocation(entt::entity e, float dt, Transform &transform, spring::Spring &springX, spring::Spring &springY) -> void;
+    auto UpdateLocation(entt::entity e, float dt, Transform &transform, spring::SpringRef springX, spring::SpringRef springY) -> void;
 
     /**
      * Update width and height springs for smooth size transformations.
      */
-    auto UpdateSize(entt::entity e, float dt, Transform &transform, spring::Spring &springW, spring::Spring springH) -> void;
+    auto UpdateSize(entt::entity e, float dt, Transform &transform, spring::SpringRef springW, spring::SpringRef springH) -> void;
 
     /**
      * Update rotation spring for smooth rotation transformations.
      */
-    auto UpdateRotation(entt::entity e, float dt, Transform &transform, spring::Spring &springR, spring::Spring &springX) -> void;
+    auto UpdateRotation(entt::entity e, float dt, Transform &transform, spring::SpringRef springR, spring::SpringRef springX) -> void;
 
 
     /**
      * Update scale spring for smooth scaling transformations.
      */
-    auto UpdateScale(entt::entity e, float dt, Transform &transform, spring::Spring &springS) -> void;
+    auto UpdateScale(entt::entity e, float dt, Transform &transform, spring::SpringRef springS) -> void;
 
     /**
      * Retrieve the parent entity of the given entity.
@@ -191,7 +234,7 @@ namespace transform
      */
     auto SnapVisualTransformValues(entt::registry *registry, entt::entity e) -> void;
     
-    SpringCacheBundle& getSpringBundleCached(entt::entity e, Transform &t) ;
+    SpringCacheBundle getSpringBundleCached(entt::entity e, Transform &t) ;
 
     /**
      * Draw the bounding rectangle of an entity for debugging purposes.
@@ -0,0 +1,245 @@
+#include "transform_hierarchy.hpp"
+
+#include <algorithm>
+
+namespace transform {
+
+TransformDepthIndex::Node *TransformDepthIndex::find(Id e) {
+    if (e == kNone) return nullptr;
+    const size_t index = e & kSlotMask;
+    if (index >= nodes_.size() || nodes_[index].id != e) return nullptr;
+    return &nodes_[index];
+}
+
+const TransformDepthIndex::Node *TransformDepthIndex::find(Id e) const {
+    return const_cast<TransformDepthIndex *>(this)->find(e);
+}
+
+TransformDepthIndex::Node &TransformDepthIndex::nodeFor(Id e) {
+    const size_t index = e & kSlotMask;
+    if (index >= nodes_.size()) nodes_.resize(index + 1);
+    return nodes_[index];
+}
+
+void TransformDepthIndex::insert(Id e) {
+    if (e == kNone || contains(e)) return;
+
+    Node &node = nodeFor(e);
+    // a stale node from an older version of this entity slot
+    if (node.id != kNone) erase(node.id);
+
+    node = Node{};
+    node.id = e;
+    place(node, 0);
+    ++size_;
+    markDirty(e);
+
+    const auto it = waiting_.find(e);
+    if (it == waiting_.end()) return;
+    const std::vector<Id> slaves = std::move(it->second);
+    waiting_.erase(it);
+    for (Id slave : slaves) {
+        const Node *waiting = find(slave);
+        if (waiting && !waiting->linked && waiting->master == e) setMaster(slave, e);
+    }
+}
+
+void TransformDepthIndex::erase(Id e) {
+    Node *node = find(e);
+    if (!node) return;
+
+    stopWaiting(*node);
+    unlink(*node);
+    for (Id child : node->children) {
+        Node &slave = *find(child);
+        slave.linked = false;
+        moveSubtree(slave, 0);
+        markDirty(child);
+        markSlavesDirty(child);
+    }
+    removeFromLevel(*node);
+    *node = Node{};
+    --size_;
+}
+
+void TransformDepthIndex::setMaster(Id e, Id master) {
+    if (e == kNone) return;
+    insert(e); // may grow nodes_, so look nodes up afterwards
+
+    Node &node = *find(e);
+    stopWaiting(node);
+    unlink(node);
+    node.master = master;
+
+    Node *parent = master != e ? find(master) : nullptr;
+    if (parent && isInSubtreeOf(master, e)) parent = nullptr; // would form a cycle
+
+    if (parent) {
+        node.linked = true;
+        node.childSlot = static_cast<uint32_t>(parent->children.size());
+        parent->children.push_back(e);
+    } else if (master != kNone && master != e && !contains(master)) {
+        waiting_[master].push_back(e);
+    }
+    moveSubtree(node, parent ? parent->depth + 1 : 0);
+
+    markDirty(e);
+    markSlavesDirty(e);
+}
+
+void TransformDepthIndex::markDirty(Id e) {
+    Node *node = find(e);
+    if (!node || node->dirty) return;
+    node->dirty = true;
+    if (dirtyLevels_.size() <= node->depth) dirtyLevels_.resize(node->depth + 1);
+    dirtyLevels_[node->depth].push_back(e);
+}
+
+void TransformDepthIndex::markSlavesDirty(Id e) {
+    const Node *root = find(e);
+    if (!root) return;
+
+    scratch_.assign(root->children.begin(), root->children.end());
+    while (!scratch_.empty()) {
+        const Id id = scratch_.back();
+        scratch_.pop_back();
+        markDirty(id);
+        const Node &node = *find(id);
+        scratch_.insert(scratch_.end(), node.children.begin(), node.children.end());
+    }
+}
+
+void TransformDepthIndex::markAllDirty() {
+    for (const auto &level : levels_)
+        for (Id e : level) markDirty(e);
+}
+
+bool TransformDepthIndex::dirty(Id e) const {
+    const Node *node = find(e);
+    return node && node->dirty;
+}
+
+void TransformDepthIndex::takeDirty(size_t depth, std::vector<Id> &out) {
+    out.clear();
+    if (depth >= dirtyLevels_.size()) return;
+
+    for (Id e : dirtyLevels_[depth]) {
+        Node *node = find(e);
+        // skip ids that were erased, or re-bucketed (they were queued again)
+        if (!node || !node->dirty || node->depth != depth) continue;
+        node->dirty = false;
+        out.push_back(e);
+    }
+    dirtyLevels_[depth].clear();
+}
+
+void TransformDepthIndex::clearDirty() {
+    for (auto &level : dirtyLevels_) {
+        for (Id e : level)
+            if (Node *node = find(e)) node->dirty = false;
+        level.clear();
+    }
+}
+
+TransformDepthIndex::Id TransformDepthIndex::master(Id e) const {
+    const Node *node = find(e);
+    return node ? node->master : kNone;
+}
+
+bool TransformDepthIndex::linked(Id e) const {
+    const Node *node = find(e);
+    return node && node->linked;
+}
+
+uint32_t TransformDepthIndex::depth(Id e) const {
+    const Node *node = find(e);
+    return node ? node->depth : 0;
+}
+
+void TransformDepthIndex::clear() {
+    nodes_.clear();
+    levels_.clear();
+    dirtyLevels_.clear();
+    waiting_.clear();
+    size_ = 0;
+}
+
+void TransformDepthIndex::unlink(Node &node) {
+    if (!node.linked) return;
+
+    auto &siblings = find(node.master)->children;
+    const Id last = siblings.back();
+    siblings[node.childSlot] = last;
+    find(last)->childSlot = node.childSlot;
+    siblings.pop_back();
+    node.linked = false;
+}
+
+void TransformDepthIndex::stopWaiting(const Node &node) {
+    if (node.linked || node.master == kNone) return;
+    const auto it = waiting_.find(node.master);
+    if (it == waiting_.end()) return;
+
+    auto &slaves = it->second;
+    slaves.erase(std::remove(slaves.begin(), slaves.end(), node.id), slaves.end());
+    if (slaves.empty()) waiting_.erase(it);
+}
+
+void TransformDepthIndex::place(Node &node, uint32_t depth) {
+    if (levels_.size() <= depth) levels_.resize(depth + 1);
+    node.depth = depth;
+    node.slot = static_cast<uint32_t>(levels_[depth].size());
+    levels_[depth].push_back(node.id);
+
+    // keep the mark: queue it again where the node lives now
+    if (node.dirty) {
+        node.dirty = false;
+        markDirty(node.id);
+    }
+}
+
+void TransformDepthIndex::removeFromLevel(Node &node) {
+    auto &level = levels_[node.depth];
+    const Id last = level.back();
+    level[node.slot] = last;
+    find(last)->slot = node.slot;
+    level.pop_back();
+
+    while (!levels_.empty() && levels_.back().empty()) levels_.pop_back();
+}
+
+void TransformDepthIndex::moveSubtree(Node &root, uint32_t depth) {
+    // slaves are placed relative to their master, so if the root stays put
+    // the whole subtree does
+    if (root.depth == depth) return;
+
+    removeFromLevel(root);
+    place(root, depth);
+
+    scratch_.assign(root.children.begin(), root.children.end());
+    while (!scratch_.empty()) {
+        Node &node = *find(scratch_.back());
+        scratch_.pop_back();
+
+        removeFromLevel(node);
+        place(node, find(node.master)->depth + 1);
+        scratch_.insert(scratch_.end(), node.children.begin(), node.children.end());
+    }
+}
+
+bool TransformDepthIndex::isInSubtreeOf(Id candidate, Id root) const {
+    for (const Node *node = find(candidate); node; node = find(node->master)) {
+        if (node->id == root) return true;
+        if (!node->linked) return false;
+    }
+    return false;
+}
+
+TransformDepthIndex &GetTransformDepthIndex() {
+    // Never destroyed: destroy listeners still reach it while static
+    // registries are torn down at shutdown.
+    static TransformDepthIndex *index = new TransformDepthIndex();
+    return *index;
+}
+
+} // namespace transform
@@ -0,0 +1,99 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace transform {
+
+//------------------------------------------------------------
+// Transforms bucketed by their depth in the master hierarchy.
+//
+// Roots (and anything whose master is missing) are depth 0, their direct
+// slaves depth 1, and so on. Walking levels() in order therefore visits every
+// master before its slaves, and everything inside one level is independent,
+// which is what lets UpdateAllTransforms run a level as parallel jobs.
+//
+// The index is kept up to date incrementally: setMaster() moves one entity
+// and re-buckets its subtree, erase() turns its slaves into roots. A slave
+// whose master is not indexed yet waits for it and is linked when the master
+// is inserted. Nothing is rebuilt per frame.
+//
+// It also keeps a dirty list per level for updates that only visit what
+// changed. Marks survive re-bucketing, a new or re-parented entity is marked
+// along with its subtree, and takeDirty() hands out one level at a time so
+// slaves marked while a level is processed are picked up further down in the
+// same pass.
+//
+// Ids are entt::to_integral(entity), so the index has no EnTT dependency.
+// Main thread only.
+//------------------------------------------------------------
+class TransformDepthIndex {
+public:
+    using Id = uint32_t;
+    static constexpr Id kNone = 0xFFFFFFFFu;     // entt::null
+    static constexpr Id kSlotMask = 0x000FFFFFu; // entity part of an id (32-bit entt traits)
+
+    // Adds e as a root; no-op if it is already indexed.
+    void insert(Id e);
+    // Removes e. Its slaves keep `master() == e` but become unlinked roots.
+    void erase(Id e);
+    // Records e's master and moves e (and its subtree) to the matching depth.
+    // e is inserted if needed. A master that is kNone, e itself, not indexed,
+    // or one of e's own slaves leaves e unlinked at depth 0; one that is not
+    // indexed yet picks e up once it is inserted.
+    void setMaster(Id e, Id master);
+
+    bool contains(Id e) const { return find(e) != nullptr; }
+    Id master(Id e) const;    // as last passed to setMaster, kNone if unknown
+    bool linked(Id e) const;  // true if e sits under its master
+    uint32_t depth(Id e) const;
+
+    void markDirty(Id e);
+    void markSlavesDirty(Id e); // everything below e, not e itself
+    void markAllDirty();
+    bool dirty(Id e) const;
+    // Replaces `out` with the dirty ids at `depth` and clears their marks.
+    void takeDirty(size_t depth, std::vector<Id> &out);
+    // Drops every mark (for passes that visited everything anyway).
+    void clearDirty();
+
+    const std::vector<std::vector<Id>> &levels() const { return levels_; }
+    size_t size() const { return size_; }
+    void clear();
+
+private:
+    struct Node {
+        Id id = kNone;
+        Id master = kNone;
+        bool linked = false;
+        bool dirty = false;
+        uint32_t depth = 0;
+        uint32_t slot = 0;      // position in levels_[depth]
+        uint32_t childSlot = 0; // position in the master's children
+        std::vector<Id> children;
+    };
+
+    Node *find(Id e);
+    const Node *find(Id e) const;
+    Node &nodeFor(Id e);
+
+    void unlink(Node &node);
+    void stopWaiting(const Node &node); // drops node from its master's waiting list
+    void place(Node &node, uint32_t depth);
+    void moveSubtree(Node &root, uint32_t depth);
+    void removeFromLevel(Node &node);
+    bool isInSubtreeOf(Id candidate, Id root) const;
+
+    std::vector<Node> nodes_; // indexed by e & kSlotMask
+    std::vector<std::vector<Id>> levels_;
+    std::vector<std::vector<Id>> dirtyLevels_; // may hold stale ids; takeDirty() filters them
+    std::unordered_map<Id, std::vector<Id>> waiting_; // master not indexed yet -> its slaves
+    std::vector<Id> scratch_;
+    size_t size_ = 0;
+};
+
+// The index behind the global registry's transforms (main thread only).
+TransformDepthIndex &GetTransformDepthIndex();
+
+} // namespace transform
@@ -0,0 +1,148 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "entt/entt.hpp"
+
+namespace transform {
+
+enum class TransformMethod; // transform.hpp
+
+//------------------------------------------------------------
+// Overrides for transform methods (see ExecuteCallsForTransformMethod).
+//
+// Almost no entity overrides anything, so the common path must not look
+// anything up: each GameObject carries a bitmask with one bit per
+// TransformMethod that has a hook, and a clear bit means "call the default".
+// The hooks themselves live in one flat table per signature, sorted by
+// (registry, entity, method), so calling one needs no type erasure beyond
+// the std::function itself.
+//
+// Hooks registered for entt::null (registry == nullptr in the table) are
+// the global ones, used when a method is executed without an entity.
+//------------------------------------------------------------
+
+enum class TransformHookStage : uint8_t {
+    Before,  // runs before the method
+    Replace, // runs instead of the default
+    After    // runs after the method
+};
+
+constexpr uint64_t TransformMethodBit(TransformMethod method) {
+    return uint64_t{1} << static_cast<unsigned>(method);
+}
+
+// Identifies a signature without RTTI; one address per Fn across the program.
+template <typename Fn>
+inline const void *TransformSignatureTag() {
+    static const char tag = 0;
+    return &tag;
+}
+
+// A default transform method: a plain function pointer plus its signature,
+// which callers are checked against before the pointer is cast back.
+struct TransformMethodDefault {
+    void (*fn)() = nullptr;
+    const void *signature = nullptr;
+
+    TransformMethodDefault() = default;
+
+    template <typename Ret, typename... Args>
+    TransformMethodDefault(Ret (*f)(Args...))
+        : fn(reinterpret_cast<void (*)()>(f)), signature(TransformSignatureTag<Ret(Args...)>()) {}
+
+    template <typename Ret, typename... Args>
+    Ret call(Args... args) const {
+        return reinterpret_cast<Ret (*)(Args...)>(fn)(args...);
+    }
+};
+
+namespace detail {
+
+// One per signature table, so an entity's hooks can be dropped without
+// knowing which signatures it used.
+using TransformHookEraser = void (*)(const entt::registry *, entt::entity);
+
+inline std::vector<TransformHookEraser> &TransformHookErasers() {
+    static std::vector<TransformHookEraser> erasers;
+    return erasers;
+}
+
+template <typename Fn>
+class TransformHookTable {
+public:
+    struct Entry {
+        const entt::registry *registry = nullptr;
+        entt::entity entity = entt::null;
+        TransformMethod method{};
+        std::function<Fn> before, replace, after;
+    };
+
+    static TransformHookTable &get() {
+        static TransformHookTable table;
+        return table;
+    }
+
+    const Entry *find(const entt::registry *registry, entt::entity e, TransformMethod method) const {
+        auto it = lowerBound(entries_, registry, e, method);
+        return it != entries_.end() && matches(*it, registry, e, method) ? &*it : nullptr;
+    }
+
+    Entry &findOrAdd(const entt::registry *registry, entt::entity e, TransformMethod method) {
+        auto it = lowerBound(entries_, registry, e, method);
+        if (it == entries_.end() || !matches(*it, registry, e, method))
+            it = entries_.insert(it, Entry{registry, e, method, {}, {}, {}});
+        return *it;
+    }
+
+    void erase(const entt::registry *registry, entt::entity e) {
+        std::erase_if(entries_, [&](const Entry &entry) {
+            return entry.registry == registry && entry.entity == e;
+        });
+    }
+
+    size_t size() const { return entries_.size(); }
+
+private:
+    TransformHookTable() {
+        TransformHookErasers().push_back([](const entt::registry *registry, entt::entity e) {
+            get().erase(registry, e);
+        });
+    }
+
+    static bool less(const Entry &entry, const entt::registry *registry, entt::entity e, TransformMethod method) {
+        if (entry.registry != registry) return std::less<const entt::registry *>{}(entry.registry, registry);
+        if (entry.entity != e) return entt::to_integral(entry.entity) < entt::to_integral(e);
+        return entry.method < method;
+    }
+
+    static bool matches(const Entry &entry, const entt::registry *registry, entt::entity e, TransformMethod method) {
+        return entry.registry == registry && entry.entity == e && entry.method == method;
+    }
+
+    // works for both the const and the mutable vector
+    template <typename Entries>
+    static auto lowerBound(Entries &entries, const entt::registry *registry, entt::entity e, TransformMethod method) {
+        return std::lower_bound(entries.begin(), entries.end(), 0, [&](const Entry &entry, int) {
+            return less(entry, registry, e, method);
+        });
+    }
+
+    std::vector<Entry> entries_;
+};
+
+} // namespace detail
+
+// Bits of the methods hooked globally (for calls without an entity).
+inline uint64_t transformHookMaskDefault = 0;
+
+// Drops every hook of e (or the global hooks for entt::null) in all tables.
+// Does not touch the owner's bitmask.
+inline void EraseTransformHooks(const entt::registry *registry, entt::entity e) {
+    for (auto eraser : detail::TransformHookErasers()) eraser(registry, e);
+}
+
+} // namespace transform
@@ -358,15 +358,15 @@ namespace ui
         if (!boxTransform || !rootTransform) return;
 
         // Access springs directly to avoid extra cache work unless a sync is needed.
-        auto &boxX = boxTransform->getXSpring();
-        auto &boxY = boxTransform->getYSpring();
-        auto &boxW = boxTransform->getWSpring();
-        auto &boxH = boxTransform->getHSpring();
+        auto boxX = boxTransform->getXSpring();
+        auto boxY = boxTransform->getYSpring();
+        auto boxW = boxTransform->getWSpring();
+        auto boxH = boxTransform->getHSpring();
 
-        auto &rootX = rootTransform->getXSpring();
-        auto &rootY = rootTransform->getYSpring();
-        auto &rootW = rootTransform->getWSpring();
-        auto &rootH = rootTransform->getHSpring();
+        auto rootX = rootTransform->getXSpring();
+        auto rootY = rootTransform->getYSpring();
+        auto rootW = rootTransform->getWSpring();
+        auto rootH = rootTransform->getHSpring();
 
         const float boxActualX = boxX.targetValue;
         const float boxActualY = boxY.targetValue;
@@ -2143,18 +2143,8 @@ node.state.collisionEnabled = true; // enable collision for scroll pane
         auto toggleSprings = [&](entt::entity e) {
             if (!registry.valid(e)) return;
             if (auto t = registry.try_get<transform::Transform>(e)) {
-                auto tryEnableSpring = [&](entt::entity springEnt) {
-                    if (registry.valid(springEnt)) {
-                        if (auto spring = registry.try_get<Spring>(springEnt))
-                            spring->enabled = enabled;
-                    }
-                };
-                tryEnableSpring(t->x);
-                tryEnableSpring(t->y);
-                tryEnableSpring(t->w);
-                tryEnableSpring(t->h);
-                tryEnableSpring(t->r);
-                tryEnableSpring(t->s);
+                for (auto &spring : t->springs)
+                    spring.ref().enabled = enabled;
             }
         };
 
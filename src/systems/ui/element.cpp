@@ -1338,6 +1338,7 @@ namespace ui
         {
             ApplyHover(registry, entity);
             elementNode->state.isBeingHovered = true;
+            transform::MarkTransformDirty(entity); // hover scale
         }
         if (!objectNode->state.isBeingHovered && elementNode->state.isBeingHovered)
         {
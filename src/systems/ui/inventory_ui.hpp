@@ -60,7 +60,7 @@ namespace ui {
             // auto itemEntity = transform::CreateOrEmplace(&registry, globals::gameWorldContainerEntity, 0, 0, cellW, cellH);
             
             auto itemEntity = animation_system::createAnimatedObjectWithTransform(random_utils::random_element(itemTypes), 0, 0);
-            auto entityTransform = registry.get<transform::Transform>(itemEntity);
+            auto &entityTransform = registry.get<transform::Transform>(itemEntity);
             entityTransform.setActualW(cellW);
             entityTransform.setActualH(cellH);
             
@@ -86,6 +86,10 @@ void PerfTracker::record_frame(int frame_number, float sim_ms, float render_ms)
     timing.frame_number = frame_number;
     timing.sim_ms = sim_ms;
     timing.render_ms = render_ms;
+    timing.lua_heap_kb = pending_lua_heap_kb_;
+    timing.lua_gc_ms = pending_lua_gc_ms_;
+    pending_lua_heap_kb_ = 0.0f;
+    pending_lua_gc_ms_ = 0.0f;
     frames_.push_back(timing);
     last_frame_number_ = frame_number;
 
@@ -98,11 +102,20 @@ void PerfTracker::record_frame(int frame_number, float sim_ms, float render_ms)
         event.phase = "X";
         event.timestamp_us = trace_time_us_;
         event.duration_us = static_cast<int64_t>((sim_ms + render_ms) * 1000.0f);
+        if (timing.lua_heap_kb > 0.0f) {
+            event.args["lua_heap_kb"] = std::to_string(timing.lua_heap_kb);
+            event.args["lua_gc_ms"] = std::to_string(timing.lua_gc_ms);
+        }
         trace_time_us_ += event.duration_us;
         trace_events_.push_back(event);
     }
 }
 
+void PerfTracker::record_lua_gc(float heap_kb, float gc_ms) {
+    pending_lua_heap_kb_ = heap_kb;
+    pending_lua_gc_ms_ = gc_ms;
+}
+
 void PerfTracker::load_budgets(const std::filesystem::path& budget_file) {
     budgets_.clear();
 
@@ -291,6 +304,8 @@ void PerfTracker::clear() {
     marks_.clear();
     next_token_ = 1;
     last_frame_number_ = 0;
+    pending_lua_heap_kb_ = 0.0f;
+    pending_lua_gc_ms_ = 0.0f;
     trace_time_us_ = 0;
     test_start_index_.reset();
     test_end_index_.reset();
@@ -325,6 +340,9 @@ PerfMetrics PerfTracker::compute_metrics(size_t start_index, size_t end_index) c
         if (total > max_frame) {
             max_frame = total;
         }
+        metrics.peak_lua_heap_kb = std::max(metrics.peak_lua_heap_kb, frame.lua_heap_kb);
+        metrics.total_lua_gc_ms += frame.lua_gc_ms;
+        metrics.max_lua_gc_ms = std::max(metrics.max_lua_gc_ms, frame.lua_gc_ms);
     }
 
     metrics.total_sim_ms = total_sim;
@@ -27,6 +27,9 @@ struct PerfMetrics {
     float asset_load_ms = 0.0f;
     size_t peak_rss_bytes = 0;
     size_t alloc_count = 0;
+    float peak_lua_heap_kb = 0.0f;
+    float total_lua_gc_ms = 0.0f;
+    float max_lua_gc_ms = 0.0f; // worst single-frame GC pause
 };
 
 struct BudgetDef {
@@ -60,6 +63,8 @@ struct FrameTiming {
     int frame_number = 0;
     float sim_ms = 0.0f;
     float render_ms = 0.0f;
+    float lua_heap_kb = 0.0f;
+    float lua_gc_ms = 0.0f;
 };
 
 class PerfTracker {
@@ -69,6 +74,8 @@ public:
     PerfToken mark();
     PerfMetrics get_metrics_since(PerfToken token) const;
     void record_frame(int frame_number, float sim_ms, float render_ms);
+    // Lua heap size and GC time for the frame recorded next.
+    void record_lua_gc(float heap_kb, float gc_ms);
 
     void load_budgets(const std::filesystem::path& budget_file);
     void set_budgets(const std::map<std::string, BudgetDef>& budgets);
@@ -103,6 +110,8 @@ private:
     std::map<int, size_t> marks_;
     int next_token_ = 1;
     int last_frame_number_ = 0;
+    float pending_lua_heap_kb_ = 0.0f;
+    float pending_lua_gc_ms_ = 0.0f;
     int64_t trace_time_us_ = 0;
     std::optional<size_t> test_start_index_;
     std::optional<size_t> test_end_index_;
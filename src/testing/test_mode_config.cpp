@@ -904,6 +904,14 @@ bool parse_test_mode_args(int argc, char** argv, TestModeConfig& out, std::strin
             out.perf_trace_path = std::filesystem::path(value);
             continue;
         }
+        if (flag == "--lua-profile") {
+            std::string value;
+            if (!take_value(i, argc, argv, inline_value, value, err, flag)) {
+                return false;
+            }
+            out.lua_profile_path = std::filesystem::path(value);
+            continue;
+        }
 
         err = "Unknown flag: " + flag + "\n" + test_mode_usage();
         return false;
@@ -1093,6 +1101,11 @@ bool validate_and_finalize(TestModeConfig& config, std::string& err) {
             return false;
         }
     }
+    if (config.lua_profile_path.has_value()) {
+        if (!validate_path(*config.lua_profile_path, out_root, "--lua-profile")) {
+            return false;
+        }
+    }
     if (config.test_script.has_value()) {
         if (!validate_input_path(std::filesystem::path(*config.test_script), "--test-script", false)) {
             return false;
@@ -1127,6 +1140,9 @@ bool validate_and_finalize(TestModeConfig& config, std::string& err) {
     if (config.perf_trace_path.has_value()) {
         config.perf_trace_path = resolve_path(root, *config.perf_trace_path);
     }
+    if (config.lua_profile_path.has_value()) {
+        config.lua_profile_path = resolve_path(root, *config.lua_profile_path);
+    }
     if (config.test_script.has_value()) {
         config.test_script = resolve_path(root, *config.test_script).string();
     }
@@ -1164,6 +1180,11 @@ bool validate_and_finalize(TestModeConfig& config, std::string& err) {
             return false;
         }
     }
+    if (config.lua_profile_path.has_value()) {
+        if (!ensure_parent_dir(*config.lua_profile_path, err)) {
+            return false;
+        }
+    }
 
     return true;
 }
@@ -129,6 +129,7 @@ struct TestModeConfig {
     PerfMode perf_mode = PerfMode::Off;
     std::optional<std::filesystem::path> perf_budget_path;
     std::optional<std::filesystem::path> perf_trace_path;
+    std::optional<std::filesystem::path> lua_profile_path; // folded stacks; the Chrome trace goes next to it
 
     std::filesystem::path artifacts_dir;
     std::filesystem::path report_json_path;
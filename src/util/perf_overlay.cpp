@@ -2,18 +2,15 @@
 #include "../third_party/rlImGui/imgui.h"
 #include "../systems/layer/layer_optimized.hpp"
 #include "../systems/main_loop_enhancement/main_loop.hpp"
+#include "../systems/particles/particle_governor.hpp"
 #include "../systems/scripting/binding_recorder.hpp"
+#include "../systems/scripting/lua_gc_pacer.hpp"
 #include "../core/globals.hpp"
 #include "raylib.h"
 
 #include <algorithm>
 #include <numeric>
 
-// Forward declarations
-namespace ai_system {
-    extern sol::state masterStateLua;
-}
-
 namespace perf_overlay {
 
 // Global state
@@ -52,25 +49,20 @@ void update(entt::registry& registry) {
     // Entity count from registry
     g_currentMetrics.entityCount = static_cast<int>(registry.storage<entt::entity>().in_use());
 
-    // Lua memory (via collectgarbage("count")) - with proper state validation
-    if (ai_system::masterStateLua.lua_state() != nullptr) {
-        try {
-            sol::protected_function_result result = ai_system::masterStateLua.script("return collectgarbage('count')");
-            if (result.valid()) {
-                g_currentMetrics.luaMemoryKB = result.get<float>();
-            } else {
-                g_currentMetrics.luaMemoryKB = 0.0f;
-            }
-        } catch (const std::exception& e) {
-            // Log once per session, not every frame
-            static bool logged = false;
-            if (!logged) {
-                SPDLOG_WARN("perf_overlay: Lua memory query failed: {}", e.what());
-                logged = true;
-            }
-            g_currentMetrics.luaMemoryKB = 0.0f;
-        }
-    }
+    // Pooled particles, as counted by the governor last frame
+    const auto& particles = particle::GetParticleGovernor().lastFrame();
+    g_currentMetrics.particlesLive = static_cast<int>(particles.live);
+    g_currentMetrics.particlesSpawned = static_cast<int>(particles.spawned);
+    g_currentMetrics.particlesThrottled = static_cast<int>(particles.throttled);
+    g_currentMetrics.particlesCulled = static_cast<int>(particles.culled);
+    g_currentMetrics.particleBudgetUsed = particles.pressure;
+
+    // Lua heap and GC work, as left by the GC pacer at the end of last frame
+    const auto& gc = scripting::lua_gc_pacer().lastFrame();
+    g_currentMetrics.luaMemoryKB = gc.heapKB;
+    g_currentMetrics.luaGcStepMs = gc.stepMs;
+    g_currentMetrics.luaGcWorstPauseMs = scripting::lua_gc_pacer().worstPauseMs();
+    g_currentMetrics.luaGcPressure = gc.pressure;
 }
 
 void render() {
@@ -154,6 +146,21 @@ void render() {
             ImGui::Text("Entities: %d", g_currentMetrics.entityCount);
         }
 
+        // Particle budget
+        if (g_config.showParticles) {
+            float used = g_currentMetrics.particleBudgetUsed;
+            ImVec4 budgetColor = used < 0.5f ? ImVec4(0.2f, 1.0f, 0.2f, 1.0f) :
+                                 used < 0.9f ? ImVec4(1.0f, 1.0f, 0.2f, 1.0f) :
+                                               ImVec4(1.0f, 0.3f, 0.3f, 1.0f);
+            ImGui::TextColored(budgetColor, "Particles: %d (%.0f%% budget)",
+                               g_currentMetrics.particlesLive, used * 100.0f);
+            ImGui::Indent(10);
+            ImGui::Text("Spawned: %d", g_currentMetrics.particlesSpawned);
+            ImGui::Text("Throttled: %d | Culled: %d",
+                        g_currentMetrics.particlesThrottled, g_currentMetrics.particlesCulled);
+            ImGui::Unindent(10);
+        }
+
         // Memory
         if (g_config.showMemory) {
             float memMB = g_currentMetrics.luaMemoryKB / 1024.0f;
@@ -161,6 +168,12 @@ void render() {
                               memMB < 100 ? ImVec4(1.0f, 1.0f, 0.2f, 1.0f) :
                                             ImVec4(1.0f, 0.3f, 0.3f, 1.0f);
             ImGui::TextColored(memColor, "Lua Mem: %.2f MB", memMB);
+            ImGui::Indent(10);
+            ImGui::Text("GC: %.2fms | Worst: %.2fms", g_currentMetrics.luaGcStepMs,
+                        g_currentMetrics.luaGcWorstPauseMs);
+            if (g_currentMetrics.luaGcPressure > 0.0f)
+                ImGui::Text("GC pressure: %.0f%%", g_currentMetrics.luaGcPressure * 100.0f);
+            ImGui::Unindent(10);
         }
 
         ImGui::Separator();
@@ -235,8 +248,16 @@ void exposeToLua(sol::state& lua) {
         t["draw_calls_ui"] = g_currentMetrics.drawCallsUI;
         t["draw_calls_state"] = g_currentMetrics.drawCallsState;
         t["entity_count"] = g_currentMetrics.entityCount;
+        t["particles_live"] = g_currentMetrics.particlesLive;
+        t["particles_spawned"] = g_currentMetrics.particlesSpawned;
+        t["particles_throttled"] = g_currentMetrics.particlesThrottled;
+        t["particles_culled"] = g_currentMetrics.particlesCulled;
+        t["particle_budget_used"] = g_currentMetrics.particleBudgetUsed;
         t["lua_memory_kb"] = g_currentMetrics.luaMemoryKB;
         t["lua_memory_mb"] = g_currentMetrics.luaMemoryKB / 1024.0f;
+        t["lua_gc_step_ms"] = g_currentMetrics.luaGcStepMs;
+        t["lua_gc_worst_pause_ms"] = g_currentMetrics.luaGcWorstPauseMs;
+        t["lua_gc_pressure"] = g_currentMetrics.luaGcPressure;
         return t;
     };
 
@@ -7,7 +7,8 @@
  * - FPS/Frame time with graph
  * - Draw call breakdown (sprites, text, shapes, UI, state changes)
  * - Entity count
- * - Lua memory usage
+ * - Lua memory usage and GC pacing
+ * - Particle budget (live / spawned / throttled / culled)
  * - Batch efficiency metrics
  *
  * Usage:
@@ -37,6 +38,7 @@ struct Config {
     bool showEntityCount = true;
     bool showMemory = true;
     bool showBatchStats = true;
+    bool showParticles = true;
     float opacity = 0.85f;
     int position = 0;  // 0=top-left, 1=top-right, 2=bottom-left, 3=bottom-right
 };
@@ -53,9 +55,17 @@ struct FrameMetrics {
     int drawCallsState = 0;
     int entityCount = 0;
     float luaMemoryKB = 0.0f;
+    float luaGcStepMs = 0.0f;        // GC work done by the pacer this frame
+    float luaGcWorstPauseMs = 0.0f;  // since the pacer's last reset
+    float luaGcPressure = 0.0f;      // 0 = within budget, 1 = cycle forced
     int stateChanges = 0;
     int shaderChanges = 0;
     int textureChanges = 0;
+    int particlesLive = 0;
+    int particlesSpawned = 0;
+    int particlesThrottled = 0;
+    int particlesCulled = 0;
+    float particleBudgetUsed = 0.0f;  // live / budget
 };
 
 // Frame time history for graph
@@ -1,7 +1,11 @@
 #include <gtest/gtest.h>
 #include "benchmark_common.hpp"
 
+#include "entt/entity/registry.hpp"
 #include "sol/sol.hpp"
+#include "systems/ai/ai_system.hpp"
+#include "systems/scripting/bulk_component_access.hpp"
+#include "systems/scripting/scripting_system.hpp"
 
 class LuaBoundaryBenchmark : public ::testing::Test {
 protected:
@@ -115,3 +119,123 @@ TEST_F(LuaBoundaryBenchmark, CallbackFromCpp) {
     benchmark::print_result("CallbackFromCpp (1k callbacks)", result);
     EXPECT_LT(result.mean_ms, 200.0) << "Baseline measurement";
 }
+
+// Test 5: BulkVersusPerEntityAccess - one bulk.read/bulk.write pair against a
+// registry lookup and two property round trips per entity
+TEST_F(LuaBoundaryBenchmark, BulkVersusPerEntityAccess) {
+    struct BenchTransform {
+        float x = 0, y = 0;
+    };
+
+    entt::registry registry;
+    std::vector<entt::entity> entities;
+    for (int i = 0; i < 1000; ++i) {
+        const auto e = registry.create();
+        registry.emplace<BenchTransform>(e, static_cast<float>(i), static_cast<float>(i));
+        entities.push_back(e);
+    }
+
+    using scripting::bulk::register_field;
+    register_field<BenchTransform>("bench_x", [](BenchTransform &t) { return t.x; },
+                                   [](BenchTransform &t, double v) { t.x = static_cast<float>(v); });
+    register_field<BenchTransform>("bench_y", [](BenchTransform &t) { return t.y; },
+                                   [](BenchTransform &t, double v) { t.y = static_cast<float>(v); });
+    scripting::bulk::exposeToLua(lua);
+
+    lua.new_usertype<BenchTransform>("BenchTransform",
+        "x", &BenchTransform::x,
+        "y", &BenchTransform::y
+    );
+    lua["registry"] = std::ref(registry);
+    lua["entity_list"] = sol::as_table(entities);
+    lua["get_transform"] = [&registry](entt::entity e) -> BenchTransform & {
+        return registry.get<BenchTransform>(e);
+    };
+
+    lua.script(R"(
+        function per_entity()
+            for _, e in ipairs(entity_list) do
+                local t = get_transform(e)
+                t.x = t.x + 1
+                t.y = t.y + 1
+            end
+        end
+
+        local q = bulk.query({ "bench_x", "bench_y" })
+        local out = {}
+        function bulk_access()
+            local n = bulk.read(registry, q, out)
+            local xs, ys = out.bench_x, out.bench_y
+            for i = 1, n do
+                xs[i] = xs[i] + 1
+                ys[i] = ys[i] + 1
+            end
+            bulk.write(registry, q, out, n)
+        end
+    )");
+
+    auto measure = [](sol::function fn) {
+        std::vector<double> times;
+        for (int i = 0; i < 100; ++i) {
+            benchmark::ScopedTimer timer(times);
+            fn();
+        }
+        return benchmark::analyze(times);
+    };
+    const auto perEntity = measure(lua["per_entity"]);
+    const auto bulk = measure(lua["bulk_access"]);
+
+    benchmark::print_result("PerEntityAccess (1k entities, 2 fields)", perEntity);
+    benchmark::print_result("BulkAccess (1k entities, 2 fields)", bulk);
+    std::cout << "  bulk speedup (median): " << perEntity.median_ms / bulk.median_ms << "x\n";
+
+    // both paths moved every entity by 200
+    EXPECT_FLOAT_EQ(registry.get<BenchTransform>(entities[7]).x, 207.0f);
+    EXPECT_LT(bulk.median_ms, perEntity.median_ms);
+}
+
+// Test 6: ScriptUpdateDispatch - script_system_update over 2k scripts, one
+// protected call from C++ per entity against one call into the batched driver
+TEST_F(LuaBoundaryBenchmark, PerEntityVersusBatchedScriptUpdates) {
+    // the dispatcher runs scripts in the master state
+    sol::state &master = ai_system::masterStateLua;
+    master = sol::state{};
+    master.open_libraries(sol::lib::base, sol::lib::math);
+    master.script(R"(
+        function make_script()
+            return { t = 0, update = function(self, dt) self.t = self.t + dt end }
+        end
+    )");
+
+    entt::registry registry;
+    std::vector<entt::entity> entities;
+    for (int i = 0; i < 2000; ++i) {
+        const auto e = registry.create();
+        registry.emplace<scripting::ScriptComponent>(e, master["make_script"]().get<sol::table>());
+        scripting::init_script(registry, e);
+        entities.push_back(e);
+    }
+
+    auto measure = [&](scripting::ScriptUpdateDispatch mode) {
+        scripting::set_script_update_dispatch(mode);
+        std::vector<double> times;
+        for (int i = 0; i < 100; ++i) {
+            benchmark::ScopedTimer timer(times);
+            scripting::script_system_update(registry, 0.5f);
+        }
+        return benchmark::analyze(times);
+    };
+    const auto perEntity = measure(scripting::ScriptUpdateDispatch::PerEntity);
+    const auto batched = measure(scripting::ScriptUpdateDispatch::Batched);
+    scripting::set_script_update_dispatch(scripting::ScriptUpdateDispatch::Off);
+
+    benchmark::print_result("PerEntityScriptUpdate (2k entities)", perEntity);
+    benchmark::print_result("BatchedScriptUpdate (2k entities)", batched);
+    std::cout << "  batched speedup (median): " << perEntity.median_ms / batched.median_ms << "x\n";
+
+    // both modes ran every update hook 100 times
+    const auto &script = registry.get<scripting::ScriptComponent>(entities[7]);
+    EXPECT_DOUBLE_EQ(script.self["t"].get<double>(), 100.0);
+
+    registry.clear(); // scripts before the state they live in
+}
@@ -3,6 +3,8 @@
 #include <entt/entt.hpp>
 #include <chrono>
 
+#include "systems/scripting/bulk_component_access.hpp"
+
 // Mock TestTransform component for testing (avoiding name collision with raylib)
 struct TestTransform {
     float actualX = 0.0f;
@@ -21,9 +23,8 @@ struct TestSprite {
 /**
  * Test fixture for bulk component access API
  *
- * This test establishes the structure for bulk access testing.
- * The actual implementation of bulk APIs requires deeper codebase analysis,
- * but this provides the framework for testing once implemented.
+ * Compares per-entity access with the bulk.query / bulk.read / bulk.write
+ * API from systems/scripting/bulk_component_access.hpp.
  */
 class BulkComponentAccessTest : public ::testing::Test {
 protected:
@@ -113,75 +114,133 @@ TEST_F(BulkComponentAccessTest, BatchIterationPattern) {
     EXPECT_EQ(transforms.size(), testEntities.size());
 }
 
-// Placeholder for actual bulk API test once implemented
-TEST_F(BulkComponentAccessTest, DISABLED_BulkGetReducesBoundaryCrossings) {
-    // This test will be enabled once the bulk API is implemented
-    //
-    // Expected API design (based on codebase patterns):
-    //
-    // C++ side:
-    //   sol::table get_components_batch(
-    //       entt::registry& reg,
-    //       const std::vector<entt::entity>& entities,
-    //       entt::id_type component_type
-    //   )
-    //
-    // Lua side:
-    //   local transforms = registry:get_batch(entity_list, TestTransform)
-    //   -- returns a table indexed by entity: { [entity] = component, ... }
-    //
-    // This should verify that:
-    // 1. A single bulk call is faster than N individual calls
-    // 2. Results are equivalent to individual calls
-    // 3. The API handles missing components gracefully (returns nil for that entity)
-
-    GTEST_SKIP() << "Enable after bulk API implementation in registry_bond.cpp";
+namespace {
+void registerTestFields() {
+    using scripting::bulk::register_field;
+    register_field<TestTransform>("actual_x", [](TestTransform &t) { return t.actualX; }, [](TestTransform &t, double v) { t.actualX = static_cast<float>(v); });
+    register_field<TestTransform>("actual_y", [](TestTransform &t) { return t.actualY; }, [](TestTransform &t, double v) { t.actualY = static_cast<float>(v); });
+    register_field<TestSprite>("alpha", [](TestSprite &s) { return s.alpha; }, [](TestSprite &s, double v) { s.alpha = static_cast<float>(v); });
+    register_field<TestSprite>("texture_id", [](TestSprite &s) { return s.textureId; }); // read-only
 }
+} // namespace
+
+TEST_F(BulkComponentAccessTest, BulkGetReducesBoundaryCrossings) {
+    registerTestFields();
+    scripting::bulk::exposeToLua(lua);
+
+    // One call fills every row; the values match per-entity access.
+    lua.script(R"(
+        q = bulk.query({ "actual_x", "actual_y" })
+        out = {}
+        n = bulk.read(registry, q, out)
+    )");
+    ASSERT_EQ(lua["n"].get<int>(), 100);
+
+    sol::table out = lua["out"];
+    sol::table entities = out["entities"];
+    sol::table xs = out["actual_x"];
+    for (int i = 1; i <= 100; ++i) {
+        const auto e = static_cast<entt::entity>(entities.get<std::uint32_t>(i));
+        EXPECT_FLOAT_EQ(xs.get<float>(i), registry.get<TestTransform>(e).actualX);
+    }
 
-// Placeholder for multi-component bulk access
-TEST_F(BulkComponentAccessTest, DISABLED_BulkGetMultipleComponentTypes) {
-    // This test will be enabled once multi-component bulk API is implemented
-    //
-    // Expected API design:
-    //
-    // C++ side:
-    //   sol::table get_components_multi(
-    //       entt::registry& reg,
-    //       const std::vector<entt::entity>& entities,
-    //       const std::vector<entt::id_type>& component_types
-    //   )
-    //
-    // Lua side:
-    //   local components = registry:get_batch_multi(entity_list, {TestTransform, TestSprite})
-    //   -- returns: { [entity] = { TestTransform = comp1, TestSprite = comp2 }, ... }
-    //
-    // This would be even more efficient for systems that need multiple component types
-
-    GTEST_SKIP() << "Enable after multi-component bulk API implementation";
+    // And back: one call writes every row.
+    lua.script(R"(
+        for i = 1, n do out.actual_x[i] = out.actual_x[i] + 5 end
+        written = bulk.write(registry, q, out, n)
+    )");
+    EXPECT_EQ(lua["written"].get<int>(), 100);
+    for (size_t i = 0; i < testEntities.size(); ++i) {
+        EXPECT_FLOAT_EQ(registry.get<TestTransform>(testEntities[i]).actualX, static_cast<float>(i * 10 + 5));
+    }
 }
 
-// Test the performance characteristics we want to achieve
-TEST_F(BulkComponentAccessTest, DISABLED_BulkAccessPerformanceBenefit) {
-    // This test will measure the actual performance improvement
-    // once the bulk API is implemented
-    //
-    // Test plan:
-    // 1. Time N individual registry:get() calls from Lua
-    // 2. Time a single registry:get_batch() call from Lua
-    // 3. Verify bulk is faster (should be ~10-50x improvement for 100+ entities)
-    // 4. Measure Lua/C++ boundary crossings (should be 1 vs N)
-
-    GTEST_SKIP() << "Enable after bulk API implementation for benchmarking";
+TEST_F(BulkComponentAccessTest, BulkGetMultipleComponentTypes) {
+    registerTestFields();
+    scripting::bulk::exposeToLua(lua);
+    for (size_t i = 0; i < testEntities.size(); i += 2) registry.remove<TestSprite>(testEntities[i]);
+
+    lua.script(R"(
+        q = bulk.query({ "actual_x", "alpha", "texture_id" })
+        out = {}
+        n = bulk.read(registry, q, out)
+        for i = 1, n do out.alpha[i] = 0.5; out.texture_id[i] = -1 end
+        bulk.write(registry, q, out, n)
+    )");
+    EXPECT_EQ(lua["n"].get<int>(), 50); // only entities with both components
+
+    for (size_t i = 1; i < testEntities.size(); i += 2) {
+        const auto &sprite = registry.get<TestSprite>(testEntities[i]);
+        EXPECT_FLOAT_EQ(sprite.alpha, 0.5f);
+        EXPECT_EQ(sprite.textureId, static_cast<int>(i)); // read-only field left alone
+    }
 }
 
-// Test edge cases for bulk access
-TEST_F(BulkComponentAccessTest, DISABLED_BulkAccessHandlesEdgeCases) {
-    // Edge cases to test once bulk API exists:
-    // 1. Empty entity list
-    // 2. Invalid entities in the list
-    // 3. Entities missing the requested component
-    // 4. Very large entity lists (1000+)
-    // 5. Requesting non-existent component type
+TEST_F(BulkComponentAccessTest, BulkAccessPerformanceBenefit) {
+    registerTestFields();
+    scripting::bulk::exposeToLua(lua);
+    for (int i = 0; i < 900; ++i) {
+        auto e = registry.create();
+        registry.emplace<TestTransform>(e);
+        testEntities.push_back(e);
+    }
+    lua["entity_list"] = sol::as_table(testEntities);
+    lua["get_transform"] = [this](entt::entity e) -> TestTransform & { return registry.get<TestTransform>(e); };
+
+    lua.script(R"(
+        function per_entity()
+            for _, e in ipairs(entity_list) do
+                local t = get_transform(e)
+                t.actualX = t.actualX + 1
+                t.actualY = t.actualY + 1
+            end
+        end
+        q = bulk.query({ "actual_x", "actual_y" })
+        out = {}
+        function batched()
+            local n = bulk.read(registry, q, out)
+            local xs, ys = out.actual_x, out.actual_y
+            for i = 1, n do xs[i] = xs[i] + 1; ys[i] = ys[i] + 1 end
+            bulk.write(registry, q, out, n)
+        end
+    )");
+
+    auto timeIt = [](sol::function fn) {
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < 20; ++i) fn();
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+    const double perEntity = timeIt(lua["per_entity"]);
+    const double batched = timeIt(lua["batched"]);
+    EXPECT_LT(batched, perEntity);
+    EXPECT_FLOAT_EQ(registry.get<TestTransform>(testEntities[1]).actualX, 10.0f + 40.0f);
+}
 
-    GTEST_SKIP() << "Enable after bulk API implementation";
+TEST_F(BulkComponentAccessTest, BulkAccessHandlesEdgeCases) {
+    registerTestFields();
+    scripting::bulk::exposeToLua(lua);
+
+    // Unknown fields are rejected when the query is compiled.
+    auto bad = lua.safe_script("bulk.query({ 'no_such_field' })", sol::script_pass_on_error);
+    EXPECT_FALSE(bad.valid());
+
+    // No entity has a component the query requires: zero rows.
+    struct Unused { int v; };
+    lua["unused_id"] = entt::type_hash<Unused>::value();
+    lua.script(R"(
+        empty = {}
+        n_empty = bulk.read(registry, bulk.query({ "actual_x" }, { unused_id }), empty)
+    )");
+    EXPECT_EQ(lua["n_empty"].get<int>(), 0);
+
+    // Rows whose entity was destroyed (or lost a component) are skipped on write.
+    lua.script(R"(
+        q = bulk.query({ "actual_x" })
+        out = {}
+        n = bulk.read(registry, q, out)
+    )");
+    registry.destroy(testEntities[0]);
+    registry.remove<TestTransform>(testEntities[1]);
+    lua.script("written = bulk.write(registry, q, out, n)");
+    EXPECT_EQ(lua["written"].get<int>(), 98);
 }
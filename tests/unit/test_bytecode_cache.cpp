@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "sol/sol.hpp"
+#include "systems/scripting/bytecode_cache.hpp"
+
+namespace fs = std::filesystem;
+namespace cache = scripting::bytecode_cache;
+
+class BytecodeCacheTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        const auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+        root = fs::temp_directory_path() / ("bytecode_cache_" + std::to_string(now));
+        scripts = root / "scripts";
+        dir = root / "cache";
+        fs::create_directories(scripts / "ai");
+        cache::configure(scripts, dir);
+        cache::reset_stats();
+    }
+
+    void TearDown() override {
+        cache::configure({}, {});
+        std::error_code ec;
+        fs::remove_all(root, ec);
+    }
+
+    void write(const fs::path &path, const std::string &text) {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << text;
+    }
+
+    int run(sol::state &lua, const fs::path &path) {
+        return cache::script_file(lua, path.string()).get<int>();
+    }
+
+    fs::path root, scripts, dir;
+};
+
+TEST_F(BytecodeCacheTest, SecondLoadComesFromCache) {
+    const fs::path file = scripts / "answer.lua";
+    write(file, "local t = {} for i = 1, 6 do t[i] = i end return t[6] * 7");
+
+    sol::state first;
+    EXPECT_EQ(run(first, file), 42);
+    EXPECT_EQ(cache::stats().compiled, 1u);
+    EXPECT_EQ(cache::stats().hits, 0u);
+
+    sol::state second;
+    EXPECT_EQ(run(second, file), 42);
+    EXPECT_EQ(cache::stats().hits, 1u);
+    EXPECT_EQ(cache::stats().compiled, 1u);
+}
+
+TEST_F(BytecodeCacheTest, ChangedSourceIsRecompiled) {
+    const fs::path file = scripts / "value.lua";
+    write(file, "return 1");
+    sol::state lua;
+    EXPECT_EQ(run(lua, file), 1);
+
+    write(file, "return 2");
+    EXPECT_EQ(run(lua, file), 2);
+    EXPECT_EQ(cache::stats().stale, 1u);
+    EXPECT_EQ(cache::stats().compiled, 2u);
+
+    EXPECT_EQ(run(lua, file), 2); // and the rewritten entry is used
+    EXPECT_EQ(cache::stats().hits, 1u);
+}
+
+TEST_F(BytecodeCacheTest, CorruptEntryFallsBackToSource) {
+    const fs::path file = scripts / "value.lua";
+    write(file, "return 3");
+    sol::state lua;
+    EXPECT_EQ(run(lua, file), 3);
+
+    for (const auto &entry : fs::directory_iterator(dir)) {
+        std::fstream f(entry.path(), std::ios::binary | std::ios::in | std::ios::out);
+        f.seekp(-4, std::ios::end);
+        f.write("\xff\xff\xff\xff", 4); // bytecode damaged, header intact
+    }
+    EXPECT_EQ(run(lua, file), 3);
+
+    for (const auto &entry : fs::directory_iterator(dir)) fs::resize_file(entry.path(), 6); // truncated header
+    EXPECT_EQ(run(lua, file), 3);
+    EXPECT_EQ(cache::stats().stale, 2u);
+}
+
+TEST_F(BytecodeCacheTest, ErrorsKeepTheSourcePath) {
+    const fs::path file = scripts / "broken.lua";
+    write(file, "#!/usr/bin/env lua\nlocal x = \nreturn");
+    sol::state lua;
+    try {
+        run(lua, file);
+        FAIL() << "expected a syntax error";
+    } catch (const sol::error &e) {
+        const std::string message = e.what();
+        EXPECT_NE(message.find("broken.lua:3"), std::string::npos) << message; // shebang line still counted
+    }
+    EXPECT_TRUE(fs::is_empty(dir));
+}
+
+TEST_F(BytecodeCacheTest, RequireGoesThroughTheCache) {
+    write(scripts / "ai" / "init.lua", "return { name = ... }");
+    for (int pass = 0; pass < 2; ++pass) {
+        sol::state lua;
+        lua.open_libraries(sol::lib::base, sol::lib::package);
+        lua["package"]["path"] = (scripts / "?.lua").generic_string() + ";" + (scripts / "?/init.lua").generic_string();
+        cache::install_searcher(lua);
+        EXPECT_EQ(lua.script("return require('ai').name").get<std::string>(), "ai");
+        EXPECT_FALSE(lua.safe_script("require('missing.module')", sol::script_pass_on_error).valid());
+    }
+    EXPECT_EQ(cache::stats().compiled, 1u);
+    EXPECT_EQ(cache::stats().hits, 1u);
+}
+
+TEST_F(BytecodeCacheTest, PrebakedEntriesAreFoundFromAnotherRoot) {
+    write(scripts / "ai" / "init.lua", "return 'baked'");
+    write(scripts / "bad.lua", "return (");
+
+    // Baked for an install of the tree at another location, named as it will be loaded there.
+    const fs::path installed = root / "installed" / "scripts";
+    std::vector<std::string> errors;
+    EXPECT_EQ(cache::prebake(scripts, dir, installed.generic_string() + "/", &errors), 1u);
+    ASSERT_EQ(errors.size(), 1u);
+    EXPECT_NE(errors[0].find("bad.lua"), std::string::npos);
+
+    fs::create_directories(installed.parent_path());
+    fs::copy(scripts, installed, fs::copy_options::recursive);
+    cache::configure(installed, dir);
+
+    sol::state lua;
+    const std::string path = (installed / "ai" / "init.lua").generic_string();
+    EXPECT_EQ(cache::script_file(lua, path).get<std::string>(), "baked");
+    EXPECT_EQ(cache::stats().hits, 1u);
+    EXPECT_EQ(cache::stats().compiled, 0u);
+}
+
+TEST_F(BytecodeCacheTest, EntriesBakedUnderAnotherNameAreStale) {
+    write(scripts / "where.lua", "return debug.getinfo(1, 'S').source");
+    write(scripts / "fails.lua", "\nerror('boom')");
+
+    // Baked under the bake machine's own paths, then loaded from an installed copy.
+    EXPECT_EQ(cache::prebake(scripts, dir, ""), 2u);
+    const fs::path installed = root / "installed" / "scripts";
+    fs::create_directories(installed.parent_path());
+    fs::copy(scripts, installed, fs::copy_options::recursive);
+    cache::configure(installed, dir);
+
+    sol::state lua;
+    lua.open_libraries(sol::lib::base, sol::lib::debug);
+    const std::string where = (installed / "where.lua").generic_string();
+    EXPECT_EQ(cache::script_file(lua, where).get<std::string>(), "@" + where);
+    try {
+        cache::script_file(lua, (installed / "fails.lua").generic_string());
+        FAIL() << "expected a runtime error";
+    } catch (const sol::error &e) {
+        const std::string message = e.what();
+        // long names are shortened from the front, so check the tail
+        EXPECT_NE(message.find("installed/scripts/fails.lua:2"), std::string::npos) << message;
+    }
+    EXPECT_EQ(cache::stats().stale, 2u);
+    EXPECT_EQ(cache::stats().hits, 0u);
+
+    // the rewritten entries carry the installed names and are used from then on
+    sol::state again;
+    again.open_libraries(sol::lib::base, sol::lib::debug);
+    EXPECT_EQ(cache::script_file(again, where).get<std::string>(), "@" + where);
+    EXPECT_EQ(cache::stats().hits, 1u);
+}
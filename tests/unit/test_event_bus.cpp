@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 #include <vector>
 #include <string>
+#include <algorithm>
+#include <type_traits>
 
 #include "core/event_bus.hpp"
 
@@ -101,3 +103,50 @@ TEST(EventBus, ExceptionsDoNotBlockOtherListeners) {
 
     EXPECT_TRUE(called);
 }
+
+namespace {
+struct OtherEvent : public event_bus::Event {
+    int value{};
+    OtherEvent() = default;
+    explicit OtherEvent(int v) : value(v) {}
+};
+
+struct StampedEvent : public event_bus::TimestampedEvent {};
+} // namespace
+
+TEST(EventBus, TypeIdsAreDenseAndStable) {
+    const auto a = event_bus::eventTypeId<SimpleEvent>();
+    const auto b = event_bus::eventTypeId<OtherEvent>();
+    EXPECT_NE(a, b);
+    EXPECT_EQ(a, event_bus::eventTypeId<SimpleEvent>());
+    EXPECT_LT(std::max(a, b), 64u); // small enough to index a vector
+    EXPECT_TRUE(std::is_trivially_copyable_v<OtherEvent>);
+
+    StampedEvent stamped;
+    EXPECT_NE(stamped.timestamp.time_since_epoch().count(), 0);
+}
+
+TEST(EventBus, DeferredEventsDrainPerTypeInBulk) {
+    event_bus::EventBus bus;
+    std::vector<std::string> calls;
+
+    bus.subscribe<SimpleEvent>([&](const SimpleEvent &ev) {
+        calls.push_back("simple:" + std::to_string(ev.value));
+        if (ev.value == 0) {
+            bus.publish(OtherEvent{1});
+            bus.publish(SimpleEvent{2});
+            bus.publish(OtherEvent{3});
+            bus.publish(SimpleEvent{4});
+        }
+    });
+    bus.subscribe<OtherEvent>([&](const OtherEvent &ev) {
+        calls.push_back("other:" + std::to_string(ev.value));
+        if (ev.value == 3) bus.publish(OtherEvent{5}); // chains into a later drain
+    });
+
+    bus.publish(SimpleEvent{0});
+
+    const std::vector<std::string> expected{"simple:0", "other:1", "other:3", "simple:2",
+                                            "simple:4", "other:5"};
+    EXPECT_EQ(calls, expected);
+}
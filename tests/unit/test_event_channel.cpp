@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "core/event_channel.hpp"
+
+namespace {
+struct HitEvent : public event_bus::Event {
+    int target{};
+    float amount{};
+    HitEvent() = default;
+    HitEvent(int t, float a) : target(t), amount(a) {}
+};
+
+std::vector<int> targets(const event_bus::EventChannel<HitEvent>::Batch &batch) {
+    std::vector<int> out;
+    batch.forEach([&](const HitEvent &e) { out.push_back(e.target); });
+    return out;
+}
+} // namespace
+
+TEST(EventChannel, EachReaderSeesEveryEventOnce) {
+    event_bus::EventChannel<HitEvent> channel;
+    auto early = channel.reader(); // reads before the producer each frame
+    auto late = channel.reader();  // reads after it
+
+    std::vector<int> earlySeen, lateSeen;
+    for (int frame = 0; frame < 3; ++frame) {
+        channel.swapBuffers();
+        for (int t : targets(channel.read(early))) earlySeen.push_back(t);
+        channel.push({frame * 10, 1.f});
+        channel.emplace(frame * 10 + 1, 2.f);
+        for (int t : targets(channel.read(late))) lateSeen.push_back(t);
+        EXPECT_TRUE(channel.read(late).empty()); // nothing new since the last read
+    }
+    channel.swapBuffers();
+    for (int t : targets(channel.read(early))) earlySeen.push_back(t);
+
+    const std::vector<int> all{0, 1, 10, 11, 20, 21};
+    EXPECT_EQ(earlySeen, all);
+    EXPECT_EQ(lateSeen, all);
+}
+
+TEST(EventChannel, OldEventsAgeOutAndNewReadersStartAtTheEnd) {
+    event_bus::EventChannel<HitEvent> channel;
+    auto stale = channel.reader();
+    channel.push({1, 0.f});
+    channel.swapBuffers();
+    channel.push({2, 0.f});
+    channel.swapBuffers(); // event 1 is gone
+    channel.push({3, 0.f});
+
+    EXPECT_EQ(channel.size(), 2u);
+    const auto batch = channel.read(stale);
+    EXPECT_EQ(batch.older.size(), 1u); // one contiguous span per buffer
+    EXPECT_EQ(targets(batch), (std::vector<int>{2, 3}));
+
+    auto fresh = channel.reader();
+    EXPECT_TRUE(channel.read(fresh).empty());
+    channel.clear();
+    EXPECT_EQ(channel.size(), 0u);
+}
+
+TEST(EventChannel, ChannelsAreLookedUpByEventType) {
+    event_bus::EventChannels channels;
+    auto reader = channels.channel<HitEvent>().reader();
+    channels.push(HitEvent{7, 0.5f});
+    channels.swapBuffers();
+
+    const auto batch = channels.channel<HitEvent>().read(reader);
+    ASSERT_EQ(batch.size(), 1u);
+    EXPECT_FLOAT_EQ(batch.older[0].amount, 0.5f);
+}
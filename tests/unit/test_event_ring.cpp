@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+
+#include "systems/timer/event_ring.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using timer::EventRing;
+
+namespace {
+
+struct Flags {
+    int id = 0;
+    bool remove = false;
+};
+
+template <typename Ring>
+std::vector<int> ids(const Ring &ring)
+{
+    std::vector<int> out;
+    for (size_t i = 0; i < ring.size(); ++i) out.push_back(ring.header(i).id);
+    return out;
+}
+
+} // namespace
+
+TEST(EventRing, PushesAtBothEndsAcrossGrowth) {
+    EventRing<Flags, std::string> ring;
+    for (int i = 0; i < 10; ++i) ring.push_back({i}, std::to_string(i));
+    for (int i = 1; i <= 10; ++i) ring.push_front({-i}, std::to_string(-i)); // wraps, then grows
+
+    ASSERT_EQ(ring.size(), 20u);
+    EXPECT_EQ(ring.capacity(), 32u);
+    for (size_t i = 0; i < ring.size(); ++i) {
+        const int id = static_cast<int>(i) - 10; // -10 .. -1, then 0 .. 9
+        EXPECT_EQ(ring.header(i).id, id) << i;
+        EXPECT_EQ(ring.payload(i), std::to_string(id)) << i;
+    }
+}
+
+TEST(EventRing, CompactsStablyAndReleasesPayloads) {
+    EventRing<Flags, std::shared_ptr<int>> ring;
+    auto tracked = std::make_shared<int>(7);
+    for (int i = 0; i < 12; ++i) ring.push_back({i, i % 3 == 0}, i == 3 ? tracked : std::make_shared<int>(i));
+    ring.push_front({-1}, nullptr); // the ring no longer starts at slot 0
+
+    EXPECT_EQ(tracked.use_count(), 2);
+    const size_t removed = ring.compact([](const Flags &f, const std::shared_ptr<int> &) { return f.remove; });
+    EXPECT_EQ(removed, 4u);
+    EXPECT_EQ(ids(ring), (std::vector<int>{-1, 1, 2, 4, 5, 7, 8, 10, 11}));
+    EXPECT_EQ(tracked.use_count(), 1); // dropped, not left in a stale slot
+    EXPECT_EQ(*ring.payload(3), 4);
+
+    // predicates may look at the payload too
+    ring.compact([](const Flags &, const std::shared_ptr<int> &p) { return !p; });
+    EXPECT_EQ(ids(ring).front(), 1);
+
+    ring.clear();
+    EXPECT_TRUE(ring.empty());
+    ring.push_back({42}, nullptr);
+    EXPECT_EQ(ids(ring), std::vector<int>{42});
+}
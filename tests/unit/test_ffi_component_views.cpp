@@ -0,0 +1,204 @@
+#include <gtest/gtest.h>
+
+#include <entt/entt.hpp>
+
+#include "components/graphics.hpp"
+#include "sol/sol.hpp"
+#include "systems/physics/physics_world.hpp"
+#include "systems/scripting/ffi_component_views.hpp"
+#include "systems/transform/transform.hpp"
+
+namespace ffi_views = scripting::ffi_views;
+
+namespace {
+
+uint32_t id(entt::entity e) {
+    return entt::to_integral(e);
+}
+
+} // namespace
+
+class FfiComponentViewsTest : public ::testing::Test {
+protected:
+    void SetUp() override { ffi_views::install(registry); }
+
+    void TearDown() override {
+        ffi_views::uninstall();
+        registry.clear();
+    }
+
+    entt::entity spawn() {
+        const auto e = registry.create();
+        registry.emplace<transform::Transform>(e);
+        registry.emplace<SpriteComponentASCII>(e);
+        return e;
+    }
+
+    entt::registry registry;
+    const ffi_views::Api &api = ffi_views::api();
+};
+
+TEST_F(FfiComponentViewsTest, TransformViewPointsAtThePooledSprings) {
+    const auto e = spawn();
+    auto &t = registry.get<transform::Transform>(e);
+    t.setActualX(5.f);
+
+    ffi_views::TransformView view{};
+    ASSERT_TRUE(api.bind_transform(&view, id(e)));
+    EXPECT_EQ(view.entity, id(e));
+    EXPECT_EQ(view.epoch, ffi_views::epoch());
+    EXPECT_FLOAT_EQ(*view.x.target, 5.f);
+
+    EXPECT_FLOAT_EQ(t.getActualY(), 0.f); // caches this frame's values
+    *view.y.target = 12.f;
+    *view.w.value = 40.f;
+    EXPECT_FLOAT_EQ(t.getYSpring().targetValue, 12.f);
+
+    ffi_views::flush();
+    EXPECT_FLOAT_EQ(t.getActualY(), 12.f);
+    EXPECT_FLOAT_EQ(t.getVisualW(), 40.f);
+}
+
+TEST_F(FfiComponentViewsTest, SpriteViewWritesTheComponentColors) {
+    const auto e = spawn();
+
+    ffi_views::SpriteView view{};
+    ASSERT_TRUE(api.bind_sprite(&view, id(e)));
+    view.fg->a = 10;
+    view.bg->r = 200;
+
+    const auto &sprite = registry.get<SpriteComponentASCII>(e);
+    EXPECT_EQ(sprite.fgColor.a, 10);
+    EXPECT_EQ(sprite.bgColor.r, 200);
+}
+
+TEST_F(FfiComponentViewsTest, RecycledIdsAndMissingComponentsAreRefused) {
+    const auto old = spawn();
+    registry.destroy(old);
+    const auto reused = registry.create(); // same index, next version
+    ASSERT_EQ(entt::to_entity(reused), entt::to_entity(old));
+
+    ffi_views::TransformView view{};
+    view.epoch = 7;
+    EXPECT_FALSE(api.bind_transform(&view, id(old)));
+    EXPECT_EQ(view.epoch, 0u);
+    EXPECT_EQ(view.x.value, nullptr);
+    EXPECT_FALSE(api.bind_transform(&view, id(reused)));
+
+    ffi_views::SpriteView sprite{};
+    EXPECT_FALSE(api.bind_sprite(&sprite, id(old)));
+    ffi_views::BodyState body{};
+    EXPECT_FALSE(api.read_body(&body, id(reused)));
+}
+
+TEST_F(FfiComponentViewsTest, EpochMovesOnRemovalsOnly) {
+    const auto a = spawn();
+    const auto b = spawn();
+    const uint32_t before = ffi_views::epoch();
+    EXPECT_NE(before, 0u);
+
+    spawn();
+    EXPECT_EQ(ffi_views::epoch(), before);
+
+    registry.remove<SpriteComponentASCII>(a); // views of a's sprite now lead to a hole
+    const uint32_t afterSprite = ffi_views::epoch();
+    EXPECT_NE(afterSprite, before);
+
+    registry.destroy(b);
+    EXPECT_NE(ffi_views::epoch(), afterSprite);
+}
+
+TEST_F(FfiComponentViewsTest, ViewsStayOnTheirEntityWhileOthersAreRemoved) {
+    const auto a = spawn();
+    const auto b = spawn();
+    const auto last = spawn(); // what a swap-remove would move into a's slot
+
+    ffi_views::TransformView lastTransform{};
+    ffi_views::SpriteView lastSprite{};
+    ASSERT_TRUE(api.bind_transform(&lastTransform, id(last)));
+    ASSERT_TRUE(api.bind_sprite(&lastSprite, id(last)));
+    ffi_views::TransformView aTransform{};
+    ASSERT_TRUE(api.bind_transform(&aTransform, id(a)));
+
+    registry.destroy(a);
+    registry.remove<SpriteComponentASCII>(b);
+    const auto spawned = spawn(); // must not get a's springs this update
+
+    *lastTransform.x.target = 33.f;
+    lastSprite.fg->r = 7;
+    *aTransform.x.target = 99.f; // a dead lane; reaches nobody
+
+    ffi_views::flush();
+    EXPECT_FLOAT_EQ(registry.get<transform::Transform>(last).getActualX(), 33.f);
+    EXPECT_EQ(registry.get<SpriteComponentASCII>(last).fgColor.r, 7);
+    EXPECT_FLOAT_EQ(registry.get<transform::Transform>(spawned).getActualX(), 0.f);
+    EXPECT_FLOAT_EQ(registry.get<transform::Transform>(b).getActualX(), 0.f);
+}
+
+TEST_F(FfiComponentViewsTest, BodyStateIsCopiedThroughChipmunk) {
+    const auto e = registry.create();
+    std::shared_ptr<cpBody> body(cpBodyNew(1.0, 1.0), cpBodyFree);
+    cpBodySetPosition(body.get(), cpv(3.0, 4.0));
+    registry.emplace<physics::ColliderComponent>(e, body, nullptr, "default");
+
+    ffi_views::BodyState state{};
+    ASSERT_TRUE(api.read_body(&state, id(e)));
+    EXPECT_DOUBLE_EQ(state.x, 3.0);
+    EXPECT_DOUBLE_EQ(state.y, 4.0);
+
+    state.vx = -2.0;
+    state.angle = 0.5;
+    ASSERT_TRUE(api.write_body(&state, id(e)));
+    EXPECT_DOUBLE_EQ(cpBodyGetVelocity(body.get()).x, -2.0);
+    EXPECT_DOUBLE_EQ(cpBodyGetAngle(body.get()), 0.5);
+}
+
+#if defined(SOL_LUAJIT) && SOL_LUAJIT
+TEST_F(FfiComponentViewsTest, LuaReadsAndWritesThroughViews) {
+    sol::state lua;
+    lua.open_libraries(sol::lib::base, sol::lib::package, sol::lib::ffi, sol::lib::jit);
+    ffi_views::exposeToLua(lua);
+    ASSERT_TRUE(lua["ecs_ffi"].valid());
+
+    std::vector<entt::entity> entities;
+    sol::table ids = lua.create_table();
+    for (int i = 0; i < 64; ++i) {
+        entities.push_back(spawn());
+        registry.get<transform::Transform>(entities.back()).setActualX(static_cast<float>(i));
+        ids[i + 1] = id(entities.back());
+    }
+    lua["ids"] = ids;
+
+    // Enough iterations for the loop to be compiled.
+    lua.script(R"(
+        local view
+        for pass = 1, 100 do
+          for i = 1, #ids do
+            view = ecs_ffi.transform(ids[i], view)
+            view.x.target[0] = view.x.target[0] + 1
+          end
+        end
+        local s = ecs_ffi.sprite(ids[1])
+        s.fg.g = 77
+        kept = ecs_ffi.transform(ids[2])
+    )");
+
+    ffi_views::flush();
+    for (size_t i = 0; i < entities.size(); ++i) {
+        EXPECT_FLOAT_EQ(registry.get<transform::Transform>(entities[i]).getActualX(), static_cast<float>(i) + 100.f);
+    }
+    EXPECT_EQ(registry.get<SpriteComponentASCII>(entities[0]).fgColor.g, 77);
+
+    EXPECT_TRUE(lua.script("return ecs_ffi.valid(kept)").get<bool>());
+    registry.destroy(entities[5]);
+    EXPECT_FALSE(lua.script("return ecs_ffi.valid(kept)").get<bool>());
+    EXPECT_TRUE(lua.script("return ecs_ffi.transform(ids[6]) == nil").get<bool>());
+}
+#else
+TEST_F(FfiComponentViewsTest, LuaTableNeedsLuaJit) {
+    sol::state lua;
+    lua.open_libraries(sol::lib::base, sol::lib::package);
+    ffi_views::exposeToLua(lua);
+    EXPECT_FALSE(lua["ecs_ffi"].valid());
+}
+#endif
@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <fstream>
+
+#include "systems/file_watch/file_watch.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+void writeFile(const fs::path &path, const std::string &content) {
+    std::ofstream(path) << content;
+}
+
+class FileWatchTest : public ::testing::TestWithParam<bool> {
+protected:
+    void SetUp() override {
+        const auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+        root = fs::temp_directory_path() / ("file_watch_" + std::to_string(now));
+        fs::create_directories(root / "scripts" / "ai");
+        fs::create_directories(root / "shaders");
+        writeFile(root / "scripts" / "ai" / "brain.lua", "return {}");
+        writeFile(root / "shaders" / "glow.fs", "void main() {}");
+
+        file_watch::WatchConfig config;
+        config.settleSeconds = 0.05;
+        config.pollSeconds = 0.0;
+        config.forcePolling = GetParam();
+        watcher = std::make_unique<file_watch::Watcher>(config);
+        ASSERT_TRUE(watcher->watchTree(root));
+    }
+
+    void TearDown() override {
+        watcher.reset();
+        std::error_code ec;
+        fs::remove_all(root, ec);
+    }
+
+    // Polling compares write times, which may not tick between quick writes.
+    void touch(const fs::path &path, const std::string &content) {
+        writeFile(path, content);
+        if (GetParam()) fs::last_write_time(path, fs::last_write_time(path) + std::chrono::seconds(++bumps));
+    }
+
+    fs::path root;
+    std::unique_ptr<file_watch::Watcher> watcher;
+    int bumps = 0;
+};
+
+} // namespace
+
+TEST_P(FileWatchTest, DeliversSettledChangesToMatchingSubscribers) {
+    std::vector<file_watch::Paths> luaBatches;
+    std::vector<file_watch::Paths> shaderBatches;
+    watcher->subscribe(root / "scripts", {".lua"}, [&](const file_watch::Paths &p) { luaBatches.push_back(p); });
+    watcher->subscribe(root / "shaders", {}, [&](const file_watch::Paths &p) { shaderBatches.push_back(p); });
+
+    touch(root / "scripts" / "ai" / "brain.lua", "return { v = 2 }");
+    writeFile(root / "scripts" / "notes.txt", "not lua");
+
+    watcher->update(1.0);
+    EXPECT_TRUE(luaBatches.empty()); // not settled yet
+    watcher->update(1.1);
+
+    ASSERT_EQ(luaBatches.size(), 1u);
+    ASSERT_EQ(luaBatches[0].size(), 1u);
+    EXPECT_EQ(luaBatches[0][0], (root / "scripts" / "ai" / "brain.lua").lexically_normal());
+    EXPECT_TRUE(shaderBatches.empty());
+    EXPECT_EQ(watcher->pendingCount(), 0u);
+
+    watcher->update(2.0);
+    EXPECT_EQ(luaBatches.size(), 1u); // nothing new
+}
+
+TEST_P(FileWatchTest, CoalescesBurstsIntoOneEntry) {
+    std::vector<file_watch::Paths> batches;
+    watcher->subscribe(root, {".fs"}, [&](const file_watch::Paths &p) { batches.push_back(p); });
+
+    const fs::path shader = root / "shaders" / "glow.fs";
+    touch(shader, "a");
+    watcher->update(1.0);
+    touch(shader, "b");
+    watcher->update(1.03); // still inside the settle window of the first write
+    touch(shader, "c");
+    watcher->update(1.06);
+    EXPECT_TRUE(batches.empty());
+
+    watcher->update(1.2);
+    ASSERT_EQ(batches.size(), 1u);
+    EXPECT_EQ(batches[0].size(), 1u);
+}
+
+TEST_P(FileWatchTest, PicksUpNewDirectories) {
+    std::vector<fs::path> seen;
+    watcher->subscribe(root, {".json"}, [&](const file_watch::Paths &p) { seen.insert(seen.end(), p.begin(), p.end()); });
+
+    fs::create_directories(root / "data" / "levels");
+    watcher->update(1.0);
+    touch(root / "data" / "levels" / "one.json", "{}");
+    watcher->update(1.5);
+    watcher->update(2.0);
+
+    ASSERT_EQ(seen.size(), 1u);
+    EXPECT_EQ(seen[0].filename(), "one.json");
+}
+
+TEST_P(FileWatchTest, IgnoredTreesAreNotDelivered) {
+    fs::create_directories(root / "cache" / "lua_bytecode");
+    fs::create_directories(root / "cache2");
+    watcher->ignoreTree(root / "cache"); // after watchTree(), as the game's order may be
+    std::vector<fs::path> seen;
+    watcher->subscribe(root, {}, [&](const file_watch::Paths &p) { seen.insert(seen.end(), p.begin(), p.end()); });
+
+    touch(root / "cache" / "lua_bytecode" / "0123.luac", "bytecode");
+    touch(root / "cache" / "lua_bytecode" / "0123.luac.tmp", "bytecode");
+    fs::create_directories(root / "cache" / "fresh");
+    watcher->update(1.0);
+    touch(root / "cache" / "fresh" / "entry.luac", "bytecode");
+    touch(root / "cache2" / "kept.json", "{}");
+    watcher->update(1.5);
+    watcher->update(2.0);
+
+    ASSERT_EQ(seen.size(), 1u);
+    EXPECT_EQ(seen[0].filename(), "kept.json");
+}
+
+TEST_P(FileWatchTest, UnsubscribedCallbacksAreNotCalled) {
+    int calls = 0;
+    const auto id = watcher->subscribe(root, {}, [&](const file_watch::Paths &) { ++calls; });
+    watcher->unsubscribe(id);
+
+    touch(root / "shaders" / "glow.fs", "changed");
+    watcher->update(1.0);
+    watcher->update(2.0);
+    EXPECT_EQ(calls, 0);
+}
+
+INSTANTIATE_TEST_SUITE_P(Backends, FileWatchTest, ::testing::Values(false, true),
+                         [](const ::testing::TestParamInfo<bool> &info) {
+                             return info.param ? std::string("Polling") : std::string("Native");
+                         });
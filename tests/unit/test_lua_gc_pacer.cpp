@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include "sol/sol.hpp"
+#include "systems/scripting/lua_gc_pacer.hpp"
+
+using scripting::LuaGcPacer;
+
+class LuaGcPacerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        lua.open_libraries(sol::lib::base, sol::lib::string, sol::lib::table);
+        pacer.config.minBaseKB = 64.0f;
+        L = lua.lua_state();
+    }
+
+    // Allocates about `kb` of garbage (a table of strings that is then dropped).
+    void churn(int kb) {
+        lua.script("local t = {} for i = 1, " + std::to_string(kb) +
+                   " do t[i] = string.rep('x', 1000) .. i end t = nil");
+    }
+
+    float heapKB() const { return static_cast<float>(lua_gc(L, LUA_GCCOUNT, 0)); }
+
+    sol::state lua;
+    lua_State *L = nullptr;
+    LuaGcPacer pacer;
+};
+
+TEST_F(LuaGcPacerTest, AllocationNoLongerTriggersCollection) {
+    pacer.step(L, 0.0);
+    EXPECT_EQ(lua_gc(L, LUA_GCISRUNNING, 0), 0);
+
+    const float before = heapKB();
+    churn(8000);
+    EXPECT_GT(heapKB() - before, 7000.0f); // nothing was reclaimed behind the pacer's back
+    EXPECT_EQ(lua_gc(L, LUA_GCISRUNNING, 0), 0);
+}
+
+TEST_F(LuaGcPacerTest, StepsStayWithinTheSlackAndCompleteCycles) {
+    pacer.config.hardRatio = 1000.0f; // never forced here
+    pacer.config.softRatio = 999.0f;
+    pacer.step(L, 0.0);
+    while (pacer.cycles() == 0) pacer.step(L, 100.0); // the cycle started on adoption
+    churn(8000);
+    const float grown = heapKB();
+
+    for (int frame = 0; frame < 4000 && pacer.cycles() < 2; ++frame) {
+        pacer.step(L, 1.0);
+        // One increment can overshoot a little; the budget is half the slack.
+        EXPECT_LT(pacer.lastFrame().stepMs, 5.0f);
+    }
+    ASSERT_EQ(pacer.cycles(), 2u);
+    EXPECT_LT(heapKB(), grown / 2.0f);
+    EXPECT_FALSE(pacer.lastFrame().cycleRunning);
+    EXPECT_EQ(lua_gc(L, LUA_GCISRUNNING, 0), 0);
+}
+
+TEST_F(LuaGcPacerTest, IdleBetweenCyclesUntilTheHeapGrows) {
+    pacer.step(L, 0.0);
+    while (pacer.cycles() == 0) pacer.step(L, 100.0); // settle the baseline
+
+    pacer.step(L, 100.0);
+    EXPECT_EQ(pacer.lastFrame().steps, 0u); // below pauseRatio: no work at all
+    EXPECT_EQ(pacer.lastFrame().stepMs, 0.0f);
+}
+
+TEST_F(LuaGcPacerTest, HardLimitFinishesTheCycleWithoutSlack) {
+    pacer.step(L, 0.0);
+    while (pacer.cycles() == 0) pacer.step(L, 100.0);
+    const auto cycles = pacer.cycles();
+
+    churn(static_cast<int>(pacer.lastFrame().baseKB * pacer.config.hardRatio) + 1000);
+    pacer.step(L, 0.0); // a frame with no slack at all
+    EXPECT_EQ(pacer.cycles(), cycles + 1);
+    EXPECT_FLOAT_EQ(pacer.lastFrame().pressure, 1.0f);
+    EXPECT_GE(pacer.worstPauseMs(), pacer.lastFrame().stepMs);
+}
+
+TEST_F(LuaGcPacerTest, DisablingHandsCollectionBackToLua) {
+    pacer.endFrame(L, 16.0);
+    EXPECT_EQ(lua_gc(L, LUA_GCISRUNNING, 0), 0);
+
+    pacer.config.enabled = false;
+    pacer.endFrame(L, 16.0);
+    EXPECT_NE(lua_gc(L, LUA_GCISRUNNING, 0), 0);
+    EXPECT_GT(pacer.lastFrame().heapKB, 0.0f);
+
+    // A replaced state is taken over on its first frame.
+    pacer.config.enabled = true;
+    sol::state other;
+    pacer.endFrame(other.lua_state(), 16.0);
+    EXPECT_EQ(lua_gc(other.lua_state(), LUA_GCISRUNNING, 0), 0);
+}
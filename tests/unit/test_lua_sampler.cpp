@@ -0,0 +1,211 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <sstream>
+
+#include "nlohmann/json.hpp"
+#include "sol/sol.hpp"
+#include "systems/scripting/lua_sampler.hpp"
+
+using lua_profiler::SampleMode;
+using lua_profiler::Sampler;
+using lua_profiler::SamplerConfig;
+
+namespace {
+
+constexpr const char* kScript = R"(local function hot(n)
+  local s = 0
+  for i = 1, n do s = s + i % 7 end
+  return s
+end
+local function deep(d)
+  if d == 0 then return hot(20000) end
+  return deep(d - 1) + 0
+end
+function run(n) local s = hot(n) return s end
+function run_deep(d) local s = deep(d) return s end
+)";
+
+SamplerConfig instructions(int interval = 1000) {
+    SamplerConfig config;
+    config.mode = SampleMode::Instructions;
+    config.instruction_interval = interval;
+    return config;
+}
+
+uint64_t folded_total(const std::string& folded) {
+    uint64_t total = 0;
+    std::istringstream in(folded);
+    for (std::string line; std::getline(in, line);) {
+        total += std::stoull(line.substr(line.rfind(' ') + 1));
+    }
+    return total;
+}
+
+} // namespace
+
+class LuaSamplerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        lua.open_libraries(sol::lib::base, sol::lib::jit);
+        // Count hooks only fire in the interpreter; keep the samples deterministic.
+        lua.script("if jit then jit.off() end");
+        lua.script(kScript, "@assets/scripts/test/hot.lua");
+    }
+
+    void TearDown() override { sampler.reset(); }
+
+    sol::state lua;
+    Sampler sampler;
+};
+
+TEST_F(LuaSamplerTest, FoldedStacksNameScriptFunctions) {
+    ASSERT_TRUE(sampler.start(lua.lua_state(), instructions()));
+    EXPECT_TRUE(sampler.running());
+    lua["run"](200000);
+    sampler.stop();
+
+    EXPECT_FALSE(sampler.running());
+    EXPECT_GT(sampler.sample_count(), 100u);
+    const std::string folded = sampler.folded();
+    // run() is entered from C, so only its location is known.
+    EXPECT_NE(folded.find("anonymous (scripts/test/hot.lua:10);hot (scripts/test/hot.lua:1) "), std::string::npos)
+        << folded;
+    EXPECT_EQ(folded_total(folded), sampler.sample_count());
+}
+
+TEST_F(LuaSamplerTest, HotLinesPointAtTheLoop) {
+    ASSERT_TRUE(sampler.start(lua.lua_state(), instructions()));
+    lua["run"](200000);
+    sampler.stop();
+
+    const auto lines = sampler.hot_lines(3);
+    ASSERT_FALSE(lines.empty());
+    EXPECT_EQ(lines[0].location, "scripts/test/hot.lua:3");
+    for (size_t i = 1; i < lines.size(); ++i) {
+        EXPECT_GE(lines[i - 1].samples, lines[i].samples);
+    }
+}
+
+TEST_F(LuaSamplerTest, ChromeTraceNestsSlices) {
+    ASSERT_TRUE(sampler.start(lua.lua_state(), instructions()));
+    lua["run"](200000);
+    sampler.stop();
+
+    const auto trace = nlohmann::json::parse(sampler.chrome_trace());
+    const auto& events = trace.at("traceEvents");
+    ASSERT_FALSE(events.empty());
+    bool saw_hot = false;
+    for (const auto& event : events) {
+        EXPECT_EQ(event.at("ph"), "X");
+        EXPECT_GT(event.at("dur").get<int64_t>(), 0);
+        saw_hot |= event.at("name") == "hot (scripts/test/hot.lua:1)";
+    }
+    EXPECT_TRUE(saw_hot);
+}
+
+TEST_F(LuaSamplerTest, StopRemovesTheHookAndResetDropsSamples) {
+    ASSERT_TRUE(sampler.start(lua.lua_state(), instructions()));
+    lua["run"](50000);
+    sampler.stop();
+
+    const uint64_t count = sampler.sample_count();
+    lua["run"](50000);
+    EXPECT_EQ(sampler.sample_count(), count);
+
+    sampler.reset();
+    EXPECT_EQ(sampler.sample_count(), 0u);
+    EXPECT_TRUE(sampler.folded().empty());
+    EXPECT_TRUE(sampler.hot_lines(5).empty());
+}
+
+TEST_F(LuaSamplerTest, SmallRingDrainsWithoutLosingSamples) {
+    SamplerConfig config = instructions();
+    config.ring_capacity = 4;
+    ASSERT_TRUE(sampler.start(lua.lua_state(), config));
+    lua["run"](200000);
+    sampler.stop();
+
+    EXPECT_GT(sampler.sample_count(), 4u);
+    EXPECT_EQ(folded_total(sampler.folded()), sampler.sample_count());
+}
+
+TEST_F(LuaSamplerTest, DeepStacksAreTruncatedAtTheRoot) {
+    SamplerConfig config = instructions(100);
+    config.max_depth = 8;
+    ASSERT_TRUE(sampler.start(lua.lua_state(), config));
+    lua["run_deep"](40);
+    sampler.stop();
+
+    const std::string folded = sampler.folded();
+    EXPECT_NE(folded.find("[truncated];deep (scripts/test/hot.lua:6)"), std::string::npos) << folded;
+}
+
+TEST_F(LuaSamplerTest, ScriptHooksAreChainedAndClearedHooksRearmed) {
+    lua.open_libraries(sol::lib::debug);
+    ASSERT_TRUE(sampler.start(lua.lua_state(), instructions()));
+
+    // a test runner's timeout hook replaces ours...
+    lua.script("hook_calls = 0 debug.sethook(function() hook_calls = hook_calls + 1 end, '', 5000)");
+    sampler.rearm();
+    uint64_t before = sampler.sample_count();
+    lua["run"](200000);
+    EXPECT_GT(sampler.sample_count(), before);
+    EXPECT_GT(lua["hook_calls"].get<int>(), 0); // ...and keeps running behind it
+
+    // ...then clears it, taking ours along until the next rearm
+    lua.script("debug.sethook()");
+    before = sampler.sample_count();
+    lua["run"](200000);
+    EXPECT_EQ(sampler.sample_count(), before);
+    sampler.rearm();
+    lua["run"](200000);
+    EXPECT_GT(sampler.sample_count(), before);
+
+    // stopping hands a chained hook back
+    lua.script("debug.sethook(function() end, '', 5000)");
+    sampler.rearm();
+    sampler.stop();
+    EXPECT_TRUE(lua.script("return debug.gethook() ~= nil").get<bool>());
+    lua.script("debug.sethook()");
+}
+
+TEST_F(LuaSamplerTest, AttachedCoroutinesAreSampled) {
+    // created before start(), so PUC Lua does not hook it by itself
+    lua.script("co = coroutine.create(function() return run(200000) end)");
+    ASSERT_TRUE(sampler.start(lua.lua_state(), instructions()));
+
+    sol::thread co = lua["co"];
+    sampler.attach(co.thread_state());
+    lua.script("assert(coroutine.resume(co))");
+    sampler.stop();
+
+    EXPECT_GT(sampler.sample_count(), 100u);
+    EXPECT_NE(sampler.folded().find("hot (scripts/test/hot.lua:1)"), std::string::npos) << sampler.folded();
+}
+
+#if defined(SOL_LUAJIT) && SOL_LUAJIT
+TEST_F(LuaSamplerTest, TimerModeSamplesCompiledCode) {
+    lua.script("jit.on()");
+    SamplerConfig config;
+    config.mode = SampleMode::Timer;
+    config.interval_ms = 1;
+    ASSERT_TRUE(sampler.start(lua.lua_state(), config));
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (sampler.sample_count() < 10 && std::chrono::steady_clock::now() < deadline) {
+        lua["run"](1000000);
+    }
+    sampler.stop();
+
+    EXPECT_GE(sampler.sample_count(), 10u);
+    EXPECT_NE(sampler.folded().find("hot (scripts/test/hot.lua:1)"), std::string::npos) << sampler.folded();
+}
+#else
+TEST_F(LuaSamplerTest, TimerModeNeedsLuaJit) {
+    SamplerConfig config;
+    config.mode = SampleMode::Timer;
+    EXPECT_FALSE(sampler.start(lua.lua_state(), config));
+    EXPECT_FALSE(sampler.running());
+}
+#endif
@@ -166,7 +166,8 @@ TEST(TestModeConfigParsing, ParsesExtendedFlags) {
         "--lua-sandbox", "off",
         "--perf-mode", "collect",
         "--perf-budget", "tests/budgets.json",
-        "--perf-trace", "tests/out/trace.json"
+        "--perf-trace", "tests/out/trace.json",
+        "--lua-profile", "tests/out/lua.folded"
     });
 
     ASSERT_TRUE(result.ok) << result.err;
@@ -210,6 +211,8 @@ TEST(TestModeConfigParsing, ParsesExtendedFlags) {
     EXPECT_EQ(result.config.perf_budget_path->string(), "tests/budgets.json");
     ASSERT_TRUE(result.config.perf_trace_path.has_value());
     EXPECT_EQ(result.config.perf_trace_path->string(), "tests/out/trace.json");
+    ASSERT_TRUE(result.config.lua_profile_path.has_value());
+    EXPECT_EQ(result.config.lua_profile_path->string(), "tests/out/lua.folded");
 }
 
 TEST(TestModeConfigParsing, RejectsUnknownFlag) {
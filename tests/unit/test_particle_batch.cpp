@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include "systems/layer/layer.hpp"
+#include "systems/layer/layer_command_buffer.hpp"
+#include "systems/layer/layer_optimized.hpp"
+#include "systems/layer/particle_batch_geometry.hpp"
+
+namespace {
+
+bool sameColor(Color a, Color b) {
+    return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+}
+
+float cross(const layer::ParticleBatchVertex& a, const layer::ParticleBatchVertex& b,
+            const layer::ParticleBatchVertex& c) {
+    return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+}
+
+} // namespace
+
+class ParticleBatchTest : public ::testing::Test {
+protected:
+    std::shared_ptr<layer::Layer> testLayer;
+
+    void SetUp() override { testLayer = std::make_shared<layer::Layer>(); }
+
+    void TearDown() override {
+        layer::layer_command_buffer::Clear(testLayer);
+        testLayer.reset();
+    }
+
+    // Queues a batch, reads it back from the layer and expands it the way
+    // ExecuteDrawParticleBatch does: shadow pass first, then colour.
+    std::vector<layer::ParticleBatchVertex> queueAndExpand(
+        std::vector<layer::ParticleBatchInstance> instances, bool shadow = false) {
+        auto* cmd = layer::layer_command_buffer::Add<layer::CmdDrawParticleBatch>(
+            testLayer, 3, layer::DrawCommandSpace::World);
+        cmd->instances = std::move(instances);
+        cmd->drawShadow = shadow;
+        cmd->shadowOffset = {4.0f, -2.0f};
+        cmd->shadowColor = {1, 2, 3, 4};
+
+        const auto& sorted = layer::layer_command_buffer::GetCommandsSorted(testLayer);
+        EXPECT_EQ(sorted.size(), 1u);
+        EXPECT_EQ(sorted[0].type, layer::DrawCommandType::DrawParticleBatch);
+        auto* queued = static_cast<layer::CmdDrawParticleBatch*>(sorted[0].data);
+
+        std::vector<layer::ParticleBatchVertex> vertices;
+        if (queued->drawShadow) {
+            layer::AppendParticleBatchVertices(queued->instances, queued->shadowOffset.x,
+                                               queued->shadowOffset.y, &queued->shadowColor, vertices);
+        }
+        layer::AppendParticleBatchVertices(queued->instances, 0.0f, 0.0f, nullptr, vertices);
+        return vertices;
+    }
+
+    static void expectUniformWinding(const std::vector<layer::ParticleBatchVertex>& v) {
+        ASSERT_EQ(v.size() % 3, 0u);
+        for (size_t i = 0; i < v.size(); i += 3) {
+            EXPECT_LE(cross(v[i], v[i + 1], v[i + 2]), 1e-3f) << "triangle " << i / 3;
+        }
+    }
+};
+
+TEST_F(ParticleBatchTest, RectangleEmitsTwoTrianglesAroundItsCentre) {
+    const Color red{255, 0, 0, 255};
+    const auto v = queueAndExpand({{100.0f, 50.0f, 20.0f, 10.0f, 0.0f, red,
+                                    layer::ParticleBatchShape::Rectangle}});
+
+    ASSERT_EQ(v.size(), 6u);
+    expectUniformWinding(v);
+    float minX = 1e9f, maxX = -1e9f, minY = 1e9f, maxY = -1e9f;
+    for (const auto& p : v) {
+        EXPECT_TRUE(sameColor(p.color, red));
+        minX = std::min(minX, p.x);
+        maxX = std::max(maxX, p.x);
+        minY = std::min(minY, p.y);
+        maxY = std::max(maxY, p.y);
+    }
+    EXPECT_FLOAT_EQ(minX, 90.0f);
+    EXPECT_FLOAT_EQ(maxX, 110.0f);
+    EXPECT_FLOAT_EQ(minY, 45.0f);
+    EXPECT_FLOAT_EQ(maxY, 55.0f);
+}
+
+TEST_F(ParticleBatchTest, RotationTurnsTheQuadAboutItsCentre) {
+    const auto v = queueAndExpand({{0.0f, 0.0f, 20.0f, 10.0f, 90.0f, WHITE,
+                                    layer::ParticleBatchShape::Rectangle}});
+
+    ASSERT_EQ(v.size(), 6u);
+    expectUniformWinding(v);
+    for (const auto& p : v) {
+        // 20x10 turned a quarter: x spans the height, y the width
+        EXPECT_NEAR(std::abs(p.x), 5.0f, 1e-4f);
+        EXPECT_NEAR(std::abs(p.y), 10.0f, 1e-4f);
+    }
+}
+
+TEST_F(ParticleBatchTest, ShapesEmitTheSegmentCountsOfTheirRaylibCalls) {
+    const auto v = queueAndExpand({
+        {0.0f, 0.0f, 8.0f, 8.0f, 0.0f, WHITE, layer::ParticleBatchShape::Circle},
+        {0.0f, 0.0f, 8.0f, 8.0f, 0.0f, WHITE, layer::ParticleBatchShape::CircleLines},
+        {0.0f, 0.0f, 8.0f, 6.0f, 30.0f, WHITE, layer::ParticleBatchShape::Ellipse},
+        {0.0f, 0.0f, 8.0f, 6.0f, 0.0f, WHITE, layer::ParticleBatchShape::RectangleLines},
+        {0.0f, 0.0f, 8.0f, 2.0f, 45.0f, WHITE, layer::ParticleBatchShape::Line},
+    });
+
+    const size_t expected = 3u * (layer::kParticleCircleSegments + 2 * layer::kParticleRingSegments +
+                                  layer::kParticleEllipseSegments + 8 + 2);
+    ASSERT_EQ(v.size(), expected);
+    expectUniformWinding(v);
+
+    // The filled circle's rim sits at radius w.
+    for (int i = 0; i < layer::kParticleCircleSegments * 3; ++i) {
+        const float r = std::sqrt(v[i].x * v[i].x + v[i].y * v[i].y);
+        EXPECT_TRUE(r < 1e-4f || std::abs(r - 8.0f) < 1e-4f) << "vertex " << i;
+    }
+}
+
+TEST_F(ParticleBatchTest, ShadowPassIsOffsetAndTintedAndDrawnFirst) {
+    const Color blue{0, 0, 255, 200};
+    const auto v = queueAndExpand({{10.0f, 10.0f, 4.0f, 4.0f, 0.0f, blue,
+                                    layer::ParticleBatchShape::Rectangle}},
+                                  /*shadow=*/true);
+
+    ASSERT_EQ(v.size(), 12u);
+    for (size_t i = 0; i < 6; ++i) {
+        EXPECT_TRUE(sameColor(v[i].color, Color{1, 2, 3, 4}));
+        EXPECT_TRUE(sameColor(v[i + 6].color, blue));
+        EXPECT_FLOAT_EQ(v[i].x, v[i + 6].x + 4.0f);
+        EXPECT_FLOAT_EQ(v[i].y, v[i + 6].y - 2.0f);
+    }
+}
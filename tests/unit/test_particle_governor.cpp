@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+
+#include "systems/particles/particle_governor.hpp"
+
+using namespace particle;
+
+namespace {
+
+ParticleGovernor makeGovernor(uint32_t budget, uint32_t live) {
+    ParticleGovernor g;
+    g.config.budget = budget;
+    g.endFrame(live);
+    return g;
+}
+
+} // namespace
+
+TEST(ParticleGovernor, NoThrottlingWithRoomToSpare) {
+    auto g = makeGovernor(1000, 100);
+    float carry = 0.f;
+    EXPECT_EQ(g.admit(50, EmitterPriority::Low, 0.f, carry), 50u);
+    EXPECT_FLOAT_EQ(carry, 0.f);
+}
+
+TEST(ParticleGovernor, LowPriorityThrottlesBeforeHigh) {
+    auto g = makeGovernor(1000, 700); // 70% full
+
+    EXPECT_LT(g.budgetScale(EmitterPriority::Low), g.budgetScale(EmitterPriority::Normal));
+    EXPECT_LT(g.budgetScale(EmitterPriority::Normal), g.budgetScale(EmitterPriority::High));
+    EXPECT_FLOAT_EQ(g.budgetScale(EmitterPriority::High), 1.f);
+    EXPECT_FLOAT_EQ(g.budgetScale(EmitterPriority::Critical), 1.f);
+
+    g.endFrame(800); // past Low's throttleEnd
+    EXPECT_FLOAT_EQ(g.budgetScale(EmitterPriority::Low), 0.f);
+}
+
+TEST(ParticleGovernor, CarryPreservesAverageRate) {
+    auto g = makeGovernor(1000, 625); // Low at 50% emission
+    ASSERT_NEAR(g.budgetScale(EmitterPriority::Low), 0.5f, 1e-6f);
+
+    float carry = 0.f;
+    uint32_t total = 0;
+    for (int i = 0; i < 100; ++i) total += g.admit(1, EmitterPriority::Low, 0.f, carry);
+    EXPECT_EQ(total, 50u);
+}
+
+TEST(ParticleGovernor, HardCapAppliesToEveryPriority) {
+    auto g = makeGovernor(100, 90);
+    float carry = 0.f;
+    EXPECT_EQ(g.admit(1000000, EmitterPriority::Critical, 0.f, carry), 10u);
+
+    for (int i = 0; i < 10; ++i) EXPECT_TRUE(g.trySpawn());
+    EXPECT_FALSE(g.trySpawn());
+    EXPECT_EQ(g.live(), 100u);
+
+    g.endFrame(g.live());
+    EXPECT_EQ(g.lastFrame().spawned, 10u);
+    EXPECT_EQ(g.lastFrame().throttled, 1000000u - 10u + 1u);
+    EXPECT_FLOAT_EQ(g.lastFrame().pressure, 1.f);
+}
+
+TEST(ParticleGovernor, DistanceFalloffAndCulling) {
+    auto g = makeGovernor(1000, 0);
+    g.setView(0.f, 0.f, 800.f, 600.f);
+
+    EXPECT_FLOAT_EQ(g.distanceToView(400.f, 300.f), 0.f);
+    EXPECT_FLOAT_EQ(g.distanceToView(803.f, 604.f), 5.f);
+    EXPECT_FLOAT_EQ(g.distanceScale(0.f), 1.f);
+    EXPECT_FLOAT_EQ(g.distanceScale(g.config.cullDistance / 2), g.config.offscreenScale / 2);
+
+    float carry = 0.f;
+    const float far = g.config.cullDistance * 2;
+    EXPECT_EQ(g.admit(40, EmitterPriority::High, far, carry), 0u);
+    EXPECT_EQ(g.admit(40, EmitterPriority::Critical, far, carry), 40u);
+
+    g.endFrame(0);
+    EXPECT_EQ(g.lastFrame().culled, 40u);
+    EXPECT_EQ(g.lastFrame().throttled, 0u);
+}
+
+TEST(ParticleGovernor, DisabledAdmitsEverything) {
+    auto g = makeGovernor(10, 10);
+    g.config.enabled = false;
+    float carry = 0.f;
+    EXPECT_EQ(g.admit(500, EmitterPriority::Low, 1e9f, carry), 500u);
+    EXPECT_TRUE(g.trySpawn());
+}
@@ -0,0 +1,234 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <random>
+
+#include "systems/particles/particle_pool.hpp"
+
+using namespace particle;
+
+namespace {
+
+// The pre-SoA per-entity motion math (atan2/cos/sin), kept here
+// as the ground truth the kernels are checked against.
+void integrateWithTrig(ParticlePool& pool, float dt) {
+    for (size_t i = 0; i < pool.size(); ++i) {
+        pool.age[i] += dt;
+        if (pool.acceleration[i] != 0.0f) {
+            const float speedIncrease = pool.acceleration[i] * dt;
+            const float angle = std::atan2(pool.velY[i], pool.velX[i]);
+            pool.velX[i] += std::cos(angle) * speedIncrease;
+            pool.velY[i] += std::sin(angle) * speedIncrease;
+        }
+        pool.velY[i] += pool.gravity[i] * dt;
+        pool.posX[i] += pool.velX[i] * dt;
+        pool.posY[i] += pool.velY[i] * dt;
+        pool.rotation[i] += pool.rotationSpeed[i] * dt;
+    }
+}
+
+ParticlePool makeRandomPool(size_t count, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> vel(-300.f, 300.f);
+    std::uniform_real_distribution<float> pos(-1000.f, 1000.f);
+    std::uniform_real_distribution<float> small(-50.f, 50.f);
+    std::uniform_real_distribution<float> life(0.1f, 3.f);
+    std::uniform_int_distribution<uint32_t> rgba;
+
+    ParticlePool pool;
+    for (size_t i = 0; i < count; ++i) {
+        ParticleSpawn s;
+        s.x = pos(rng);
+        s.y = pos(rng);
+        // a few particles at rest exercise the zero-length direction path
+        s.vx = (i % 13 == 0) ? 0.f : vel(rng);
+        s.vy = (i % 13 == 0) ? 0.f : vel(rng);
+        s.rotation = small(rng);
+        s.rotationSpeed = small(rng);
+        s.gravity = small(rng);
+        s.acceleration = (i % 5 == 0) ? 0.f : small(rng);
+        s.age = 0.f;
+        s.lifespan = (i % 7 == 0) ? kParticleLivesForever : life(rng);
+        s.startColor = rgba(rng);
+        s.endColor = rgba(rng);
+        s.color = rgba(rng);
+        s.flags = (i % 3 == 0) ? 0 : kParticleFlagColorLerp;
+        pool.push(s);
+    }
+    return pool;
+}
+
+void expectNear(const std::vector<float>& a, const std::vector<float>& b, const char* field) {
+    ASSERT_EQ(a.size(), b.size());
+    for (size_t i = 0; i < a.size(); ++i) {
+        // relative, with an absolute floor for values that pass through zero
+        const float tol = 1e-4f * std::max(10.0f, std::fabs(a[i]));
+        EXPECT_NEAR(a[i], b[i], tol) << field << " @ " << i;
+    }
+}
+
+void expectColorsNear(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b) {
+    ASSERT_EQ(a.size(), b.size());
+    for (size_t i = 0; i < a.size(); ++i) {
+        for (int shift = 0; shift < 32; shift += 8) {
+            const int ca = static_cast<int>((a[i] >> shift) & 0xFFu);
+            const int cb = static_cast<int>((b[i] >> shift) & 0xFFu);
+            EXPECT_LE(std::abs(ca - cb), 1) << "color @ " << i << " channel " << shift / 8;
+        }
+    }
+}
+
+} // namespace
+
+TEST(ParticleKernel, ScalarMatchesTrigReference) {
+    ParticlePool kernel = makeRandomPool(203, 42);
+    ParticlePool reference = kernel;
+
+    for (int frame = 0; frame < 30; ++frame) {
+        IntegrateParticlePool(kernel, 1.f / 60.f, ParticleKernel::Scalar);
+        integrateWithTrig(reference, 1.f / 60.f);
+    }
+
+    expectNear(kernel.posX, reference.posX, "posX");
+    expectNear(kernel.posY, reference.posY, "posY");
+    expectNear(kernel.velX, reference.velX, "velX");
+    expectNear(kernel.velY, reference.velY, "velY");
+    expectNear(kernel.rotation, reference.rotation, "rotation");
+    expectNear(kernel.age, reference.age, "age");
+}
+
+TEST(ParticleKernel, AVX2MatchesScalar) {
+    if (!ParticleKernelAvailable(ParticleKernel::AVX2)) {
+        GTEST_SKIP() << "AVX2 not available on this CPU/build";
+    }
+
+    // odd count so the scalar tail runs as well
+    ParticlePool simd = makeRandomPool(1021, 7);
+    ParticlePool scalar = simd;
+
+    for (int frame = 0; frame < 60; ++frame) {
+        IntegrateParticlePool(simd, 1.f / 60.f, ParticleKernel::AVX2);
+        IntegrateParticlePool(scalar, 1.f / 60.f, ParticleKernel::Scalar);
+    }
+
+    expectNear(simd.posX, scalar.posX, "posX");
+    expectNear(simd.posY, scalar.posY, "posY");
+    expectNear(simd.velX, scalar.velX, "velX");
+    expectNear(simd.velY, scalar.velY, "velY");
+    expectNear(simd.rotation, scalar.rotation, "rotation");
+    expectNear(simd.age, scalar.age, "age");
+    expectColorsNear(simd.color, scalar.color);
+}
+
+TEST(ParticleKernel, ColorLerpOnlyTouchesFlaggedParticles) {
+    for (ParticleKernel k : {ParticleKernel::Scalar, ParticleKernel::AVX2}) {
+        if (!ParticleKernelAvailable(k)) continue;
+
+        ParticlePool pool;
+        for (int i = 0; i < 16; ++i) {
+            ParticleSpawn s;
+            s.lifespan = 1.f;
+            s.color = 0x11223344u;
+            s.startColor = 0x00000000u;
+            s.endColor = 0xFFFFFFFFu;
+            s.flags = (i % 2) ? kParticleFlagColorLerp : 0;
+            pool.push(s);
+        }
+
+        IntegrateParticlePool(pool, 0.5f, k);
+
+        for (size_t i = 0; i < pool.size(); ++i) {
+            if (i % 2) {
+                // halfway from 0 to 255 truncates to 127 on every channel
+                EXPECT_EQ(pool.color[i], 0x7F7F7F7Fu) << i;
+            } else {
+                EXPECT_EQ(pool.color[i], 0x11223344u) << i;
+            }
+        }
+    }
+}
+
+TEST(ParticleKernel, ColorLerpClampsAtEndOfLife) {
+    for (ParticleKernel k : {ParticleKernel::Scalar, ParticleKernel::AVX2}) {
+        if (!ParticleKernelAvailable(k)) continue;
+
+        ParticlePool pool;
+        for (int i = 0; i < 9; ++i) {
+            ParticleSpawn s;
+            s.lifespan = 1.f;
+            s.age = 0.9f;
+            s.startColor = 0x000000FFu;
+            s.endColor = 0xFF0000FFu;
+            s.flags = kParticleFlagColorLerp;
+            pool.push(s);
+        }
+
+        IntegrateParticlePool(pool, 0.5f, k); // age 1.4 > lifespan
+
+        for (size_t i = 0; i < pool.size(); ++i) {
+            EXPECT_EQ(pool.color[i], 0xFF0000FFu) << i;
+        }
+        EXPECT_EQ(RemoveExpiredParticles(pool), 9u);
+    }
+}
+
+TEST(ParticleKernel, RestingParticleAcceleratesAlongPositiveX) {
+    ParticlePool pool;
+    ParticleSpawn s;
+    s.acceleration = 10.f;
+    pool.push(s);
+
+    IntegrateParticlePool(pool, 1.f, ParticleKernel::Scalar);
+
+    EXPECT_FLOAT_EQ(pool.velX[0], 10.f);
+    EXPECT_FLOAT_EQ(pool.velY[0], 0.f);
+}
+
+TEST(ParticleKernel, ChunkedSimulationMatchesWholePool) {
+    ParticlePool chunked = makeRandomPool(1000, 99);
+    for (size_t i = 0; i < chunked.size(); ++i) {
+        chunked.callbackSlot[i] = (i % 4 == 0) ? static_cast<uint32_t>(i) : kNoParticleCallback;
+    }
+    ParticlePool whole = chunked;
+
+    for (int frame = 0; frame < 90; ++frame) {
+        const float dt = 1.f / 30.f;
+
+        // chunks may be simulated in any order; run them back to front
+        std::vector<ParticleChunk> chunks;
+        for (size_t begin = 0; begin < chunked.size(); begin += 128) {
+            ParticleChunk c;
+            c.begin = begin;
+            c.end = std::min(begin + 128, chunked.size());
+            chunks.push_back(c);
+        }
+        for (size_t c = chunks.size(); c-- > 0;) {
+            SimulateParticleChunk(chunked, dt, ParticleKernel::Scalar, chunks[c]);
+        }
+        for (const auto& c : chunks) {
+            for (uint32_t i : c.withCallback) {
+                EXPECT_LT(chunked.age[i], chunked.lifespan[i]);
+                EXPECT_NE(chunked.callbackSlot[i], kNoParticleCallback);
+            }
+        }
+        std::vector<uint32_t> releasedChunked;
+        for (size_t c = chunks.size(); c-- > 0;) {
+            for (size_t k = chunks[c].expired.size(); k-- > 0;) {
+                RemoveParticleAt(chunked, chunks[c].expired[k], &releasedChunked);
+            }
+        }
+
+        std::vector<uint32_t> releasedWhole;
+        IntegrateParticlePool(whole, dt, ParticleKernel::Scalar);
+        RemoveExpiredParticles(whole, &releasedWhole);
+
+        ASSERT_EQ(chunked.size(), whole.size()) << "frame " << frame;
+        EXPECT_EQ(releasedChunked, releasedWhole) << "frame " << frame;
+    }
+
+    EXPECT_EQ(chunked.posX, whole.posX);
+    EXPECT_EQ(chunked.posY, whole.posY);
+    EXPECT_EQ(chunked.color, whole.color);
+    EXPECT_EQ(chunked.callbackSlot, whole.callbackSlot);
+}
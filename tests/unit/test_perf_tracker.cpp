@@ -75,6 +75,22 @@ TEST(PerfTracker, TestScopedMetrics) {
     EXPECT_NEAR(metrics.max_frame_ms, 3.0f, 0.001f);
 }
 
+TEST(PerfTracker, LuaGcSamplesAttachToTheNextFrame) {
+    testing::PerfTracker tracker;
+    tracker.initialize(make_config());
+
+    tracker.record_lua_gc(2048.0f, 0.5f);
+    tracker.record_frame(1, 1.0f, 0.0f);
+    tracker.record_frame(2, 1.0f, 0.0f); // no sample: counts as no GC work
+    tracker.record_lua_gc(4096.0f, 1.5f);
+    tracker.record_frame(3, 1.0f, 0.0f);
+
+    auto metrics = tracker.get_current_metrics();
+    EXPECT_NEAR(metrics.peak_lua_heap_kb, 4096.0f, 0.001f);
+    EXPECT_NEAR(metrics.total_lua_gc_ms, 2.0f, 0.001f);
+    EXPECT_NEAR(metrics.max_lua_gc_ms, 1.5f, 0.001f);
+}
+
 TEST(PerfTracker, BudgetViolations) {
     testing::PerfTracker tracker;
     tracker.initialize(make_config());
@@ -7,17 +7,19 @@
 #include "core/engine_context.hpp"
 #include "core/events.hpp"
 #include "core/globals.hpp"
+#include "systems/event/event_system.hpp"
 
-class PhysicsEventBusTest : public ::testing::Test {
+// Collisions go to the pull-based event channels, not EventBus listeners.
+class PhysicsEventChannelTest : public ::testing::Test {
 protected:
     void SetUp() override {
         savedCtx = globals::g_ctx;
         globals::g_ctx = nullptr;
-        globals::getEventBus().clear();
+        globals::getEventChannels().clear();
     }
     void TearDown() override {
         globals::g_ctx = savedCtx;
-        globals::getEventBus().clear();
+        globals::getEventChannels().clear();
     }
     EngineContext* savedCtx{nullptr};
 };
@@ -40,7 +42,7 @@ static void pushCollision(physics::PhysicsWorld& world,
     world.collisionExit["a:b"].push_back(exit);
 }
 
-TEST_F(PhysicsEventBusTest, PublishesCollisionEventsToContextBus) {
+TEST_F(PhysicsEventChannelTest, PublishesCollisionEventsToContextChannels) {
     EngineContext ctx{EngineConfig{std::string{"config.json"}}};
     globals::setEngineContext(&ctx);
 
@@ -51,18 +53,21 @@ TEST_F(PhysicsEventBusTest, PublishesCollisionEventsToContextBus) {
     auto e2 = registry.create();
     pushCollision(world, e1, e2, 3.0f, 4.0f);
 
+    auto& startedChannel = ctx.eventChannels.channel<events::CollisionStarted>();
+    auto& endedChannel = ctx.eventChannels.channel<events::CollisionEnded>();
+    auto startedReader = startedChannel.reader();
+    auto endedReader = endedChannel.reader();
+
+    world.PostUpdate();
+
     int started = 0;
     int ended = 0;
     events::CollisionStarted last{};
-    ctx.eventBus.subscribe<events::CollisionStarted>(
-        [&](const events::CollisionStarted& ev) {
-            ++started;
-            last = ev;
-        });
-    ctx.eventBus.subscribe<events::CollisionEnded>(
-        [&](const events::CollisionEnded&) { ++ended; });
-
-    world.PostUpdate();
+    startedChannel.read(startedReader).forEach([&](const events::CollisionStarted& ev) {
+        ++started;
+        last = ev;
+    });
+    endedChannel.read(endedReader).forEach([&](const events::CollisionEnded&) { ++ended; });
 
     EXPECT_EQ(started, 1);
     EXPECT_EQ(ended, 1);
@@ -74,7 +79,7 @@ TEST_F(PhysicsEventBusTest, PublishesCollisionEventsToContextBus) {
     EXPECT_TRUE(world.collisionExit.empty());
 }
 
-TEST_F(PhysicsEventBusTest, FallsBackToGlobalBusWhenNoContext) {
+TEST_F(PhysicsEventChannelTest, FallsBackToGlobalChannelsWhenNoContext) {
     globals::setEngineContext(nullptr);
 
     entt::registry registry;
@@ -84,19 +89,59 @@ TEST_F(PhysicsEventBusTest, FallsBackToGlobalBusWhenNoContext) {
     auto e2 = registry.create();
     pushCollision(world, e1, e2, 5.0f, 6.0f);
 
-    int started = 0;
-    events::CollisionStarted last{};
-    globals::getEventBus().subscribe<events::CollisionStarted>(
-        [&](const events::CollisionStarted& ev) {
-            ++started;
-            last = ev;
-        });
+    auto& channel = globals::getEventChannels().channel<events::CollisionStarted>();
+    auto reader = channel.reader();
 
     world.PostUpdate();
 
+    int started = 0;
+    events::CollisionStarted last{};
+    channel.read(reader).forEach([&](const events::CollisionStarted& ev) {
+        ++started;
+        last = ev;
+    });
+
     EXPECT_EQ(started, 1);
     EXPECT_EQ(last.entityA, e1);
     EXPECT_EQ(last.entityB, e2);
     EXPECT_FLOAT_EQ(last.point.x, 5.0f);
     EXPECT_FLOAT_EQ(last.point.y, 6.0f);
 }
+
+TEST_F(PhysicsEventChannelTest, ClearAllListenersDropsLuaChannelReaders) {
+    sol::state lua;
+    lua.open_libraries(sol::lib::base);
+    event_system::exposeEventSystemToLua(lua);
+
+    lua.script("reader = event_channels.reader('collision_started')");
+    EXPECT_TRUE(lua.script("return event_channels.read(reader) ~= nil").get<bool>());
+
+    event_system::ClearAllListeners();
+    EXPECT_TRUE(lua.script("return event_channels.read(reader) == nil").get<bool>());
+}
+
+TEST_F(PhysicsEventChannelTest, ReleasedLuaChannelReadersAreReused) {
+    sol::state lua;
+    lua.open_libraries(sol::lib::base);
+    event_system::exposeEventSystemToLua(lua);
+
+    lua.script(R"(
+        first = event_channels.reader('collision_started')
+        second = event_channels.reader('collision_ended')
+        event_channels.release(first)
+        event_channels.release(first) -- twice is harmless
+    )");
+    EXPECT_TRUE(lua.script("return event_channels.read(first) == nil").get<bool>());
+    EXPECT_TRUE(lua.script("return event_channels.read(second) ~= nil").get<bool>());
+
+    // the freed slot is handed out again, and only once
+    lua.script(R"(
+        third = event_channels.reader('collision_started')
+        fourth = event_channels.reader('collision_started')
+    )");
+    EXPECT_EQ(lua["third"].get<size_t>(), lua["first"].get<size_t>());
+    EXPECT_NE(lua["fourth"].get<size_t>(), lua["third"].get<size_t>());
+    EXPECT_TRUE(lua.script("return event_channels.read(third) ~= nil").get<bool>());
+
+    event_system::ClearAllListeners();
+}
@@ -16,6 +16,8 @@ protected:
     }
 
     void TearDown() override {
+        scripting::task_scheduler().clear();
+        scripting::set_script_update_dispatch(scripting::ScriptUpdateDispatch::Off);
         globals::g_ctx = savedCtx;
     }
 
@@ -67,18 +69,19 @@ TEST_F(ScriptingLifecycleTest, ReleaseScriptCallsDestroyAndAbandonsSelf) {
     tbl["destroy"] = [&]() { destroyed = true; };
     tbl["update"] = []() {};
 
-    scripting::ScriptComponent sc{tbl};
-    sc.tasks.push_back(lua["make_co"]());
-
     entt::registry registry;
     const entt::entity e = registry.create();
+    scripting::ScriptComponent sc{tbl};
+    sc.owner = e;
+    sc.add_task(lua["make_co"]());
     registry.emplace<scripting::ScriptComponent>(e, sc);
+    ASSERT_EQ(scripting::task_scheduler().count(e), 1u);
 
     scripting::release_script(registry, e);
 
     EXPECT_TRUE(destroyed);
     auto& stored = registry.get<scripting::ScriptComponent>(e);
-    EXPECT_TRUE(stored.tasks.empty());
+    EXPECT_EQ(stored.count_tasks(), 0u);
     EXPECT_FALSE(stored.self.valid());
 }
 
@@ -99,18 +102,112 @@ TEST_F(ScriptingLifecycleTest, AddScriptComponentAddsTableThroughHelper) {
     EXPECT_EQ(sc.self.lua_state(), tbl.lua_state());
 }
 
-TEST_F(ScriptingLifecycleTest, AddTaskCreatesCoroutineInMasterState) {
+TEST_F(ScriptingLifecycleTest, AddTaskRunsOnTheSchedulerForItsOwner) {
     auto& lua = ai_system::masterStateLua;
     int calls = 0;
     lua.set_function("tick", [&]() { calls++; });
 
     scripting::ScriptComponent sc{};
+    sc.owner = static_cast<entt::entity>(7);
     sc.add_task(lua["tick"]);
 
-    ASSERT_EQ(sc.tasks.size(), 1u);
-    sol::coroutine& co = sc.tasks.front();
-    ASSERT_TRUE(co.valid());
-    auto result = co();
-    EXPECT_TRUE(result.valid());
+    ASSERT_EQ(sc.count_tasks(), 1u);
+    EXPECT_EQ(calls, 0); // first runs on the next update
+    scripting::task_scheduler().update(0.016f);
     EXPECT_EQ(calls, 1);
+    EXPECT_EQ(sc.count_tasks(), 0u);
+}
+
+TEST_F(ScriptingLifecycleTest, BatchedUpdateKeepsPerEntityOrderAndIsolatesErrors) {
+    sol::state& lua = ai_system::masterStateLua;
+    lua.script(R"(
+        order = ""
+        function make_script(name, fail)
+            return { update = function(self, dt)
+                order = order .. name
+                if fail then error("boom") end
+            end }
+        end
+    )");
+
+    entt::registry registry;
+    for (const char* name : {"a", "b", "c", "d"}) {
+        const entt::entity e = registry.create();
+        registry.emplace<scripting::ScriptComponent>(e, lua["make_script"](name, std::string(name) == "b").get<sol::table>());
+        scripting::init_script(registry, e);
+    }
+
+    auto run = [&](scripting::ScriptUpdateDispatch mode) {
+        lua["order"] = "";
+        scripting::set_script_update_dispatch(mode);
+        scripting::script_system_update(registry, 0.016f);
+        return lua["order"].get<std::string>();
+    };
+
+    EXPECT_EQ(run(scripting::ScriptUpdateDispatch::Off), "");
+    const std::string perEntity = run(scripting::ScriptUpdateDispatch::PerEntity);
+    EXPECT_EQ(perEntity.size(), 4u); // "b" failing does not stop the rest
+    EXPECT_EQ(run(scripting::ScriptUpdateDispatch::Batched), perEntity);
+    EXPECT_EQ(run(scripting::ScriptUpdateDispatch::Batched), perEntity);
+    EXPECT_EQ(lua_gettop(lua.lua_state()), 0);
+}
+
+TEST_F(ScriptingLifecycleTest, BatchedUpdateSkipsScriptsReleasedMidBatch) {
+    sol::state& lua = ai_system::masterStateLua;
+    entt::registry registry;
+    const entt::entity a = registry.create();
+    const entt::entity b = registry.create();
+
+    // Each script releases the other, so only the first one in the batch may run.
+    int updates = 0;
+    auto add_rival = [&](entt::entity self, entt::entity rival) {
+        sol::table tbl = lua.create_table();
+        tbl["update"] = [&registry, &updates, rival](sol::table, float) {
+            updates++;
+            if (registry.get<scripting::ScriptComponent>(rival).self.valid())
+                scripting::release_script(registry, rival);
+        };
+        registry.emplace<scripting::ScriptComponent>(self, tbl);
+        scripting::init_script(registry, self);
+    };
+    add_rival(a, b);
+    add_rival(b, a);
+
+    scripting::set_script_update_dispatch(scripting::ScriptUpdateDispatch::Batched);
+    scripting::script_system_update(registry, 0.016f);
+    EXPECT_EQ(updates, 1);
+    scripting::script_system_update(registry, 0.016f);
+    EXPECT_EQ(updates, 2);
+}
+
+TEST_F(ScriptingLifecycleTest, BatchedUpdateDoesNotKeepScriptsAlive) {
+    sol::state& lua = ai_system::masterStateLua;
+    lua.script(R"(
+        watched = setmetatable({}, { __mode = "k" })
+        function make_watched_script()
+            local script = { update = function(self, dt) end }
+            watched[script] = true
+            return script
+        end
+        function count_watched()
+            collectgarbage()
+            collectgarbage()
+            local n = 0
+            for _ in pairs(watched) do n = n + 1 end
+            return n
+        end
+    )");
+
+    entt::registry registry;
+    const entt::entity e = registry.create();
+    registry.emplace<scripting::ScriptComponent>(e, lua["make_watched_script"]().get<sol::table>());
+    scripting::init_script(registry, e);
+
+    scripting::set_script_update_dispatch(scripting::ScriptUpdateDispatch::Batched);
+    scripting::script_system_update(registry, 0.016f);
+    EXPECT_EQ(lua["count_watched"]().get<int>(), 1);
+
+    // release_script is not hooked up here, so the component's references simply go away
+    registry.destroy(e);
+    EXPECT_EQ(lua["count_watched"]().get<int>(), 0);
 }
@@ -310,6 +310,26 @@ TEST_F(ShaderSystemTest, SkipsReloadWhenUnchanged)
     EXPECT_EQ(shaders::loadedShaders["basic"].id, 2u);
 }
 
+TEST_F(ShaderSystemTest, FileWatchReloadsOnlyShadersUsingChangedFiles)
+{
+    auto vertexPath = makeTempFile("watch_reload_vert.glsl", "// vertex");
+    auto fragmentPath = makeTempFile("watch_reload_frag.glsl", "// fragment");
+    auto otherFragment = makeTempFile("watch_other_frag.glsl", "// fragment");
+
+    shaders::loadedShaders["basic"] = Shader{.id = 1};
+    shaders::shaderPaths["basic"] = {vertexPath.string(), fragmentPath.string()};
+    shaders::shaderFileModificationTimes["basic"] = {0, 0};
+    shaders::loadedShaders["other"] = Shader{.id = 2};
+    shaders::shaderPaths["other"] = {"", otherFragment.string()};
+    shaders::shaderFileModificationTimes["other"] = {0, 0};
+
+    shaders::reloadShadersForFiles({std::filesystem::absolute(fragmentPath).lexically_normal()});
+
+    EXPECT_EQ(ShaderStubStats::loadCount, 1);
+    EXPECT_NE(shaders::loadedShaders["basic"].id, 1u);
+    EXPECT_EQ(shaders::loadedShaders["other"].id, 2u);
+}
+
 TEST(ShaderManifest, DesktopAndWebShaderFilesExistAndAreNonEmpty)
 {
     const auto manifest = LoadShaderManifest();
@@ -0,0 +1,240 @@
+#include <gtest/gtest.h>
+
+#include "systems/spring/spring_pool.hpp"
+
+#include <random>
+
+using namespace spring;
+
+TEST(SpringPool, HandlesStayValidAcrossGrowthAndDetectReuse) {
+    SpringPool pool;
+    const SpringHandle first = pool.create(5.f, 200.f, 40.f);
+    float *firstValue = &pool.get(first).value;
+
+    std::vector<SpringHandle> others;
+    for (uint32_t i = 0; i < SpringPool::kChunkSize * 3; ++i)
+        others.push_back(pool.create(static_cast<float>(i), 200.f, 40.f));
+
+    // chunks never move, so references taken before growth still point at the spring
+    EXPECT_EQ(&pool.get(first).value, firstValue);
+    EXPECT_FLOAT_EQ(pool.get(first).value, 5.f);
+    EXPECT_FLOAT_EQ(pool.get(others.back()).targetValue, SpringPool::kChunkSize * 3 - 1.f);
+
+    pool.destroy(first);
+    EXPECT_FALSE(pool.alive(first));
+
+    // the slot is held back until the next update, so old pointers into it reach nobody
+    const SpringHandle fresh = pool.create(1.f, 1.f, 1.f);
+    EXPECT_NE(fresh.index, first.index);
+    pool.update(1.f / 60.f);
+
+    const SpringHandle reused = pool.create(1.f, 1.f, 1.f);
+    EXPECT_EQ(reused.index, first.index);
+    EXPECT_NE(reused.generation, first.generation);
+    EXPECT_FALSE(pool.alive(first));
+    EXPECT_TRUE(pool.alive(reused));
+    EXPECT_EQ(pool.size(), others.size() + 2);
+}
+
+TEST(SpringPool, SettledSpringsSleepUntilRetargeted) {
+    SpringPool pool;
+    const SpringHandle h = pool.create(0.f, 200.f, 40.f);
+    pool.create(0.f, 200.f, 40.f); // stays at rest throughout
+
+    pool.update(1.f / 60.f);
+    EXPECT_EQ(pool.awake(), 0u);
+
+    pool.get(h).targetValue = 100.f;
+    pool.update(1.f / 60.f);
+    EXPECT_EQ(pool.awake(), 1u);
+    EXPECT_GT(pool.get(h).value, 0.f);
+
+    for (int i = 0; i < 600 && pool.awake() > 0; ++i) pool.update(1.f / 60.f);
+    EXPECT_EQ(pool.awake(), 0u);
+
+    // asleep means snapped exactly onto the target
+    SpringRef s = pool.get(h);
+    EXPECT_EQ(s.value, 100.f);
+    EXPECT_EQ(s.velocity, 0.f);
+
+    // a kick on the velocity alone is enough to wake it
+    s.velocity = 50.f;
+    pool.update(1.f / 60.f);
+    EXPECT_EQ(pool.awake(), 1u);
+    EXPECT_NE(pool.get(h).value, 100.f);
+}
+
+TEST(SpringPool, DisabledSpringsAreNotIntegrated) {
+    SpringPool pool;
+    SpringRef s = pool.get(pool.create(0.f, 200.f, 40.f));
+    s.targetValue = 10.f;
+    s.enabled = false;
+
+    pool.update(1.f / 60.f);
+    EXPECT_EQ(s.value, 0.f);
+
+    // `s` was taken before the last update, so the write has to be announced
+    s.enabled = true;
+    s.wake();
+    pool.update(1.f / 60.f);
+    EXPECT_GT(s.value, 0.f);
+}
+
+TEST(SpringPool, UpdateOnlyVisitsGroupsThatMayBeAwake) {
+    SpringPool pool;
+    std::vector<SpringHandle> hs;
+    for (uint32_t i = 0; i < SpringPool::kChunkSize * 2; ++i) hs.push_back(pool.create(0.f, 200.f, 40.f));
+    EXPECT_EQ(pool.awakeGroups(), 0u); // new springs are at rest
+
+    pool.get(hs[3]).targetValue = 10.f;
+    pool.get(hs[5]).targetValue = 10.f; // same group of 8
+    pool.get(hs[SpringPool::kChunkSize + 100]).velocity = 5.f;
+    EXPECT_EQ(pool.awakeGroups(), 2u);
+
+    pool.update(1.f / 60.f);
+    EXPECT_EQ(pool.awake(), 3u);
+    EXPECT_EQ(pool.awakeGroups(), 2u);
+
+    for (int i = 0; i < 600 && pool.awake() > 0; ++i) pool.update(1.f / 60.f);
+    EXPECT_EQ(pool.awakeGroups(), 0u);
+    EXPECT_EQ(pool.get(hs[3]).value, 10.f);
+
+    // a ref kept across updates writes without waking anything until told to
+    SpringRef kept = pool.get(hs[700]);
+    pool.update(1.f / 60.f);
+    kept.targetValue = 4.f;
+    pool.update(1.f / 60.f);
+    EXPECT_EQ(kept.value, 0.f);
+    kept.wake();
+    pool.update(1.f / 60.f);
+    EXPECT_GT(kept.value, 0.f);
+}
+
+TEST(SpringPool, SpringRefKnowsWhenItsSpringIsGone) {
+    SpringPool pool;
+    const SpringHandle h = pool.create(1.f, 200.f, 40.f);
+    const SpringRef ref = pool.get(h);
+    EXPECT_TRUE(ref.alive());
+    EXPECT_EQ(ref.handle, h);
+
+    pool.destroy(h);
+    EXPECT_FALSE(ref.alive());
+
+    // the slot goes to a new spring; the old view still refuses it
+    pool.update(1.f / 60.f);
+    const SpringHandle next = pool.create(2.f, 200.f, 40.f);
+    ASSERT_EQ(next.index, h.index);
+    EXPECT_FALSE(ref.alive());
+    EXPECT_TRUE(pool.get(next).alive());
+    ref.wake(); // a no-op on a dead view
+    EXPECT_EQ(pool.awakeGroups(), 1u);
+}
+
+TEST(SpringPool, CloneCopiesStateIntoANewSlot) {
+    SpringPool pool;
+    const SpringHandle a = pool.create(3.f, 150.f, 20.f);
+    pool.get(a).targetValue = 7.f;
+    pool.get(a).velocity = 2.f;
+
+    const SpringHandle b = pool.clone(a);
+    EXPECT_NE(a.index, b.index);
+    EXPECT_FLOAT_EQ(pool.get(b).targetValue, 7.f);
+    EXPECT_FLOAT_EQ(pool.get(b).velocity, 2.f);
+    EXPECT_FLOAT_EQ(pool.get(b).stiffness, 150.f);
+
+    pool.get(b).value = -1.f;
+    EXPECT_FLOAT_EQ(pool.get(a).value, 3.f);
+}
+
+TEST(SpringPool, AVX2MatchesScalar) {
+    if (!SpringKernelAvailable(SpringKernel::AVX2)) GTEST_SKIP() << "AVX2 not available";
+
+    SpringPool scalar, simd;
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> pos(-500.f, 500.f), k(50.f, 2000.f), d(5.f, 120.f);
+
+    std::vector<SpringHandle> hs, hv;
+    for (int i = 0; i < 1500; ++i) {
+        const float v = pos(rng), stiff = k(rng), damp = d(rng);
+        hs.push_back(scalar.create(v, stiff, damp));
+        hv.push_back(simd.create(v, stiff, damp));
+        const float target = (i % 3 == 0) ? v : pos(rng); // a third start asleep
+        scalar.get(hs.back()).targetValue = target;
+        simd.get(hv.back()).targetValue = target;
+        if (i % 11 == 0) scalar.get(hs.back()).enabled = simd.get(hv.back()).enabled = false;
+    }
+    // free some slots so the kernels also walk holes
+    for (int i = 0; i < 1500; i += 17) {
+        scalar.destroy(hs[i]);
+        simd.destroy(hv[i]);
+    }
+
+    for (int frame = 0; frame < 120; ++frame) {
+        const float dt = frame % 10 == 0 ? 0.05f : 1.f / 60.f; // include substepped frames
+        scalar.update(dt, SpringKernel::Scalar);
+        simd.update(dt, SpringKernel::AVX2);
+    }
+
+    EXPECT_EQ(scalar.awake(), simd.awake());
+    for (size_t i = 0; i < hs.size(); ++i) {
+        if (!scalar.alive(hs[i])) continue;
+        EXPECT_NEAR(scalar.get(hs[i]).value, simd.get(hv[i]).value, 1e-2f) << i;
+        EXPECT_NEAR(scalar.get(hs[i]).velocity, simd.get(hv[i]).velocity, 1e-2f) << i;
+    }
+}
+
+TEST(SpringPool, PooledSpringOwnsItsSlot) {
+    auto &pool = GetSpringPool();
+    const size_t before = pool.size();
+    {
+        PooledSpring a{1.f, 200.f, 40.f};
+        PooledSpring b = a;
+        b.ref().value = 9.f;
+        EXPECT_FLOAT_EQ(a.ref().value, 1.f);
+        EXPECT_EQ(pool.size(), before + 2);
+
+        PooledSpring c = std::move(a);
+        EXPECT_FALSE(a.handle().valid());
+        EXPECT_EQ(pool.size(), before + 2);
+    }
+    EXPECT_EQ(pool.size(), before);
+}
+
+TEST(SpringPool, CollectChangedReportsOwnersOfMovedSprings) {
+    for (SpringKernel kernel : {SpringKernel::Scalar, SpringKernel::AVX2}) {
+        if (!SpringKernelAvailable(kernel)) continue;
+
+        SpringPool pool;
+        const SpringHandle a = pool.create(0.f, 200.f, 40.f);
+        const SpringHandle b = pool.create(0.f, 200.f, 40.f);
+        const SpringHandle unowned = pool.create(0.f, 200.f, 40.f);
+        pool.setOwner(a, 7);
+        pool.setOwner(b, 9);
+
+        std::vector<uint32_t> owners;
+        pool.collectChanged(owners, kernel);
+        EXPECT_TRUE(owners.empty()); // new springs start out seen
+
+        pool.get(b).targetValue = 5.f;     // written through a ref
+        pool.get(unowned).value = 3.f;     // changes, but nobody to tell
+        pool.collectChanged(owners, kernel);
+        EXPECT_EQ(owners, std::vector<uint32_t>{9});
+
+        owners.clear();
+        pool.collectChanged(owners, kernel);
+        EXPECT_TRUE(owners.empty());
+
+        pool.update(1.f / 60.f, kernel); // integration moves b's value
+        pool.collectChanged(owners, kernel);
+        EXPECT_EQ(owners, std::vector<uint32_t>{9});
+
+        owners.clear();
+        const SpringHandle copy = pool.clone(a);
+        EXPECT_EQ(pool.owner(copy), SpringPool::kNoOwner); // claimed by whoever holds it
+        pool.destroy(a);
+        EXPECT_EQ(pool.owner(a), SpringPool::kNoOwner);
+        pool.update(1.f / 60.f, kernel);
+        pool.collectChanged(owners, kernel);
+        EXPECT_EQ(owners, std::vector<uint32_t>{9}); // b is still settling, the rest are at rest
+    }
+}
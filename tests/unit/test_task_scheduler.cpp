@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+
+#include "sol/sol.hpp"
+#include "systems/scripting/task_scheduler.hpp"
+
+using scripting::kNoTask;
+using scripting::task_scheduler;
+
+class TaskSchedulerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        lua.open_libraries(sol::lib::base, sol::lib::coroutine, sol::lib::string, sol::lib::table);
+        scripting::exposeTaskSchedulerToLua(lua);
+        lua.script("log = {}");
+    }
+
+    void TearDown() override { task_scheduler().clear(); }
+
+    scripting::TaskHandle spawn(const char *body, entt::entity owner = entt::null) {
+        sol::function fn = lua.script(std::string("return function() ") + body + " end");
+        return task_scheduler().spawn(fn, owner);
+    }
+
+    std::string log() {
+        return lua.script("return table.concat(log, ',')").get<std::string>();
+    }
+
+    sol::state lua;
+};
+
+TEST_F(TaskSchedulerTest, SecondsAndFramesWaitsOnlyResumeWhenDue) {
+    spawn("log[#log+1] = 's0'; tasks.wait(0.7); log[#log+1] = 's1'");
+    spawn("log[#log+1] = 'f0'; tasks.wait_frames(2); log[#log+1] = 'f2'");
+    spawn("for i = 1, 2 do log[#log+1] = 'n' .. i; tasks.next_frame() end");
+
+    auto &tasks = task_scheduler();
+    EXPECT_EQ(log(), ""); // spawned tasks start on the next update
+    tasks.update(0.4f);
+    EXPECT_EQ(log(), "s0,f0,n1");
+    tasks.update(0.4f);   // 0.4 s and one frame into the waits
+    EXPECT_EQ(log(), "s0,f0,n1,n2");
+    EXPECT_EQ(tasks.size(), 3u);
+    tasks.update(0.4f);   // two frames, 0.8 s
+    EXPECT_EQ(log(), "s0,f0,n1,n2,f2,s1");
+    EXPECT_EQ(tasks.size(), 0u);
+}
+
+TEST_F(TaskSchedulerTest, PlainYieldsKeepTheOldContract) {
+    // Tasks written for the per-frame loop yield nothing and get dt back.
+    spawn("local total = 0 while total < 0.25 do total = total + coroutine.yield() end log[#log+1] = 'done'");
+    for (int i = 0; i < 2; ++i) task_scheduler().update(0.1f);
+    EXPECT_EQ(log(), "");
+    task_scheduler().update(0.1f);
+    task_scheduler().update(0.1f);
+    EXPECT_EQ(log(), "done");
+}
+
+TEST_F(TaskSchedulerTest, EventWaitsResumeWithNotifyArguments) {
+    spawn("local a, b = tasks.wait_event('door_opened') log[#log+1] = a .. b");
+    const auto id = task_scheduler().event_id("door_opened");
+    spawn(("local v = tasks.wait_event(" + std::to_string(id) + ") log[#log+1] = 'id' .. tostring(v)").c_str());
+
+    auto &tasks = task_scheduler();
+    tasks.update(0.016f);
+    tasks.update(10.0f); // time passing does not wake them
+    EXPECT_EQ(log(), "");
+
+    EXPECT_EQ(lua.script("return tasks.notify('door_opened', 'x', 7)").get<int>(), 2);
+    EXPECT_EQ(log(), "x7,idx");
+    EXPECT_EQ(tasks.notify(id), 0u); // nobody waiting any more
+    EXPECT_EQ(tasks.size(), 0u);
+}
+
+TEST_F(TaskSchedulerTest, ZeroWaitsRunOncePerUpdate) {
+    // Each resume yields a wait that is due right away; none may run twice in one update.
+    spawn("log[#log+1] = 'n'; tasks.wait(0); log[#log+1] = 'n2'");
+    spawn("tasks.wait_frames(1); log[#log+1] = 'f'; tasks.wait(0); log[#log+1] = 'f2'");
+
+    auto &tasks = task_scheduler();
+    tasks.update(0.016f);
+    EXPECT_EQ(log(), "n");
+    tasks.update(0.016f);
+    EXPECT_EQ(log(), "n,f,n2"); // frame waits are resumed before seconds waits
+    tasks.update(0.016f);
+    EXPECT_EQ(log(), "n,f,n2,f2");
+    EXPECT_EQ(tasks.size(), 0u);
+}
+
+TEST_F(TaskSchedulerTest, WaitingOnAnUnknownEventIdFailsTheTask) {
+    const auto survivor = spawn("tasks.wait_event('known') log[#log+1] = 'known'");
+    spawn("tasks.wait_event(100000) log[#log+1] = 'never'");
+    spawn("coroutine.yield('event', 100001) log[#log+1] = 'never'");
+
+    auto &tasks = task_scheduler();
+    tasks.event_id("known");
+    const size_t interned = tasks.event_count();
+    tasks.update(0.016f);
+    EXPECT_EQ(tasks.event_count(), interned); // no waiter lists grown for bogus ids
+    EXPECT_EQ(tasks.size(), 1u);
+    EXPECT_TRUE(tasks.alive(survivor));
+
+    EXPECT_EQ(lua.script("return tasks.notify('known')").get<int>(), 1);
+    EXPECT_EQ(log(), "known");
+}
+
+TEST_F(TaskSchedulerTest, CancelOwnerDropsEveryTaskOfTheEntity) {
+    const auto owner = static_cast<entt::entity>(42);
+    auto &tasks = task_scheduler();
+    for (int i = 0; i < 3; ++i) spawn("tasks.wait(5) log[#log+1] = 'owned'", owner);
+    const auto other = spawn("tasks.wait(5) log[#log+1] = 'free'");
+    EXPECT_EQ(tasks.count(owner), 3u);
+
+    tasks.update(0.1f);
+    EXPECT_EQ(tasks.cancel_owner(owner), 3u);
+    EXPECT_EQ(tasks.count(owner), 0u);
+    EXPECT_TRUE(tasks.alive(other));
+
+    tasks.update(5.0f);
+    EXPECT_EQ(log(), "free");
+}
+
+TEST_F(TaskSchedulerTest, TaskCanCancelItselfAndErrorsOnlyDropTheFailingTask) {
+    lua.script("self_handle = 0");
+    const auto self = spawn("tasks.cancel(self_handle) log[#log+1] = 'ran'; tasks.next_frame() log[#log+1] = 'never'");
+    lua["self_handle"] = self;
+    spawn("tasks.next_frame() error('boom')");
+    spawn("tasks.wait_frames(2) log[#log+1] = 'survivor'");
+
+    auto &tasks = task_scheduler();
+    for (int i = 0; i < 3; ++i) tasks.update(0.016f);
+    EXPECT_EQ(log(), "ran,survivor");
+    EXPECT_FALSE(tasks.alive(self));
+    EXPECT_EQ(tasks.size(), 0u);
+}
+
+TEST_F(TaskSchedulerTest, StaleHandlesAndUnschedulableObjects) {
+    auto &tasks = task_scheduler();
+    const auto first = spawn("");
+    tasks.update(0.016f); // finishes; its slot is free again
+    const auto second = spawn("tasks.wait(1)");
+    EXPECT_NE(first, second);
+    EXPECT_FALSE(tasks.cancel(first)); // does not reach the new occupant
+    EXPECT_TRUE(tasks.alive(second));
+
+    EXPECT_EQ(tasks.spawn(sol::make_object(lua, 3)), kNoTask);
+
+    // A coroutine made in Lua can be handed over, even after it started.
+    sol::object co = lua.script(
+        "local co = coroutine.create(function() coroutine.yield() log[#log+1] = 'handed' end) "
+        "coroutine.resume(co) return co");
+    EXPECT_NE(tasks.spawn(co), kNoTask);
+    tasks.update(0.016f);
+    EXPECT_EQ(log(), "handed");
+}
+
+TEST_F(TaskSchedulerTest, SleepingTasksAreNotResumed) {
+    // 5000 tasks asleep for a minute; each update only touches the one that is due.
+    lua.script("resumes = 0");
+    for (int i = 0; i < 5000; ++i) spawn("resumes = resumes + 1 tasks.wait(60) resumes = resumes + 1");
+    spawn("while true do resumes = resumes + 1 tasks.next_frame() end");
+
+    auto &tasks = task_scheduler();
+    tasks.update(0.016f); // every task starts
+    EXPECT_EQ(lua["resumes"].get<int>(), 5001);
+    for (int i = 0; i < 100; ++i) tasks.update(0.016f);
+    EXPECT_EQ(lua["resumes"].get<int>(), 5101);
+    EXPECT_TRUE(lua.script("return tasks.in_task()").get<bool>() == false);
+}
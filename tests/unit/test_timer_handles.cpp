@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "sol/sol.hpp"
+#include "systems/ai/ai_system.hpp"
+#include "systems/timer/timer.hpp"
+
+using timer::kNoTimer;
+using timer::TimerHandle;
+namespace TimerSystem = timer::TimerSystem;
+
+namespace {
+
+class TimerHandles : public ::testing::Test {
+protected:
+    void SetUp() override { TimerSystem::clear_all_timers(); }
+    void TearDown() override { TimerSystem::clear_all_timers(); }
+
+    static TimerHandle After(float delay, int *fired, const std::string &tag = "", const std::string &group = "") {
+        return TimerSystem::timer_after(delay, [fired](std::optional<float>) { ++*fired; }, tag, group);
+    }
+};
+
+// The Lua bindings clone callbacks into the master state, so the tests run there.
+sol::state &TimerLua() {
+    sol::state &lua = ai_system::masterStateLua;
+    static bool exposed = false;
+    if (!exposed) {
+        lua.open_libraries(sol::lib::base);
+        timer::exposeToLua(lua);
+        exposed = true;
+    }
+    return lua;
+}
+
+} // namespace
+
+TEST_F(TimerHandles, StaleHandleIsRefusedAfterItsSlotIsReused) {
+    int oldFired = 0, newFired = 0;
+    const TimerHandle old = After(1.f, &oldFired);
+    TimerSystem::cancel_timer(old);
+
+    const TimerHandle reused = After(1.f, &newFired);
+    ASSERT_EQ(reused & 0xFFFFFu, old & 0xFFFFFu); // same slot, next generation
+    EXPECT_NE(reused, old);
+    EXPECT_EQ(TimerSystem::get_timer(old), nullptr);
+
+    // nothing done through the old handle reaches the new occupant
+    TimerSystem::pause_timer(old);
+    TimerSystem::cancel_timer(old);
+    TimerSystem::timer_set_multiplier(old, 100.f);
+    ASSERT_NE(TimerSystem::get_timer(reused), nullptr);
+    EXPECT_FALSE(TimerSystem::get_timer(reused)->paused);
+    EXPECT_FLOAT_EQ(TimerSystem::get_timer(reused)->multiplier, 1.f);
+
+    TimerSystem::update_timers(1.5f);
+    EXPECT_EQ(oldFired, 0);
+    EXPECT_EQ(newFired, 1);
+}
+
+TEST_F(TimerHandles, GenerationWrapsAroundWithoutEverBeingZero) {
+    int fired = 0;
+    const TimerHandle first = After(1.f, &fired);
+
+    // the 12-bit generation runs 1..4095, so the slot's 4096th occupant has the first's handle
+    TimerHandle handle = first;
+    for (int reuse = 1; reuse < 4095; ++reuse) {
+        TimerSystem::cancel_timer(handle);
+        handle = After(1.f, &fired);
+        ASSERT_EQ(handle & 0xFFFFFu, first & 0xFFFFFu);
+        ASSERT_NE(handle, first) << reuse;
+        ASSERT_NE(handle >> 20, 0u) << reuse;
+        ASSERT_NE(handle, kNoTimer);
+    }
+
+    TimerSystem::cancel_timer(handle);
+    handle = After(1.f, &fired);
+    EXPECT_EQ(handle, first);
+    EXPECT_NE(TimerSystem::get_timer(first), nullptr);
+    EXPECT_EQ(TimerSystem::timer_count(), 1u);
+}
+
+TEST_F(TimerHandles, RecreatingATagReplacesTheOldTimer) {
+    int firstFired = 0, secondFired = 0;
+    const TimerHandle first = After(1.f, &firstFired, "blink");
+    const TimerHandle second = After(2.f, &secondFired, "blink");
+
+    EXPECT_EQ(TimerSystem::get_timer(first), nullptr);
+    EXPECT_EQ(TimerSystem::find_timer("blink"), second);
+    EXPECT_EQ(TimerSystem::timer_count(), 1u);
+
+    TimerSystem::update_timers(1.5f);
+    EXPECT_EQ(firstFired, 0);
+    TimerSystem::update_timers(1.f);
+    EXPECT_EQ(secondFired, 1);
+    EXPECT_EQ(TimerSystem::find_timer("blink"), kNoTimer);
+
+    // a timer replacing itself from its own callback
+    int replaced = 0;
+    TimerSystem::timer_after(0.5f, [&](std::optional<float>) { After(0.5f, &replaced, "self"); }, "self");
+    TimerSystem::update_timers(1.f);
+    EXPECT_NE(TimerSystem::find_timer("self"), kNoTimer);
+    TimerSystem::update_timers(1.f);
+    EXPECT_EQ(replaced, 1);
+}
+
+TEST_F(TimerHandles, LuaPausesAndCancelsByHandleAndByTag) {
+    sol::state &lua = TimerLua();
+    lua.script(R"(
+        fired = { byHandle = 0, byTag = 0 }
+        handle = timer.after(1.0, function() fired.byHandle = fired.byHandle + 1 end)
+        timer.after(1.0, function() fired.byTag = fired.byTag + 1 end, "tagged")
+        timer.pause(handle)
+        timer.pause("tagged")
+    )");
+    TimerSystem::update_timers(2.f);
+    EXPECT_EQ(lua["fired"]["byHandle"].get<int>(), 0);
+    EXPECT_EQ(lua["fired"]["byTag"].get<int>(), 0);
+
+    lua.script(R"(
+        timer.resume(handle)
+        timer.resume("tagged")
+    )");
+    TimerSystem::update_timers(1.5f);
+    EXPECT_EQ(lua["fired"]["byHandle"].get<int>(), 1);
+    EXPECT_EQ(lua["fired"]["byTag"].get<int>(), 1);
+
+    lua.script(R"(
+        handle = timer.after(1.0, function() fired.byHandle = fired.byHandle + 1 end)
+        timer.after(1.0, function() fired.byTag = fired.byTag + 1 end, "tagged")
+        timer.cancel(handle)
+        timer.cancel("tagged")
+        timer.cancel("never_created")
+    )");
+    EXPECT_EQ(TimerSystem::timer_count(), 0u);
+    TimerSystem::update_timers(2.f);
+    EXPECT_EQ(lua["fired"]["byHandle"].get<int>(), 1);
+    EXPECT_EQ(lua["fired"]["byTag"].get<int>(), 1);
+}
+
+TEST_F(TimerHandles, GroupsDropFinishedHandles) {
+    int fired = 0;
+    for (int i = 0; i < 1000; ++i) {
+        After(0.f, &fired, "", "bursts");
+        TimerSystem::update_timers(0.1f);
+    }
+    EXPECT_EQ(fired, 1000);
+    EXPECT_LE(TimerSystem::groups["bursts"].size(), 2u);
+
+    // the group still reaches the timers that are alive
+    int live = 0;
+    for (int i = 0; i < 5; ++i) After(1.f, &live, "", "bursts");
+    TimerSystem::pause_group("bursts");
+    TimerSystem::update_timers(2.f);
+    EXPECT_EQ(live, 0);
+    TimerSystem::resume_group("bursts");
+    TimerSystem::update_timers(2.f);
+    EXPECT_EQ(live, 5);
+
+    for (int i = 0; i < 5; ++i) After(1.f, &live, "", "bursts");
+    TimerSystem::kill_group("bursts");
+    EXPECT_EQ(TimerSystem::timer_count(), 0u);
+}
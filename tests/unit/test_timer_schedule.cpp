@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+
+#include "systems/timer/timer_schedule.hpp"
+
+#include <algorithm>
+#include <map>
+#include <random>
+
+using timer::TimerSchedule;
+
+TEST(TimerSchedule, PopsOnlyWhatIsDueEarliestFirst) {
+    TimerSchedule schedule;
+    schedule.schedule(3, 3.0);
+    schedule.schedule(1, 1.0);
+    schedule.schedule(7, 10.0);
+    schedule.schedule(2, 2.0);
+
+    std::vector<TimerSchedule::Key> due;
+    schedule.popDue(0.5, due);
+    EXPECT_TRUE(due.empty());
+
+    schedule.popDue(3.0, due); // inclusive
+    EXPECT_EQ(due, (std::vector<TimerSchedule::Key>{1, 2, 3}));
+    EXPECT_EQ(schedule.size(), 1u);
+    EXPECT_FALSE(schedule.scheduled(3));
+    EXPECT_TRUE(schedule.scheduled(7));
+}
+
+TEST(TimerSchedule, RescheduleAndUnscheduleMoveKeys) {
+    TimerSchedule schedule;
+    schedule.schedule(0, 5.0);
+    schedule.schedule(1, 6.0);
+    schedule.schedule(0, 7.0); // pushed back
+    schedule.schedule(1, 1.0); // pulled forward
+    EXPECT_DOUBLE_EQ(schedule.due(0), 7.0);
+    EXPECT_EQ(schedule.size(), 2u);
+
+    schedule.unschedule(1);
+    schedule.unschedule(1); // no-op
+    schedule.unschedule(42); // never seen
+    EXPECT_FALSE(schedule.scheduled(1));
+
+    std::vector<TimerSchedule::Key> due;
+    schedule.popDue(100.0, due);
+    EXPECT_EQ(due, std::vector<TimerSchedule::Key>{0});
+    EXPECT_TRUE(schedule.empty());
+}
+
+TEST(TimerSchedule, RandomEditsMatchAReferenceMap) {
+    TimerSchedule schedule;
+    std::map<TimerSchedule::Key, double> expected;
+    std::mt19937 rng(37);
+    std::uniform_int_distribution<TimerSchedule::Key> pickKey(0, 199);
+    std::uniform_real_distribution<double> pickTime(0.0, 50.0);
+
+    double now = 0.0;
+    std::vector<TimerSchedule::Key> due;
+    for (int step = 0; step < 20000; ++step) {
+        const TimerSchedule::Key key = pickKey(rng);
+        switch (rng() % 8) {
+        case 0:
+            schedule.unschedule(key);
+            expected.erase(key);
+            break;
+        case 1: {
+            now += 0.25;
+            due.clear();
+            schedule.popDue(now, due);
+
+            // earliest first
+            for (size_t i = 1; i < due.size(); ++i) {
+                ASSERT_LE(expected.at(due[i - 1]), expected.at(due[i]));
+            }
+
+            std::vector<TimerSchedule::Key> want;
+            for (auto it = expected.begin(); it != expected.end();) {
+                if (it->second <= now) {
+                    want.push_back(it->first);
+                    it = expected.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+            std::vector<TimerSchedule::Key> got = due;
+            std::sort(got.begin(), got.end());
+            ASSERT_EQ(got, want) << "step " << step;
+            break;
+        }
+        default: {
+            const double at = now + pickTime(rng);
+            schedule.schedule(key, at);
+            expected[key] = at;
+            break;
+        }
+        }
+        ASSERT_EQ(schedule.size(), expected.size());
+    }
+}
@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+
+#include "systems/transform/transform_affine.hpp"
+
+#include <cmath>
+#include <random>
+
+using transform::Affine2D;
+using transform::AffineBatch;
+using transform::AffineKernel;
+
+namespace {
+
+void Apply(const Affine2D &m, float x, float y, float &outX, float &outY) {
+    outX = m.a * x + m.c * y + m.tx;
+    outY = m.b * x + m.d * y + m.ty;
+}
+
+} // namespace
+
+TEST(TransformAffine, OriginLandsOnCenterAndAxesRotate) {
+    const Affine2D m = transform::ComposeAffine(100.f, 50.f, 20.f, 10.f, 2.f, 90.f);
+
+    float x, y;
+    Apply(m, 20.f, 10.f, x, y); // the origin
+    EXPECT_NEAR(x, 100.f, 1e-4f);
+    EXPECT_NEAR(y, 50.f, 1e-4f);
+
+    Apply(m, 21.f, 10.f, x, y); // one unit along +x ends up two units along +y
+    EXPECT_NEAR(x, 100.f, 1e-4f);
+    EXPECT_NEAR(y, 52.f, 1e-4f);
+
+    EXPECT_EQ(transform::ComposeAffine(0.f, 0.f, 0.f, 0.f, 1.f, 0.f), Affine2D{});
+}
+
+TEST(TransformAffine, KernelsMatchTheReference) {
+    std::mt19937 rng(36);
+    std::uniform_real_distribution<float> pos(-4000.f, 4000.f);
+    std::uniform_real_distribution<float> size(0.f, 512.f);
+    std::uniform_real_distribution<float> scale(0.f, 3.f);
+    std::uniform_real_distribution<float> angle(-1080.f, 1080.f);
+
+    AffineBatch batch;
+    std::vector<Affine2D> expected;
+    for (int i = 0; i < 1003; ++i) { // not a multiple of the vector width
+        const float cx = pos(rng), cy = pos(rng), ox = size(rng), oy = size(rng);
+        const float s = scale(rng);
+        const float r = (i % 50 == 0) ? 90.f * static_cast<float>(i / 50 % 8) : angle(rng);
+        EXPECT_EQ(batch.push(cx, cy, ox, oy, s, r), expected.size());
+        expected.push_back(transform::ComposeAffine(cx, cy, ox, oy, s, r));
+    }
+
+    for (AffineKernel kernel : {AffineKernel::Scalar, AffineKernel::AVX2}) {
+        if (!transform::AffineKernelAvailable(kernel)) continue;
+        batch.compose(kernel);
+        for (size_t i = 0; i < expected.size(); ++i) {
+            const Affine2D got = batch.result(i);
+            const Affine2D &want = expected[i];
+            EXPECT_NEAR(got.a, want.a, 1e-5f) << i;
+            EXPECT_NEAR(got.b, want.b, 1e-5f) << i;
+            EXPECT_EQ(got.c, -got.b) << i;
+            EXPECT_EQ(got.d, got.a) << i;
+            // translations reach a few thousand pixels
+            EXPECT_NEAR(got.tx, want.tx, 1e-3f) << i;
+            EXPECT_NEAR(got.ty, want.ty, 1e-3f) << i;
+        }
+    }
+
+    batch.clear();
+    EXPECT_EQ(batch.size(), 0u);
+    batch.compose(); // empty batches are fine
+}
@@ -0,0 +1,193 @@
+#include <gtest/gtest.h>
+
+#include "systems/transform/transform_hierarchy.hpp"
+
+#include <random>
+#include <unordered_map>
+
+using transform::TransformDepthIndex;
+using Id = TransformDepthIndex::Id;
+
+namespace {
+
+// Every indexed id appears exactly once, in the bucket of its depth, and a
+// linked id sits one level below its master.
+void ExpectConsistent(const TransformDepthIndex &index) {
+    size_t seen = 0;
+    const auto &levels = index.levels();
+    for (size_t d = 0; d < levels.size(); ++d) {
+        for (Id e : levels[d]) {
+            ++seen;
+            EXPECT_EQ(index.depth(e), d) << e;
+            if (index.linked(e)) {
+                EXPECT_EQ(index.depth(index.master(e)) + 1, d) << e;
+            } else {
+                EXPECT_EQ(d, 0u) << e;
+            }
+        }
+    }
+    EXPECT_EQ(seen, index.size());
+    if (!levels.empty()) {
+        EXPECT_FALSE(levels.back().empty());
+    }
+}
+
+} // namespace
+
+TEST(TransformDepthIndex, LevelsOrderMastersBeforeSlaves) {
+    TransformDepthIndex index;
+    index.setMaster(3, 2);
+    EXPECT_FALSE(index.linked(3)); // 2 is not indexed yet
+
+    index.insert(1);
+    index.setMaster(2, 1);
+    index.setMaster(3, 2);
+
+    EXPECT_EQ(index.depth(1), 0u);
+    EXPECT_EQ(index.depth(2), 1u);
+    EXPECT_EQ(index.depth(3), 2u);
+    ASSERT_EQ(index.levels().size(), 3u);
+    ExpectConsistent(index);
+}
+
+TEST(TransformDepthIndex, SlavesWaitForTheirMaster) {
+    TransformDepthIndex index;
+    index.setMaster(3, 2);
+    index.setMaster(4, 3);
+    index.setMaster(5, 2);
+    index.setMaster(5, TransformDepthIndex::kNone); // stopped waiting
+    EXPECT_FALSE(index.linked(3));
+
+    index.insert(1);
+    index.setMaster(2, 1); // inserts 2, which picks up 3 (and 4 below it)
+    EXPECT_TRUE(index.linked(3));
+    EXPECT_EQ(index.depth(3), 2u);
+    EXPECT_EQ(index.depth(4), 3u);
+    EXPECT_FALSE(index.linked(5));
+    ExpectConsistent(index);
+
+    // a waiting slave that is erased is not linked later
+    index.setMaster(7, 6);
+    index.erase(7);
+    index.insert(6);
+    EXPECT_FALSE(index.contains(7));
+    ExpectConsistent(index);
+}
+
+TEST(TransformDepthIndex, ReparentingMovesTheWholeSubtree) {
+    TransformDepthIndex index;
+    index.insert(1);
+    index.insert(10);
+    index.setMaster(11, 10);
+    index.setMaster(2, 1);
+    index.setMaster(3, 2);
+    index.setMaster(4, 3);
+
+    index.setMaster(2, 11);
+    EXPECT_EQ(index.depth(2), 2u);
+    EXPECT_EQ(index.depth(4), 4u);
+    ExpectConsistent(index);
+
+    index.setMaster(2, TransformDepthIndex::kNone);
+    EXPECT_FALSE(index.linked(2));
+    EXPECT_EQ(index.depth(4), 2u);
+    ExpectConsistent(index);
+}
+
+TEST(TransformDepthIndex, CyclesAndSelfMastersStayUnlinked) {
+    TransformDepthIndex index;
+    index.setMaster(5, 5);
+    EXPECT_FALSE(index.linked(5));
+    EXPECT_EQ(index.master(5), 5u);
+
+    index.insert(1);
+    index.setMaster(2, 1);
+    index.setMaster(1, 2); // 2 is 1's slave
+    EXPECT_FALSE(index.linked(1));
+    EXPECT_TRUE(index.linked(2));
+    ExpectConsistent(index);
+}
+
+TEST(TransformDepthIndex, ErasingAMasterOrphansItsSlaves) {
+    TransformDepthIndex index;
+    index.insert(1);
+    index.setMaster(2, 1);
+    index.setMaster(3, 2);
+
+    index.erase(1);
+    EXPECT_FALSE(index.contains(1));
+    EXPECT_FALSE(index.linked(2));
+    EXPECT_EQ(index.master(2), 1u); // still what the role says
+    EXPECT_EQ(index.depth(3), 1u);
+    EXPECT_EQ(index.size(), 2u);
+    ExpectConsistent(index);
+
+    // a recycled slot with a new version is a different entity
+    const Id recycled = 1u | (1u << 20);
+    index.insert(recycled);
+    EXPECT_FALSE(index.contains(1));
+    EXPECT_TRUE(index.contains(recycled));
+    ExpectConsistent(index);
+}
+
+TEST(TransformDepthIndex, RandomEditsMatchRecomputedDepths) {
+    TransformDepthIndex index;
+    std::unordered_map<Id, Id> masters; // what the roles say
+    std::mt19937 rng(33);
+    constexpr Id kCount = 400;
+    std::uniform_int_distribution<Id> pick(0, kCount - 1);
+
+    for (int step = 0; step < 5000; ++step) {
+        const Id e = pick(rng);
+        if (step % 13 == 0) {
+            index.erase(e);
+            masters.erase(e);
+            continue;
+        }
+        const Id m = (rng() % 5 == 0) ? TransformDepthIndex::kNone : pick(rng);
+        index.setMaster(e, m);
+        masters[e] = m;
+    }
+    ExpectConsistent(index);
+
+    // a linked id's chain of masters ends at an unlinked root within size() steps
+    for (const auto &[e, m] : masters) {
+        ASSERT_TRUE(index.contains(e));
+        EXPECT_EQ(index.master(e), m);
+        Id walk = e;
+        uint32_t steps = 0;
+        while (index.linked(walk)) {
+            walk = index.master(walk);
+            ASSERT_LE(++steps, index.size());
+        }
+        EXPECT_EQ(steps, index.depth(e));
+    }
+}
+
+TEST(TransformDepthIndex, DirtyMarksFollowReparenting) {
+    TransformDepthIndex index;
+    index.insert(1);
+    index.setMaster(2, 1);
+    index.setMaster(3, 2);
+
+    std::vector<Id> taken;
+    for (size_t d = 0; d < 3; ++d) index.takeDirty(d, taken); // new ones start dirty
+    EXPECT_FALSE(index.dirty(3));
+
+    index.markDirty(3);
+    index.insert(10);
+    index.takeDirty(0, taken); // only 10
+    index.setMaster(3, 10);    // the queued mark moves with 3, up to depth 1
+    EXPECT_TRUE(index.dirty(3));
+
+    index.takeDirty(1, taken);
+    EXPECT_EQ(taken, std::vector<Id>{3});
+    index.takeDirty(2, taken);
+    EXPECT_TRUE(taken.empty()); // the stale depth-2 entry is dropped
+
+    index.markSlavesDirty(1);
+    EXPECT_FALSE(index.dirty(1));
+    EXPECT_TRUE(index.dirty(2));
+    index.clearDirty();
+    EXPECT_FALSE(index.dirty(2));
+}
@@ -1,53 +1,73 @@
 #include <gtest/gtest.h>
 
-#include <any>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 #include "entt/entt.hpp"
 #include "systems/transform/transform_functions.hpp"
 
-// Provide test-local definitions for the transform hook maps used by the inline template.
+namespace {
+    std::vector<std::string>* defaultCalls = nullptr;
+
+    void RecordDefaultUpdate(entt::registry*, float) {
+        if (defaultCalls) defaultCalls->push_back("default");
+    }
+}
+
+// Provide a test-local default table used by the inline template.
 namespace transform {
-    std::unordered_map<TransformMethod, std::any> transformFunctionsDefault;
-    std::unordered_map<TransformMethod, std::any> hooksToCallBeforeDefault;
-    std::unordered_map<TransformMethod, std::any> hooksToCallAfterDefault;
+    std::array<TransformMethodDefault, kTransformMethodCount> transformFunctionsDefault;
 }
 
+using UpdateFn = void(entt::registry*, float);
+
 class TransformHookTest : public ::testing::Test {
 protected:
+    void SetUp() override {
+        transform::transformFunctionsDefault[static_cast<size_t>(transform::TransformMethod::UpdateAllTransforms)] = &RecordDefaultUpdate;
+        defaultCalls = &calls;
+    }
+
     void TearDown() override {
-        transform::transformFunctionsDefault.clear();
-        transform::hooksToCallBeforeDefault.clear();
-        transform::hooksToCallAfterDefault.clear();
+        transform::ClearTransformHooks(registry, entt::null);
+        transform::transformFunctionsDefault = {};
+        defaultCalls = nullptr;
     }
+
+    void run(entt::entity e, float dt) {
+        transform::ExecuteCallsForTransformMethod<void>(registry, e, transform::TransformMethod::UpdateAllTransforms, &registry, dt);
+    }
+
+    std::function<UpdateFn> record(std::string name) {
+        return [this, name](entt::registry*, float) { calls.push_back(name); };
+    }
+
+    entt::registry registry;
+    std::vector<std::string> calls;
 };
 
 TEST_F(TransformHookTest, ExecutesHooksAndMainFunctionInOrder) {
-    std::vector<std::string> calls;
     float observedDt = -1.0f;
 
-    transform::hooksToCallBeforeDefault[transform::TransformMethod::UpdateAllTransforms] =
-        std::function<void(entt::registry*, float)>([&](entt::registry*, float dt) {
+    transform::SetTransformHook<UpdateFn>(registry, entt::null, transform::TransformMethod::UpdateAllTransforms, transform::TransformHookStage::Before,
+        [&](entt::registry*, float dt) {
             calls.push_back("before");
             observedDt = dt;
         });
 
-    transform::transformFunctionsDefault[transform::TransformMethod::UpdateAllTransforms] =
-        std::function<void(entt::registry*, float)>([&](entt::registry*, float dt) {
+    transform::SetTransformHook<UpdateFn>(registry, entt::null, transform::TransformMethod::UpdateAllTransforms, transform::TransformHookStage::Replace,
+        [&](entt::registry*, float dt) {
             calls.push_back("main");
             observedDt = dt;
         });
 
-    transform::hooksToCallAfterDefault[transform::TransformMethod::UpdateAllTransforms] =
-        std::function<void(entt::registry*, float)>([&](entt::registry*, float dt) {
+    transform::SetTransformHook<UpdateFn>(registry, entt::null, transform::TransformMethod::UpdateAllTransforms, transform::TransformHookStage::After,
+        [&](entt::registry*, float dt) {
             calls.push_back("after");
             observedDt = dt;
         });
 
-    entt::registry registry;
-    transform::ExecuteCallsForTransformMethod<void>(registry, entt::null, transform::TransformMethod::UpdateAllTransforms, &registry, 0.5f);
+    run(entt::null, 0.5f);
 
     ASSERT_EQ(calls.size(), 3u);
     EXPECT_EQ(calls[0], "before");
@@ -57,25 +77,59 @@ TEST_F(TransformHookTest, ExecutesHooksAndMainFunctionInOrder) {
 }
 
 TEST_F(TransformHookTest, UsesPerEntityHooksWhenAvailable) {
-    entt::registry registry;
     const entt::entity e = registry.create();
-    auto& go = registry.emplace<transform::GameObject>(e);
-
-    std::vector<std::string> calls;
-
-    go.hooksToCallBefore[transform::TransformMethod::UpdateAllTransforms] =
-        std::function<void(entt::registry*, float)>([&](entt::registry*, float) { calls.push_back("before-entity"); });
-
-    go.transformFunctions[transform::TransformMethod::UpdateAllTransforms] =
-        std::function<void(entt::registry*, float)>([&](entt::registry*, float) { calls.push_back("main-entity"); });
+    registry.emplace<transform::GameObject>(e);
 
-    go.hooksToCallAfter[transform::TransformMethod::UpdateAllTransforms] =
-        std::function<void(entt::registry*, float)>([&](entt::registry*, float) { calls.push_back("after-entity"); });
+    transform::SetTransformHook<UpdateFn>(registry, e, transform::TransformMethod::UpdateAllTransforms, transform::TransformHookStage::Before, record("before-entity"));
+    transform::SetTransformHook<UpdateFn>(registry, e, transform::TransformMethod::UpdateAllTransforms, transform::TransformHookStage::Replace, record("main-entity"));
+    transform::SetTransformHook<UpdateFn>(registry, e, transform::TransformMethod::UpdateAllTransforms, transform::TransformHookStage::After, record("after-entity"));
 
-    transform::ExecuteCallsForTransformMethod<void>(registry, e, transform::TransformMethod::UpdateAllTransforms, &registry, 0.1f);
+    run(e, 0.1f);
 
     ASSERT_EQ(calls.size(), 3u);
     EXPECT_EQ(calls[0], "before-entity");
     EXPECT_EQ(calls[1], "main-entity");
     EXPECT_EQ(calls[2], "after-entity");
 }
+
+TEST_F(TransformHookTest, UnhookedEntitiesCallTheDefaultOnly) {
+    const entt::entity hooked = registry.create();
+    const entt::entity plain = registry.create();
+    registry.emplace<transform::GameObject>(hooked);
+    registry.emplace<transform::GameObject>(plain);
+
+    transform::SetTransformHook<UpdateFn>(registry, hooked, transform::TransformMethod::UpdateAllTransforms, transform::TransformHookStage::After, record("after"));
+    EXPECT_EQ(registry.get<transform::GameObject>(plain).transformHookMask, 0u);
+
+    run(plain, 0.1f);
+    ASSERT_EQ(calls, std::vector<std::string>{"default"});
+
+    // without a replacement the default still runs between the hooks
+    calls.clear();
+    run(hooked, 0.1f);
+    EXPECT_EQ(calls, (std::vector<std::string>{"default", "after"}));
+
+    // the same entity id in another registry is a different entity
+    entt::registry other;
+    const entt::entity twin = other.create();
+    ASSERT_EQ(twin, hooked);
+    other.emplace<transform::GameObject>(twin).transformHookMask = transform::TransformMethodBit(transform::TransformMethod::UpdateAllTransforms);
+    calls.clear();
+    transform::ExecuteCallsForTransformMethod<void>(other, twin, transform::TransformMethod::UpdateAllTransforms, &other, 0.1f);
+    EXPECT_EQ(calls, std::vector<std::string>{"default"});
+}
+
+TEST_F(TransformHookTest, DestroyingTheGameObjectDropsItsHooks) {
+    registry.on_destroy<transform::GameObject>().connect<&transform::onGameObjectDestroyed>();
+    auto &table = transform::detail::TransformHookTable<UpdateFn>::get();
+    const size_t before = table.size();
+
+    const entt::entity e = registry.create();
+    registry.emplace<transform::GameObject>(e);
+    transform::SetTransformHook<UpdateFn>(registry, e, transform::TransformMethod::UpdateAllTransforms, transform::TransformHookStage::Before, record("before"));
+    transform::SetTransformHook<UpdateFn>(registry, e, transform::TransformMethod::UpdateAllTransforms, transform::TransformHookStage::After, record("after"));
+    EXPECT_EQ(table.size(), before + 1);
+
+    registry.destroy(e);
+    EXPECT_EQ(table.size(), before);
+}
@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+
+#include "core/globals.hpp"
+#include "systems/transform/transform.hpp"
+
+#include <entt/entt.hpp>
+
+TEST(TransformSprings, ConstructionCreatesNoEntities) {
+    auto &registry = globals::getRegistry();
+    const auto before = registry.storage<entt::entity>().in_use();
+
+    transform::Transform transform;
+
+    EXPECT_EQ(registry.storage<entt::entity>().in_use(), before);
+}
+
+TEST(TransformSprings, DefaultsMatchDefaultSprings) {
+    transform::Transform transform;
+
+    EXPECT_FLOAT_EQ(transform.getXSpring().value, transform::DEFAULT_SPRING_ZERO.value);
+    EXPECT_FLOAT_EQ(transform.getWSpring().value, transform::DEFAULT_SPRING_ONE.value);
+    EXPECT_FLOAT_EQ(transform.getSSpring().targetValue, transform::DEFAULT_SPRING_ONE.targetValue);
+    EXPECT_FLOAT_EQ(transform.getRSpring().stiffness, transform::DEFAULT_SPRING_ZERO.stiffness);
+}
+
+TEST(TransformSprings, SettersAndGettersSharePooledStorage) {
+    entt::registry registry;
+    auto e = registry.create();
+    auto &transform = registry.emplace<transform::Transform>(e);
+
+    transform.setActualX(12.f);
+    transform.setVisualY(-4.f);
+    transform.setActualScale(2.f);
+
+    EXPECT_FLOAT_EQ(transform.getXSpring().targetValue, 12.f);
+    EXPECT_FLOAT_EQ(transform.getSpring(transform::TransformSpring::Y).value, -4.f);
+    EXPECT_FLOAT_EQ(transform.getActualScale(), 2.f);
+
+    transform.getWSpring().targetValue = 64.f;
+    transform.updateCachedValues(true);
+    EXPECT_FLOAT_EQ(transform.getActualW(), 64.f);
+
+    // the copy owns its own springs
+    transform::Transform copy = transform;
+    copy.setActualX(99.f);
+    EXPECT_FLOAT_EQ(transform.getActualX(), 12.f);
+}
+
+TEST(TransformSprings, DestroyingTransformReleasesPoolSlots) {
+    auto &pool = spring::GetSpringPool();
+    const size_t before = pool.size();
+
+    entt::registry registry;
+    auto e = registry.create();
+    registry.emplace<transform::Transform>(e);
+    EXPECT_EQ(pool.size(), before + static_cast<size_t>(transform::TransformSpring::Count));
+
+    registry.destroy(e);
+    EXPECT_EQ(pool.size(), before);
+}
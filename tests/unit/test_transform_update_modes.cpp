@@ -0,0 +1,294 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "core/globals.hpp"
+#include "systems/collision/broad_phase.hpp"
+#include "systems/job_system/job_system.hpp"
+#include "systems/main_loop_enhancement/main_loop.hpp"
+#include "systems/spring/spring_pool.hpp"
+#include "systems/transform/transform_functions.hpp"
+#include "systems/transform/transform_hierarchy.hpp"
+
+using transform::InheritedProperties;
+using transform::Transform;
+
+namespace {
+
+constexpr float kDt = 1.0f / 60.0f;
+constexpr int kFrames = 150;
+
+// Everything drawing or a slave reads from a transform.
+using Snapshot = std::array<float, 21>;
+
+Snapshot Capture(Transform &t) {
+    Snapshot out{};
+    for (size_t i = 0; i < static_cast<size_t>(transform::TransformSpring::Count); ++i) {
+        const auto spring = t.getSpring(static_cast<transform::TransformSpring>(i));
+        out[i * 2] = spring.value;
+        out[i * 2 + 1] = spring.targetValue;
+    }
+    out[12] = t.rotationOffset;
+    out[13] = t.getVisualScaleWithHoverAndDynamicMotionReflected();
+    out[14] = t.getVisualRWithDynamicMotionAndXLeaning();
+    const auto &m = t.cachedMatrix;
+    out[15] = m.a;
+    out[16] = m.b;
+    out[17] = m.c;
+    out[18] = m.d;
+    out[19] = m.tx;
+    out[20] = m.ty;
+    return out;
+}
+
+struct Run {
+    std::vector<std::vector<Snapshot>> frames; // [frame][node in creation order]
+    size_t depth = 0;                           // deepest hierarchy level seen
+    size_t widest = 0;                          // most entities in one level
+};
+
+// Empties the global registry and gives it a fresh game world container.
+entt::entity ResetWorld() {
+    auto &registry = globals::getRegistry();
+    registry.clear();
+    transform::GetTransformDepthIndex().clear();
+    globals::getMasterCacheEntityToParentCompMap.clear();
+    transform::registerDestroyListeners(registry);
+    main_loop::mainLoop.frame = 1;
+
+    const entt::entity world = transform::CreateGameWorldContainerEntity(&registry, 0, 0, 4096, 4096);
+    globals::setGameWorldContainer(world);
+    return world;
+}
+
+void ClearWorld() {
+    globals::getRegistry().clear();
+    transform::GetTransformDepthIndex().clear();
+    globals::getMasterCacheEntityToParentCompMap.clear();
+}
+
+void Step() {
+    spring::GetSpringPool().update(kDt);
+    transform::UpdateAllTransforms(&globals::getRegistry(), kDt);
+    ++main_loop::mainLoop.frame;
+}
+
+// Builds a four-level hierarchy in the global registry and drives it through
+// the real UpdateAllTransforms. The edits are drawn from a fixed seed, so every
+// run sees the same sequence: roots moving and turning, offsets nudged (and
+// marked, as the dirty-only contract asks), subtrees reparented and new
+// slaves spawned. `parallel` starts the job system, so levels wider than a
+// chunk are updated by workers.
+Run Simulate(bool dirtyOnly, bool parallel = false, int roots = 6) {
+    auto &registry = globals::getRegistry();
+    const entt::entity world = ResetWorld();
+    transform::SetDirtyOnlyTransformUpdates(dirtyOnly);
+    if (parallel) job_system::init(2);
+    std::mt19937 rng(34);
+
+    std::vector<entt::entity> nodes;
+    auto spawn = [&](entt::entity master) {
+        const float x = static_cast<float>(rng() % 1000);
+        const float y = static_cast<float>(rng() % 1000);
+        const float size = static_cast<float>(16 + rng() % 32);
+        const entt::entity e = transform::CreateOrEmplace(&registry, world, x, y, size, size);
+        if (master != entt::null) {
+            const auto bond = rng() % 2 ? InheritedProperties::Sync::Strong : InheritedProperties::Sync::Weak;
+            transform::AssignRole(&registry, e, InheritedProperties::Type::RoleInheritor, master, bond, bond, bond, bond);
+            registry.get<InheritedProperties>(e).offset =
+                Vector2{static_cast<float>(rng() % 64) - 32.f, static_cast<float>(rng() % 64) - 32.f};
+        }
+        nodes.push_back(e);
+    };
+
+    // the roots, three slaves under each node of the first three levels
+    for (int i = 0; i < roots; ++i) spawn(entt::null);
+    for (size_t first = 0, level = 0; level < 3; ++level) {
+        const size_t last = nodes.size();
+        for (size_t m = first; m < last; ++m)
+            for (int s = 0; s < 3; ++s) spawn(nodes[m]);
+        first = last;
+    }
+
+    Run run;
+    for (int frame = 0; frame < kFrames; ++frame) {
+        if (frame % 25 == 10) spawn(nodes[rng() % nodes.size()]);
+
+        for (int edit = 0; edit < 5; ++edit) {
+            // masters always come earlier than their slaves, so reparenting
+            // to an earlier node never forms a cycle
+            const size_t i = rng() % nodes.size();
+            const entt::entity e = nodes[i];
+            auto &t = registry.get<Transform>(e);
+            auto &role = registry.get<InheritedProperties>(e);
+            switch (rng() % 4) {
+            case 0:
+                t.setActualX(t.getActualX() + static_cast<float>(rng() % 9) - 4.f);
+                break;
+            case 1:
+                t.setActualRotation(static_cast<float>(rng() % 90));
+                break;
+            case 2:
+                if (role.master == entt::null) break;
+                role.offset->x += static_cast<float>(rng() % 5) - 2.f;
+                transform::MarkTransformDirty(e);
+                break;
+            case 3:
+                if (i < static_cast<size_t>(roots)) break; // keep the roots
+                transform::AssignRole(&registry, e, InheritedProperties::Type::RoleInheritor, nodes[rng() % i]);
+                break;
+            }
+        }
+
+        Step();
+
+        run.depth = std::max(run.depth, transform::GetTransformDepthIndex().levels().size());
+        for (const auto &ids : transform::GetTransformDepthIndex().levels()) run.widest = std::max(run.widest, ids.size());
+        auto &snapshots = run.frames.emplace_back();
+        for (entt::entity e : nodes) snapshots.push_back(Capture(registry.get<Transform>(e)));
+    }
+
+    transform::SetDirtyOnlyTransformUpdates(false);
+    if (parallel) job_system::shutdown();
+    ClearWorld();
+    return run;
+}
+
+void ExpectSameFrames(const Run &expected, const Run &actual) {
+    ASSERT_EQ(expected.frames.size(), actual.frames.size());
+    for (size_t f = 0; f < expected.frames.size(); ++f) {
+        ASSERT_EQ(expected.frames[f].size(), actual.frames[f].size());
+        for (size_t n = 0; n < expected.frames[f].size(); ++n) {
+            for (size_t k = 0; k < Snapshot{}.size(); ++k) {
+                ASSERT_FLOAT_EQ(expected.frames[f][n][k], actual.frames[f][n][k])
+                    << "frame " << f << " node " << n << " field " << k;
+            }
+        }
+    }
+}
+
+// A root with more slaves than fit in one job chunk, every slave scripted.
+// Some slaves are dragged each frame, which raises alignmentChanged on them.
+// Records where each callback ran and every transform's matrix.
+struct DragRun {
+    std::vector<std::vector<Snapshot>> frames;
+    int callbacksOffMainThread = 0;
+};
+
+DragRun SimulateDrag(bool parallel) {
+    auto &registry = globals::getRegistry();
+    const entt::entity world = ResetWorld();
+    if (parallel) job_system::init(2);
+
+    const entt::entity cursor = transform::CreateOrEmplace(&registry, world, 300, 200, 1, 1);
+    globals::setCursorEntity(cursor);
+
+    DragRun run;
+    const std::thread::id mainThread = std::this_thread::get_id();
+    auto onMainThread = [&run, mainThread](entt::registry &, entt::entity, float) {
+        if (std::this_thread::get_id() != mainThread) ++run.callbacksOffMainThread;
+    };
+
+    const entt::entity root = transform::CreateOrEmplace(&registry, world, 100, 100, 64, 64);
+    registry.get<transform::GameObject>(root).methods.update = onMainThread;
+    std::vector<entt::entity> nodes{root};
+    for (int i = 0; i < 600; ++i) {
+        const entt::entity e = transform::CreateOrEmplace(&registry, world, 0, 0, 8, 8);
+        transform::AssignRole(&registry, e, InheritedProperties::Type::RoleInheritor, root);
+        registry.get<InheritedProperties>(e).offset = Vector2{static_cast<float>(i % 40), static_cast<float>(i / 40)};
+        registry.emplace<collision::ScreenSpaceCollisionMarker>(e); // no world camera here
+        registry.get<transform::GameObject>(e).methods.update = onMainThread;
+        nodes.push_back(e);
+    }
+
+    for (int frame = 0; frame < 20; ++frame) {
+        for (size_t i = 1 + frame % 3; i < nodes.size(); i += 3) {
+            transform::handleDefaultTransformDrag(&registry, nodes[i], Vector2{4.f, 4.f});
+        }
+        Step();
+        auto &snapshots = run.frames.emplace_back();
+        for (entt::entity e : nodes) snapshots.push_back(Capture(registry.get<Transform>(e)));
+    }
+
+    if (parallel) job_system::shutdown();
+    ClearWorld();
+    return run;
+}
+
+} // namespace
+
+// A dirty-only pass has to leave every transform where a full pass puts it.
+TEST(TransformUpdateModes, DirtyOnlyUpdatesMatchFullUpdates) {
+    const Run full = Simulate(false);
+    const Run dirty = Simulate(true);
+
+    EXPECT_GE(full.depth, 4u);
+    ExpectSameFrames(full, dirty);
+}
+
+// Levels split over several chunks on the executor come out as they do
+// serially, in both modes.
+TEST(TransformUpdateModes, ParallelLevelsMatchSerialUpdates) {
+    const Run serial = Simulate(false, false, 12);
+    const Run parallel = Simulate(false, true, 12);
+    const Run parallelDirty = Simulate(true, true, 12);
+
+    EXPECT_GT(serial.widest, 256u); // more than one chunk
+    ExpectSameFrames(serial, parallel);
+    ExpectSameFrames(serial, parallelDirty);
+}
+
+// Dragged slaves go to the main thread, so their master is never updated from
+// a job, and callbacks never leave the main thread.
+TEST(TransformUpdateModes, DraggedSlavesAreUpdatedOnTheMainThread) {
+    const DragRun serial = SimulateDrag(false);
+    const DragRun parallel = SimulateDrag(true);
+
+    EXPECT_EQ(parallel.callbacksOffMainThread, 0);
+    ASSERT_EQ(serial.frames.size(), parallel.frames.size());
+    for (size_t f = 0; f < serial.frames.size(); ++f) {
+        for (size_t n = 0; n < serial.frames[f].size(); ++n) {
+            for (size_t k = 0; k < Snapshot{}.size(); ++k) {
+                ASSERT_FLOAT_EQ(serial.frames[f][n][k], parallel.frames[f][n][k])
+                    << "frame " << f << " node " << n << " field " << k;
+            }
+        }
+    }
+}
+
+// What an update callback does to its transform shows in the same frame's matrix.
+TEST(TransformUpdateModes, ScriptedMatricesAreComposedAfterTheCallback) {
+    auto &registry = globals::getRegistry();
+    const entt::entity world = ResetWorld();
+    job_system::init(2);
+
+    const entt::entity root = transform::CreateOrEmplace(&registry, world, 100, 100, 64, 64);
+    std::vector<entt::entity> slaves;
+    for (int i = 0; i < 600; ++i) {
+        const entt::entity e = transform::CreateOrEmplace(&registry, world, 0, 0, 8, 8);
+        transform::AssignRole(&registry, e, InheritedProperties::Type::RoleInheritor, root);
+        registry.get<transform::GameObject>(e).methods.update = [](entt::registry &r, entt::entity self, float) {
+            auto &t = r.get<Transform>(self);
+            t.setVisualX(t.getVisualX() + 10.f);
+        };
+        slaves.push_back(e);
+    }
+
+    for (int frame = 0; frame < 3; ++frame) {
+        Step();
+        for (entt::entity e : slaves) {
+            auto &t = registry.get<Transform>(e);
+            const auto drawn = t.cachedMatrix;
+            transform::UpdateTransformMatrices(registry, e);
+            ASSERT_FLOAT_EQ(drawn.tx, t.cachedMatrix.tx) << "frame " << frame;
+            ASSERT_FLOAT_EQ(drawn.ty, t.cachedMatrix.ty) << "frame " << frame;
+        }
+    }
+
+    job_system::shutdown();
+    ClearWorld();
+}
@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+
+#include "systems/timer/tween_channel.hpp"
+
+#include <vector>
+
+using timer::TweenChannel;
+using timer::TweenEase;
+using timer::TweenHandle;
+
+namespace {
+
+// Writes into a shared array; index < 0 stands for a target that is gone.
+struct SlotTarget {
+    std::vector<float> *out = nullptr;
+    int index = 0;
+
+    bool write(const float *value) const
+    {
+        if (index < 0) return false;
+        (*out)[static_cast<size_t>(index) * 2] = value[0];
+        (*out)[static_cast<size_t>(index) * 2 + 1] = value[1];
+        return true;
+    }
+};
+
+} // namespace
+
+TEST(TweenChannel, EasingsStartAtZeroAndEndAtOne) {
+    for (int e = 0; e < static_cast<int>(TweenEase::Count); ++e) {
+        const auto ease = static_cast<TweenEase>(e);
+        EXPECT_NEAR(timer::EvaluateTweenEase(ease, 0.f), 0.f, 1e-5f) << e;
+        EXPECT_NEAR(timer::EvaluateTweenEase(ease, 1.f), 1.f, 1e-5f) << e;
+    }
+    EXPECT_FLOAT_EQ(timer::EvaluateTweenEase(TweenEase::QuadIn, 0.5f), 0.25f);
+    EXPECT_FLOAT_EQ(timer::EvaluateTweenEase(TweenEase::QuadInOut, 0.25f), 0.125f);
+
+    // the batched pass matches lane by lane, across runs of mixed easings
+    std::vector<TweenEase> eases;
+    std::vector<float> t, expected;
+    for (int i = 0; i < 100; ++i) {
+        eases.push_back(static_cast<TweenEase>((i / 7) % static_cast<int>(TweenEase::Count)));
+        t.push_back(static_cast<float>(i % 11) / 10.f);
+        expected.push_back(timer::EvaluateTweenEase(eases.back(), t.back()));
+    }
+    timer::EaseTweenProgress(eases.data(), t.data(), t.size());
+    for (size_t i = 0; i < t.size(); ++i) EXPECT_FLOAT_EQ(t[i], expected[i]) << i;
+}
+
+TEST(TweenChannel, InterpolatesWritesAndFinishes) {
+    std::vector<float> out(6, -1.f);
+    TweenChannel<SlotTarget, 2> channel;
+    int finished = 0;
+
+    const TweenHandle a = channel.add({&out, 0}, {0.f, 10.f}, {10.f, 30.f}, 1.f, TweenEase::Linear, [&] { finished++; });
+    const TweenHandle b = channel.add({&out, 1}, {0.f, 0.f}, {1.f, 1.f}, 0.5f, TweenEase::QuadIn);
+    channel.add({&out, -1}, {0.f, 0.f}, {1.f, 1.f}, 1.f, TweenEase::Linear, [&] { finished += 100; });
+    EXPECT_EQ(channel.size(), 3u);
+
+    channel.update(0.25f);
+    EXPECT_FLOAT_EQ(out[0], 2.5f);
+    EXPECT_FLOAT_EQ(out[1], 15.f);
+    EXPECT_FLOAT_EQ(out[2], 0.25f); // (0.25 / 0.5)^2
+    EXPECT_EQ(channel.size(), 2u);  // the one whose target is gone, without its after()
+
+    channel.update(0.25f);
+    EXPECT_FLOAT_EQ(out[2], 1.f);
+    EXPECT_FALSE(channel.active(b));
+    EXPECT_TRUE(channel.active(a));
+
+    channel.update(10.f); // overshooting clamps to the end value
+    EXPECT_FLOAT_EQ(out[0], 10.f);
+    EXPECT_FLOAT_EQ(out[1], 30.f);
+    EXPECT_EQ(finished, 1);
+    EXPECT_EQ(channel.size(), 0u);
+}
+
+TEST(TweenChannel, HandlesGoStaleAndCallbacksMayAddTweens) {
+    std::vector<float> out(4, 0.f);
+    TweenChannel<SlotTarget, 2> channel;
+
+    const TweenHandle first = channel.add({&out, 0}, {0.f, 0.f}, {1.f, 1.f}, 1.f);
+    channel.cancel(first);
+    EXPECT_FALSE(channel.active(first));
+    channel.update(0.5f);
+    EXPECT_FLOAT_EQ(out[0], 0.f); // cancelled before it wrote anything
+
+    const TweenHandle reused = channel.add({&out, 0}, {0.f, 0.f}, {1.f, 1.f}, 0.1f, TweenEase::Linear, [&] {
+        channel.add({&out, 1}, {5.f, 5.f}, {6.f, 6.f}, 1.f);
+    });
+    EXPECT_EQ(reused.index, first.index);
+    EXPECT_FALSE(channel.active(first));
+    channel.cancel(first); // stale: leaves the new tween alone
+    EXPECT_TRUE(channel.active(reused));
+
+    channel.update(0.2f);
+    EXPECT_EQ(channel.size(), 1u);
+    channel.update(0.5f);
+    EXPECT_FLOAT_EQ(out[2], 5.5f);
+
+    channel.clear();
+    EXPECT_EQ(channel.size(), 0u);
+}
+
+TEST(TweenChannel, PausedTweensHoldTheirValueUntilResumed) {
+    std::vector<float> out(4, -1.f);
+    TweenChannel<SlotTarget, 2> channel;
+    int finished = 0;
+
+    const TweenHandle b = channel.add({&out, 1}, {0.f, 0.f}, {10.f, 10.f}, 1.f);
+    const TweenHandle a = channel.add({&out, 0}, {0.f, 0.f}, {10.f, 10.f}, 1.f, TweenEase::Linear, [&] { finished++; });
+    channel.update(0.5f);
+    EXPECT_FLOAT_EQ(out[0], 5.f);
+
+    channel.setPaused(a, true);
+    channel.cancel(b); // moves a into b's lane; the pause goes with it
+    channel.update(5.f);
+    EXPECT_FLOAT_EQ(out[0], 5.f);
+    EXPECT_TRUE(channel.active(a));
+
+    channel.setPaused(a, false);
+    channel.setDuration(a, 2.f); // 0.5 of 2 seconds done
+    channel.update(0.5f);
+    EXPECT_FLOAT_EQ(out[0], 5.f);
+
+    channel.rewind(a);
+    channel.update(0.5f);
+    EXPECT_FLOAT_EQ(out[0], 2.5f);
+    channel.update(2.f);
+    EXPECT_FLOAT_EQ(out[0], 10.f);
+    EXPECT_EQ(finished, 1);
+    EXPECT_EQ(channel.size(), 0u);
+}
+
+TEST(TweenChannel, ManyTweensFinishTogether) {
+    constexpr int kCount = 20000;
+    std::vector<float> out(kCount * 2, 0.f);
+    TweenChannel<SlotTarget, 2> channel;
+    for (int i = 0; i < kCount; ++i) {
+        const auto ease = static_cast<TweenEase>(i % static_cast<int>(TweenEase::Count));
+        channel.add({&out, i}, {0.f, 0.f}, {static_cast<float>(i), 1.f}, 1.f + static_cast<float>(i % 4), ease);
+    }
+
+    for (int frame = 0; frame < 300 && channel.size() > 0; ++frame) channel.update(1.f / 60.f);
+    EXPECT_EQ(channel.size(), 0u);
+    for (int i = 0; i < kCount; ++i) ASSERT_FLOAT_EQ(out[static_cast<size_t>(i) * 2], static_cast<float>(i)) << i;
+}
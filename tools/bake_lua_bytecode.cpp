@@ -0,0 +1,30 @@
+// Pre-compiles the script tree into the bytecode cache for shipping builds.
+//
+//   bake_lua_bytecode <scripts dir> <cache dir> [<scripts dir as the game names it>]
+//
+// Chunk names are compiled into the bytecode and entries are only used when
+// they match the path the game loads a script by, so pass the game's
+// ASSETS_PATH "scripts/" as the third argument when it differs from
+// <scripts dir>.
+//
+// Must be built against the same Lua backend (and pointer width) as the
+// game; entries for any other VM flavour are simply ignored at load time.
+#include "systems/scripting/bytecode_cache.hpp"
+
+#include <iostream>
+
+int main(int argc, char** argv) {
+    if (argc != 3 && argc != 4) {
+        std::cerr << "usage: " << argv[0] << " <scripts dir> <cache dir> [<scripts dir as the game names it>]\n";
+        return 2;
+    }
+
+    std::vector<std::string> errors;
+    const std::string gameScriptsRoot = argc == 4 ? argv[3] : "";
+    const size_t baked = scripting::bytecode_cache::prebake(argv[1], argv[2], gameScriptsRoot, &errors);
+    // Not fatal: a script that does not compile here fails (or is never loaded) at runtime just the same.
+    for (const std::string& error : errors) std::cerr << "skipped: " << error << "\n";
+    std::cout << "baked " << baked << " scripts (" << scripting::bytecode_cache::vm_flavour() << ") into " << argv[2]
+              << "\n";
+    return 0;
+}